@@ -45,7 +45,7 @@ else:
 
 ref_notreq = ["ubiquitin_dgrtl","uracil.cc-pvdz.ccsd_t.json","ch4.def2-tzvp.ccsd_t.json"]
 for rf in ref_notreq:
-    if rf not in cur_files:
+    if rf not in cur_files and rf in ref_files:
         ref_files.remove(rf)
 
 def check_results(ref_energy,cur_energy,ccsd_threshold,en_str):
@@ -83,6 +83,20 @@ for ref_file in ref_files:
         print("ERROR: SCF energy does not match. reference: " + str(ref_scf_energy) + ", current: " + str(cur_scf_energy))
         sys.exit(1)
 
+    if "gradient" in ref_data["output"]["SCF"]:
+        print("Checking SCF gradient", end='')
+        grad_threshold = ref_data["input"]["SCF"].get("gradient_threshold", scf_threshold)
+        ref_grad = ref_data["output"]["SCF"]["gradient"]
+        cur_grad = cur_data["output"]["SCF"]["gradient"]
+
+        rcheck = len(ref_grad) == len(cur_grad)
+        if not rcheck: print(" ... ERROR: gradient of " + str(len(cur_grad)) + " atoms, expected " + str(len(ref_grad)))
+        for iatom in range(0,min(len(ref_grad),len(cur_grad))):
+            for xyz in range(0,3):
+                rcheck &= check_results(ref_grad[iatom][xyz],cur_grad[iatom][xyz],grad_threshold,
+                                        "gradient of atom " + str(iatom+1) + " " + "xyz"[xyz])
+        if not rcheck: sys.exit(1)
+
     ccsd_threshold = ref_data["input"]["CCSD"]["threshold"]
     if "CCSD" in ref_data["output"]:
         #print("Checking CCSD results")
@@ -198,6 +212,22 @@ for ref_file in ref_files:
 
         if not rcheck: sys.exit(1)
 
+    if "GW" in ref_data["output"]:
+        print("Checking GW results", end='')
+        # quasiparticle energies in eV
+        gw_threshold = 1e-3
+        ref_gw_data = ref_data["output"]["GW"]
+        cur_gw_data = cur_data["output"]["GW"]
+
+        rcheck = True
+        for spin in ["alpha","beta"]:
+            if spin not in ref_gw_data: continue
+            for orb in ref_gw_data[spin]:
+                ref_eqp = ref_gw_data[spin][orb]["e_qp"]
+                cur_eqp = cur_gw_data[spin][orb]["e_qp"]
+                rcheck &= check_results(ref_eqp,cur_eqp,gw_threshold,spin + " orbital " + orb + " quasiparticle energy")
+        if not rcheck: sys.exit(1)
+
     if "GFCCSD" in ref_data["output"]:
         print("Checking GFCCSD results", end='')
         ref_gfcc_data = ref_data["output"]["GFCCSD"]["retarded_alpha"]
@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+
+# Checks the analytic SCF gradient of an input against central finite differences of the energy.
+#
+# fd_gradient.py <input.json> <exe-path> <mpi-cmd> [gradient_threshold] [step_bohr]
+#
+# Runs the input with the analytic gradient, then one SCF per displaced cartesian coordinate and
+# direction, and writes <name>.fd.scf.json in the format of the SCF json output with the finite
+# difference gradient in output.SCF.gradient. Compare it with the analytic result using
+#   compare_results.py <name>.fd.scf.json <analytic scf json>
+# The generated inputs are written to <name>_fd/, a relative basisfile is resolved against the
+# directory of the input.
+
+import sys
+import os
+import copy
+import json
+import shlex
+import subprocess
+
+if len(sys.argv) < 4:
+    print("\nUsage: python3 fd_gradient.py input.json exe-path mpi-cmd [gradient_threshold] [step_bohr]")
+    sys.exit(1)
+
+inp_file = os.path.abspath(str(sys.argv[1]))
+exe_path = str(sys.argv[2])
+mpi_cmd = shlex.split(str(sys.argv[3]))
+grad_threshold = float(sys.argv[4]) if len(sys.argv) > 4 else 1e-5
+step = float(sys.argv[5]) if len(sys.argv) > 5 else 1e-3
+
+bohr_to_ang = 0.52917721092
+
+with open(inp_file) as json_file:
+    inp = json.load(json_file)
+
+name = os.path.splitext(os.path.basename(inp_file))[0]
+basis = inp["basis"]["basisset"].lower()
+scf_type = inp["SCF"].get("scf_type", "restricted")
+units = inp["geometry"].get("units", "angstrom").lower()
+gstep = step * bohr_to_ang if units == "angstrom" else step
+
+if "basisfile" in inp["basis"]:
+    inp["basis"]["basisfile"] = os.path.join(os.path.dirname(inp_file), inp["basis"]["basisfile"])
+
+inp_dir = name + "_fd"
+if not os.path.exists(inp_dir): os.makedirs(inp_dir)
+
+def run_scf(jinp, jname, gradient):
+    jinp["SCF"]["gradient"] = gradient
+    jinp["SCF"]["restart"] = False
+    jinp["TASK"] = {"scf": True}
+    jinp.setdefault("common", {})["file_prefix"] = jname
+    jfile = os.path.join(inp_dir, jname + ".json")
+    with open(jfile, "w") as out:
+        json.dump(jinp, out, indent=2)
+    with open(os.path.join(inp_dir, jname + ".out"), "w") as log:
+        if subprocess.call(mpi_cmd + [exe_path, jfile], stdout=log, stderr=subprocess.STDOUT) != 0:
+            print("ERROR: " + jfile + " failed, see " + jname + ".out")
+            sys.exit(1)
+    res_file = jname + "." + basis + "_files/" + scf_type + "/json/" + jname + "." + basis + ".scf.json"
+    with open(res_file) as json_file:
+        return json.load(json_file)
+
+ref_data = run_scf(copy.deepcopy(inp), name, True)
+if "gradient" not in ref_data["output"]["SCF"]:
+    print("ERROR: " + name + " did not write output.SCF.gradient")
+    sys.exit(1)
+
+coords = inp["geometry"]["coordinates"]
+fd_grad = []
+for iatom in range(len(coords)):
+    fd_grad.append([0.0, 0.0, 0.0])
+    for xyz in range(3):
+        energy = []
+        for sign in [1, -1]:
+            jinp = copy.deepcopy(inp)
+            fields = coords[iatom].split()
+            fields[xyz + 1] = "%.15f" % (float(fields[xyz + 1]) + sign * gstep)
+            jinp["geometry"]["coordinates"][iatom] = "   ".join(fields)
+            jname = name + "_" + str(iatom) + "xyz"[xyz] + ("p" if sign > 0 else "m")
+            energy.append(run_scf(jinp, jname, False)["output"]["SCF"]["final_energy"])
+        fd_grad[iatom][xyz] = (energy[0] - energy[1]) / (2 * step)
+
+fd_data = copy.deepcopy(ref_data)
+fd_data["input"]["SCF"]["gradient_threshold"] = grad_threshold
+fd_data["input"]["SCF"]["fd_step"] = step
+fd_data["output"]["SCF"]["gradient"] = fd_grad
+with open(name + ".fd.scf.json", "w") as out:
+    json.dump(fd_data, out, indent=2)
+
+print(name + ": finite difference gradient written to " + name + ".fd.scf.json")
@@ -320,7 +320,7 @@ void cc2_canonical_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type + "/cc2";
@@ -359,7 +359,7 @@ void cc2_canonical_driver(ExecutionContext& ec, ChemEnv& chem_env) {
       read_from_disk(d_t1, t1file);
       read_from_disk(d_t2, t2file);
     }
-    read_from_disk(cholVpr, v2file);
+    exachem::cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
     p_evl_sorted = tamm::diagonal(d_f1);
   }
@@ -369,7 +369,7 @@ void cc2_canonical_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    exachem::cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -406,7 +406,7 @@ void cc2_canonical_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     read_from_disk(d_v2, fullV2file);
   }
 
-  free_tensors(cholVpr);
+  exachem::cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
   auto [residual, corr_energy] =
     cc2_canonical::cc2_v2_driver<T>(chem_env, ec, MO, d_t1, d_t2, d_f1, d_v2, d_r1, d_r2, d_r1s,
@@ -38,7 +38,7 @@ void cd_cc2_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type + "/cc2";
@@ -52,8 +52,14 @@ void cd_cc2_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
   const bool is_rhf = sys_data.is_restricted;
 
+  const bool cc2_lowmem = ccsd_options.cc2_lowmem;
+  if(cc2_lowmem && !is_rhf)
+    tamm_terminate("[CC2] cc2_lowmem is only supported for closed-shell references");
+
   bool ccsd_restart = ccsd_options.readt || ((fs::exists(t1file) && fs::exists(t2file) &&
                                               fs::exists(f1file) && fs::exists(v2file)));
+  // The low-memory path keeps no doubles, so there is nothing to restart from.
+  if(cc2_lowmem) ccsd_restart = false;
 
   // deallocates F_AO, C_AO
   auto [cholVpr, d_f1, lcao, chol_count, max_cvecs, CI] =
@@ -62,6 +68,29 @@ void cd_cc2_driver(ExecutionContext& ec, ChemEnv& chem_env) {
                                                 cholfile);
   free_tensors(lcao);
 
+  if(cc2_lowmem) {
+    ec.pg().barrier();
+    auto cc_t1 = std::chrono::high_resolution_clock::now();
+
+    auto [residual, corr_energy] =
+      cc2_cs::cd_cc2_cs_lowmem_driver<T>(chem_env, ec, MO, CI, d_f1, cholVpr, files_prefix);
+
+    ccsd_stats(ec, hf_energy, residual, corr_energy, ccsd_options.threshold);
+
+    auto   cc_t2 = std::chrono::high_resolution_clock::now();
+    double cc2_time =
+      std::chrono::duration_cast<std::chrono::duration<double>>((cc_t2 - cc_t1)).count();
+    if(rank == 0)
+      std::cout << std::endl
+                << "Time taken for Closed Shell CC2 (low memory): " << std::fixed
+                << std::setprecision(2) << cc2_time << " secs" << std::endl;
+
+    free_tensors(d_f1);
+    exachem::cholesky_2e::free_chol_vectors(chem_env, cholVpr);
+    ec.flush_and_sync();
+    return;
+  }
+
   if(ccsd_options.writev) ccsd_options.writet = true;
 
   TiledIndexSpace N = MO("all");
@@ -83,7 +112,7 @@ void cd_cc2_driver(ExecutionContext& ec, ChemEnv& chem_env) {
       read_from_disk(d_t1, t1file);
       read_from_disk(d_t2, t2file);
     }
-    read_from_disk(cholVpr, v2file);
+    exachem::cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
     p_evl_sorted = tamm::diagonal(d_f1);
   }
@@ -93,7 +122,7 @@ void cd_cc2_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    exachem::cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -179,7 +208,8 @@ void cd_cc2_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     free_vec_tensors(d_r1s, d_r2s, d_t1s, d_t2s);
   }
 
-  free_tensors(d_f1, d_t1, d_t2, cholVpr);
+  free_tensors(d_f1, d_t1, d_t2);
+  exachem::cholesky_2e::free_chol_vectors(chem_env, cholVpr);
   if(computeTData && is_rhf) free_tensors(dt1_full, dt2_full);
 
   ec.flush_and_sync();
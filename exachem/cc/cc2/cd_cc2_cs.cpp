@@ -11,27 +11,41 @@
 namespace cc2_cs {
 
 using CCEType = double;
-CCSE_Tensors<CCEType> _a021;
-TiledIndexSpace       o_alpha, v_alpha, o_beta, v_beta;
+TiledIndexSpace o_alpha, v_alpha, o_beta, v_beta;
 
-Tensor<CCEType>       _a01V, _a02V, _a007V;
-CCSE_Tensors<CCEType> _a01, _a02, _a03, _a04, _a05, _a06, _a001, _a004, _a006, _a008, _a009, _a017,
-  _a019, _a020; //_a022
+Tensor<CCEType>       _a01V, _a02V;
+CCSE_Tensors<CCEType> _a01, _a02, _a03, _a04, _a05, _a06;
 
-Tensor<CCEType> i0_temp, t2_aaaa_temp; // CS only
-};                                     // namespace cc2_cs
+Tensor<CCEType> t2_aaaa_temp; // CS only
+};                            // namespace cc2_cs
+
+// t2_aaaa_temp = 2 t2_abab(a,b,i,j) - t2_abab(b,a,i,j)
+template<typename T>
+void cc2_cs::cc2_t2_tilde_cs(Scheduler& sch, const Tensor<T>& t2_abab, Tensor<T>& t2_aaaa) {
+  auto [p1_va, p2_va] = v_alpha.labels<2>("all");
+  auto [h1_oa, h2_oa] = o_alpha.labels<2>("all");
+
+  // clang-format off
+  sch
+    (t2_aaaa_temp()=0)
+    .exact_copy(t2_aaaa(p1_va, p2_va, h1_oa, h2_oa), t2_abab(p1_va, p2_va, h1_oa, h2_oa))
+    (t2_aaaa_temp() = t2_aaaa(), 
+    "t2_aaaa_temp() = t2_aaaa()")
+    (t2_aaaa(p1_va,p2_va,h1_oa,h2_oa) += -1.0 * t2_aaaa_temp(p2_va,p1_va,h1_oa,h2_oa), 
+    "t2_aaaa(p1_va,p2_va,h1_oa,h2_oa) += -1.0 * t2_aaaa_temp(p2_va,p1_va,h1_oa,h2_oa)")
+    (t2_aaaa_temp(p1_va,p2_va,h1_oa,h2_oa) +=  1.0 * t2_aaaa(p2_va,p1_va,h2_oa,h1_oa), 
+    "t2_aaaa_temp(p1_va,p2_va,h1_oa,h2_oa) +=  1.0 * t2_aaaa(p2_va,p1_va,h2_oa,h1_oa)");
+  // clang-format on
+}
 
 template<typename T>
 void cc2_cs::cc2_e_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace& CI,
-                      Tensor<T>& de, const Tensor<T>& t1_aa, const Tensor<T>& t2_abab,
-                      const Tensor<T>& t2_aaaa, std::vector<CCSE_Tensors<T>>& f1_se,
+                      Tensor<T>& de, const Tensor<T>& t1_aa, std::vector<CCSE_Tensors<T>>& f1_se,
                       std::vector<CCSE_Tensors<T>>& chol3d_se) {
   auto [cind] = CI.labels<1>("all");
 
   auto [p1_va, p2_va] = v_alpha.labels<2>("all");
-  auto [p1_vb]        = v_beta.labels<1>("all");
   auto [h1_oa, h2_oa] = o_alpha.labels<2>("all");
-  auto [h1_ob]        = o_beta.labels<1>("all");
 
   // f1_se     = {f1_oo,f1_ov,f1_vv}
   // chol3d_se = {chol3d_oo,chol3d_ov,chol3d_vv}
@@ -40,15 +54,6 @@ void cc2_cs::cc2_e_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledInde
 
   // clang-format off
   sch
-    (t2_aaaa_temp()=0)
-    .exact_copy(t2_aaaa(p1_va, p2_va, h1_oa, h2_oa), t2_abab(p1_va, p2_va, h1_oa, h2_oa))
-    (t2_aaaa_temp() = t2_aaaa(), 
-    "t2_aaaa_temp() = t2_aaaa()")
-    (t2_aaaa(p1_va,p2_va,h1_oa,h2_oa) += -1.0 * t2_aaaa_temp(p2_va,p1_va,h1_oa,h2_oa), 
-    "t2_aaaa(p1_va,p2_va,h1_oa,h2_oa) += -1.0 * t2_aaaa_temp(p2_va,p1_va,h1_oa,h2_oa)")
-    (t2_aaaa_temp(p1_va,p2_va,h1_oa,h2_oa) +=  1.0 * t2_aaaa(p2_va,p1_va,h2_oa,h1_oa), 
-    "t2_aaaa_temp(p1_va,p2_va,h1_oa,h2_oa) +=  1.0 * t2_aaaa(p2_va,p1_va,h2_oa,h1_oa)")
-
     (_a01V(cind) = t1_aa(p1_va, h1_oa) * chol3d_ov("aa")(h1_oa, p1_va, cind), 
     "_a01V(cind) = t1_aa(p1_va, h1_oa) * chol3d_ov( aa )(h1_oa, p1_va, cind)")
     (_a02("aa")(h1_oa, h2_oa, cind)    = t1_aa(p1_va, h1_oa) * chol3d_ov("aa")(h2_oa, p1_va, cind), 
@@ -142,134 +147,39 @@ void cc2_cs::cc2_t1_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledInd
   // clang-format on
 }
 
+// The singles enter the CC2 doubles residual only through the T1-dressed (ai|bj), so for the
+// abab block this is the dressed Coulomb term plus the Fock terms.
 template<typename T>
 void cc2_cs::cc2_t2_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace& CI,
-                       Tensor<T>& i0_abab, const Tensor<T>& t1_aa, Tensor<T>& t2_abab,
-                       Tensor<T>& t2_aaaa, std::vector<CCSE_Tensors<T>>& f1_se,
-                       std::vector<CCSE_Tensors<T>>& chol3d_se, Tensor<T>& d_f1, Tensor<T>& cv3d,
-                       Tensor<T>& res_2) {
-  auto [cind]                  = CI.labels<1>("all");
-  auto [p3, p4, a, b, c, d, e] = MO.labels<7>("virt");
-  auto [h1, h2, i, j, k, l, m] = MO.labels<7>("occ");
-
-  auto [p1_va, p2_va, p3_va, p4_va] = v_alpha.labels<4>("all");
-  auto [p1_vb, p2_vb, p3_vb, p4_vb] = v_beta.labels<4>("all");
-  auto [h1_oa, h2_oa, h3_oa, h4_oa] = o_alpha.labels<4>("all");
-  auto [h1_ob, h2_ob, h3_ob, h4_ob] = o_beta.labels<4>("all");
-
-  // f1_se     = {f1_oo,f1_ov,f1_vv}
-  // chol3d_se = {chol3d_oo,chol3d_ov,chol3d_vv}
-  auto f1_oo     = f1_se[0];
-  auto f1_ov     = f1_se[1];
-  auto f1_vv     = f1_se[2];
-  auto chol3d_oo = chol3d_se[0];
-  auto chol3d_ov = chol3d_se[1];
-  auto chol3d_vv = chol3d_se[2];
-  // auto hw     = sch.ec().exhw();
-  // auto rank = sch.ec().pg().rank();
-
-  Tensor<T> ph{{a, i, cind}, {1, 1}};
-  Tensor<T> ph_1{{a, i, cind}, {1, 1}};
-  Tensor<T> ph_2{{a, i, cind}, {1, 1}};
-  Tensor<T> ph_3{{a, i, cind}, {1, 1}};
-  // Tensor<T> ph_4{{a, i, cind}, {1, 1}};
-  Tensor<T> hh{{i, j, cind}, {1, 1}};
+                       Tensor<T>& i0_abab, const Tensor<T>& t2_abab,
+                       std::vector<CCSE_Tensors<T>>& f1_se,
+                       std::vector<CCSE_Tensors<T>>& dchol3d_se) {
+  auto [cind] = CI.labels<1>("all");
 
-  Tensor<T> d_t1{{a, i}, {1, 1}};
-  Tensor<T> d_t2{{a, b, i, j}, {2, 2}};
+  auto [p1_va, p3_va] = v_alpha.labels<2>("all");
+  auto [p2_vb, p4_vb] = v_beta.labels<2>("all");
+  auto [h1_oa, h3_oa] = o_alpha.labels<2>("all");
+  auto [h2_ob, h4_ob] = o_beta.labels<2>("all");
 
-  Tensor<T> t1_bb{v_beta, o_beta};
-  Tensor<T> t2_bbbb{v_beta, v_beta, o_beta, o_beta};
-  Tensor<T> t2_baba{v_beta, v_alpha, o_beta, o_alpha};
-  Tensor<T> t2_abba{v_alpha, v_beta, o_beta, o_alpha};
-  Tensor<T> t2_baab{v_beta, v_alpha, o_alpha, o_beta};
+  // f1_se      = {f1_oo,f1_ov,f1_vv}
+  // dchol3d_se = {dchol3d_oo,dchol3d_vo,dchol3d_vv}
+  auto f1_oo      = f1_se[0];
+  auto f1_vv      = f1_se[2];
+  auto dchol3d_vo = dchol3d_se[1];
 
   // clang-format off
-  sch.allocate(t1_bb,t2_bbbb,t2_baba,t2_abba,t2_baab, d_t1, d_t2)
-  .exact_copy(t1_bb(p1_vb,h3_ob),  t1_aa(p1_vb,h3_ob))
-  .exact_copy(t2_bbbb(p1_vb,p2_vb,h3_ob,h4_ob),  t2_aaaa(p1_vb,p2_vb,h3_ob,h4_ob)).execute();
-
   sch
-  (t2_baba(p2_vb,p1_va,h4_ob,h3_oa) =        t2_abab(p1_va,p2_vb,h3_oa,h4_ob))
-  (t2_abba(p1_va,p2_vb,h4_ob,h3_oa) = -1.0 * t2_abab(p1_va,p2_vb,h3_oa,h4_ob))
-  (t2_baab(p2_vb,p1_va,h3_oa,h4_ob) = -1.0 * t2_abab(p1_va,p2_vb,h3_oa,h4_ob))
-
-  (d_t1(p1_va,h3_oa)             = t1_aa(p1_va,h3_oa))
-  (d_t1(p1_vb,h3_ob)             = t1_bb(p1_vb,h3_ob))
-  (d_t2(p1_va,p2_va,h3_oa,h4_oa) = t2_aaaa(p1_va,p2_va,h3_oa,h4_oa))
-  (d_t2(p1_va,p2_vb,h3_oa,h4_ob) = t2_abab(p1_va,p2_vb,h3_oa,h4_ob))
-  (d_t2(p1_vb,p2_vb,h3_ob,h4_ob) = t2_bbbb(p1_vb,p2_vb,h3_ob,h4_ob))
-
-  (d_t2(p1_vb,p2_va,h3_ob,h4_oa) = t2_baba(p1_vb,p2_va,h3_ob,h4_oa))
-  (d_t2(p1_va,p2_vb,h3_ob,h4_oa) = t2_abba(p1_va,p2_vb,h3_ob,h4_oa))
-  (d_t2(p1_vb,p2_va,h3_oa,h4_ob) = t2_baab(p1_vb,p2_va,h3_oa,h4_ob))
-  .deallocate(t1_bb,t2_bbbb,t2_baba,t2_abba,t2_baab)
-  .execute();
+    (i0_abab(p1_va, p2_vb, h1_oa, h2_ob)  =        dchol3d_vo("aa")(p1_va, h1_oa, cind) * dchol3d_vo("bb")(p2_vb, h2_ob, cind), 
+    "i0_abab(p1_va, p2_vb, h1_oa, h2_ob)  =        dchol3d_vo( aa )(p1_va, h1_oa, cind) * dchol3d_vo( bb )(p2_vb, h2_ob, cind)")
+    (i0_abab(p1_va, p2_vb, h1_oa, h2_ob) +=        f1_vv("aa")(p1_va, p3_va) * t2_abab(p3_va, p2_vb, h1_oa, h2_ob), 
+    "i0_abab(p1_va, p2_vb, h1_oa, h2_ob) +=        f1_vv( aa )(p1_va, p3_va) * t2_abab(p3_va, p2_vb, h1_oa, h2_ob)")
+    (i0_abab(p1_va, p2_vb, h1_oa, h2_ob) +=        f1_vv("bb")(p2_vb, p4_vb) * t2_abab(p1_va, p4_vb, h1_oa, h2_ob), 
+    "i0_abab(p1_va, p2_vb, h1_oa, h2_ob) +=        f1_vv( bb )(p2_vb, p4_vb) * t2_abab(p1_va, p4_vb, h1_oa, h2_ob)")
+    (i0_abab(p1_va, p2_vb, h1_oa, h2_ob) += -1.0 * f1_oo("aa")(h3_oa, h1_oa) * t2_abab(p1_va, p2_vb, h3_oa, h2_ob), 
+    "i0_abab(p1_va, p2_vb, h1_oa, h2_ob) += -1.0 * f1_oo( aa )(h3_oa, h1_oa) * t2_abab(p1_va, p2_vb, h3_oa, h2_ob)")
+    (i0_abab(p1_va, p2_vb, h1_oa, h2_ob) += -1.0 * f1_oo("bb")(h4_ob, h2_ob) * t2_abab(p1_va, p2_vb, h1_oa, h4_ob), 
+    "i0_abab(p1_va, p2_vb, h1_oa, h2_ob) += -1.0 * f1_oo( bb )(h4_ob, h2_ob) * t2_abab(p1_va, p2_vb, h1_oa, h4_ob)");
   // clang-format on
-
-  Tensor<T> i0{{a, b, i, j}, {2, 2}};
-  Tensor<T> pphh{{a, b, i, j}, {2, 2}};
-  sch.allocate(ph, ph_1, ph_2, ph_3, hh, i0, pphh).execute();
-
-  // clang-format off
-  sch(i0(a, b, i, j)          =                            res_2(a, b, i, j))
-     (pphh(a, b, i, j)        = d_f1(a, c)          *       d_t2(b, c, j, i))
-     (i0(a, b, i, j)         +=                             pphh(a, b, i, j))
-     (i0(a, b, i, j)         += -1.0                *       pphh(b, a, i, j))
-     (pphh(a, b, i, j)        = d_f1(k, i)          *       d_t2(b, a, j, k))
-     (i0(a, b, i, j)         += -1.0                *       pphh(a, b, i, j))
-     (i0(a, b, i, j)         +=                             pphh(a, b, j, i))
-     (ph(b, j, cind)          = cv3d(b, c, cind)    *             d_t1(c, j))  // 4
-     (ph_2(b, j, cind)        = ph(b, j, cind)                              )
-     (pphh(a, b, i, j)        = ph(b, j, cind)      *       cv3d(a, i, cind))
-      (i0(a, b, i, j)        +=                             pphh(a, b, i, j))
-      (i0(a, b, i, j)        +=-1.0                 *       pphh(b, a, i, j))
-      (i0(a, b, i, j)        +=-1.0                 *       pphh(a, b, j, i))
-      (i0(a, b, i, j)        +=                             pphh(b, a, j, i))
-      (ph_1(b, i, cind)       = cv3d(k, i, cind)    *             d_t1(b, k))
-      (ph_3(b, i, cind)       =                             ph_1(b, i, cind))
-      (pphh(a, b, i, j)       = ph(a, j, cind)      *       ph_1(b, i, cind))
-      (i0(a, b, i, j)        +=                             pphh(a, b, i, j))
-      (i0(a, b, i, j)        += -1.0                *       pphh(a, b, j, i))
-      (i0(a, b, i, j)        += -1.0                *       pphh(b, a, i, j))
-      (i0(a, b, i, j)        +=                             pphh(b, a, j, i))
-      (pphh(a, b, i, j)       = ph(a, i, cind)      *         ph(b, j, cind))  //8
-      (i0(a, b, i, j)        += pphh(a, b, i, j))
-      (i0(a, b, i, j)        +=-1.0                 *       pphh(a, b, j, i))
-      (pphh(a, b, i, j)       = ph_1(b, j, cind)    *       cv3d(a, i, cind))   // 5
-      (i0(a, b, i, j)        += -1.0                *       pphh(a, b, i, j))
-      (i0(a, b, i, j)        +=                             pphh(a, b, j, i))
-      (i0(a, b, i, j)        +=                             pphh(b, a, i, j))
-      (i0(a, b, i, j)        += -1.0                *       pphh(b, a, j, i))
-      (pphh(a, b, i, j)       = ph_1(a, i, cind)    *       ph_1(b, j, cind))   //9
-      (i0(a, b, i, j)        += pphh(a, b, i, j))
-      (i0(a, b, i, j)        += -1.0                *       pphh(a, b, j, i)) 
-      (hh(k, j, cind)         = cv3d(k, c, cind)    *             d_t1(c, j))
-      (ph(b, j, cind)         = hh(k, j, cind)      *             d_t1(b, k))
-      (pphh(a, b, i, j)       = cv3d(a, i, cind)    *         ph(b, j, cind))
-      (i0(a, b, i, j)        += -1.0                *       pphh(a, b, i, j))
-      (i0(a, b, i, j)        +=                             pphh(a, b, j, i)) 
-      (i0(a, b, i, j)        +=                             pphh(b, a, i, j))
-      (i0(a, b, i, j)        += -1.0                *       pphh(b, a, j, i))
-      (pphh(a, b, i, j)       = ph(b, j, cind)      *       ph_2(a, i, cind))   //11
-      (i0(a, b, i, j)        += -1.0                *       pphh(a, b, i, j))
-      (i0(a, b, i, j)        +=                             pphh(a, b, j, i))
-      (i0(a, b, i, j)        +=                             pphh(b, a, i, j))
-      (i0(a, b, i, j)        += -1.0                *       pphh(b, a, j, i))
-      (pphh(a, b, i, j)       = ph(a, i, cind)      *       ph_3(b, j, cind))  //12
-      (i0(a, b, i, j)        +=                             pphh(a, b, i, j))
-      (i0(a, b, i, j)        += -1.0                *       pphh(a, b, j, i))
-      (i0(a, b, i, j)        += -1.0                *       pphh(b, a, i, j))
-      (i0(a, b, i, j)        +=                             pphh(b, a, j, i))
-      (pphh(a, b, i, j)       = ph(a, i, cind)      *         ph(b, j, cind))  // 13
-        (i0(a, b, i, j)      +=                             pphh(a, b, i, j))
-        (i0(a, b, i, j)      += -1.0                *       pphh(a, b, j, i));
-
-    // f(k, c)t1(c, i)*t2(a, b, k, j)  is not added as f(k, c) is zero for RHF case
-    // f(k, c) t1(a, k)*t2(c, b, i, j) is also not added for RHF case
-  // clang-format on
-  sch(i0_abab(p3_va, p4_vb, h1_oa, h2_ob) = i0(p3_va, p4_vb, h1_oa, h2_ob));
-  sch.deallocate(ph_2, ph_3, hh, i0, pphh).execute();
 }
 
 template<typename T>
@@ -328,20 +238,24 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
   CCSE_Tensors<T> f1_ov{MO, {O, V}, "f1_ov", {"aa", "bb"}};
   CCSE_Tensors<T> f1_vv{MO, {V, V}, "f1_vv", {"aa", "bb"}};
 
-  CCSE_Tensors<T> chol3d_oo{MO, {O, O, CI}, "chol3d_oo", {"aa", "bb"}};
-  CCSE_Tensors<T> chol3d_ov{MO, {O, V, CI}, "chol3d_ov", {"aa", "bb"}};
-  CCSE_Tensors<T> chol3d_vv{MO, {V, V, CI}, "chol3d_vv", {"aa", "bb"}};
+  CCSE_Tensors<T> chol3d_oo{MO, {O, O, CI}, "chol3d_oo", {"aa"}};
+  CCSE_Tensors<T> chol3d_ov{MO, {O, V, CI}, "chol3d_ov", {"aa"}};
+  CCSE_Tensors<T> chol3d_vv{MO, {V, V, CI}, "chol3d_vv", {"aa"}};
+
+  // T1-dressed vectors
+  CCSE_Tensors<T> dchol3d_oo{MO, {O, O, CI}, "dchol3d_oo", {"aa"}};
+  CCSE_Tensors<T> dchol3d_vo{MO, {V, O, CI}, "dchol3d_vo", {"aa", "bb"}};
+  CCSE_Tensors<T> dchol3d_vv{MO, {V, V, CI}, "dchol3d_vv", {"aa"}};
 
   std::vector<CCSE_Tensors<T>> f1_se{f1_oo, f1_ov, f1_vv};
   std::vector<CCSE_Tensors<T>> chol3d_se{chol3d_oo, chol3d_ov, chol3d_vv};
+  std::vector<CCSE_Tensors<T>> dchol3d_se{dchol3d_oo, dchol3d_vo, dchol3d_vv};
 
   _a01V = {CI};
   _a02  = CCSE_Tensors<T>{MO, {O, O, CI}, "_a02", {"aa"}};
   _a03  = CCSE_Tensors<T>{MO, {O, V, CI}, "_a03", {"aa"}};
-  _a004 = CCSE_Tensors<T>{MO, {V, V, O, O}, "_a004", {"aaaa", "abab"}};
 
   t2_aaaa_temp = {v_alpha, v_alpha, o_alpha, o_alpha};
-  i0_temp      = {v_beta, v_alpha, o_beta, o_alpha};
 
   // Intermediates
   // T1
@@ -351,23 +265,9 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
   _a05  = CCSE_Tensors<T>{MO, {O, V}, "_a05", {"aa", "bb"}};
   _a06  = CCSE_Tensors<T>{MO, {V, O, CI}, "_a06", {"aa"}};
 
-  // T2
-  _a007V = {CI};
-  _a001  = CCSE_Tensors<T>{MO, {V, V}, "_a001", {"aa", "bb"}};
-  _a006  = CCSE_Tensors<T>{MO, {O, O}, "_a006", {"aa", "bb"}};
-
-  _a008 = CCSE_Tensors<T>{MO, {O, O, CI}, "_a008", {"aa"}};
-  _a009 = CCSE_Tensors<T>{MO, {O, O, CI}, "_a009", {"aa", "bb"}};
-  _a017 = CCSE_Tensors<T>{MO, {V, O, CI}, "_a017", {"aa", "bb"}};
-  _a021 = CCSE_Tensors<T>{MO, {V, V, CI}, "_a021", {"aa", "bb"}};
-
-  _a019 = CCSE_Tensors<T>{MO, {O, O, O, O}, "_a019", {"abab"}};
-  // _a022 = CCSE_Tensors<T>{MO, {V, V, V, V}, "_a022", {"abab"}};
-  _a020 = CCSE_Tensors<T>{MO, {V, O, V, O}, "_a020", {"aaaa", "baba", "baab", "bbbb"}};
-
   double total_cc2_mem =
-    sum_tensor_sizes(t1_aa, t2_aaaa, t2_abab, d_f1, r1_aa, r2_abab, cv3d, d_e, i0_temp,
-                     t2_aaaa_temp, _a01V) +
+    sum_tensor_sizes(t1_aa, t2_aaaa, t2_abab, d_f1, r1_aa, r2_abab, cv3d, d_e, t2_aaaa_temp,
+                     _a01V) +
     CCSE_Tensors<T>::sum_tensor_sizes_list(f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv) +
     CCSE_Tensors<T>::sum_tensor_sizes_list(_a02, _a03);
 
@@ -375,11 +275,10 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
     total_cc2_mem += sum_tensor_sizes(d_r1s[ri], d_r2s[ri], d_t1s[ri], d_t2s[ri]);
 
   // Intermediates
-  // const double v4int_size         = CCSE_Tensors<T>::sum_tensor_sizes_list(_a022);
-  double total_cc2_mem_tmp = sum_tensor_sizes(_a02V, _a007V) + /*v4int_size +*/
-                             CCSE_Tensors<T>::sum_tensor_sizes_list(_a01, _a04, _a05, _a06, _a001,
-                                                                    _a004, _a006, _a008, _a009,
-                                                                    _a017, _a019, _a020, _a021);
+  double total_cc2_mem_tmp =
+    sum_tensor_sizes(_a02V) +
+    CCSE_Tensors<T>::sum_tensor_sizes_list(_a01, _a04, _a05, _a06, dchol3d_oo, dchol3d_vo,
+                                           dchol3d_vv);
 
   if(!cc2_restart) total_cc2_mem += total_cc2_mem_tmp;
 
@@ -396,7 +295,7 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
   ExecutionHW exhw = ec.exhw();
 
   sch.allocate(t2_aaaa);
-  sch.allocate(d_e, i0_temp, t2_aaaa_temp, _a01V);
+  sch.allocate(d_e, t2_aaaa_temp, _a01V);
   CCSE_Tensors<T>::allocate_list(sch, f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv);
   CCSE_Tensors<T>::allocate_list(sch, _a02, _a03);
 
@@ -405,9 +304,6 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
     (chol3d_oo("aa")(h3_oa,h4_oa,cind) = cv3d(h3_oa,h4_oa,cind))
     (chol3d_ov("aa")(h3_oa,p2_va,cind) = cv3d(h3_oa,p2_va,cind))
     (chol3d_vv("aa")(p1_va,p2_va,cind) = cv3d(p1_va,p2_va,cind))
-    (chol3d_oo("bb")(h3_ob,h4_ob,cind) = cv3d(h3_ob,h4_ob,cind))
-    (chol3d_ov("bb")(h3_ob,p1_vb,cind) = cv3d(h3_ob,p1_vb,cind))
-    (chol3d_vv("bb")(p1_vb,p2_vb,cind) = cv3d(p1_vb,p2_vb,cind))
 
     (f1_oo("aa")(h3_oa,h4_oa) = d_f1(h3_oa,h4_oa))
     (f1_ov("aa")(h3_oa,p2_va) = d_f1(h3_oa,p2_va))
@@ -421,35 +317,19 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
 
   if(!cc2_restart) {
     // allocate all intermediates
-    sch.allocate(_a02V, _a007V);
-    CCSE_Tensors<T>::allocate_list(sch, _a004, _a01, _a04, _a05, _a06, _a001, _a006, _a008, _a009,
-                                   _a017, _a019, _a020, _a021); //_a022
+    sch.allocate(_a02V);
+    CCSE_Tensors<T>::allocate_list(sch, _a01, _a04, _a05, _a06, dchol3d_oo, dchol3d_vo,
+                                   dchol3d_vv);
     sch.execute();
 
     // clang-format off
     sch
       (r1_aa() = 0)
       (r2_abab() = 0);
-      // (_a004("aaaa")(p1_va, p2_va, h4_oa, h3_oa) = 1.0 * chol3d_ov("aa")(h4_oa, p1_va, cind) * chol3d_ov("aa")(h3_oa, p2_va, cind))
-      //.exact_copy(_a004("abab")(p1_va, p1_vb, h3_oa, h3_ob), _a004("aaaa")(p1_va, p1_vb, h3_oa, h3_ob))
     // clang-format on
 
     sch.execute(exhw);
 
-    //--------------------------------------
-    auto [cind]                  = CI.labels<1>("all");
-    auto [p3, p4, a, b, c, d, e] = MO.labels<7>("virt");
-    auto [h1, h2, i, j, k, l, m] = MO.labels<7>("occ");
-    Tensor<T> res_2{{a, b, i, j}, {2, 2}};
-    Tensor<T> pphh{{a, b, i, j}, {2, 2}};
-    sch.allocate(res_2, pphh).execute();
-
-    // clang-format off
-    sch(pphh(a, b, i, j)  = cv3d(a, i, cind) * cv3d(b, j, cind))
-      (res_2(a, b, i, j)  = pphh(a, b, i, j))
-      (res_2(a, b, i, j) += -1.0*pphh(a, b, j, i));
-    // clang-format on
-
     Tensor<T> d_r1_residual{}, d_r2_residual{};
     Tensor<T>::allocate(&ec, d_r1_residual, d_r2_residual);
 
@@ -466,10 +346,13 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
                .execute();
         // clang-format on
 
-        cc2_cs::cc2_e_cs(sch, MO, CI, d_e, t1_aa, t2_abab, t2_aaaa, f1_se, chol3d_se);
+        cc2_cs::cc2_t2_tilde_cs(sch, t2_abab, t2_aaaa);
+        cc2_cs::cc2_e_cs(sch, MO, CI, d_e, t1_aa, f1_se, chol3d_se);
         cc2_cs::cc2_t1_cs(sch, MO, CI, r1_aa, t1_aa, t2_abab, f1_se, chol3d_se);
-        cc2_cs::cc2_t2_cs(sch, MO, CI, r2_abab, t1_aa, t2_abab, t2_aaaa, f1_se, chol3d_se, d_f1,
-                          cv3d, res_2);
+        t1_dress_chol_cs(sch, CI, t1_aa, chol3d_se, dchol3d_se);
+        // closed shell: the beta dressed vectors are the alpha ones
+        sch.exact_copy(dchol3d_vo("bb")(p1_vb, h3_ob, cind), dchol3d_vo("aa")(p1_vb, h3_ob, cind));
+        cc2_cs::cc2_t2_cs(sch, MO, CI, r2_abab, t2_abab, f1_se, dchol3d_se);
 
         sch.execute(exhw, profile);
 
@@ -522,13 +405,14 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
     }
 
     // deallocate all intermediates
-    sch.deallocate(_a02V, _a007V, d_r1_residual, d_r2_residual);
-    CCSE_Tensors<T>::deallocate_list(sch, _a004, _a01, _a04, _a05, _a06, _a001, _a006, _a008, _a009,
-                                     _a017, _a019, _a020, _a021); //_a022
+    sch.deallocate(_a02V, d_r1_residual, d_r2_residual);
+    CCSE_Tensors<T>::deallocate_list(sch, _a01, _a04, _a05, _a06, dchol3d_oo, dchol3d_vo,
+                                     dchol3d_vv);
 
   } // no restart
   else {
-    cc2_cs::cc2_e_cs(sch, MO, CI, d_e, t1_aa, t2_abab, t2_aaaa, f1_se, chol3d_se);
+    cc2_cs::cc2_t2_tilde_cs(sch, t2_abab, t2_aaaa);
+    cc2_cs::cc2_e_cs(sch, MO, CI, d_e, t1_aa, f1_se, chol3d_se);
 
     sch.execute(exhw, profile);
 
@@ -545,7 +429,7 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
     chem_env.write_json_data("CC2");
   }
 
-  sch.deallocate(d_e, i0_temp, t2_aaaa_temp, _a01V);
+  sch.deallocate(d_e, t2_aaaa_temp, _a01V);
   CCSE_Tensors<T>::deallocate_list(sch, _a02, _a03);
   CCSE_Tensors<T>::deallocate_list(sch, f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv);
   sch.execute();
@@ -602,6 +486,251 @@ std::tuple<double, double> cc2_cs::cd_cc2_cs_driver(
   return std::make_tuple(residual, energy);
 }
 
+template<typename T>
+std::tuple<double, double>
+cc2_cs::cd_cc2_cs_lowmem_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIndexSpace& MO,
+                                const TiledIndexSpace& CI, Tensor<T>& d_f1, Tensor<T>& cv3d,
+                                std::string cd_cc2_fp) {
+  SystemData& sys_data = chem_env.sys_data;
+  int         maxiter  = chem_env.ioptions.ccsd_options.ccsd_maxiter;
+  int         ndiis    = chem_env.ioptions.ccsd_options.ndiis;
+  double      thresh   = chem_env.ioptions.ccsd_options.threshold;
+  double      zshiftl  = chem_env.ioptions.ccsd_options.lshift;
+  bool        profile  = chem_env.ioptions.ccsd_options.profile_ccsd;
+  double      residual = 0.0;
+  double      energy   = 0.0;
+  int         niter    = 0;
+
+  const TAMM_SIZE n_occ_alpha = static_cast<TAMM_SIZE>(sys_data.n_occ_alpha);
+  const TAMM_SIZE n_vir_alpha = static_cast<TAMM_SIZE>(sys_data.n_vir_alpha);
+  const TAMM_SIZE noab        = 2 * n_occ_alpha;
+
+  std::vector<T> p_evl_sorted = tamm::diagonal(d_f1);
+
+  std::cout.precision(15);
+
+  const TiledIndexSpace& O = MO("occ");
+  const TiledIndexSpace& V = MO("virt");
+  auto [cind]              = CI.labels<1>("all");
+  const Index ctiles       = CI.num_tiles();
+
+  const int otiles  = O.num_tiles();
+  const int vtiles  = V.num_tiles();
+  const int oatiles = MO("occ_alpha").num_tiles();
+  const int vatiles = MO("virt_alpha").num_tiles();
+
+  o_alpha = {MO("occ"), range(oatiles)};
+  v_alpha = {MO("virt"), range(vatiles)};
+  o_beta  = {MO("occ"), range(oatiles, otiles)};
+  v_beta  = {MO("virt"), range(vatiles, vtiles)};
+
+  auto [p1_va, p2_va] = v_alpha.labels<2>("all");
+  auto [h3_oa, h4_oa] = o_alpha.labels<2>("all");
+
+  Tensor<T> d_e{};
+  Tensor<T> t1_aa{{v_alpha, o_alpha}, {1, 1}};
+  Tensor<T> r1_aa{{v_alpha, o_alpha}, {1, 1}};
+
+  std::vector<Tensor<T>> d_r1s, d_t1s;
+  for(int i = 0; i < ndiis; i++) {
+    d_r1s.push_back(Tensor<T>{{v_alpha, o_alpha}, {1, 1}});
+    d_t1s.push_back(Tensor<T>{{v_alpha, o_alpha}, {1, 1}});
+  }
+
+  CCSE_Tensors<T> f1_oo{MO, {O, O}, "f1_oo", {"aa"}};
+  CCSE_Tensors<T> f1_ov{MO, {O, V}, "f1_ov", {"aa"}};
+  CCSE_Tensors<T> f1_vv{MO, {V, V}, "f1_vv", {"aa"}};
+
+  CCSE_Tensors<T> chol3d_oo{MO, {O, O, CI}, "chol3d_oo", {"aa"}};
+  CCSE_Tensors<T> chol3d_ov{MO, {O, V, CI}, "chol3d_ov", {"aa"}};
+  CCSE_Tensors<T> chol3d_vv{MO, {V, V, CI}, "chol3d_vv", {"aa"}};
+
+  CCSE_Tensors<T> dchol3d_oo{MO, {O, O, CI}, "dchol3d_oo", {"aa"}};
+  CCSE_Tensors<T> dchol3d_vo{MO, {V, O, CI}, "dchol3d_vo", {"aa"}};
+  CCSE_Tensors<T> dchol3d_vv{MO, {V, V, CI}, "dchol3d_vv", {"aa"}};
+
+  std::vector<CCSE_Tensors<T>> f1_se{f1_oo, f1_ov, f1_vv};
+  std::vector<CCSE_Tensors<T>> chol3d_se{chol3d_oo, chol3d_ov, chol3d_vv};
+  std::vector<CCSE_Tensors<T>> dchol3d_se{dchol3d_oo, dchol3d_vo, dchol3d_vv};
+
+  _a01V = {CI};
+  _a02V = {CI};
+  _a01  = CCSE_Tensors<T>{MO, {O, O, CI}, "_a01", {"aa"}};
+  _a02  = CCSE_Tensors<T>{MO, {O, O, CI}, "_a02", {"aa"}};
+  _a03  = CCSE_Tensors<T>{MO, {O, V, CI}, "_a03", {"aa"}};
+  _a04  = CCSE_Tensors<T>{MO, {O, O}, "_a04", {"aa"}};
+  _a05  = CCSE_Tensors<T>{MO, {O, V}, "_a05", {"aa"}};
+  _a06  = CCSE_Tensors<T>{MO, {V, O, CI}, "_a06", {"aa"}};
+
+  // The doubles only enter the energy and the singles residual through
+  // t2_aaaa_temp = 2 t2(a,b,i,j) - t2(b,a,i,j), with the CC2 amplitudes
+  // t2(a,b,i,j) = sum_Q L~(a,i,Q) L~(b,j,Q) / (e_i + e_j - e_a - e_b).
+  // Each block is assembled from the dressed vectors when it is requested.
+  Tensor<T> chol_ai = dchol3d_vo("aa");
+  auto      t2_tilde_block = [chol_ai, ctiles, noab,
+                         evl = p_evl_sorted](const IndexVector& blockid, span<T> buf) mutable {
+    const Index ba = blockid[0], bb = blockid[1], bi = blockid[2], bj = blockid[3];
+    const auto& tis = chol_ai.tiled_index_spaces();
+
+    const auto   ai_dims = chol_ai.block_dims(IndexVector{ba, bi, 0});
+    const auto   bj_dims = chol_ai.block_dims(IndexVector{bb, bj, 0});
+    const size_t da = ai_dims[0], di = ai_dims[1], db = bj_dims[0], dj = bj_dims[1];
+
+    // coul(a,i,b,j) = sum_Q L~(a,i,Q) L~(b,j,Q), exch(b,i,a,j) = sum_Q L~(b,i,Q) L~(a,j,Q)
+    std::vector<T> coul(da * di * db * dj, 0), exch(db * di * da * dj, 0);
+    for(Index c = 0; c < ctiles; c++) {
+      const size_t   dc = chol_ai.block_dims(IndexVector{ba, bi, c})[2];
+      std::vector<T> lai(da * di * dc), lbj(db * dj * dc), lbi(db * di * dc), laj(da * dj * dc);
+      chol_ai.get(IndexVector{ba, bi, c}, lai);
+      chol_ai.get(IndexVector{bb, bj, c}, lbj);
+      chol_ai.get(IndexVector{bb, bi, c}, lbi);
+      chol_ai.get(IndexVector{ba, bj, c}, laj);
+      blas::gemm(blas::Layout::RowMajor, blas::Op::NoTrans, blas::Op::Trans, da * di, db * dj, dc,
+                 1.0, lai.data(), dc, lbj.data(), dc, 1.0, coul.data(), db * dj);
+      blas::gemm(blas::Layout::RowMajor, blas::Op::NoTrans, blas::Op::Trans, db * di, da * dj, dc,
+                 1.0, lbi.data(), dc, laj.data(), dc, 1.0, exch.data(), da * dj);
+    }
+
+    const size_t aoff = noab + tis[0].tile_offset(ba), boff = noab + tis[0].tile_offset(bb);
+    const size_t ioff = tis[1].tile_offset(bi), joff = tis[1].tile_offset(bj);
+    for(size_t a = 0, x = 0; a < da; a++)
+      for(size_t b = 0; b < db; b++)
+        for(size_t i = 0; i < di; i++)
+          for(size_t j = 0; j < dj; j++, x++) {
+            const T denom = evl[ioff + i] + evl[joff + j] - evl[aoff + a] - evl[boff + b];
+            buf[x] = (2.0 * coul[((a * di + i) * db + b) * dj + j] -
+                      exch[((b * di + i) * da + a) * dj + j]) /
+                     denom;
+          }
+  };
+  t2_aaaa_temp = Tensor<T>{{v_alpha, v_alpha, o_alpha, o_alpha}, t2_tilde_block};
+
+  double total_cc2_mem =
+    sum_tensor_sizes(t1_aa, r1_aa, d_f1, cv3d, d_e, _a01V, _a02V) +
+    CCSE_Tensors<T>::sum_tensor_sizes_list(f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv) +
+    CCSE_Tensors<T>::sum_tensor_sizes_list(dchol3d_oo, dchol3d_vo, dchol3d_vv) +
+    CCSE_Tensors<T>::sum_tensor_sizes_list(_a01, _a02, _a03, _a04, _a05, _a06);
+
+  for(int i = 0; i < ndiis; i++) total_cc2_mem += sum_tensor_sizes(d_r1s[i], d_t1s[i]);
+
+  if(ec.print()) {
+    std::cout << std::endl
+              << "Total CPU memory required for low-memory Closed Shell Cholesky CC2: "
+              << std::fixed << std::setprecision(2) << total_cc2_mem << " GiB" << std::endl;
+  }
+  check_memory_requirements(ec, total_cc2_mem);
+
+  print_ccsd_header(ec.print(), "CC2");
+
+  Scheduler   sch{ec};
+  ExecutionHW exhw = ec.exhw();
+
+  sch.allocate(d_e, t1_aa, r1_aa, _a01V, _a02V);
+  for(int i = 0; i < ndiis; i++) sch.allocate(d_r1s[i], d_t1s[i]);
+  CCSE_Tensors<T>::allocate_list(sch, f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv);
+  CCSE_Tensors<T>::allocate_list(sch, dchol3d_oo, dchol3d_vo, dchol3d_vv);
+  CCSE_Tensors<T>::allocate_list(sch, _a01, _a02, _a03, _a04, _a05, _a06);
+
+  // clang-format off
+  sch
+    (t1_aa() = 0)
+    (chol3d_oo("aa")(h3_oa,h4_oa,cind) = cv3d(h3_oa,h4_oa,cind))
+    (chol3d_ov("aa")(h3_oa,p2_va,cind) = cv3d(h3_oa,p2_va,cind))
+    (chol3d_vv("aa")(p1_va,p2_va,cind) = cv3d(p1_va,p2_va,cind))
+
+    (f1_oo("aa")(h3_oa,h4_oa) = d_f1(h3_oa,h4_oa))
+    (f1_ov("aa")(h3_oa,p2_va) = d_f1(h3_oa,p2_va))
+    (f1_vv("aa")(p1_va,p2_va) = d_f1(p1_va,p2_va));
+  // clang-format on
+
+  sch.execute();
+
+  Tensor<T> d_r1_residual{};
+  Tensor<T>::allocate(&ec, d_r1_residual);
+
+  for(int titer = 0; titer < maxiter; titer += ndiis) {
+    for(int iter = titer; iter < std::min(titer + ndiis, maxiter); iter++) {
+      const auto timer_start = std::chrono::high_resolution_clock::now();
+
+      niter   = iter;
+      int off = iter - titer;
+
+      sch((d_t1s[off])() = t1_aa()).execute();
+
+      // the dressed vectors have to be complete before any block of t2_aaaa_temp is requested
+      t1_dress_chol_cs(sch, CI, t1_aa, chol3d_se, dchol3d_se);
+      sch.execute(exhw);
+
+      // t2 enters only through t2_aaaa_temp
+      cc2_cs::cc2_e_cs(sch, MO, CI, d_e, t1_aa, f1_se, chol3d_se);
+      cc2_cs::cc2_t1_cs(sch, MO, CI, r1_aa, t1_aa, Tensor<T>{}, f1_se, chol3d_se);
+
+      sch.execute(exhw, profile);
+
+      // clang-format off
+      sch
+        (d_r1_residual() = r1_aa() * r1_aa())
+        ((d_r1s[off])()  = r1_aa())
+        .execute();
+      // clang-format on
+
+      residual = 0.5 * std::sqrt(get_scalar(d_r1_residual));
+      energy   = get_scalar(d_e);
+      jacobi_cs(ec, r1_aa, t1_aa, -1.0 * zshiftl, false, p_evl_sorted, n_occ_alpha, n_vir_alpha,
+                true);
+
+      const auto timer_end = std::chrono::high_resolution_clock::now();
+      auto       iter_time =
+        std::chrono::duration_cast<std::chrono::duration<double>>((timer_end - timer_start))
+          .count();
+
+      iteration_print(chem_env, ec.pg(), iter, residual, energy, iter_time);
+
+      if(residual < thresh) { break; }
+    }
+
+    if(residual < thresh || titer + ndiis >= maxiter) { break; }
+    if(ec.pg().rank() == 0) {
+      std::cout << " MICROCYCLE DIIS UPDATE:";
+      std::cout.width(21);
+      std::cout << std::right << std::min(titer + ndiis, maxiter) + 1 << std::endl;
+    }
+
+    std::vector<std::vector<Tensor<T>>> rs{d_r1s};
+    std::vector<std::vector<Tensor<T>>> ts{d_t1s};
+    std::vector<Tensor<T>>              next_t{t1_aa};
+    diis<T>(ec, rs, ts, next_t);
+  }
+
+  if(profile && ec.print()) {
+    std::string   profile_csv = cd_cc2_fp + "_profile.csv";
+    std::ofstream pds(profile_csv, std::ios::out);
+    if(!pds) std::cerr << "Error opening file " << profile_csv << std::endl;
+    pds << ec.get_profile_header() << std::endl;
+    pds << ec.get_profile_data().str() << std::endl;
+    pds.close();
+  }
+
+  sys_data.cc2_corr_energy = energy;
+
+  if(ec.pg().rank() == 0) {
+    sys_data.results["output"]["CC2"]["n_iterations"]                = niter + 1;
+    sys_data.results["output"]["CC2"]["final_energy"]["correlation"] = energy;
+    sys_data.results["output"]["CC2"]["final_energy"]["total"]       = sys_data.scf_energy + energy;
+    chem_env.write_json_data("CC2");
+  }
+
+  sch.deallocate(d_e, t1_aa, r1_aa, _a01V, _a02V, d_r1_residual);
+  CCSE_Tensors<T>::deallocate_list(sch, _a01, _a02, _a03, _a04, _a05, _a06);
+  CCSE_Tensors<T>::deallocate_list(sch, dchol3d_oo, dchol3d_vo, dchol3d_vv);
+  CCSE_Tensors<T>::deallocate_list(sch, f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv);
+  sch.execute();
+  free_vec_tensors(d_r1s, d_t1s);
+  t2_aaaa_temp = {};
+
+  return std::make_tuple(residual, energy);
+}
+
 using T = double;
 template std::tuple<double, double> cc2_cs::cd_cc2_cs_driver<T>(
   ChemEnv& chem_env, ExecutionContext& ec, const TiledIndexSpace& MO, const TiledIndexSpace& CI,
@@ -609,3 +738,8 @@ template std::tuple<double, double> cc2_cs::cd_cc2_cs_driver<T>(
   std::vector<Tensor<T>>& d_r1s, std::vector<Tensor<T>>& d_r2s, std::vector<Tensor<T>>& d_t1s,
   std::vector<Tensor<T>>& d_t2s, std::vector<T>& p_evl_sorted, Tensor<T>& cv3d, Tensor<T> dt1_full,
   Tensor<T> dt2_full, bool cc2_restart, std::string out_fp, bool computeTData);
+
+template std::tuple<double, double>
+cc2_cs::cd_cc2_cs_lowmem_driver<T>(ChemEnv& chem_env, ExecutionContext& ec,
+                                   const TiledIndexSpace& MO, const TiledIndexSpace& CI,
+                                   Tensor<T>& d_f1, Tensor<T>& cv3d, std::string out_fp);
@@ -14,10 +14,13 @@ using namespace tamm;
 
 namespace cc2_cs {
 
+template<typename T>
+void cc2_t2_tilde_cs(Scheduler& sch, const Tensor<T>& t2_abab, Tensor<T>& t2_aaaa);
+
 template<typename T>
 void cc2_e_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace& CI, Tensor<T>& de,
-              const Tensor<T>& t1_aa, const Tensor<T>& t2_abab, const Tensor<T>& t2_aaaa,
-              std::vector<CCSE_Tensors<T>>& f1_se, std::vector<CCSE_Tensors<T>>& chol3d_se);
+              const Tensor<T>& t1_aa, std::vector<CCSE_Tensors<T>>& f1_se,
+              std::vector<CCSE_Tensors<T>>& chol3d_se);
 
 template<typename T>
 void cc2_t1_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace& CI,
@@ -26,9 +29,8 @@ void cc2_t1_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace&
 
 template<typename T>
 void cc2_t2_cs(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace& CI,
-               Tensor<T>& i0_abab, const Tensor<T>& t1_aa, Tensor<T>& t2_abab, Tensor<T>& t2_aaaa,
-               std::vector<CCSE_Tensors<T>>& f1_se, std::vector<CCSE_Tensors<T>>& chol3d_se,
-               Tensor<T>& d_f1, Tensor<T>& cv3d, Tensor<T>& res_2);
+               Tensor<T>& i0_abab, const Tensor<T>& t2_abab, std::vector<CCSE_Tensors<T>>& f1_se,
+               std::vector<CCSE_Tensors<T>>& dchol3d_se);
 
 template<typename T>
 std::tuple<double, double> cd_cc2_cs_driver(
@@ -38,4 +40,12 @@ std::tuple<double, double> cd_cc2_cs_driver(
   std::vector<Tensor<T>>& d_t2s, std::vector<T>& p_evl_sorted, Tensor<T>& cv3d, Tensor<T> dt1_full,
   Tensor<T> dt2_full, bool cc2_restart = false, std::string out_fp = "", bool computeTData = false);
 
+// CC2 without stored doubles: t2 is rebuilt block by block from the T1-dressed (ai|Q) vectors
+// whenever the singles residual or the energy need it.
+template<typename T>
+std::tuple<double, double> cd_cc2_cs_lowmem_driver(ChemEnv& chem_env, ExecutionContext& ec,
+                                                   const TiledIndexSpace& MO,
+                                                   const TiledIndexSpace& CI, Tensor<T>& d_f1,
+                                                   Tensor<T>& cv3d, std::string out_fp = "");
+
 }; // namespace cc2_cs
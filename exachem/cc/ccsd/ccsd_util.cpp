@@ -78,6 +78,9 @@ void iteration_print(ChemEnv& chem_env, const ProcGroup& pg, int iter, double re
       {"residual", residual}, {"correlation", energy}};
     chem_env.sys_data.results["output"][cmethod]["iter"][std::to_string(iter + 1)]["performance"] =
       {{"total_time", time}};
+    chem_env.telemetry.record(
+      cmethod, "iteration",
+      {{"iter", iter + 1}, {"wall_time", time}, {"residual", residual}, {"correlation", energy}});
   }
 }
 
@@ -167,6 +170,81 @@ rest_cs(ExecutionContext& ec, const TiledIndexSpace& MO, Tensor<T>& d_r1, Tensor
   return {residual, energy};
 }
 
+template<typename T>
+void t1_dress_chol_cs(Scheduler& sch, const TiledIndexSpace& CI, const Tensor<T>& t1_aa,
+                      std::vector<CCSE_Tensors<T>>& chol3d_se, CCSE_Tensors<T>& dchol3d_oo,
+                      CCSE_Tensors<T>& dchol3d_vv) {
+  auto [cind]   = CI.labels<1>("all");
+  auto [a, b]   = t1_aa.tiled_index_spaces()[0].labels<2>("all");
+  auto [i, k]   = t1_aa.tiled_index_spaces()[1].labels<2>("all");
+  auto chol_oo  = chol3d_se[0]("aa");
+  auto chol_ov  = chol3d_se[1]("aa");
+  auto chol_vv  = chol3d_se[2]("aa");
+  auto dchol_oo = dchol3d_oo("aa");
+  auto dchol_vv = dchol3d_vv("aa");
+
+  // L~(k,i) = L(k,i) + t(b,i) L(k,b)
+  // L~(a,b) = L(a,b) - t(a,k) L(k,b)
+  // clang-format off
+  sch
+    (dchol_oo(k, i, cind)  =        chol_oo(k, i, cind))
+    (dchol_oo(k, i, cind) +=        t1_aa(b, i) * chol_ov(k, b, cind))
+    (dchol_vv(a, b, cind)  =        chol_vv(a, b, cind))
+    (dchol_vv(a, b, cind) += -1.0 * t1_aa(a, k) * chol_ov(k, b, cind));
+  // clang-format on
+}
+
+template<typename T>
+void t1_dress_chol_os(Scheduler& sch, const TiledIndexSpace& CI, const Tensor<T>& t1_aa,
+                      const Tensor<T>& t1_bb, std::vector<CCSE_Tensors<T>>& chol3d_se,
+                      CCSE_Tensors<T>& dchol3d_oo, CCSE_Tensors<T>& dchol3d_vv) {
+  auto [cind]     = CI.labels<1>("all");
+  auto [a_a, b_a] = t1_aa.tiled_index_spaces()[0].labels<2>("all");
+  auto [i_a, k_a] = t1_aa.tiled_index_spaces()[1].labels<2>("all");
+  auto [a_b, b_b] = t1_bb.tiled_index_spaces()[0].labels<2>("all");
+  auto [i_b, k_b] = t1_bb.tiled_index_spaces()[1].labels<2>("all");
+  // chol3d_se{chol3d_oo,chol3d_ov,chol3d_vo,chol3d_vv}
+  auto chol_oo = chol3d_se[0];
+  auto chol_ov = chol3d_se[1];
+  auto chol_vv = chol3d_se[3];
+
+  // same dressing as t1_dress_chol_cs, once per spin block
+  // clang-format off
+  sch
+    (dchol3d_oo("aa")(k_a, i_a, cind)  =        chol_oo("aa")(k_a, i_a, cind))
+    (dchol3d_oo("aa")(k_a, i_a, cind) +=        t1_aa(b_a, i_a) * chol_ov("aa")(k_a, b_a, cind))
+    (dchol3d_oo("bb")(k_b, i_b, cind)  =        chol_oo("bb")(k_b, i_b, cind))
+    (dchol3d_oo("bb")(k_b, i_b, cind) +=        t1_bb(b_b, i_b) * chol_ov("bb")(k_b, b_b, cind))
+    (dchol3d_vv("aa")(a_a, b_a, cind)  =        chol_vv("aa")(a_a, b_a, cind))
+    (dchol3d_vv("aa")(a_a, b_a, cind) += -1.0 * t1_aa(a_a, k_a) * chol_ov("aa")(k_a, b_a, cind))
+    (dchol3d_vv("bb")(a_b, b_b, cind)  =        chol_vv("bb")(a_b, b_b, cind))
+    (dchol3d_vv("bb")(a_b, b_b, cind) += -1.0 * t1_bb(a_b, k_b) * chol_ov("bb")(k_b, b_b, cind));
+  // clang-format on
+}
+
+template<typename T>
+void t1_dress_chol_cs(Scheduler& sch, const TiledIndexSpace& CI, const Tensor<T>& t1_aa,
+                      std::vector<CCSE_Tensors<T>>& chol3d_se,
+                      std::vector<CCSE_Tensors<T>>& dchol3d_se) {
+  t1_dress_chol_cs(sch, CI, t1_aa, chol3d_se, dchol3d_se[0], dchol3d_se[2]);
+
+  auto [cind]   = CI.labels<1>("all");
+  auto [a, b]   = t1_aa.tiled_index_spaces()[0].labels<2>("all");
+  auto [i, k]   = t1_aa.tiled_index_spaces()[1].labels<2>("all");
+  auto chol_ov  = chol3d_se[1]("aa");
+  auto chol_vv  = chol3d_se[2]("aa");
+  auto dchol_oo = dchol3d_se[0]("aa");
+  auto dchol_vo = dchol3d_se[1]("aa");
+
+  // L~(a,i) = L(a,i) + t(b,i) L(a,b) - t(a,k) L~(k,i)
+  // clang-format off
+  sch
+    (dchol_vo(a, i, cind)  =        chol_ov(i, a, cind))
+    (dchol_vo(a, i, cind) +=        t1_aa(b, i) * chol_vv(a, b, cind))
+    (dchol_vo(a, i, cind) += -1.0 * t1_aa(a, k) * dchol_oo(k, i, cind));
+  // clang-format on
+}
+
 void print_ccsd_header(const bool do_print, std::string mname) {
   if(do_print) {
     if(mname.empty()) mname = "CCSD";
@@ -412,6 +490,22 @@ rest_cs<T>(ExecutionContext& ec, const TiledIndexSpace& MO, Tensor<T>& d_r1, Ten
            Tensor<T>& d_r2_residual, std::vector<T>& p_evl_sorted, double zshiftl,
            const TAMM_SIZE& noa, const TAMM_SIZE& nva, bool transpose, const bool not_spin_orbital);
 
+template void t1_dress_chol_cs<T>(Scheduler& sch, const TiledIndexSpace& CI,
+                                 const Tensor<T>& t1_aa, std::vector<CCSE_Tensors<T>>& chol3d_se,
+                                 std::vector<CCSE_Tensors<T>>& dchol3d_se);
+template void t1_dress_chol_cs<T>(Scheduler& sch, const TiledIndexSpace& CI,
+                                 const Tensor<T>& t1_aa, std::vector<CCSE_Tensors<T>>& chol3d_se,
+                                 CCSE_Tensors<T>& dchol3d_oo, CCSE_Tensors<T>& dchol3d_vv);
+template void t1_dress_chol_os<T>(Scheduler& sch, const TiledIndexSpace& CI,
+                                 const Tensor<T>& t1_aa, const Tensor<T>& t1_bb,
+                                 std::vector<CCSE_Tensors<T>>& chol3d_se,
+                                 CCSE_Tensors<T>& dchol3d_oo, CCSE_Tensors<T>& dchol3d_vv);
+// the real-time EOM driver propagates complex amplitudes
+template void t1_dress_chol_os<std::complex<T>>(
+  Scheduler& sch, const TiledIndexSpace& CI, const Tensor<std::complex<T>>& t1_aa,
+  const Tensor<std::complex<T>>& t1_bb, std::vector<CCSE_Tensors<std::complex<T>>>& chol3d_se,
+  CCSE_Tensors<std::complex<T>>& dchol3d_oo, CCSE_Tensors<std::complex<T>>& dchol3d_vv);
+
 template std::tuple<std::vector<T>, Tensor<T>, Tensor<T>, Tensor<T>, Tensor<T>,
                     std::vector<Tensor<T>>, std::vector<Tensor<T>>, std::vector<Tensor<T>>,
                     std::vector<Tensor<T>>>
@@ -48,6 +48,33 @@ rest_cs(ExecutionContext& ec, const TiledIndexSpace& MO, Tensor<T>& d_r1, Tensor
         Tensor<T>& d_r2_residual, std::vector<T>& p_evl_sorted, T zshiftl, const TAMM_SIZE& noa,
         const TAMM_SIZE& nva, bool transpose = false, const bool not_spin_orbital = false);
 
+/**
+ * T1-dressed closed-shell Cholesky vectors, rebuilt once per iteration so that the residuals
+ * see the singles only through the dressed vectors.
+ *
+ * @param chol3d_se  bare vectors {oo,ov,vv}, "aa" blocks are used
+ * @param dchol3d_se dressed vectors {oo,vo,vv}, "aa" blocks are written; the dressed ov block
+ *                   is identical to the bare one
+ */
+template<typename T>
+void t1_dress_chol_cs(Scheduler& sch, const TiledIndexSpace& CI, const Tensor<T>& t1_aa,
+                      std::vector<CCSE_Tensors<T>>& chol3d_se,
+                      std::vector<CCSE_Tensors<T>>& dchol3d_se);
+
+// dressed oo and vv blocks only, for residuals that fold the T1 terms of the vo block into
+// their own intermediates (closed-shell CCSD)
+template<typename T>
+void t1_dress_chol_cs(Scheduler& sch, const TiledIndexSpace& CI, const Tensor<T>& t1_aa,
+                      std::vector<CCSE_Tensors<T>>& chol3d_se, CCSE_Tensors<T>& dchol3d_oo,
+                      CCSE_Tensors<T>& dchol3d_vv);
+
+// open-shell counterpart of the oo/vv form: writes the "aa" and "bb" blocks of the dressed
+// vectors from chol3d_se{oo,ov,vo,vv} (open-shell CCSD, RT-EOM-CCSD)
+template<typename T>
+void t1_dress_chol_os(Scheduler& sch, const TiledIndexSpace& CI, const Tensor<T>& t1_aa,
+                      const Tensor<T>& t1_bb, std::vector<CCSE_Tensors<T>>& chol3d_se,
+                      CCSE_Tensors<T>& dchol3d_oo, CCSE_Tensors<T>& dchol3d_vv);
+
 void print_ccsd_header(const bool do_print, std::string mname = "");
 
 template<typename T>
@@ -40,7 +40,7 @@ void exachem::cc::ccsd::cd_ccsd(ExecutionContext& ec, ChemEnv& chem_env) {
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -84,7 +84,7 @@ void exachem::cc::ccsd::cd_ccsd(ExecutionContext& ec, ChemEnv& chem_env) {
       read_from_disk(d_t1, t1file);
       read_from_disk(d_t2, t2file);
     }
-    read_from_disk(cholVpr, v2file);
+    cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
     p_evl_sorted = tamm::diagonal(d_f1);
   }
@@ -94,7 +94,7 @@ void exachem::cc::ccsd::cd_ccsd(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -180,7 +180,8 @@ void exachem::cc::ccsd::cd_ccsd(ExecutionContext& ec, ChemEnv& chem_env) {
     free_vec_tensors(d_r1s, d_r2s, d_t1s, d_t2s);
   }
 
-  free_tensors(d_f1, d_t1, d_t2, cholVpr);
+  free_tensors(d_f1, d_t1, d_t2);
+  cholesky_2e::free_chol_vectors(chem_env, cholVpr);
   if(computeTData && is_rhf) free_tensors(dt1_full, dt2_full);
 
   ec.flush_and_sync();
@@ -8,6 +8,7 @@
  */
 
 #include "cd_ccsd_cs_ann.hpp"
+#include "common/memory_plan.hpp"
 
 using CCEType = double;
 CCSE_Tensors<CCEType> _a021;
@@ -468,6 +469,9 @@ void exachem::cc::ccsd::ccsd_t2_cs(Scheduler& sch, const TiledIndexSpace& MO,
 
   a22_abab = Tensor<T>{{v_alpha, v_beta, v_alpha, v_beta}, compute_v4_term};
 
+  // _a009 = L~(k,i) and _a021 = L~(a,b), the T1-dressed cholesky vectors shared with CC2
+  t1_dress_chol_cs(sch, CI, t1_aa, chol3d_se, _a009, _a021);
+
   // clang-format off
   sch
     (_a017("aa")(p1_va, h2_oa, cind)         = -1.0  * t2_aaaa_temp(p1_va, p2_va, h2_oa, h1_oa) * chol3d_ov("aa")(h1_oa, p2_va, cind),
@@ -476,22 +480,16 @@ void exachem::cc::ccsd::ccsd_t2_cs(Scheduler& sch, const TiledIndexSpace& MO,
     "_a006( aa )(h2_oa, h1_oa)               = -1.0  * chol3d_ov( aa )(h2_oa, p2_va, cind) * _a017( aa )(p2_va, h1_oa, cind)")
     (_a007V(cind)                            =  2.0  * chol3d_ov("aa")(h1_oa, p1_va, cind) * t1_aa(p1_va, h1_oa),
     "_a007V(cind)                            =  2.0  * chol3d_ov( aa )(h1_oa, p1_va, cind) * t1_aa(p1_va, h1_oa)")
-    (_a009("aa")(h1_oa, h2_oa, cind)         =  1.0  * chol3d_ov("aa")(h1_oa, p1_va, cind) * t1_aa(p1_va, h2_oa),
-    "_a009( aa )(h1_oa, h2_oa, cind)         =  1.0  * chol3d_ov( aa )(h1_oa, p1_va, cind) * t1_aa(p1_va, h2_oa)")
-    (_a021("aa")(p2_va, p1_va, cind)         = -0.5  * chol3d_ov("aa")(h1_oa, p1_va, cind) * t1_aa(p2_va, h1_oa),
-    "_a021( aa )(p2_va, p1_va, cind)         = -0.5  * chol3d_ov( aa )(h1_oa, p1_va, cind) * t1_aa(p2_va, h1_oa)")
-    (_a021("aa")(p2_va, p1_va, cind)        +=  0.5  * chol3d_vv("aa")(p2_va, p1_va, cind),
-    "_a021( aa )(p2_va, p1_va, cind)        +=  0.5  * chol3d_vv( aa )(p2_va, p1_va, cind)")
-    (_a017("aa")(p1_va, h2_oa, cind)        += -2.0  * t1_aa(p2_va, h2_oa) * _a021("aa")(p1_va, p2_va, cind),
-    "_a017( aa )(p1_va, h2_oa, cind)        += -2.0  * t1_aa(p2_va, h2_oa) * _a021( aa )(p1_va, p2_va, cind)")
+    (_a017("aa")(p1_va, h2_oa, cind)        += -1.0  * t1_aa(p2_va, h2_oa) * _a021("aa")(p1_va, p2_va, cind),
+    "_a017( aa )(p1_va, h2_oa, cind)        += -1.0  * t1_aa(p2_va, h2_oa) * _a021( aa )(p1_va, p2_va, cind)")
     (_a008("aa")(h2_oa, h1_oa, cind)         =  1.0  * _a009("aa")(h2_oa, h1_oa, cind),
     "_a008( aa )(h2_oa, h1_oa, cind)         =  1.0  * _a009( aa )(h2_oa, h1_oa, cind)")
-    (_a009("aa")(h2_oa, h1_oa, cind)        +=  1.0  * chol3d_oo("aa")(h2_oa, h1_oa, cind),
-    "_a009( aa )(h2_oa, h1_oa, cind)        +=  1.0  * chol3d_oo( aa )(h2_oa, h1_oa, cind)")
+    (_a008("aa")(h2_oa, h1_oa, cind)        += -1.0  * chol3d_oo("aa")(h2_oa, h1_oa, cind),
+    "_a008( aa )(h2_oa, h1_oa, cind)        += -1.0  * chol3d_oo( aa )(h2_oa, h1_oa, cind)")
     .exact_copy(_a009("bb")(h2_ob,h1_ob,cind),_a009("aa")(h2_ob,h1_ob,cind))
     .exact_copy(_a021("bb")(p2_vb,p1_vb,cind),_a021("aa")(p2_vb,p1_vb,cind))
-    (_a001("aa")(p1_va, p2_va)               = -2.0  * _a021("aa")(p1_va, p2_va, cind) * _a007V(cind),
-    "_a001( aa )(p1_va, p2_va)               = -2.0  * _a021( aa )(p1_va, p2_va, cind) * _a007V(cind)")
+    (_a001("aa")(p1_va, p2_va)               = -1.0  * _a021("aa")(p1_va, p2_va, cind) * _a007V(cind),
+    "_a001( aa )(p1_va, p2_va)               = -1.0  * _a021( aa )(p1_va, p2_va, cind) * _a007V(cind)")
     (_a001("aa")(p1_va, p2_va)              += -1.0  * _a017("aa")(p1_va, h2_oa, cind) * chol3d_ov("aa")(h2_oa, p2_va, cind),
     "_a001( aa )(p1_va, p2_va)              += -1.0  * _a017( aa )(p1_va, h2_oa, cind) * chol3d_ov( aa )(h2_oa, p2_va, cind)")
     (_a006("aa")(h2_oa, h1_oa)              +=  1.0  * _a009("aa")(h2_oa, h1_oa, cind) * _a007V(cind),
@@ -500,8 +498,8 @@ void exachem::cc::ccsd::ccsd_t2_cs(Scheduler& sch, const TiledIndexSpace& MO,
     "_a006( aa )(h3_oa, h1_oa)              += -1.0  * _a009( aa )(h2_oa, h1_oa, cind) * _a008( aa )(h3_oa, h2_oa, cind)")
     (_a019("abab")(h2_oa, h1_ob, h1_oa, h2_ob)  =  0.25 * _a009("aa")(h2_oa, h1_oa, cind) * _a009("bb")(h1_ob, h2_ob, cind),
     "_a019( abab )(h2_oa, h1_ob, h1_oa, h2_ob)  =  0.25 * _a009( aa )(h2_oa, h1_oa, cind) * _a009( bb )(h1_ob, h2_ob, cind)")
-    (_a020("aaaa")(p2_va, h2_oa, p1_va, h1_oa)  = -2.0  * _a009("aa")(h2_oa, h1_oa, cind) * _a021("aa")(p2_va, p1_va, cind),
-    "_a020( aaaa )(p2_va, h2_oa, p1_va, h1_oa)  = -2.0  * _a009( aa )(h2_oa, h1_oa, cind) * _a021( aa )(p2_va, p1_va, cind)")
+    (_a020("aaaa")(p2_va, h2_oa, p1_va, h1_oa)  = -1.0  * _a009("aa")(h2_oa, h1_oa, cind) * _a021("aa")(p2_va, p1_va, cind),
+    "_a020( aaaa )(p2_va, h2_oa, p1_va, h1_oa)  = -1.0  * _a009( aa )(h2_oa, h1_oa, cind) * _a021( aa )(p2_va, p1_va, cind)")
     .exact_copy(_a020("baba")(p2_vb, h2_oa, p1_vb, h1_oa),_a020("aaaa")(p2_vb, h2_oa, p1_vb, h1_oa))
     (_a020("aaaa")(p1_va, h3_oa, p3_va, h2_oa) +=  0.5  * _a004("aaaa")(p2_va, p3_va, h3_oa, h1_oa) * t2_aaaa(p1_va,p2_va,h1_oa,h2_oa),
     "_a020( aaaa )(p1_va, h3_oa, p3_va, h2_oa) +=  0.5  * _a004( aaaa )(p2_va, p3_va, h3_oa, h1_oa) * t2_aaaa(p1_va,p2_va,h1_oa,h2_oa)")
@@ -542,8 +540,8 @@ void exachem::cc::ccsd::ccsd_t2_cs(Scheduler& sch, const TiledIndexSpace& MO,
     sch
     // (_a022("abab")(p1_va,p2_vb,p2_va,p1_vb)       =  1.0  * _a021("aa")(p1_va,p2_va,cind) * _a021("bb")(p2_vb,p1_vb,cind),
     // "_a022( abab )(p1_va,p2_vb,p2_va,p1_vb)       =  1.0  * _a021( aa )(p1_va,p2_va,cind) * _a021( bb )(p2_vb,p1_vb,cind)")
-    (i0_abab(p1_va, p2_vb, h1_oa, h2_ob)         +=  4.0  * a22_abab(p1_va, p2_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob),
-    "i0_abab(p1_va, p2_vb, h1_oa, h2_ob)         +=  4.0  * a22_abab(p1_va, p2_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob)");
+    (i0_abab(p1_va, p2_vb, h1_oa, h2_ob)         +=  1.0  * a22_abab(p1_va, p2_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob),
+    "i0_abab(p1_va, p2_vb, h1_oa, h2_ob)         +=  1.0  * a22_abab(p1_va, p2_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob)");
 
 
     sch(_a019("abab")(h2_oa, h1_ob, h1_oa, h2_ob)   +=  0.25 * _a004("abab")(p1_va, p2_vb, h2_oa, h1_ob) * t2_abab(p1_va,p2_vb,h1_oa,h2_ob),
@@ -620,9 +618,10 @@ std::tuple<double, double> exachem::cc::ccsd::cd_ccsd_cs_driver(
   CCSE_Tensors<T> f1_ov{MO, {O, V}, "f1_ov", {"aa", "bb"}};
   CCSE_Tensors<T> f1_vv{MO, {V, V}, "f1_vv", {"aa", "bb"}};
 
-  CCSE_Tensors<T> chol3d_oo{MO, {O, O, CI}, "chol3d_oo", {"aa", "bb"}};
-  CCSE_Tensors<T> chol3d_ov{MO, {O, V, CI}, "chol3d_ov", {"aa", "bb"}};
-  CCSE_Tensors<T> chol3d_vv{MO, {V, V, CI}, "chol3d_vv", {"aa", "bb"}};
+  // the closed-shell equations only use the alpha block of the cholesky vectors
+  CCSE_Tensors<T> chol3d_oo{MO, {O, O, CI}, "chol3d_oo", {"aa"}};
+  CCSE_Tensors<T> chol3d_ov{MO, {O, V, CI}, "chol3d_ov", {"aa"}};
+  CCSE_Tensors<T> chol3d_vv{MO, {V, V, CI}, "chol3d_vv", {"aa"}};
 
   std::vector<CCSE_Tensors<T>> f1_se{f1_oo, f1_ov, f1_vv};
   std::vector<CCSE_Tensors<T>> chol3d_se{chol3d_oo, chol3d_ov, chol3d_vv};
@@ -657,14 +656,20 @@ std::tuple<double, double> exachem::cc::ccsd::cd_ccsd_cs_driver(
   // _a022 = CCSE_Tensors<T>{MO, {V, V, V, V}, "_a022", {"abab"}};
   _a020 = CCSE_Tensors<T>{MO, {V, O, V, O}, "_a020", {"aaaa", "baba", "baab", "bbbb"}};
 
-  double total_ccsd_mem =
-    sum_tensor_sizes(t1_aa, t2_aaaa, t2_abab, d_f1, r1_aa, r2_abab, cv3d, d_e, i0_temp,
-                     t2_aaaa_temp, _a01V) +
-    CCSE_Tensors<T>::sum_tensor_sizes_list(f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv) +
-    CCSE_Tensors<T>::sum_tensor_sizes_list(_a02, _a03);
-
+  MemoryPlan ccsd_plan{ec, "CCSD", chem_env.ioptions.common_options.memory_overhead};
+  ccsd_plan.allocate("amplitudes and residuals", t1_aa, t2_aaaa, t2_abab, r1_aa, r2_abab, i0_temp,
+                     t2_aaaa_temp);
+  ccsd_plan.allocate("fock and cholesky vectors", d_f1, cv3d, d_e, _a01V);
+  ccsd_plan.allocate_gib(
+    "fock and cholesky blocks",
+    CCSE_Tensors<T>::sum_tensor_sizes_list(f1_oo, f1_ov, f1_vv, chol3d_oo, chol3d_ov, chol3d_vv));
+  ccsd_plan.allocate_gib("intermediates (_a02,_a03)",
+                         CCSE_Tensors<T>::sum_tensor_sizes_list(_a02, _a03));
+
+  double diis_mem = 0;
   for(size_t ri = 0; ri < d_r1s.size(); ri++)
-    total_ccsd_mem += sum_tensor_sizes(d_r1s[ri], d_r2s[ri], d_t1s[ri], d_t2s[ri]);
+    diis_mem += sum_tensor_sizes(d_r1s[ri], d_r2s[ri], d_t1s[ri], d_t2s[ri]);
+  ccsd_plan.allocate_gib("diis history", diis_mem);
 
   // Intermediates
   // const double v4int_size         = CCSE_Tensors<T>::sum_tensor_sizes_list(_a022);
@@ -673,16 +678,16 @@ std::tuple<double, double> exachem::cc::ccsd::cd_ccsd_cs_driver(
                                                                      _a004, _a006, _a008, _a009,
                                                                      _a017, _a019, _a020, _a021);
 
-  if(!ccsd_restart) total_ccsd_mem += total_ccsd_mem_tmp;
+  if(!ccsd_restart) ccsd_plan.allocate_gib("iteration intermediates", total_ccsd_mem_tmp);
 
   if(ec.print()) {
     std::cout << std::endl
               << "Total CPU memory required for Closed Shell Cholesky CCSD calculation: "
-              << std::fixed << std::setprecision(2) << total_ccsd_mem << " GiB" << std::endl;
+              << std::fixed << std::setprecision(2) << ccsd_plan.peak() << " GiB" << std::endl;
     // std::cout << " (V^4 intermediate size: " << std::fixed << std::setprecision(2) << v4int_size
     //           << " GiB)" << std::endl;
   }
-  check_memory_requirements(ec, total_ccsd_mem);
+  ccsd_plan.check(ec, "the CCSD iterations", false);
 
   print_ccsd_header(ec.print());
 
@@ -699,9 +704,6 @@ std::tuple<double, double> exachem::cc::ccsd::cd_ccsd_cs_driver(
     (chol3d_oo("aa")(h3_oa,h4_oa,cind) = cv3d(h3_oa,h4_oa,cind))
     (chol3d_ov("aa")(h3_oa,p2_va,cind) = cv3d(h3_oa,p2_va,cind))
     (chol3d_vv("aa")(p1_va,p2_va,cind) = cv3d(p1_va,p2_va,cind))
-    (chol3d_oo("bb")(h3_ob,h4_ob,cind) = cv3d(h3_ob,h4_ob,cind))
-    (chol3d_ov("bb")(h3_ob,p1_vb,cind) = cv3d(h3_ob,p1_vb,cind))
-    (chol3d_vv("bb")(p1_vb,p2_vb,cind) = cv3d(p1_vb,p2_vb,cind))
 
     (f1_oo("aa")(h3_oa,h4_oa) = d_f1(h3_oa,h4_oa))
     (f1_ov("aa")(h3_oa,p2_va) = d_f1(h3_oa,p2_va))
@@ -827,6 +829,7 @@ std::tuple<double, double> exachem::cc::ccsd::cd_ccsd_cs_driver(
     sys_data.results["output"]["CCSD"]["final_energy"]["correlation"] = energy;
     sys_data.results["output"]["CCSD"]["final_energy"]["total"]     = sys_data.scf_energy + energy;
     sys_data.results["output"]["CCSD"]["performance"]["total_time"] = ccsd_time;
+    chem_env.telemetry.record("CCSD", "total", {{"wall_time", ccsd_time}, {"correlation", energy}});
     chem_env.write_json_data("CCSD");
   }
 
@@ -884,6 +887,8 @@ std::tuple<double, double> exachem::cc::ccsd::cd_ccsd_cs_driver(
 
   sch.deallocate(t2_aaaa).execute();
 
+  ccsd_plan.validate(ec, chem_env.telemetry);
+
   return std::make_tuple(residual, energy);
 }
 
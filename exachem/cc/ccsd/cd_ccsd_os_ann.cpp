@@ -7,6 +7,7 @@
  */
 
 #include "cd_ccsd_os_ann.hpp"
+#include "common/memory_plan.hpp"
 
 using CCEType = double;
 CCSE_Tensors<CCEType> _a021_os;
@@ -579,6 +580,9 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
   a22_abab_os = Tensor<T>{{v_alpha_os, v_beta_os, v_alpha_os, v_beta_os}, compute_v4_term};
   a22_bbbb_os = Tensor<T>{{v_beta_os, v_beta_os, v_beta_os, v_beta_os}, compute_v4_term};
 
+  // _a009_os = L~(k,i) and _a021_os = L~(a,b) per spin, the T1-dressed cholesky vectors
+  t1_dress_chol_os(sch, CI, t1_aa, t1_bb, chol3d_se, _a009_os, _a021_os);
+
   // clang-format off
   sch
     (_a017_os("aa")(p3_va, h2_oa, cind)         = -1.0   * t2_aaaa(p1_va, p3_va, h3_oa, h2_oa) * chol3d_ov("aa")(h3_oa, p1_va, cind),
@@ -597,35 +601,23 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
     "_a007V_os(cind)                            =  1.0   * chol3d_ov( aa )(h4_oa, p1_va, cind) * t1_aa(p1_va, h4_oa)")
     (_a007V_os(cind)                           +=  1.0   * chol3d_ov("bb")(h4_ob, p1_vb, cind) * t1_bb(p1_vb, h4_ob),
     "_a007V_os(cind)                           +=  1.0   * chol3d_ov( bb )(h4_ob, p1_vb, cind) * t1_bb(p1_vb, h4_ob)")
-    (_a009_os("aa")(h3_oa, h2_oa, cind)         =  1.0   * chol3d_ov("aa")(h3_oa, p1_va, cind) * t1_aa(p1_va, h2_oa),
-    "_a009_os( aa )(h3_oa, h2_oa, cind)         =  1.0   * chol3d_ov( aa )(h3_oa, p1_va, cind) * t1_aa(p1_va, h2_oa)")
-    (_a009_os("bb")(h3_ob, h2_ob, cind)         =  1.0   * chol3d_ov("bb")(h3_ob, p1_vb, cind) * t1_bb(p1_vb, h2_ob),
-    "_a009_os( bb )(h3_ob, h2_ob, cind)         =  1.0   * chol3d_ov( bb )(h3_ob, p1_vb, cind) * t1_bb(p1_vb, h2_ob)")
-    (_a021_os("aa")(p3_va, p1_va, cind)         = -0.5   * chol3d_ov("aa")(h3_oa, p1_va, cind) * t1_aa(p3_va, h3_oa),
-    "_a021_os( aa )(p3_va, p1_va, cind)         = -0.5   * chol3d_ov( aa )(h3_oa, p1_va, cind) * t1_aa(p3_va, h3_oa)")
-    (_a021_os("bb")(p3_vb, p1_vb, cind)         = -0.5   * chol3d_ov("bb")(h3_ob, p1_vb, cind) * t1_bb(p3_vb, h3_ob),
-    "_a021_os( bb )(p3_vb, p1_vb, cind)         = -0.5   * chol3d_ov( bb )(h3_ob, p1_vb, cind) * t1_bb(p3_vb, h3_ob)")
-    (_a021_os("aa")(p3_va, p1_va, cind)        +=  0.5   * chol3d_vv("aa")(p3_va, p1_va, cind),
-    "_a021_os( aa )(p3_va, p1_va, cind)        +=  0.5   * chol3d_vv( aa )(p3_va, p1_va, cind)")
-    (_a021_os("bb")(p3_vb, p1_vb, cind)        +=  0.5   * chol3d_vv("bb")(p3_vb, p1_vb, cind),
-    "_a021_os( bb )(p3_vb, p1_vb, cind)        +=  0.5   * chol3d_vv( bb )(p3_vb, p1_vb, cind)")
-    (_a017_os("aa")(p3_va, h2_oa, cind)        += -2.0   * t1_aa(p2_va, h2_oa) * _a021_os("aa")(p3_va, p2_va, cind),
-    "_a017_os( aa )(p3_va, h2_oa, cind)        += -2.0   * t1_aa(p2_va, h2_oa) * _a021_os( aa )(p3_va, p2_va, cind)")
-    (_a017_os("bb")(p3_vb, h2_ob, cind)        += -2.0   * t1_bb(p2_vb, h2_ob) * _a021_os("bb")(p3_vb, p2_vb, cind),
-    "_a017_os( bb )(p3_vb, h2_ob, cind)        += -2.0   * t1_bb(p2_vb, h2_ob) * _a021_os( bb )(p3_vb, p2_vb, cind)")
+    (_a017_os("aa")(p3_va, h2_oa, cind)        += -1.0   * t1_aa(p2_va, h2_oa) * _a021_os("aa")(p3_va, p2_va, cind),
+    "_a017_os( aa )(p3_va, h2_oa, cind)        += -1.0   * t1_aa(p2_va, h2_oa) * _a021_os( aa )(p3_va, p2_va, cind)")
+    (_a017_os("bb")(p3_vb, h2_ob, cind)        += -1.0   * t1_bb(p2_vb, h2_ob) * _a021_os("bb")(p3_vb, p2_vb, cind),
+    "_a017_os( bb )(p3_vb, h2_ob, cind)        += -1.0   * t1_bb(p2_vb, h2_ob) * _a021_os( bb )(p3_vb, p2_vb, cind)")
     (_a008_os("aa")(h3_oa, h1_oa, cind)         =  1.0   * _a009_os("aa")(h3_oa, h1_oa, cind),
     "_a008_os( aa )(h3_oa, h1_oa, cind)         =  1.0   * _a009_os( aa )(h3_oa, h1_oa, cind)")
+    (_a008_os("aa")(h3_oa, h1_oa, cind)        += -1.0   * chol3d_oo("aa")(h3_oa, h1_oa, cind),
+    "_a008_os( aa )(h3_oa, h1_oa, cind)        += -1.0   * chol3d_oo( aa )(h3_oa, h1_oa, cind)")
     (_a008_os("bb")(h3_ob, h1_ob, cind)         =  1.0   * _a009_os("bb")(h3_ob, h1_ob, cind),
     "_a008_os( bb )(h3_ob, h1_ob, cind)         =  1.0   * _a009_os( bb )(h3_ob, h1_ob, cind)")
-    (_a009_os("aa")(h3_oa, h1_oa, cind)        +=  1.0   * chol3d_oo("aa")(h3_oa, h1_oa, cind),
-    "_a009_os( aa )(h3_oa, h1_oa, cind)        +=  1.0   * chol3d_oo( aa )(h3_oa, h1_oa, cind)")
-    (_a009_os("bb")(h3_ob, h1_ob, cind)        +=  1.0   * chol3d_oo("bb")(h3_ob, h1_ob, cind),
-    "_a009_os( bb )(h3_ob, h1_ob, cind)        +=  1.0   * chol3d_oo( bb )(h3_ob, h1_ob, cind)")
-
-    (_a001_os("aa")(p4_va, p2_va)                  = -2.0   * _a021_os("aa")(p4_va, p2_va, cind) * _a007V_os(cind),
-    "_a001_os( aa )(p4_va, p2_va)                  = -2.0   * _a021_os( aa )(p4_va, p2_va, cind) * _a007V_os(cind)")
-    (_a001_os("bb")(p4_vb, p2_vb)                  = -2.0   * _a021_os("bb")(p4_vb, p2_vb, cind) * _a007V_os(cind),
-    "_a001_os( bb )(p4_vb, p2_vb)                  = -2.0   * _a021_os( bb )(p4_vb, p2_vb, cind) * _a007V_os(cind)")
+    (_a008_os("bb")(h3_ob, h1_ob, cind)        += -1.0   * chol3d_oo("bb")(h3_ob, h1_ob, cind),
+    "_a008_os( bb )(h3_ob, h1_ob, cind)        += -1.0   * chol3d_oo( bb )(h3_ob, h1_ob, cind)")
+
+    (_a001_os("aa")(p4_va, p2_va)                  = -1.0   * _a021_os("aa")(p4_va, p2_va, cind) * _a007V_os(cind),
+    "_a001_os( aa )(p4_va, p2_va)                  = -1.0   * _a021_os( aa )(p4_va, p2_va, cind) * _a007V_os(cind)")
+    (_a001_os("bb")(p4_vb, p2_vb)                  = -1.0   * _a021_os("bb")(p4_vb, p2_vb, cind) * _a007V_os(cind),
+    "_a001_os( bb )(p4_vb, p2_vb)                  = -1.0   * _a021_os( bb )(p4_vb, p2_vb, cind) * _a007V_os(cind)")
     (_a001_os("aa")(p4_va, p2_va)                 += -1.0   * _a017_os("aa")(p4_va, h2_oa, cind) * chol3d_ov("aa")(h2_oa, p2_va, cind),
     "_a001_os( aa )(p4_va, p2_va)                 += -1.0   * _a017_os( aa )(p4_va, h2_oa, cind) * chol3d_ov( aa )(h2_oa, p2_va, cind)")
     (_a001_os("bb")(p4_vb, p2_vb)                 += -1.0   * _a017_os("bb")(p4_vb, h2_ob, cind) * chol3d_ov("bb")(h2_ob, p2_vb, cind),
@@ -644,14 +636,14 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
     "_a019_os( abab )(h4_oa, h3_ob, h1_oa, h2_ob)  =  0.25  * _a009_os( aa )(h4_oa, h1_oa, cind) * _a009_os( bb )(h3_ob, h2_ob, cind)")
     (_a019_os("bbbb")(h4_ob, h3_ob, h1_ob, h2_ob)  =  0.25  * _a009_os("bb")(h4_ob, h1_ob, cind) * _a009_os("bb")(h3_ob, h2_ob, cind),
     "_a019_os( bbbb )(h4_ob, h3_ob, h1_ob, h2_ob)  =  0.25  * _a009_os( bb )(h4_ob, h1_ob, cind) * _a009_os( bb )(h3_ob, h2_ob, cind)")
-    (_a020_os("aaaa")(p4_va, h4_oa, p1_va, h1_oa)  = -2.0   * _a009_os("aa")(h4_oa, h1_oa, cind) * _a021_os("aa")(p4_va, p1_va, cind),
-    "_a020_os( aaaa )(p4_va, h4_oa, p1_va, h1_oa)  = -2.0   * _a009_os( aa )(h4_oa, h1_oa, cind) * _a021_os( aa )(p4_va, p1_va, cind)")
-    (_a020_os("abab")(p4_va, h4_ob, p1_va, h1_ob)  = -2.0   * _a009_os("bb")(h4_ob, h1_ob, cind) * _a021_os("aa")(p4_va, p1_va, cind),
-    "_a020_os( abab )(p4_va, h4_ob, p1_va, h1_ob)  = -2.0   * _a009_os( bb )(h4_ob, h1_ob, cind) * _a021_os( aa )(p4_va, p1_va, cind)")
-    (_a020_os("baba")(p4_vb, h4_oa, p1_vb, h1_oa)  = -2.0   * _a009_os("aa")(h4_oa, h1_oa, cind) * _a021_os("bb")(p4_vb, p1_vb, cind),
-    "_a020_os( baba )(p4_vb, h4_oa, p1_vb, h1_oa)  = -2.0   * _a009_os( aa )(h4_oa, h1_oa, cind) * _a021_os( bb )(p4_vb, p1_vb, cind)")
-    (_a020_os("bbbb")(p4_vb, h4_ob, p1_vb, h1_ob)  = -2.0   * _a009_os("bb")(h4_ob, h1_ob, cind) * _a021_os("bb")(p4_vb, p1_vb, cind),
-    "_a020_os( bbbb )(p4_vb, h4_ob, p1_vb, h1_ob)  = -2.0   * _a009_os( bb )(h4_ob, h1_ob, cind) * _a021_os( bb )(p4_vb, p1_vb, cind)")
+    (_a020_os("aaaa")(p4_va, h4_oa, p1_va, h1_oa)  = -1.0   * _a009_os("aa")(h4_oa, h1_oa, cind) * _a021_os("aa")(p4_va, p1_va, cind),
+    "_a020_os( aaaa )(p4_va, h4_oa, p1_va, h1_oa)  = -1.0   * _a009_os( aa )(h4_oa, h1_oa, cind) * _a021_os( aa )(p4_va, p1_va, cind)")
+    (_a020_os("abab")(p4_va, h4_ob, p1_va, h1_ob)  = -1.0   * _a009_os("bb")(h4_ob, h1_ob, cind) * _a021_os("aa")(p4_va, p1_va, cind),
+    "_a020_os( abab )(p4_va, h4_ob, p1_va, h1_ob)  = -1.0   * _a009_os( bb )(h4_ob, h1_ob, cind) * _a021_os( aa )(p4_va, p1_va, cind)")
+    (_a020_os("baba")(p4_vb, h4_oa, p1_vb, h1_oa)  = -1.0   * _a009_os("aa")(h4_oa, h1_oa, cind) * _a021_os("bb")(p4_vb, p1_vb, cind),
+    "_a020_os( baba )(p4_vb, h4_oa, p1_vb, h1_oa)  = -1.0   * _a009_os( aa )(h4_oa, h1_oa, cind) * _a021_os( bb )(p4_vb, p1_vb, cind)")
+    (_a020_os("bbbb")(p4_vb, h4_ob, p1_vb, h1_ob)  = -1.0   * _a009_os("bb")(h4_ob, h1_ob, cind) * _a021_os("bb")(p4_vb, p1_vb, cind),
+    "_a020_os( bbbb )(p4_vb, h4_ob, p1_vb, h1_ob)  = -1.0   * _a009_os( bb )(h4_ob, h1_ob, cind) * _a021_os( bb )(p4_vb, p1_vb, cind)")
 
     (_a017_os("aa")(p3_va, h2_oa, cind)        +=  1.0   * t1_aa(p3_va, h3_oa) * chol3d_oo("aa")(h3_oa, h2_oa, cind),
     "_a017_os( aa )(p3_va, h2_oa, cind)        +=  1.0   * t1_aa(p3_va, h3_oa) * chol3d_oo( aa )(h3_oa, h2_oa, cind)")
@@ -686,18 +678,18 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
 
     a22_flag = 1;
 
-    sch(i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  1.0   * a22_aaaa_os(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa),
-       "i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  1.0   * a22_aaaa_os(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa)").execute(hw);
+    sch(i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  0.25  * a22_aaaa_os(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa),
+       "i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  0.25  * a22_aaaa_os(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa)").execute(hw);
 
     a22_flag = 2;
 
-    sch(i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  1.0   * a22_bbbb_os(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob),
-       "i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  1.0   * a22_bbbb_os(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob)").execute(hw);
+    sch(i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  0.25  * a22_bbbb_os(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob),
+       "i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  0.25  * a22_bbbb_os(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob)").execute(hw);
 
     a22_flag = 3;
 
-    sch(i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  4.0   * a22_abab_os(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob),
-       "i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  4.0   * a22_abab_os(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob)").execute(hw);
+    sch(i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  1.0   * a22_abab_os(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob),
+       "i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  1.0   * a22_abab_os(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob)").execute(hw);
 
     sch(_a019_os("aaaa")(h4_oa, h3_oa, h1_oa, h2_oa) += -0.125 * _a004_os("aaaa")(p1_va, p2_va, h3_oa, h4_oa) * t2_aaaa(p1_va,p2_va,h1_oa,h2_oa),
     "_a019_os( aaaa )(h4_oa, h3_oa, h1_oa, h2_oa)    += -0.125 * _a004_os( aaaa )(p1_va, p2_va, h3_oa, h4_oa) * t2_aaaa(p1_va,p2_va,h1_oa,h2_oa)")
@@ -903,15 +895,22 @@ cd_ccsd_os_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIndexSpace
 
   CCSE_Tensors<CCEType> i0_t2_tmp{MO, {V, V, O, O}, "i0_t2_tmp", {"aaaa", "bbbb"}};
 
-  double total_ccsd_mem = sum_tensor_sizes(d_t1, d_t2, d_f1, d_r1, d_r2, cv3d, d_e, _a01V_os) +
-                          CCSE_Tensors<T>::sum_tensor_sizes_list(r1_vo, r2_vvoo, t1_vo, t2_vvoo) +
-                          CCSE_Tensors<T>::sum_tensor_sizes_list(f1_oo, f1_ov, f1_vo, f1_vv,
-                                                                 chol3d_oo, chol3d_ov, chol3d_vo,
-                                                                 chol3d_vv) +
-                          CCSE_Tensors<T>::sum_tensor_sizes_list(_a02_os, _a03_os);
-
+  MemoryPlan ccsd_plan{ec, "CCSD", chem_env.ioptions.common_options.memory_overhead};
+  ccsd_plan.allocate("amplitudes and residuals", d_t1, d_t2, d_r1, d_r2);
+  ccsd_plan.allocate_gib("amplitude and residual blocks",
+                         CCSE_Tensors<T>::sum_tensor_sizes_list(r1_vo, r2_vvoo, t1_vo, t2_vvoo));
+  ccsd_plan.allocate("fock and cholesky vectors", d_f1, cv3d, d_e, _a01V_os);
+  ccsd_plan.allocate_gib("fock and cholesky blocks",
+                         CCSE_Tensors<T>::sum_tensor_sizes_list(f1_oo, f1_ov, f1_vo, f1_vv,
+                                                                chol3d_oo, chol3d_ov, chol3d_vo,
+                                                                chol3d_vv));
+  ccsd_plan.allocate_gib("intermediates (_a02,_a03)",
+                         CCSE_Tensors<T>::sum_tensor_sizes_list(_a02_os, _a03_os));
+
+  double diis_mem = 0;
   for(size_t ri = 0; ri < d_r1s.size(); ri++)
-    total_ccsd_mem += sum_tensor_sizes(d_r1s[ri], d_r2s[ri], d_t1s[ri], d_t2s[ri]);
+    diis_mem += sum_tensor_sizes(d_r1s[ri], d_r2s[ri], d_t1s[ri], d_t2s[ri]);
+  ccsd_plan.allocate_gib("diis history", diis_mem);
 
   // Intermediates
   // const double v4int_size = CCSE_Tensors<T>::sum_tensor_sizes_list(_a022);
@@ -921,16 +920,16 @@ cd_ccsd_os_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIndexSpace
                                            _a004_os, _a006_os, _a008_os, _a009_os, _a017_os,
                                            _a019_os, _a020_os, _a021_os);
 
-  if(!ccsd_restart) total_ccsd_mem += total_ccsd_mem_tmp;
+  if(!ccsd_restart) ccsd_plan.allocate_gib("iteration intermediates", total_ccsd_mem_tmp);
 
   if(ec.print()) {
     std::cout << std::endl
               << "Total CPU memory required for Open Shell Cholesky CCSD calculation: "
-              << std::fixed << std::setprecision(2) << total_ccsd_mem << " GiB" << std::endl;
+              << std::fixed << std::setprecision(2) << ccsd_plan.peak() << " GiB" << std::endl;
     // std::cout << " (V^4 intermediate size: " << std::fixed << std::setprecision(2) << v4int_size
     //           << " GiB)" << std::endl;
   }
-  check_memory_requirements(ec, total_ccsd_mem);
+  ccsd_plan.check(ec, "the CCSD iterations", false);
 
   Scheduler   sch{ec};
   ExecutionHW exhw = ec.exhw();
@@ -1170,6 +1169,7 @@ cd_ccsd_os_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIndexSpace
     sys_data.results["output"]["CCSD"]["final_energy"]["correlation"] = energy;
     sys_data.results["output"]["CCSD"]["final_energy"]["total"]     = sys_data.scf_energy + energy;
     sys_data.results["output"]["CCSD"]["performance"]["total_time"] = ccsd_time;
+    chem_env.telemetry.record("CCSD", "total", {{"wall_time", ccsd_time}, {"correlation", energy}});
 
     chem_env.write_json_data("CCSD");
   }
@@ -1180,6 +1180,8 @@ cd_ccsd_os_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIndexSpace
                                    chol3d_vv);
   sch.deallocate(d_e, _a01V_os).execute();
 
+  ccsd_plan.validate(ec, chem_env.telemetry);
+
   return std::make_tuple(residual, energy);
 }
 
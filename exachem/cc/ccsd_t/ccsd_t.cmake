@@ -7,6 +7,7 @@ set(CCSD_T_COMMON_SRCS
     ${CCSD_T_SRCDIR}/ccsd_t_common.hpp
     ${CCSD_T_SRCDIR}/hybrid.cpp
     ${CCSD_T_SRCDIR}/ccsd_t_fused_driver.hpp
+    ${CCSD_T_SRCDIR}/ccsd_t_screening.hpp
     ${CCSD_T_SRCDIR}/fused_common.hpp
     )
 
@@ -11,6 +11,7 @@
 #include "cc/ccsd/cd_ccsd_os_ann.hpp"
 #include "cc/ccsd_t/ccsd_t_fused_driver.hpp"
 #include "cholesky/cholesky_2e_driver.hpp"
+#include "common/memory_plan.hpp"
 // clang-format on
 
 double ccsdt_s1_t1_GetTime  = 0;
@@ -45,6 +46,9 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
   CCSDOptions& ccsd_options   = chem_env.ioptions.ccsd_options;
   const int    ccsdt_tilesize = ccsd_options.ccsdt_tilesize;
 
+  if(ccsd_options.localize)
+    tamm_terminate("INPUT FILE ERROR: (T) requires canonical orbitals, disable DLPNO localize");
+
   sys_data.freeze_atomic    = chem_env.ioptions.ccsd_options.freeze_atomic;
   sys_data.n_frozen_core    = chem_env.get_nfcore();
   sys_data.n_frozen_virtual = chem_env.ioptions.ccsd_options.freeze_virtual;
@@ -58,7 +62,8 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
   if(nsranks < 1) nsranks = 1;
   int ga_cnn = ec.nnodes();
   if(nsranks > ga_cnn) nsranks = ga_cnn;
-  nsranks = nsranks * GA_Cluster_nprocs(0);
+  // a task-farm group can hold fewer ranks than a node
+  nsranks = std::min<int>(nsranks * GA_Cluster_nprocs(0), ec.pg().size().value());
   int subranks[nsranks];
   for(int i = 0; i < nsranks; i++) subranks[i] = i;
 
@@ -93,7 +98,7 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -150,7 +155,7 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
         read_from_disk(d_t1, t1file);
         read_from_disk(d_t2, t2file);
       }
-      read_from_disk(cholVpr, v2file);
+      exachem::cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
       ec.pg().barrier();
       p_evl_sorted = tamm::diagonal(d_f1);
     }
@@ -160,7 +165,7 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
       if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
       write_to_disk(d_f1, f1file);
-      write_to_disk(cholVpr, v2file);
+      exachem::cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
       if(rank == 0) {
         std::ofstream out(cholfile, std::ios::out);
@@ -284,14 +289,14 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
     ec.flush_and_sync();
   }
   else { // skip ccsd
-    cholesky_2e::update_sysdata(chem_env, MO);
+    cholesky_2e::update_sysdata(ec, chem_env, MO);
     N    = MO("all");
     d_f1 = {{N, N}, {1, 1}};
     Tensor<T>::allocate(&ec, d_f1);
     if(rank == 0) sys_data.print();
   }
 
-  auto [MO1, total_orbitals1] = cholesky_2e::setupMOIS(chem_env, true);
+  auto [MO1, total_orbitals1] = cholesky_2e::setupMOIS(ec, chem_env, true);
   TiledIndexSpace N1          = MO1("all");
   TiledIndexSpace O1          = MO1("occ");
   TiledIndexSpace V1          = MO1("virt");
@@ -330,6 +335,9 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
   Index nvab       = MO1("virt").num_tiles();
   Index cache_size = ccsd_options.cache_size;
 
+  MemoryPlan ccsd_t_plan{ec, "CCSD(T)", chem_env.ioptions.common_options.memory_overhead};
+  ccsd_t_plan.allocate_gib("input tensors", ccsd_t_mem);
+
   {
     Index noa    = MO1("occ_alpha").num_tiles();
     Index nva    = MO1("virt_alpha").num_tiles();
@@ -366,7 +374,9 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
     cache_mem_per_rank     = cache_mem_per_rank / gib;
     double total_cache_mem = cache_mem_per_rank * nranks; // GiB
 
-    double total_ccsd_t_mem = ccsd_t_mem + total_extra_buf_mem + total_cache_mem;
+    ccsd_t_plan.allocate_per_rank("intermediate buffers", extra_buf_mem_per_rank);
+    ccsd_t_plan.allocate_per_rank("t1,t2,v2 block cache", cache_mem_per_rank);
+    const double total_ccsd_t_mem = ccsd_t_plan.peak();
     if(rank == 0) {
       std::cout << std::string(70, '-') << std::fixed << std::setprecision(2) << std::endl;
       std::cout << "Total CPU memory required for (T) calculation = " << total_ccsd_t_mem << " GiB"
@@ -386,13 +396,13 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
       //           << " GiB, new v2 = " << v2tensors.tensor_sizes(MO1) << " GiB)" << std::endl;
       std::cout << std::string(70, '-') << std::endl;
     }
-    check_memory_requirements(ec, total_ccsd_t_mem);
+    ccsd_t_plan.check(ec, "the (T) calculation", false);
   }
 
   if(computeTData && !skip_ccsd) {
     Tensor<T>::allocate(&ec, t_d_cv2);
-    retile_tamm_tensor(cholVpr, t_d_cv2, "CholV2");
-    free_tensors(cholVpr);
+    exachem::cholesky_2e::retile_chol_vectors(ec, chem_env, cholVpr, MO1, t_d_cv2);
+    exachem::cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
     v2tensors = cholesky_2e::setupV2Tensors<T>(ec, t_d_cv2, ex_hw, v2tensors.get_blocks());
     if(ccsd_options.writev) {
@@ -579,6 +589,11 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
     sys_data.results["output"]["CCSD(T)"]["performance"]["gflops"]         = n_gflops;
     sys_data.results["output"]["CCSD(T)"]["performance"]["total_num_ops"]  = total_num_ops;
     sys_data.results["output"]["CCSD(T)"]["performance"]["load_imbalance"] = load_imb;
+    chem_env.telemetry.record("CCSD(T)", "total",
+                              {{"wall_time", total_t_time},
+                               {"flops", total_num_ops},
+                               {"gflops", n_gflops},
+                               {"load_imbalance", load_imb}});
     chem_env.write_json_data("CCSD_T");
   }
 
@@ -599,6 +614,8 @@ void exachem::cc::ccsd_t::ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env)
   free_tensors(t_d_t1, t_d_t2, d_f1);
   v2tensors.deallocate();
 
+  ccsd_t_plan.validate(ec, chem_env.telemetry);
+
   ec.flush_and_sync();
   // delete ec;
 }
@@ -15,6 +15,7 @@
 #include "ccsd_t_all_fused_cpu.hpp"
 #endif
 #include "ccsd_t_common.hpp"
+#include "ccsd_t_screening.hpp"
 
 namespace exachem::cc::ccsd_t {
 void ccsd_t_driver(ExecutionContext& ec, ChemEnv& chem_env);
@@ -139,6 +140,11 @@ std::tuple<T, T, double, double> ccsd_t_fused_driver_new(
   std::shared_ptr<hostEnergyReduceData_t> reduceData = std::make_shared<hostEnergyReduceData_t>();
 #endif
 
+  // tile tuples whose estimated (T) energy is below the threshold are skipped
+  const T           screen_thresh = chem_env.ioptions.ccsd_options.ccsdt_screen_thresh;
+  CCSDTScreening<T> screening(ec, screen_thresh, noab, nvab, k_range, k_offset, k_evl_sorted,
+                              d_t1, d_t2, d_v2);
+
   AtomicCounter* ac = new AtomicCounterGA(ec.pg(), 1);
   ac->allocate(0);
   int64_t taskcount = 0;
@@ -261,65 +267,68 @@ std::tuple<T, T, double, double> ccsd_t_fused_driver_new(
                       if((t_h1b == t_h2b) && (t_h2b == t_h3b)) { factor /= 6.0; }
                       else if((t_h1b == t_h2b) || (t_h2b == t_h3b)) { factor /= 2.0; }
 
-                      num_task++;
+                      if(!screening.skip(t_h1b, t_h2b, t_h3b, t_p4b, t_p5b, t_p6b, factor)) {
+                        num_task++;
 
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
-                      ccsd_t_fully_fused_none_df_none_task<T>(
-                        is_restricted, noab, nvab, rank, k_spin, k_range, k_offset, d_t1, d_t2,
-                        d_v2, k_evl_sorted,
-                        //
-                        df_host_pinned_s1_t1, df_host_pinned_s1_v2, df_host_pinned_d1_t2,
-                        df_host_pinned_d1_v2, df_host_pinned_d2_t2, df_host_pinned_d2_v2,
-                        df_host_energies,
-                        //
-                        //
-                        //
-                        host_d1_size, host_d2_size,
-                        //
-                        df_simple_s1_size, df_simple_d1_size, df_simple_d2_size, df_simple_s1_exec,
-                        df_simple_d1_exec, df_simple_d2_exec,
+                        ccsd_t_fully_fused_none_df_none_task<T>(
+                          is_restricted, noab, nvab, rank, k_spin, k_range, k_offset, d_t1, d_t2,
+                          d_v2, k_evl_sorted,
+                          //
+                          df_host_pinned_s1_t1, df_host_pinned_s1_v2, df_host_pinned_d1_t2,
+                          df_host_pinned_d1_v2, df_host_pinned_d2_t2, df_host_pinned_d2_v2,
+                          df_host_energies,
+                          //
+                          //
+                          //
+                          host_d1_size, host_d2_size,
+                          //
+                          df_simple_s1_size, df_simple_d1_size, df_simple_d2_size,
+                          df_simple_s1_exec, df_simple_d1_exec, df_simple_d2_exec,
 //
 #ifdef USE_DPCPP
-                        const_df_s1_size, const_df_s1_exec, const_df_d1_size, const_df_d1_exec,
-                        const_df_d2_size, const_df_d2_exec,
+                          const_df_s1_size, const_df_s1_exec, const_df_d1_size, const_df_d1_exec,
+                          const_df_d2_size, const_df_d2_exec,
 #endif
-                        //
-                        df_dev_s1_t1_all, df_dev_s1_v2_all, df_dev_d1_t2_all, df_dev_d1_v2_all,
-                        df_dev_d2_t2_all, df_dev_d2_v2_all, df_dev_energies,
-                        //
-                        t_h1b, t_h2b, t_h3b, t_p4b, t_p5b, t_p6b, factor, taskcount,
-                        max_d1_kernels_pertask, max_d2_kernels_pertask,
-                        //
-                        size_T_s1_t1, size_T_s1_v2, size_T_d1_t2, size_T_d1_v2, size_T_d2_t2,
-                        size_T_d2_v2,
-                        //
-                        energy_l,
+                          //
+                          df_dev_s1_t1_all, df_dev_s1_v2_all, df_dev_d1_t2_all, df_dev_d1_v2_all,
+                          df_dev_d2_t2_all, df_dev_d2_v2_all, df_dev_energies,
+                          //
+                          t_h1b, t_h2b, t_h3b, t_p4b, t_p5b, t_p6b, factor, taskcount,
+                          max_d1_kernels_pertask, max_d2_kernels_pertask,
+                          //
+                          size_T_s1_t1, size_T_s1_v2, size_T_d1_t2, size_T_d1_v2, size_T_d2_t2,
+                          size_T_d2_v2,
+                          //
+                          energy_l,
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
-                        reduceData.get(),
+                          reduceData.get(),
 #endif
-                        cache_s1t, cache_s1v, cache_d1t, cache_d1v, cache_d2t, cache_d2v,
-                        //
-                        done_compute, done_copy);
+                          cache_s1t, cache_s1v, cache_d1t, cache_d1v, cache_d2t, cache_d2v,
+                          //
+                          done_compute, done_copy);
 #else
-                      total_fused_ccsd_t_cpu<T>(
-                        is_restricted, noab, nvab, rank, k_spin, k_range, k_offset, d_t1, d_t2,
-                        d_v2, k_evl_sorted,
-                        //
-                        df_host_pinned_s1_t1, df_host_pinned_s1_v2, df_host_pinned_d1_t2,
-                        df_host_pinned_d1_v2, df_host_pinned_d2_t2, df_host_pinned_d2_v2,
-                        df_host_energies, host_d1_size, host_d2_size,
-                        //
-                        df_simple_s1_size, df_simple_d1_size, df_simple_d2_size, df_simple_s1_exec,
-                        df_simple_d1_exec, df_simple_d2_exec,
-                        //
-                        t_h1b, t_h2b, t_h3b, t_p4b, t_p5b, t_p6b, factor, taskcount,
-                        max_d1_kernels_pertask, max_d2_kernels_pertask,
-                        //
-                        size_T_s1_t1, size_T_s1_v2, size_T_d1_t2, size_T_d1_v2, size_T_d2_t2,
-                        size_T_d2_v2,
-                        //
-                        energy_l, cache_s1t, cache_s1v, cache_d1t, cache_d1v, cache_d2t, cache_d2v);
+                        total_fused_ccsd_t_cpu<T>(
+                          is_restricted, noab, nvab, rank, k_spin, k_range, k_offset, d_t1, d_t2,
+                          d_v2, k_evl_sorted,
+                          //
+                          df_host_pinned_s1_t1, df_host_pinned_s1_v2, df_host_pinned_d1_t2,
+                          df_host_pinned_d1_v2, df_host_pinned_d2_t2, df_host_pinned_d2_v2,
+                          df_host_energies, host_d1_size, host_d2_size,
+                          //
+                          df_simple_s1_size, df_simple_d1_size, df_simple_d2_size,
+                          df_simple_s1_exec, df_simple_d1_exec, df_simple_d2_exec,
+                          //
+                          t_h1b, t_h2b, t_h3b, t_p4b, t_p5b, t_p6b, factor, taskcount,
+                          max_d1_kernels_pertask, max_d2_kernels_pertask,
+                          //
+                          size_T_s1_t1, size_T_s1_v2, size_T_d1_t2, size_T_d1_v2, size_T_d2_t2,
+                          size_T_d2_v2,
+                          //
+                          energy_l, cache_s1t, cache_s1v, cache_d1t, cache_d1v, cache_d2t,
+                          cache_d2v);
 #endif
+                      }
 
                       next = ac->fetch_add(0, 1);
                     }
@@ -369,6 +378,9 @@ std::tuple<T, T, double, double> ccsd_t_fused_driver_new(
                       if((t_h1b == t_h2b) && (t_h2b == t_h3b)) { factor /= 6.0; }
                       else if((t_h1b == t_h2b) || (t_h2b == t_h3b)) { factor /= 2.0; }
 
+                      if(screening.skip(t_h1b, t_h2b, t_h3b, t_p4b, t_p5b, t_p6b, factor))
+                        continue;
+
                       //
                       num_task++;
 
@@ -509,6 +521,24 @@ operator delete[](df_host_pinned_d2_v2);
   ac->deallocate();
   delete ac;
 
+  if(screening.enabled()) {
+    T       discarded   = screening.discarded_energy();
+    int64_t num_skipped = screening.num_skipped();
+    discarded           = ec.pg().reduce(&discarded, ReduceOp::sum, 0);
+    num_skipped         = ec.pg().reduce(&num_skipped, ReduceOp::sum, 0);
+    if(nodezero) {
+      std::cout << std::endl
+                << "(T) tile tuples screened out (threshold = " << std::scientific
+                << screen_thresh << "): " << num_skipped << std::endl;
+      std::cout << "Estimated discarded (T) energy (upper bound) = " << discarded << std::endl
+                << std::defaultfloat;
+      auto& screen_json = chem_env.sys_data.results["output"]["CCSD(T)"]["screening"];
+      screen_json["threshold"]        = screen_thresh;
+      screen_json["tuples_skipped"]   = num_skipped;
+      screen_json["discarded_energy"] = discarded;
+    }
+  }
+
   return std::make_tuple(energy1, energy2, ccsd_t_time, total_t_time);
 }
 
@@ -0,0 +1,138 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "cholesky/v2tensors.hpp"
+
+/**
+ *  A-priori screening of the (t_h1b,t_h2b,t_h3b,t_p4b,t_p5b,t_p6b) tile tuples of the (T)
+ *  correction. The triples block of a tuple is bounded by the Frobenius norms of the tiles that
+ *  enter it (Cauchy-Schwarz over the contracted h7/p7 tiles):
+ *    ||t3|| <= sum_perm ||t2(p,p,h,:)|| ||v2(h,h,:,p)|| + ||t2(:,p,h,h)|| ||v2(h,:,p,p)||
+ *    ||s3|| <= sum_perm ||t1(p,h)|| ||v2(h,h,p,p)||
+ *  and |E_tuple| <= factor * ||t3|| (||t3|| + ||s3||) / min|D|, with D the orbital-energy
+ *  denominator over the tiles. Tuples whose bound is below the threshold are skipped and their
+ *  bounds are summed up as an estimate of the discarded energy.
+ **/
+template<typename T>
+class CCSDTScreening {
+public:
+  CCSDTScreening(ExecutionContext& ec, T threshold, Index noab, Index nvab,
+                 const std::vector<size_t>& k_range, const std::vector<size_t>& k_offset,
+                 const std::vector<T>& k_evl_sorted, Tensor<T>& d_t1, Tensor<T>& d_t2,
+                 exachem::cholesky_2e::V2Tensors<T>& d_v2):
+    thresh_(threshold), noab_(noab), nvab_(nvab) {
+    if(!enabled()) return;
+
+    // orbital-energy range of every tile
+    emin_.resize(noab + nvab);
+    emax_.resize(noab + nvab);
+    for(Index t = 0; t < noab + nvab; t++) {
+      const auto first = k_evl_sorted.begin() + k_offset[t];
+      emin_[t]         = *std::min_element(first, first + k_range[t]);
+      emax_[t]         = *std::max_element(first, first + k_range[t]);
+    }
+
+    const size_t o = noab, v = nvab;
+    // clang-format off
+    t1_ = binned_norms(ec, d_t1, v * o,
+            [&](const IndexVector& b) { return b[0] * o + b[1]; });
+    t2_h_ = binned_norms(ec, d_t2, v * v * o,
+            [&](const IndexVector& b) { return (b[0] * v + b[1]) * o + b[2]; });
+    t2_p_ = binned_norms(ec, d_t2, v * o * o,
+            [&](const IndexVector& b) { return (b[1] * o + b[2]) * o + b[3]; });
+    v_ijab_ = binned_norms(ec, d_v2.v2ijab, o * o * v * v,
+            [&](const IndexVector& b) { return ((b[0] * o + b[1]) * v + b[2]) * v + b[3]; });
+    v_ijka_ = binned_norms(ec, d_v2.v2ijka, o * o * v,
+            [&](const IndexVector& b) { return (b[0] * o + b[1]) * v + b[3]; });
+    v_iabc_ = binned_norms(ec, d_v2.v2iabc, o * v * v,
+            [&](const IndexVector& b) { return (b[0] * v + b[2]) * v + b[3]; });
+    // clang-format on
+  }
+
+  bool enabled() const { return thresh_ > 0; }
+
+  // Returns true if the tuple can be skipped and accounts for its bound.
+  bool skip(size_t t_h1b, size_t t_h2b, size_t t_h3b, size_t t_p4b, size_t t_p5b, size_t t_p6b,
+            T factor) {
+    if(!enabled()) return false;
+
+    const T denom = emin_[t_p4b] + emin_[t_p5b] + emin_[t_p6b] - emax_[t_h1b] - emax_[t_h2b] -
+                    emax_[t_h3b];
+    if(denom <= 0) return false;
+
+    const size_t o = noab_, v = nvab_;
+    const size_t h[3] = {t_h1b, t_h2b, t_h3b};
+    const size_t p[3] = {t_p4b - noab_, t_p5b - noab_, t_p6b - noab_};
+    // the two remaining indices of a triple, in order
+    const int rest[3][2] = {{1, 2}, {0, 2}, {0, 1}};
+
+    T nrm_t3 = 0;
+    T nrm_s3 = 0;
+    for(int ip = 0; ip < 3; ip++) {
+      const size_t pa = p[ip], pb = p[rest[ip][0]], pc = p[rest[ip][1]];
+      for(int ih = 0; ih < 3; ih++) {
+        const size_t hi = h[ih], hj = h[rest[ih][0]], hk = h[rest[ih][1]];
+        // doubles1: t2(pb,pc,hi,h7) * v2(hj,hk,h7,pa)
+        nrm_t3 += t2_h_[(pb * v + pc) * o + hi] * v_ijka_[(hj * o + hk) * v + pa];
+        // doubles2: t2(p7,pa,hj,hk) * v2(hi,p7,pb,pc)
+        nrm_t3 += t2_p_[(pa * o + hj) * o + hk] * v_iabc_[(hi * v + pb) * v + pc];
+        // singles: t1(pa,hi) * v2(hj,hk,pb,pc)
+        nrm_s3 += t1_[pa * o + hi] * v_ijab_[((hj * o + hk) * v + pb) * v + pc];
+      }
+    }
+
+    const T bound = std::abs(factor) * nrm_t3 * (nrm_t3 + nrm_s3) / denom;
+    if(bound >= thresh_) return false;
+
+    discarded_energy_ += bound;
+    num_skipped_++;
+    return true;
+  }
+
+  T      discarded_energy() const { return discarded_energy_; }
+  size_t num_skipped() const { return num_skipped_; }
+
+private:
+  // Frobenius norms of the tensor blocks, accumulated (as sums of squares) into the bins given
+  // by binid(blockid) and replicated on every rank.
+  template<typename Func>
+  static std::vector<T> binned_norms(ExecutionContext& ec, Tensor<T>& tensor, size_t nbins,
+                                     Func&& binid) {
+    std::vector<T> sq(nbins, 0);
+    auto           block_norms_lambda = [&](const IndexVector& blockid) {
+      if(!tensor.is_non_zero(blockid)) return;
+      std::vector<T> buf(tensor.block_size(blockid));
+      tensor.get(blockid, buf);
+      T nrm2 = 0;
+      for(auto x: buf) nrm2 += x * x;
+      sq[binid(blockid)] += nrm2;
+    };
+    block_for(ec, tensor(), block_norms_lambda);
+
+    std::vector<T> norms(nbins, 0);
+    ec.pg().allreduce(sq.data(), norms.data(), nbins, ReduceOp::sum);
+    for(auto& x: norms) x = std::sqrt(x);
+    return norms;
+  }
+
+  T      thresh_;
+  size_t noab_;
+  size_t nvab_;
+  T      discarded_energy_{0};
+  size_t num_skipped_{0};
+
+  std::vector<T> emin_, emax_;
+  std::vector<T> t1_;     // (p,h)     ||t1(p,h)||
+  std::vector<T> t2_h_;   // (p,p,h)   ||t2(p,p,h,:)||
+  std::vector<T> t2_p_;   // (p,h,h)   ||t2(:,p,h,h)||
+  std::vector<T> v_ijab_; // (h,h,p,p) ||v2(h,h,p,p)||
+  std::vector<T> v_ijka_; // (h,h,p)   ||v2(h,h,:,p)||
+  std::vector<T> v_iabc_; // (h,p,p)   ||v2(h,:,p,p)||
+};
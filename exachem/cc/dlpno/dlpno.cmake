@@ -0,0 +1,10 @@
+
+include(TargetMacros)
+
+set(DLPNO_SRCDIR ${CMAKE_CURRENT_SOURCE_DIR}/../exachem/cc/dlpno)
+set(DLPNO_SRCS
+    ${DLPNO_SRCDIR}/dlpno_ccsd.cpp
+    ${DLPNO_SRCDIR}/dlpno_t.cpp
+    ${DLPNO_SRCDIR}/pno_ccsd.cpp
+    ${DLPNO_SRCDIR}/pno_spaces.cpp
+    )
@@ -0,0 +1,170 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "cc/dlpno/dlpno_ccsd.hpp"
+#include "cholesky/cholesky_2e_driver.hpp"
+
+void exachem::cc::dlpno::dlpno_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
+  using T = double;
+  using namespace exachem::cc::ccsd;
+
+  auto rank = ec.pg().rank();
+
+  scf::scf_driver(ec, chem_env);
+
+  double              hf_energy      = chem_env.hf_energy;
+  libint2::BasisSet   shells         = chem_env.shells;
+  Tensor<T>           C_AO           = chem_env.C_AO;
+  Tensor<T>           C_beta_AO      = chem_env.C_beta_AO;
+  Tensor<T>           F_AO           = chem_env.F_AO;
+  Tensor<T>           F_beta_AO      = chem_env.F_beta_AO;
+  TiledIndexSpace     AO_opt         = chem_env.AO_opt;
+  std::vector<size_t> shell_tile_map = chem_env.shell_tile_map;
+
+  SystemData&  sys_data     = chem_env.sys_data;
+  CCSDOptions& ccsd_options = chem_env.ioptions.ccsd_options;
+  const bool   compute_t    = chem_env.ioptions.task_options.dlpno_ccsd_t.first;
+  if(rank == 0) ccsd_options.print();
+
+  if(!sys_data.is_restricted)
+    tamm_terminate("INPUT FILE ERROR: DLPNO-CCSD is only implemented for closed-shell references");
+  if(ccsd_options.localize_virtuals)
+    tamm_terminate("INPUT FILE ERROR: DLPNO-CCSD requires canonical virtuals, disable "
+                   "localize_virtuals");
+  if(rank == 0 && !ccsd_options.localize)
+    std::cout << std::endl
+              << "Note: DLPNO localize is disabled, the pairs are built from canonical orbitals"
+              << std::endl;
+
+  if(rank == 0)
+    cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
+
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
+
+  std::string files_dir    = chem_env.workspace_dir + chem_env.ioptions.scf_options.scf_type;
+  std::string files_prefix = files_dir + "/" + sys_data.output_file_prefix;
+  std::string cholfile     = files_prefix + ".cholcount";
+
+  // deallocates F_AO, C_AO
+  auto [cholVpr, d_f1, lcao, chol_count, max_cvecs, CI] =
+    cholesky_2e::cholesky_2e_driver<T>(chem_env, ec, MO, AO_opt, C_AO, F_AO, C_beta_AO, F_beta_AO,
+                                       shells, shell_tile_map, false, cholfile);
+
+  auto cc_t1 = std::chrono::high_resolution_clock::now();
+
+  const int nocc = sys_data.n_occ_alpha;
+  const int nvir = sys_data.n_vir_alpha;
+
+  // active alpha occupied and virtual orbitals, the MO space is {occ_alpha, occ_beta, virt_alpha,
+  // virt_beta}
+  std::vector<int> alpha(nocc + nvir);
+  std::iota(alpha.begin(), alpha.begin() + nocc, 0);
+  std::iota(alpha.begin() + nocc, alpha.end(), 2 * nocc);
+  const Matrix C_act = select_cols(tamm_to_eigen_matrix(lcao), alpha);
+  const Matrix F_act = select_rows(select_cols(tamm_to_eigen_matrix(d_f1), alpha), alpha);
+  free_tensors(lcao, d_f1);
+
+  if(rank == 0 && (!ccsd_options.dlpno_dfbasis.empty() || !ccsd_options.doubles_opt_eqns.empty()))
+    std::cout << std::endl
+              << "Note: DLPNO-CCSD uses the Cholesky vectors, df_basisset and doubles_opt_eqns "
+                 "are ignored"
+              << std::endl;
+
+  // every rank keeps the Cholesky vectors of its cholesky indices in the PAO basis
+  PNOSpaces pnos(ec, chem_env, F_act, C_act);
+  pnos.load_cholesky(ec, MO, CI, cholVpr);
+  cholesky_2e::free_chol_vectors(chem_env, cholVpr);
+  pnos.build(ec);
+  pnos.print_summary(ec, chem_env);
+
+  auto   cc_t2 = std::chrono::high_resolution_clock::now();
+  double pno_time =
+    std::chrono::duration_cast<std::chrono::duration<double>>((cc_t2 - cc_t1)).count();
+  if(rank == 0) {
+    std::cout << std::endl
+              << "Time taken for pair prescreening and PNO construction: " << std::fixed
+              << std::setprecision(2) << pno_time << " secs" << std::endl;
+    chem_env.telemetry.record("DLPNO-CCSD", "pno", {{"wall_time", pno_time}});
+  }
+
+  const double e_weak  = pnos.weak_pair_energy();
+  const double e_trunc = pnos.truncation_correction();
+  auto&        jout    = sys_data.results["output"]["DLPNO-CCSD"];
+
+  if(ccsd_options.skip_dlpno) {
+    if(rank == 0) {
+      jout["final_energy"]["scmp2"] = pnos.scmp2_energy();
+      jout["final_energy"]["total"] = hf_energy + pnos.scmp2_energy();
+      chem_env.write_json_data("DLPNO-CCSD");
+    }
+    ec.flush_and_sync();
+    return;
+  }
+
+  PNOAmplitudes amps;
+  auto [residual, corr_energy] = dlpno_ccsd_iterations(ec, chem_env, pnos, amps);
+
+  ccsd_stats(ec, hf_energy, residual, corr_energy, ccsd_options.threshold);
+
+  const double e_dlpno_ccsd = corr_energy + e_weak + e_trunc;
+
+  auto   cc_t3 = std::chrono::high_resolution_clock::now();
+  double ccsd_time =
+    std::chrono::duration_cast<std::chrono::duration<double>>((cc_t3 - cc_t2)).count();
+  if(rank == 0) {
+    std::cout << std::endl << std::fixed << std::setprecision(10);
+    std::cout << "DLPNO-CCSD strong pair energy        = " << corr_energy << std::endl;
+    std::cout << "Weak pair MP2 energy                 = " << e_weak << std::endl;
+    std::cout << "PNO truncation correction            = " << e_trunc << std::endl;
+    std::cout << "DLPNO-CCSD correlation energy        = " << e_dlpno_ccsd << std::endl;
+    std::cout << "DLPNO-CCSD total energy              = " << hf_energy + e_dlpno_ccsd
+              << std::endl;
+    std::cout << std::endl
+              << "Time taken for DLPNO-CCSD: " << std::setprecision(2) << ccsd_time << " secs"
+              << std::endl;
+    chem_env.telemetry.record("DLPNO-CCSD", "ccsd",
+                              {{"wall_time", ccsd_time}, {"correlation", e_dlpno_ccsd}});
+  }
+
+  double e_t = 0.0;
+  if(compute_t) {
+    auto cc_t4 = std::chrono::high_resolution_clock::now();
+    e_t        = dlpno_triples(ec, chem_env, pnos, amps);
+
+    auto   cc_t5 = std::chrono::high_resolution_clock::now();
+    double t_time =
+      std::chrono::duration_cast<std::chrono::duration<double>>((cc_t5 - cc_t4)).count();
+    if(rank == 0) {
+      std::cout << std::endl << std::fixed << std::setprecision(10);
+      std::cout << "DLPNO-(T0) correction                = " << e_t << std::endl;
+      std::cout << "DLPNO-CCSD(T0) correlation energy    = " << e_dlpno_ccsd + e_t << std::endl;
+      std::cout << "DLPNO-CCSD(T0) total energy          = " << hf_energy + e_dlpno_ccsd + e_t
+                << std::endl;
+      std::cout << std::endl
+                << "Time taken for DLPNO-(T0): " << std::setprecision(2) << t_time << " secs"
+                << std::endl;
+      jout["performance"]["triples_time"] = t_time;
+      chem_env.telemetry.record("DLPNO-CCSD", "triples", {{"wall_time", t_time}, {"energy", e_t}});
+    }
+  }
+
+  if(rank == 0) {
+    jout["final_energy"]["strong_pairs"] = corr_energy;
+    jout["final_energy"]["correlation"]  = e_dlpno_ccsd;
+    jout["final_energy"]["total"]        = hf_energy + e_dlpno_ccsd;
+    if(compute_t) {
+      jout["final_energy"]["triples"]            = e_t;
+      jout["final_energy"]["total_with_triples"] = hf_energy + e_dlpno_ccsd + e_t;
+    }
+    jout["performance"]["pno_time"]  = pno_time;
+    jout["performance"]["ccsd_time"] = ccsd_time;
+    chem_env.write_json_data("DLPNO-CCSD");
+  }
+
+  ec.flush_and_sync();
+}
@@ -0,0 +1,159 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "cc/ccsd/cd_ccsd_cs_ann.hpp"
+
+namespace exachem::cc::dlpno {
+
+// DLPNO-CCSD (task dlpno_ccsd) and DLPNO-CCSD(T0) (task dlpno_ccsd_t) for closed-shell references
+void dlpno_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env);
+
+// orthonormal virtual orbitals of a domain, expanded in its projected atomic orbitals (PAOs)
+struct LocalSpace {
+  std::vector<int>    pao; // AO indices of the PAOs of the domain, sorted
+  Matrix              C;   // npao x n
+  std::vector<double> eps; // semicanonical orbital energies
+
+  int size() const { return C.cols(); }
+};
+
+/**
+ * Local virtual spaces of the active occupied orbitals of a closed-shell reference, usually
+ * localized (CC DLPNO option localize).
+ *
+ * The virtual space is spanned by the PAOs, the AOs projected onto the active virtuals. The
+ * domain of an occupied orbital at a threshold are the PAOs of the atoms that carry at least that
+ * Mulliken population of the orbital, the domain of a pair is the union of the domains of its
+ * orbitals.
+ *
+ * Pairs are prescreened with semicanonical MP2 in the TCutDOPre domains, pairs below TCutPre keep
+ * this estimate. The others are recomputed in the TCutDOij domains, and those below TCutPairs are
+ * weak: they contribute their MP2 pair energy and carry no amplitudes. Diagonal pairs are always
+ * strong. Every strong pair gets the natural orbitals of its MP2 pair density with occupation
+ * above TCutPNO as PNOs, extended until they recover the fraction TCutEN of the pair energy, and
+ * the MP2 energy lost by the truncation is added as a correction. The singles of an orbital live
+ * in its TCutDO domain. All local spaces are semicanonical.
+ *
+ * Every rank holds the Cholesky vectors of a contiguous range of cholesky indices, with the
+ * virtual indices transformed to the PAOs. The pair integrals are summed over the ranks and
+ * reduced on the rank that owns the pair, which builds its PNOs. The PNOs of the strong pairs
+ * are then replicated.
+ */
+class PNOSpaces {
+public:
+  // Cholesky vectors L^Q of the cholesky indices of this rank, the virtual indices are the
+  // covariant PAO components P^T L
+  struct Cholesky {
+    std::vector<Matrix> oo; // nocc x nocc
+    std::vector<Matrix> ov; // nocc x nao
+    std::vector<Matrix> vv; // nao x nao
+  };
+
+  // F: active alpha MO Fock matrix {occ, virt}, C: the corresponding columns of the LCAO matrix
+  PNOSpaces(ExecutionContext& ec, ChemEnv& chem_env, const Matrix& F, const Matrix& C);
+
+  // copies the alpha blocks of the spin-orbital Cholesky vectors of this rank
+  void load_cholesky(ExecutionContext& ec, const TiledIndexSpace& MO, const TiledIndexSpace& CI,
+                     Tensor<double>& cholVpr);
+
+  // prescreening, PNOs of the strong pairs and singles domains
+  void build(ExecutionContext& ec);
+
+  void print_summary(ExecutionContext& ec, ChemEnv& chem_env) const;
+
+  int    nocc() const { return nocc_; }
+  int    nao() const { return nao_; }
+  bool   is_strong(int i, int j) const { return pair_index_(i, j) >= 0; }
+  double weak_pair_energy() const;
+  double truncation_correction() const;
+  double scmp2_energy() const;
+
+  // strong pairs i <= j, a pair is owned by the rank of its index modulo the number of ranks
+  const std::vector<std::pair<int, int>>& strong_pairs() const { return strong_pairs_; }
+  int  pair_index(int i, int j) const { return pair_index_(i, j); }
+  bool owns(size_t index) const { return static_cast<int>(index % nranks_) == rank_; }
+
+  const LocalSpace& pno(int p) const { return pnos_[p]; }
+  const LocalSpace& singles_space(int i) const { return singles_[i]; }
+  // natural orbitals of the diagonal pair (i,i), scaled by the square root of their occupation.
+  // The triples natural orbitals are built from them.
+  const LocalSpace& diagonal_no(int i) const { return diag_no_[i]; }
+
+  const Matrix&   F_oo() const { return F_oo_; }
+  const Matrix&   fock_ov() const { return F_ov_; }  // nocc x nao
+  const Matrix&   fock_pao() const { return F_pao_; } // P^T F_vv P
+  const Matrix&   metric() const { return S_pao_; }   // P^T P
+  const Cholesky& cholesky() const { return chol_; }
+
+  // a.C^T (P^T P) b.C
+  Matrix overlap(const LocalSpace& a, const LocalSpace& b) const;
+
+private:
+  std::vector<int> domain_atoms(int i, double threshold) const;
+  std::vector<int> domain_paos(const std::vector<int>& atoms) const;
+  LocalSpace       domain_space(const std::vector<int>& pao) const;
+  LocalSpace make_pno(int i, int j, const LocalSpace& domain, const Matrix& K, double e_full,
+                      double& e_trunc) const;
+
+  // K_ij = sum_Q L_i^Q L_j^Q^T in the PAOs of the pairs, reduced on the owners of the pairs
+  void pair_integrals(ExecutionContext& ec, const std::vector<std::pair<int, int>>& pairs,
+                      const std::vector<std::vector<int>>&               paos,
+                      const std::function<void(size_t, const Matrix&)>& process) const;
+
+  int    nocc_, nvir_, nao_;
+  int    nranks_, rank_;
+  double tcut_pairs_, tcut_pre_, tcut_pno_, tcut_en_, tcut_tno_;
+  double tcut_do_, tcut_doij_, tcut_dopre_;
+  int    max_pnos_;
+  size_t keep_npairs_;
+
+  Matrix F_oo_, F_ov_, F_pao_, S_pao_;
+  Matrix P_;          // nvir x nao, PAOs in the canonical virtuals
+  Matrix population_; // natoms x nocc, Mulliken populations of the occupied orbitals
+  std::vector<std::vector<int>> atom_aos_;
+
+  Cholesky chol_;
+
+  // pairs i <= j in the upper triangle, replicated
+  Matrix          e_pair_;  // semicanonical MP2 pair energy, counting (i,j) and (j,i)
+  Matrix          e_trunc_; // MP2 energy lost by the PNO truncation of strong pairs
+  Eigen::MatrixXi screened_; // 1 for pairs that kept their TCutDOPre estimate
+  Eigen::MatrixXi pair_index_;
+
+  std::vector<std::pair<int, int>> strong_pairs_;
+  std::vector<LocalSpace>          pnos_;
+  std::vector<LocalSpace>          singles_;
+  std::vector<LocalSpace>          diag_no_;
+};
+
+// amplitudes of the strong pairs in their PNOs and of the singles in their domains
+struct PNOAmplitudes {
+  std::vector<Matrix>          x; // X_ij of the strong pairs i <= j, T_ij = Q_ij X_ij Q_ij^T
+  std::vector<Eigen::VectorXd> s; // singles of every occupied orbital
+};
+
+// DLPNO-CCSD iterations, returns the residual and the correlation energy of the strong pairs
+std::tuple<double, double> dlpno_ccsd_iterations(ExecutionContext& ec, ChemEnv& chem_env,
+                                                 const PNOSpaces& pnos, PNOAmplitudes& amps);
+
+// (T0) correction of the triples with at least two strong pairs in triples natural orbitals
+double dlpno_triples(ExecutionContext& ec, ChemEnv& chem_env, const PNOSpaces& pnos,
+                     const PNOAmplitudes& amps);
+
+// rows/columns idx of M
+Matrix select_rows(const Matrix& M, const std::vector<int>& idx);
+Matrix select_cols(const Matrix& M, const std::vector<int>& idx);
+
+// sums buf over all ranks, rank r receives the sum of its counts[r] words, which follow those of
+// the ranks before it in buf
+std::vector<double> reduce_to_owners(ExecutionContext& ec, const std::vector<double>& buf,
+                                     const std::vector<int>& counts);
+
+} // namespace exachem::cc::dlpno
@@ -0,0 +1,296 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "cc/dlpno/dlpno_ccsd.hpp"
+
+namespace exachem::cc::dlpno {
+
+namespace {
+
+struct Triple {
+  int        occ[3]; // i <= j <= k
+  LocalSpace tno;    // semicanonical TNOs
+};
+
+// integrals of a triple in its TNOs, position 0, 1, 2 stands for i, j, k
+struct TripleInts {
+  std::vector<Matrix> A[3]; // A_p[x](y,d) = (y d|x p)
+  Matrix              M[3][3]; // M_rq(z,l) = (z r|q l), r != q
+  Matrix              v[3];    // v_jk, v_ik, v_ij with v_pq(a,b) = (a p|b q)
+
+  TripleInts(int n, int nocc) {
+    for(int p = 0; p < 3; p++) {
+      A[p].assign(n, Matrix::Zero(n, n));
+      v[p] = Matrix::Zero(n, n);
+      for(int q = 0; q < 3; q++)
+        if(p != q) M[p][q] = Matrix::Zero(n, nocc);
+    }
+  }
+
+  std::vector<Matrix*> parts() {
+    std::vector<Matrix*> out;
+    for(int p = 0; p < 3; p++) {
+      for(auto& a: A[p]) out.push_back(&a);
+      for(int q = 0; q < 3; q++)
+        if(p != q) out.push_back(&M[p][q]);
+      out.push_back(&v[p]);
+    }
+    return out;
+  }
+
+  static size_t words(int n, int nocc) {
+    return 3 * (static_cast<size_t>(n) * n * n + 2 * static_cast<size_t>(n) * nocc +
+                static_cast<size_t>(n) * n);
+  }
+};
+
+// semicanonical TNOs from the averaged densities of the diagonal pairs, orthonormal in the PAO
+// metric
+Triple make_triple(const PNOSpaces& pnos, const std::array<int, 3>& ijk, double tcut_tno) {
+  Triple              t{{ijk[0], ijk[1], ijk[2]}, {}};
+  const std::set<int> occ(ijk.begin(), ijk.end());
+
+  std::vector<int> pao;
+  int              ncols = 0;
+  for(int m: occ) {
+    std::vector<int> merged;
+    std::set_union(pao.begin(), pao.end(), pnos.diagonal_no(m).pao.begin(),
+                   pnos.diagonal_no(m).pao.end(), std::back_inserter(merged));
+    pao = std::move(merged);
+    ncols += pnos.diagonal_no(m).size();
+  }
+
+  Matrix B = Matrix::Zero(pao.size(), ncols);
+  ncols    = 0;
+  for(int m: occ) {
+    const LocalSpace& no = pnos.diagonal_no(m);
+    for(size_t a = 0, b = 0; a < no.pao.size(); a++) {
+      while(pao[b] != no.pao[a]) b++;
+      B.block(b, ncols, 1, no.size()) = no.C.row(a);
+    }
+    ncols += no.size();
+  }
+  B /= std::sqrt(static_cast<double>(occ.size()));
+
+  const Matrix Sp = select_rows(select_cols(pnos.metric(), pao), pao);
+  const Matrix Fp = select_rows(select_cols(pnos.fock_pao(), pao), pao);
+
+  // eigenvectors of the density B B^T from the smaller B^T S B
+  Eigen::SelfAdjointEigenSolver<Matrix> eig_b(B.transpose() * Sp * B);
+  std::vector<int>                      keep;
+  for(int p = 0; p < ncols; p++)
+    if(eig_b.eigenvalues()(p) > tcut_tno) keep.push_back(p);
+  Matrix U(pao.size(), keep.size());
+  for(size_t p = 0; p < keep.size(); p++)
+    U.col(p) = B * eig_b.eigenvectors().col(keep[p]) / std::sqrt(eig_b.eigenvalues()(keep[p]));
+
+  Eigen::SelfAdjointEigenSolver<Matrix> eig_f(U.transpose() * Fp * U);
+  t.tno.pao = pao;
+  t.tno.C   = U * eig_f.eigenvectors();
+  t.tno.eps.assign(eig_f.eigenvalues().data(), eig_f.eigenvalues().data() + U.cols());
+  return t;
+}
+
+// contributions of the cholesky vectors of this rank to the integrals of a triple
+void triple_integrals(const Triple& t, const PNOSpaces& pnos, TripleInts& ints) {
+  const auto&       chol = pnos.cholesky();
+  const LocalSpace& tno  = t.tno;
+  const Matrix      Uc   = tno.C.transpose();
+
+  for(size_t q = 0; q < chol.ov.size(); q++) {
+    const Matrix Y  = Uc * select_rows(select_cols(chol.vv[q], tno.pao), tno.pao) * tno.C;
+    const Matrix Lt = Uc * select_cols(chol.ov[q], tno.pao).transpose();
+    Eigen::VectorXd lt[3];
+    for(int p = 0; p < 3; p++) lt[p] = Lt.col(t.occ[p]);
+
+    for(int p = 0; p < 3; p++) {
+      for(int x = 0; x < tno.size(); x++) ints.A[p][x] += lt[p](x) * Y;
+      for(int r = 0; r < 3; r++)
+        if(r != p) ints.M[r][p] += lt[r] * chol.oo[q].row(t.occ[p]);
+    }
+    ints.v[0] += lt[1] * lt[2].transpose();
+    ints.v[1] += lt[0] * lt[2].transpose();
+    ints.v[2] += lt[0] * lt[1].transpose();
+  }
+}
+
+// contribution of the triple (i,j,k), i <= j <= k, with all its orderings
+double triple_energy(const Triple& t, const TripleInts& ints, const PNOSpaces& pnos,
+                     const PNOAmplitudes& amps) {
+  const LocalSpace& tno  = t.tno;
+  const int         n    = tno.size();
+  const int         nocc = pnos.nocc();
+  const Matrix&     F_oo = pnos.F_oo();
+
+  // doubles of the pair (p,q) in the TNOs, zero for weak pairs
+  std::map<std::pair<int, int>, Matrix> Tt;
+  auto amplitudes = [&](int p, int q) -> const Matrix& {
+    auto it = Tt.find({p, q});
+    if(it != Tt.end()) return it->second;
+    Matrix tpq = Matrix::Zero(n, n);
+    if(pnos.is_strong(p, q)) {
+      const int    pq = pnos.pair_index(p, q);
+      const Matrix S  = pnos.overlap(tno, pnos.pno(pq));
+      tpq             = S * amps.x[pq] * S.transpose();
+      if(p > q) tpq.transposeInPlace();
+    }
+    return Tt.emplace(std::make_pair(p, q), tpq).first->second;
+  };
+
+  // w_pqr(x,y,z) = sum_d (y d|x p) T_rq^zd - sum_l (z r|q l) T_pl^xy, for the positions p, q, r
+  auto w = [&](int p, int q, int r) {
+    const int           op = t.occ[p], oq = t.occ[q], orr = t.occ[r];
+    std::vector<double> wpqr(n * n * n, 0.0);
+    const Matrix&       trq = amplitudes(orr, oq);
+    for(int x = 0; x < n; x++) {
+      const Matrix yz = ints.A[p][x] * trq.transpose();
+      for(int y = 0; y < n; y++)
+        for(int z = 0; z < n; z++) wpqr[(x * n + y) * n + z] = yz(y, z);
+    }
+    const Matrix& M = ints.M[r][q];
+    for(int l = 0; l < nocc; l++) {
+      if(!pnos.is_strong(op, l)) continue;
+      const Matrix& tpl = amplitudes(op, l);
+      for(int x = 0; x < n; x++)
+        for(int y = 0; y < n; y++)
+          for(int z = 0; z < n; z++) wpqr[(x * n + y) * n + z] -= M(z, l) * tpl(x, y);
+    }
+    return wpqr;
+  };
+
+  const auto w_ijk = w(0, 1, 2);
+  const auto w_ikj = w(0, 2, 1);
+  const auto w_jik = w(1, 0, 2);
+  const auto w_jki = w(1, 2, 0);
+  const auto w_kij = w(2, 0, 1);
+  const auto w_kji = w(2, 1, 0);
+
+  auto idx = [n](int x, int y, int z) { return (x * n + y) * n + z; };
+
+  std::vector<double> W(n * n * n), V(n * n * n);
+  for(int a = 0; a < n; a++)
+    for(int b = 0; b < n; b++)
+      for(int c = 0; c < n; c++)
+        W[idx(a, b, c)] = w_ijk[idx(a, b, c)] + w_ikj[idx(a, c, b)] + w_jik[idx(b, a, c)] +
+                          w_jki[idx(b, c, a)] + w_kij[idx(c, a, b)] + w_kji[idx(c, b, a)];
+
+  Eigen::VectorXd t1[3];
+  for(int p = 0; p < 3; p++)
+    t1[p] = pnos.overlap(tno, pnos.singles_space(t.occ[p])) * amps.s[t.occ[p]];
+  const Matrix& v_jk = ints.v[0]; // (bj|ck)
+  const Matrix& v_ik = ints.v[1]; // (ai|ck)
+  const Matrix& v_ij = ints.v[2]; // (ai|bj)
+  for(int a = 0; a < n; a++)
+    for(int b = 0; b < n; b++)
+      for(int c = 0; c < n; c++)
+        V[idx(a, b, c)] = W[idx(a, b, c)] + v_jk(b, c) * t1[0](a) + v_ik(a, c) * t1[1](b) +
+                          v_ij(a, b) * t1[2](c);
+
+  const double f_ijk = F_oo(t.occ[0], t.occ[0]) + F_oo(t.occ[1], t.occ[1]) +
+                       F_oo(t.occ[2], t.occ[2]);
+  double e = 0.0;
+  for(int a = 0; a < n; a++)
+    for(int b = 0; b < n; b++)
+      for(int c = 0; c < n; c++) {
+        const double d = f_ijk - tno.eps[a] - tno.eps[b] - tno.eps[c];
+        e += (4.0 * W[idx(a, b, c)] + W[idx(b, c, a)] + W[idx(c, a, b)]) *
+             (V[idx(a, b, c)] - V[idx(c, b, a)]) / (3.0 * d);
+      }
+
+  // all orderings of (i,j,k) contribute equally
+  const int mult = (t.occ[0] == t.occ[1] || t.occ[1] == t.occ[2]) ? 3 : 6;
+  return mult * e;
+}
+
+} // namespace
+
+double dlpno_triples(ExecutionContext& ec, ChemEnv& chem_env, const PNOSpaces& pnos,
+                     const PNOAmplitudes& amps) {
+  const int    nocc     = pnos.nocc();
+  const int    nranks   = ec.pg().size().value();
+  const int    rank     = ec.pg().rank().value();
+  const double tcut_tno = chem_env.ioptions.ccsd_options.TCutTNO;
+
+  // triples i <= j <= k with at least two strong pairs, i = j = k does not contribute. A triple
+  // is owned by the rank of its index modulo the number of ranks.
+  std::vector<std::array<int, 3>> triples;
+  for(int i = 0; i < nocc; i++)
+    for(int j = i; j < nocc; j++)
+      for(int k = j; k < nocc; k++) {
+        if(i == k) continue;
+        const int nstrong = pnos.is_strong(i, j) + pnos.is_strong(i, k) + pnos.is_strong(j, k);
+        if(nstrong >= 2) triples.push_back({i, j, k});
+      }
+
+  // every rank adds the contributions of its cholesky vectors to the integrals of a chunk of
+  // triples, which are summed on their owners
+  const double max_chunk_words = (1UL << 30) / sizeof(double);
+
+  double e_t  = 0.0;
+  double ntno = 0.0;
+  size_t next = 0;
+  while(next < triples.size()) {
+    std::vector<Triple> chunk;
+    double              words = 0;
+    while(next < triples.size() && (chunk.empty() || words < max_chunk_words)) {
+      chunk.push_back(make_triple(pnos, triples[next++], tcut_tno));
+      words += TripleInts::words(chunk.back().tno.size(), nocc);
+    }
+
+    std::vector<int>    counts(nranks, 0);
+    std::vector<size_t> order;
+    for(int r = 0; r < nranks; r++)
+      for(size_t t = 0; t < chunk.size(); t++) {
+        if(static_cast<int>((next - chunk.size() + t) % nranks) != r) continue;
+        order.push_back(t);
+        counts[r] += TripleInts::words(chunk[t].tno.size(), nocc);
+      }
+
+    std::vector<double> buf;
+    buf.reserve(static_cast<size_t>(words));
+    for(size_t t: order) {
+      TripleInts ints(chunk[t].tno.size(), nocc);
+      triple_integrals(chunk[t], pnos, ints);
+      for(auto m: ints.parts()) buf.insert(buf.end(), m->data(), m->data() + m->size());
+    }
+
+    const auto sum = reduce_to_owners(ec, buf, counts);
+    size_t     off = 0;
+    for(size_t t = 0; t < chunk.size(); t++) {
+      if(static_cast<int>((next - chunk.size() + t) % nranks) != rank) continue;
+      const int  n = chunk[t].tno.size();
+      TripleInts ints(n, nocc);
+      for(auto m: ints.parts()) {
+        *m = Eigen::Map<const Matrix>(sum.data() + off, m->rows(), m->cols());
+        off += m->size();
+      }
+      ntno += n;
+      if(n > 0) e_t += triple_energy(chunk[t], ints, pnos, amps);
+    }
+  }
+
+  double e_sum = 0.0, ntno_sum = 0.0;
+  ec.pg().allreduce(&e_t, &e_sum, 1, ReduceOp::sum);
+  ec.pg().allreduce(&ntno, &ntno_sum, 1, ReduceOp::sum);
+
+  const size_t ntriples = triples.size();
+  if(rank == 0) {
+    std::cout << std::endl << "Triples natural orbitals" << std::endl;
+    std::cout << " - number of triples               = " << ntriples << std::endl;
+    std::cout << " - average TNOs per triple         = " << std::fixed << std::setprecision(1)
+              << (ntriples > 0 ? ntno_sum / ntriples : 0.0) << std::defaultfloat << std::endl;
+
+    auto& jtriples      = chem_env.sys_data.results["output"]["DLPNO-CCSD"]["triples"];
+    jtriples["total"]   = ntriples;
+    jtriples["average"] = ntriples > 0 ? ntno_sum / ntriples : 0.0;
+  }
+
+  return e_sum;
+}
+
+} // namespace exachem::cc::dlpno
@@ -0,0 +1,508 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "cc/dlpno/dlpno_ccsd.hpp"
+
+// Closed-shell CCSD equations of cd_ccsd_cs_ann.cpp with the doubles of the strong pairs in
+// their PNOs and the singles in their domains. Every virtual vector is handled through its PAO
+// components, covariant (P^T v) or contravariant (v = P c), so that the projections onto a
+// local space only touch the PAOs of its domain.
+//
+// The terms with a sum over the cholesky vectors are evaluated by every rank for its own
+// vectors and all pairs: the ladder, the ring terms and the products of the dressed X_ai. The
+// remaining terms of a pair are added by the rank that owns it, and one reduction completes the
+// residuals. Intermediates with at most two virtual indices, like the dressed Fock matrices,
+// are kept in the PAO basis.
+
+namespace exachem::cc::dlpno {
+
+namespace {
+
+void scatter_add(Matrix& M, int col, const std::vector<int>& pao, const Eigen::VectorXd& c) {
+  for(size_t m = 0; m < pao.size(); m++) M(pao[m], col) += c(m);
+}
+
+Eigen::VectorXd gather(const Matrix& M, int col, const std::vector<int>& pao) {
+  Eigen::VectorXd v(pao.size());
+  for(size_t m = 0; m < pao.size(); m++) v(m) = M(pao[m], col);
+  return v;
+}
+
+// sum_{k in ks, l in ls} (A_k Za_k(:,l)) (B_l Zb_l(:,k))^T, the ring terms quadratic in the
+// amplitudes, where the columns of Za_k and Zb_l are the projections of L_m^Q onto their PNOs
+Matrix ring_product(const std::vector<int>& ks, const std::vector<int>& ls,
+                    const std::vector<Matrix>& A, const std::vector<Matrix>& Za,
+                    const std::vector<Matrix>& B, const std::vector<Matrix>& Zb, int n) {
+  const size_t nl = ls.size();
+  Matrix       Acat(n, ks.size() * nl), Bcat(n, ks.size() * nl);
+  for(size_t a = 0; a < ks.size(); a++) {
+    const Matrix AZ = A[a] * Za[a];
+    for(size_t b = 0; b < nl; b++) Acat.col(a * nl + b) = AZ.col(ls[b]);
+  }
+  for(size_t b = 0; b < nl; b++) {
+    const Matrix BZ = B[b] * Zb[b];
+    for(size_t a = 0; a < ks.size(); a++) Bcat.col(a * nl + b) = BZ.col(ks[a]);
+  }
+  return Acat * Bcat.transpose();
+}
+
+void allreduce_matrices(ExecutionContext& ec, const std::vector<Matrix*>& parts, double& scalar) {
+  size_t total = 1;
+  for(auto m: parts) total += m->size();
+  std::vector<double> buf(total), sum(total);
+  size_t              off = 0;
+  for(auto m: parts) {
+    Eigen::Map<Matrix>(buf.data() + off, m->rows(), m->cols()) = *m;
+    off += m->size();
+  }
+  buf[off] = scalar;
+  ec.pg().allreduce(buf.data(), sum.data(), total, ReduceOp::sum);
+  off = 0;
+  for(auto m: parts) {
+    *m = Eigen::Map<const Matrix>(sum.data() + off, m->rows(), m->cols());
+    off += m->size();
+  }
+  scalar = sum[off];
+}
+
+Eigen::VectorXd pack(const PNOAmplitudes& amps) {
+  size_t total = 0;
+  for(const auto& s: amps.s) total += s.size();
+  for(const auto& x: amps.x) total += x.size();
+  Eigen::VectorXd v(total);
+  size_t          off = 0;
+  for(const auto& s: amps.s) {
+    v.segment(off, s.size()) = s;
+    off += s.size();
+  }
+  for(const auto& x: amps.x) {
+    Eigen::Map<Matrix>(v.data() + off, x.rows(), x.cols()) = x;
+    off += x.size();
+  }
+  return v;
+}
+
+void unpack(const Eigen::VectorXd& v, PNOAmplitudes& amps) {
+  size_t off = 0;
+  for(auto& s: amps.s) {
+    s = v.segment(off, s.size());
+    off += s.size();
+  }
+  for(auto& x: amps.x) {
+    x = Eigen::Map<const Matrix>(v.data() + off, x.rows(), x.cols());
+    off += x.size();
+  }
+}
+
+// overlaps S_{ij,sk} of the PNOs of a pair (i,j) with those of the strong pairs (s,k) of one of
+// its orbitals s, and their products with T_sk: a = S X(s,k), b = S A(s,k), c = S X(s,k)^T,
+// with A = X - X^T
+struct PairSide {
+  const std::vector<Matrix>* S;
+  std::vector<Matrix>        a, b, c;
+};
+
+// The PNO overlaps only depend on the local spaces and are built once. A pair (i,j) couples to
+// the pairs (i,k) and (j,k) in the ring and Fock-like terms, which every rank evaluates for all
+// pairs, and through the hole-hole ladder to the pairs (k,l) whose domains share PAOs with its
+// own, which only the owner evaluates.
+struct Context {
+  const PNOSpaces&              pnos;
+  std::vector<std::vector<int>> partners; // strong partners k of every orbital
+  std::vector<Matrix>           SC;       // P^T P Q_p of every strong pair, nao x npno
+  // S_{ij,ik} and S_{ij,jk} for the partners k of i and j
+  std::vector<std::array<std::vector<Matrix>, 2>> side_S;
+  // the pairs (k,l) with a common PAO, the orbitals k,l of these pairs and the positions of k,l
+  // among them, and for the owned pairs S_{ij,kl}
+  std::vector<std::vector<int>>                 near;
+  std::vector<std::vector<int>>                 near_orbs;
+  std::vector<std::vector<std::pair<int, int>>> near_kl;
+  std::vector<std::vector<Matrix>>              near_S;
+
+  Context(const PNOSpaces& pnos_);
+
+  Matrix overlap(int p, int p2) const {
+    return pnos.pno(p).C.transpose() * select_rows(SC[p2], pnos.pno(p).pao);
+  }
+
+  // side 0 pairs (i,j) with the (i,k), side 1 with the (j,k)
+  PairSide side(const PNOAmplitudes& amps, int p, int which) const {
+    const int s = which == 0 ? pnos.strong_pairs()[p].first : pnos.strong_pairs()[p].second;
+    PairSide  out{&side_S[p][which], {}, {}, {}};
+    for(size_t a = 0; a < partners[s].size(); a++) {
+      const int     k  = partners[s][a];
+      const int     p2 = pnos.pair_index(s, k);
+      const Matrix  x  = s <= k ? amps.x[p2] : Matrix(amps.x[p2].transpose());
+      const Matrix& S  = side_S[p][which][a];
+      out.a.push_back(S * x);
+      out.b.push_back(S * (x - x.transpose()));
+      out.c.push_back(S * x.transpose());
+    }
+    return out;
+  }
+};
+
+Context::Context(const PNOSpaces& pnos_): pnos{pnos_} {
+  const int   nocc   = pnos.nocc();
+  const auto& pairs  = pnos.strong_pairs();
+  const int   npairs = pairs.size();
+
+  partners.resize(nocc);
+  for(int i = 0; i < nocc; i++)
+    for(int k = 0; k < nocc; k++)
+      if(pnos.is_strong(i, k)) partners[i].push_back(k);
+
+  SC.resize(npairs);
+  for(int p = 0; p < npairs; p++)
+    SC[p] = select_cols(pnos.metric(), pnos.pno(p).pao) * pnos.pno(p).C;
+
+  side_S.resize(npairs);
+  for(int p = 0; p < npairs; p++) {
+    const auto [i, j] = pairs[p];
+    for(int k: partners[i]) side_S[p][0].push_back(overlap(p, pnos.pair_index(i, k)));
+    for(int k: partners[j]) side_S[p][1].push_back(overlap(p, pnos.pair_index(j, k)));
+  }
+
+  // pairs with a common PAO through the pairs of every PAO
+  std::vector<std::vector<int>> pao_pairs(pnos.nao());
+  for(int p = 0; p < npairs; p++)
+    for(int mu: pnos.pno(p).pao) pao_pairs[mu].push_back(p);
+
+  near.resize(npairs);
+  near_orbs.resize(npairs);
+  near_kl.resize(npairs);
+  near_S.resize(npairs);
+  std::vector<int> seen(npairs, -1), pos(nocc, -1);
+  for(int p = 0; p < npairs; p++) {
+    for(int mu: pnos.pno(p).pao)
+      for(int p2: pao_pairs[mu]) {
+        if(seen[p2] == p) continue;
+        seen[p2] = p;
+        near[p].push_back(p2);
+      }
+    std::sort(near[p].begin(), near[p].end());
+
+    // (i,j) shares its PAOs with itself, so i and j are among the orbitals
+    for(int p2: near[p]) {
+      near_orbs[p].push_back(pairs[p2].first);
+      near_orbs[p].push_back(pairs[p2].second);
+    }
+    auto& orbs = near_orbs[p];
+    std::sort(orbs.begin(), orbs.end());
+    orbs.erase(std::unique(orbs.begin(), orbs.end()), orbs.end());
+    for(size_t m = 0; m < orbs.size(); m++) pos[orbs[m]] = m;
+    for(int p2: near[p]) near_kl[p].push_back({pos[pairs[p2].first], pos[pairs[p2].second]});
+
+    if(pnos.owns(p))
+      for(int p2: near[p]) near_S[p].push_back(overlap(p, p2));
+  }
+}
+
+// position of orbital i among the near orbitals of pair p
+int orb_pos(const Context& ctx, int p, int i) {
+  const auto& orbs = ctx.near_orbs[p];
+  return std::lower_bound(orbs.begin(), orbs.end(), i) - orbs.begin();
+}
+
+// residuals of amps, which are replaced by their Jacobi update. Returns the residual norm and
+// the correlation energy of amps, res receives the residuals.
+std::tuple<double, double> iterate(ExecutionContext& ec, const Context& ctx, PNOAmplitudes& amps,
+                                   PNOAmplitudes& res, double zshiftl) {
+  const PNOSpaces& pnos   = ctx.pnos;
+  const int        nocc   = pnos.nocc();
+  const int        nao    = pnos.nao();
+  const auto&      pairs  = pnos.strong_pairs();
+  const int        npairs = pairs.size();
+  const auto&      chol   = pnos.cholesky();
+  const int        nq     = chol.ov.size();
+  const Matrix&    Sp     = pnos.metric();
+  const Matrix&    Fp     = pnos.fock_pao();
+  const Matrix&    Fov    = pnos.fock_ov();
+  const Matrix&    F_oo   = pnos.F_oo();
+
+  // singles as PAO coefficients and covariant components
+  Matrix Cs = Matrix::Zero(nao, nocc);
+  for(int i = 0; i < nocc; i++) {
+    const LocalSpace& sp = pnos.singles_space(i);
+    scatter_add(Cs, i, sp.pao, sp.C * amps.s[i]);
+  }
+  const Matrix Tcov  = Sp * Cs;
+  const Matrix FovCs = Fov * Cs; // sum_c f_kc t_i^c
+
+  // dressed L_ab, X_ai = L^_ai + Y_ai and dressed L_ki of every cholesky vector, kept for the
+  // pair terms
+  std::vector<Matrix> Lhvv(nq), Xcov(nq), Lhoo(nq);
+
+  // alpha_ij(k,l) over the near orbitals of (i,j)
+  std::vector<Matrix> alpha(npairs);
+  for(int p = 0; p < npairs; p++)
+    alpha[p] = Matrix::Zero(ctx.near_orbs[p].size(), ctx.near_orbs[p].size());
+  Matrix              LoY     = Matrix::Zero(nocc, nocc);
+  Matrix              Woo     = Matrix::Zero(nocc, nocc);
+  Matrix              Hov     = Matrix::Zero(nocc, nao);
+  Matrix              Wvv     = Matrix::Zero(nao, nao);
+  Matrix              rcov    = Matrix::Zero(nao, nocc);
+  Matrix              rcontra = Matrix::Zero(nao, nocc);
+  double              energy  = 0.0;
+
+  for(int q = 0; q < nq; q++) {
+    const Matrix& oo  = chol.oo[q];
+    const Matrix& ov  = chol.ov[q];
+    const Matrix& vv  = chol.vv[q];
+    const Matrix  Lt  = ov * Cs; // sum_c L_kc t_i^c
+    const double  rho = Lt.trace();
+    Lhoo[q]           = oo + Lt;
+
+    // Y_ai = sum_kc u_ik^ac L_kc from the projections Z = Q_ij^T L_m of the near orbitals m of
+    // (i,j), and the hole-hole ladder intermediate alpha_ij(k,l) = (ki|lj) + sum_cd (kc|ld) t_ij^cd
+    Matrix y = Matrix::Zero(nao, nocc);
+    for(int p = 0; p < npairs; p++) {
+      const auto [i, j]     = pairs[p];
+      const LocalSpace& pno = pnos.pno(p);
+      const Matrix&     x   = amps.x[p];
+      const auto&       mo  = ctx.near_orbs[p];
+      const Matrix Z  = pno.C.transpose() * select_cols(select_rows(ov, mo), pno.pao).transpose();
+      const Matrix U  = 2.0 * x - x.transpose();
+      const Matrix Lo = select_rows(select_cols(Lhoo[q], {i, j}), mo);
+      scatter_add(y, i, pno.pao, pno.C * (U * Z.col(orb_pos(ctx, p, j))));
+      if(i != j) scatter_add(y, j, pno.pao, pno.C * (U.transpose() * Z.col(orb_pos(ctx, p, i))));
+      alpha[p] += Lo.col(0) * Lo.col(1).transpose() + Z.transpose() * x * Z;
+    }
+    const Matrix Ycov = Sp * y;
+    const Matrix VCs  = vv * Cs;
+    Lhvv[q]           = vv - Tcov * ov;
+    Xcov[q]           = ov.transpose() + VCs - Tcov * Lhoo[q] + Ycov;
+
+    const Matrix ovy = ov * y;
+    LoY += ovy;
+    Woo += 2.0 * rho * Lhoo[q] - Lt * Lhoo[q];
+    Hov -= Lt * ov;
+    Wvv += -2.0 * rho * Lhvv[q] + (Ycov + Lhvv[q] * Cs) * ov;
+    energy += 2.0 * rho * rho - Lt.cwiseProduct(Lt.transpose()).sum() + ovy.trace();
+
+    rcov += 2.0 * rho * ov.transpose() + vv * y + 2.0 * rho * VCs - VCs * Lhoo[q];
+    rcontra += 2.0 * rho * y + (-y - 2.0 * rho * Cs + Cs * Lt) * Lhoo[q];
+  }
+
+  std::vector<Matrix*> parts{&LoY, &Woo, &Hov, &Wvv, &rcov, &rcontra};
+  allreduce_matrices(ec, parts, energy);
+
+  // the hole-hole ladder intermediates are only used by the owners of their pairs
+  {
+    const int           nranks = ec.pg().size().value();
+    std::vector<int>    counts(nranks, 0);
+    std::vector<double> buf;
+    for(int r = 0; r < nranks; r++)
+      for(int p = r; p < npairs; p += nranks) {
+        buf.insert(buf.end(), alpha[p].data(), alpha[p].data() + alpha[p].size());
+        counts[r] += alpha[p].size();
+      }
+    const auto sum = reduce_to_owners(ec, buf, counts);
+    size_t     off = 0;
+    for(int p = 0; p < npairs; p++) {
+      if(!pnos.owns(p)) continue;
+      alpha[p] = Eigen::Map<const Matrix>(sum.data() + off, alpha[p].rows(), alpha[p].cols());
+      off += alpha[p].size();
+    }
+  }
+
+  Woo += F_oo + FovCs + LoY;
+  Hov += Fov;
+  Wvv += -Fp + Tcov * Fov;
+  energy += 2.0 * FovCs.trace();
+
+  // singles, the PAO coefficients are added to the covariant components through the metric
+  Matrix rc = rcontra + Cs * (-F_oo - FovCs - LoY);
+  for(int p = 0; p < npairs; p++) {
+    const auto [i, j]     = pairs[p];
+    const LocalSpace& pno = pnos.pno(p);
+    const Matrix&     x   = amps.x[p];
+    const Matrix      U   = 2.0 * x - x.transpose();
+    const Matrix      Hq  = pno.C.transpose() * select_cols(Hov, pno.pao).transpose();
+    scatter_add(rc, i, pno.pao, pno.C * (U * Hq.col(j)));
+    if(i != j) scatter_add(rc, j, pno.pao, pno.C * (U.transpose() * Hq.col(i)));
+  }
+  const Matrix r1 = rcov + Fov.transpose() + Fp * Cs + Sp * rc;
+  for(int i = 0; i < nocc; i++) {
+    const LocalSpace& sp = pnos.singles_space(i);
+    res.s[i]             = sp.C.transpose() * gather(r1, i, sp.pao);
+  }
+
+  // doubles
+  for(int p = 0; p < npairs; p++) {
+    const auto [i, j]     = pairs[p];
+    const LocalSpace& pno = pnos.pno(p);
+    const int         n   = pno.size();
+    const Matrix&     x   = amps.x[p];
+    const auto&       Ki  = ctx.partners[i];
+    const auto&       Kj  = ctx.partners[j];
+    const PairSide    si  = ctx.side(amps, p, 0);
+    const PairSide    sj  = ctx.side(amps, p, 1);
+
+    Matrix& r = res.x[p];
+    r.setZero(n, n);
+
+    // ring terms linear in the amplitudes, T_ik (kj|cb)^ and T_kj (ki|cb)^, are accumulated as
+    // G1_k = sum_Q L^_kj Q_ik^T L^_vv^T Q_ij and G2_k = sum_Q L^_ki Q_jk^T L^_vv^T Q_ij
+    std::vector<Matrix> G1, G2;
+    for(int k: Ki) G1.push_back(Matrix::Zero(pnos.pno(pnos.pair_index(i, k)).size(), n));
+    for(int k: Kj) G2.push_back(Matrix::Zero(pnos.pno(pnos.pair_index(j, k)).size(), n));
+
+    for(int q = 0; q < nq; q++) {
+      const Matrix W = pno.C.transpose() * select_rows(Lhvv[q], pno.pao);
+
+      // particle-particle ladder
+      const Matrix B = select_cols(W, pno.pao) * pno.C;
+      r += B * x * B.transpose();
+
+      // X_ai X_bj
+      const Eigen::VectorXd xi = pno.C.transpose() * gather(Xcov[q], i, pno.pao);
+      const Eigen::VectorXd xj = pno.C.transpose() * gather(Xcov[q], j, pno.pao);
+      r += xi * xj.transpose();
+
+      std::vector<Matrix> Zi, Zj;
+      for(size_t a = 0; a < Ki.size(); a++) {
+        const LocalSpace& pk = pnos.pno(pnos.pair_index(i, Ki[a]));
+        G1[a] += Lhoo[q](Ki[a], j) * (select_cols(W, pk.pao) * pk.C).transpose();
+        Zi.push_back(pk.C.transpose() * select_cols(chol.ov[q], pk.pao).transpose());
+      }
+      for(size_t b = 0; b < Kj.size(); b++) {
+        const LocalSpace& pk = pnos.pno(pnos.pair_index(j, Kj[b]));
+        G2[b] += Lhoo[q](Kj[b], i) * (select_cols(W, pk.pao) * pk.C).transpose();
+        Zj.push_back(pk.C.transpose() * select_cols(chol.ov[q], pk.pao).transpose());
+      }
+
+      // ring terms quadratic in the amplitudes of (i,j) and of its transpose (j,i)
+      const Matrix Zq = -0.5 * (ring_product(Ki, Kj, si.a, Zi, sj.b, Zj, n) +
+                                ring_product(Ki, Kj, si.b, Zi, sj.a, Zj, n)) +
+                        0.5 * ring_product(Kj, Ki, sj.c, Zj, si.c, Zi, n);
+      const Matrix Zt = -0.5 * (ring_product(Kj, Ki, sj.a, Zj, si.b, Zi, n) +
+                                ring_product(Kj, Ki, sj.b, Zj, si.a, Zi, n)) +
+                        0.5 * ring_product(Ki, Kj, si.c, Zi, sj.c, Zj, n);
+      r += Zq + Zt.transpose();
+    }
+    for(size_t a = 0; a < Ki.size(); a++) r -= si.a[a] * G1[a] + (si.c[a] * G1[a]).transpose();
+    for(size_t b = 0; b < Kj.size(); b++) r -= sj.c[b] * G2[b] + (sj.a[b] * G2[b]).transpose();
+
+    if(!pnos.owns(p)) continue;
+
+    // Fock-like terms
+    const Matrix Wp = pno.C.transpose() * select_rows(select_cols(Wvv, pno.pao), pno.pao) * pno.C;
+    r -= x * Wp.transpose() + Wp * x;
+    for(size_t b = 0; b < Kj.size(); b++) r -= Woo(Kj[b], i) * sj.c[b] * (*sj.S)[b].transpose();
+    for(size_t a = 0; a < Ki.size(); a++) r -= Woo(Ki[a], j) * si.a[a] * (*si.S)[a].transpose();
+
+    // hole-hole ladder over the pairs that share PAOs with (i,j)
+    for(size_t n2 = 0; n2 < ctx.near[p].size(); n2++) {
+      const int     p2  = ctx.near[p][n2];
+      const auto [k, l] = ctx.near_kl[p][n2];
+      const Matrix& S   = ctx.near_S[p][n2];
+      Matrix        xkl = alpha[p](k, l) * amps.x[p2];
+      if(k != l) xkl += alpha[p](l, k) * amps.x[p2].transpose();
+      r += S * xkl * S.transpose();
+    }
+  }
+
+  std::vector<Matrix*> rparts;
+  for(auto& r: res.x) rparts.push_back(&r);
+  double dummy = 0.0;
+  allreduce_matrices(ec, rparts, dummy);
+
+  // Jacobi update
+  double r1norm = 0.0, r2norm = 0.0;
+  for(int i = 0; i < nocc; i++) {
+    const LocalSpace& sp = pnos.singles_space(i);
+    for(int a = 0; a < sp.size(); a++)
+      amps.s[i](a) += res.s[i](a) / (F_oo(i, i) - sp.eps[a] - zshiftl);
+    r1norm += res.s[i].squaredNorm();
+  }
+  for(int p = 0; p < npairs; p++) {
+    const auto [i, j]     = pairs[p];
+    const LocalSpace& pno = pnos.pno(p);
+    const double      fij = F_oo(i, i) + F_oo(j, j);
+    for(int a = 0; a < pno.size(); a++)
+      for(int b = 0; b < pno.size(); b++)
+        amps.x[p](a, b) += res.x[p](a, b) / (fij - pno.eps[a] - pno.eps[b] - 2.0 * zshiftl);
+    r2norm += (i == j ? 1.0 : 2.0) * res.x[p].squaredNorm();
+  }
+
+  return {std::max(0.5 * std::sqrt(r1norm), 0.5 * std::sqrt(r2norm)), energy};
+}
+
+} // namespace
+
+std::tuple<double, double> dlpno_ccsd_iterations(ExecutionContext& ec, ChemEnv& chem_env,
+                                                 const PNOSpaces& pnos, PNOAmplitudes& amps) {
+  const CCSDOptions& ccsd_options = chem_env.ioptions.ccsd_options;
+  const int          maxiter      = ccsd_options.ccsd_maxiter;
+  const int          ndiis        = ccsd_options.ndiis;
+  const double       thresh       = ccsd_options.threshold;
+  const double       zshiftl      = ccsd_options.lshift;
+
+  const int   nocc  = pnos.nocc();
+  const auto& pairs = pnos.strong_pairs();
+
+  const Context ctx{pnos};
+
+  amps.s.clear();
+  amps.x.clear();
+  for(int i = 0; i < nocc; i++) amps.s.push_back(Eigen::VectorXd::Zero(pnos.singles_space(i).size()));
+  for(size_t p = 0; p < pairs.size(); p++)
+    amps.x.push_back(Matrix::Zero(pnos.pno(p).size(), pnos.pno(p).size()));
+  PNOAmplitudes res = amps;
+
+  print_ccsd_header(ec.print(), "DLPNO-CCSD");
+
+  double                       residual = 0.0, energy = 0.0;
+  std::vector<Eigen::VectorXd> ts, rs;
+  for(int titer = 0; titer < maxiter; titer += ndiis) {
+    ts.clear();
+    rs.clear();
+    for(int iter = titer; iter < std::min(titer + ndiis, maxiter); iter++) {
+      const auto timer_start = std::chrono::high_resolution_clock::now();
+
+      ts.push_back(pack(amps));
+      std::tie(residual, energy) = iterate(ec, ctx, amps, res, zshiftl);
+      rs.push_back(pack(res));
+
+      const auto timer_end = std::chrono::high_resolution_clock::now();
+      auto       iter_time =
+        std::chrono::duration_cast<std::chrono::duration<double>>((timer_end - timer_start))
+          .count();
+
+      iteration_print(chem_env, ec.pg(), iter, residual, energy, iter_time, "DLPNO-CCSD");
+
+      if(residual < thresh) { break; }
+    }
+
+    if(residual < thresh || titer + ndiis >= maxiter) { break; }
+    if(ec.pg().rank() == 0) {
+      std::cout << " MICROCYCLE DIIS UPDATE:";
+      std::cout.width(21);
+      std::cout << std::right << std::min(titer + ndiis, maxiter) + 1 << std::endl;
+    }
+
+    // the amplitudes and residuals are replicated, every rank extrapolates
+    const int       nd = ts.size();
+    Matrix          A  = Matrix::Zero(nd + 1, nd + 1);
+    Eigen::VectorXd b  = Eigen::VectorXd::Zero(nd + 1);
+    for(int i = 0; i < nd; i++) {
+      for(int j = 0; j < nd; j++) A(i, j) = rs[i].dot(rs[j]);
+      A(i, nd) = A(nd, i) = -1.0;
+    }
+    b(nd)                   = -1.0;
+    const Eigen::VectorXd c = A.lu().solve(b);
+    Eigen::VectorXd       t = Eigen::VectorXd::Zero(ts[0].size());
+    for(int j = 0; j < nd; j++) t += c(j) * ts[j];
+    unpack(t, amps);
+  }
+
+  return {residual, energy};
+}
+
+} // namespace exachem::cc::dlpno
@@ -0,0 +1,547 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "cc/dlpno/dlpno_ccsd.hpp"
+
+namespace exachem::cc::dlpno {
+
+namespace {
+
+// PAO combinations with a smaller norm in the domain metric are linearly dependent
+constexpr double pao_lindep = 1e-6;
+
+// words of the pair integrals summed per batch
+constexpr double max_batch_words = (1UL << 30) / sizeof(double);
+
+Matrix compute_overlap(const libint2::BasisSet& shells) {
+  const auto shell2bf = shells.shell2bf();
+  Matrix     S        = Matrix::Zero(shells.nbf(), shells.nbf());
+
+  libint2::Engine engine(libint2::Operator::overlap, shells.max_nprim(), shells.max_l(), 0);
+  const auto&     buf = engine.results();
+
+  for(size_t s1 = 0; s1 < shells.size(); s1++) {
+    const auto n1 = shells[s1].size();
+    for(size_t s2 = 0; s2 < shells.size(); s2++) {
+      const auto n2 = shells[s2].size();
+      engine.compute(shells[s1], shells[s2]);
+      if(buf[0] == nullptr) continue;
+      Eigen::Map<const Matrix> buf_mat(buf[0], n1, n2);
+      S.block(shell2bf[s1], shell2bf[s2], n1, n2) = buf_mat;
+    }
+  }
+  return S;
+}
+
+// semicanonical MP2 energy of the pairs (i,j) and (j,i) from K_ij = (ia|jb) in a virtual basis
+// with orbital energies eps
+double pair_energy(const Matrix& K, const std::vector<double>& eps, double f_ij, bool diagonal) {
+  double e = 0.0;
+  for(size_t a = 0; a < eps.size(); a++)
+    for(size_t b = 0; b < eps.size(); b++) {
+      const double t_ab = -K(a, b) / (eps[a] + eps[b] - f_ij);
+      const double t_ba = -K(b, a) / (eps[a] + eps[b] - f_ij);
+      e += K(a, b) * (2.0 * t_ab - t_ba);
+    }
+  return diagonal ? e : 2.0 * e;
+}
+
+std::vector<int> merge(const std::vector<int>& a, const std::vector<int>& b) {
+  std::vector<int> out;
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+  return out;
+}
+
+} // namespace
+
+Matrix select_rows(const Matrix& M, const std::vector<int>& idx) {
+  Matrix out(idx.size(), M.cols());
+  for(size_t r = 0; r < idx.size(); r++) out.row(r) = M.row(idx[r]);
+  return out;
+}
+
+Matrix select_cols(const Matrix& M, const std::vector<int>& idx) {
+  Matrix out(M.rows(), idx.size());
+  for(size_t c = 0; c < idx.size(); c++) out.col(c) = M.col(idx[c]);
+  return out;
+}
+
+std::vector<double> reduce_to_owners(ExecutionContext& ec, const std::vector<double>& buf,
+                                     const std::vector<int>& counts) {
+  std::vector<double> out(counts[ec.pg().rank().value()]);
+  MPI_Reduce_scatter(buf.data(), out.data(), counts.data(), MPI_DOUBLE, MPI_SUM, ec.pg().comm());
+  return out;
+}
+
+PNOSpaces::PNOSpaces(ExecutionContext& ec, ChemEnv& chem_env, const Matrix& F, const Matrix& C) {
+  const CCSDOptions& ccsd_options = chem_env.ioptions.ccsd_options;
+
+  nocc_        = chem_env.sys_data.n_occ_alpha;
+  nvir_        = F.rows() - nocc_;
+  nao_         = C.rows();
+  nranks_      = ec.pg().size().value();
+  rank_        = ec.pg().rank().value();
+  tcut_pairs_  = ccsd_options.TCutPairs;
+  tcut_pre_    = ccsd_options.TCutPre;
+  tcut_pno_    = ccsd_options.TCutPNO;
+  tcut_en_     = ccsd_options.TCutEN;
+  tcut_tno_    = ccsd_options.TCutTNO;
+  tcut_do_     = ccsd_options.TCutDO;
+  tcut_doij_   = ccsd_options.TCutDOij;
+  tcut_dopre_  = ccsd_options.TCutDOPre;
+  max_pnos_    = ccsd_options.max_pnos;
+  keep_npairs_ = ccsd_options.keep_npairs;
+
+  const Matrix S   = compute_overlap(chem_env.shells);
+  const Matrix C_o = C.leftCols(nocc_);
+  const Matrix C_v = C.rightCols(nvir_);
+
+  F_oo_  = F.topLeftCorner(nocc_, nocc_);
+  P_     = C_v.transpose() * S;
+  S_pao_ = P_.transpose() * P_;
+  F_pao_ = P_.transpose() * F.bottomRightCorner(nvir_, nvir_) * P_;
+  F_ov_  = F.topRightCorner(nocc_, nvir_) * P_;
+
+  auto       atom2shell = chem_env.shells.atom2shell(chem_env.atoms);
+  const auto shell2bf   = chem_env.shells.shell2bf();
+  atom_aos_.resize(atom2shell.size());
+  for(size_t A = 0; A < atom2shell.size(); A++)
+    for(auto s: atom2shell[A])
+      for(size_t mu = 0; mu < chem_env.shells[s].size(); mu++)
+        atom_aos_[A].push_back(shell2bf[s] + mu);
+
+  const Matrix SC = S * C_o;
+  population_     = Matrix::Zero(atom_aos_.size(), nocc_);
+  for(size_t A = 0; A < atom_aos_.size(); A++)
+    for(int i = 0; i < nocc_; i++)
+      for(int mu: atom_aos_[A]) population_(A, i) += C_o(mu, i) * SC(mu, i);
+
+  e_pair_     = Matrix::Zero(nocc_, nocc_);
+  e_trunc_    = Matrix::Zero(nocc_, nocc_);
+  screened_   = Eigen::MatrixXi::Zero(nocc_, nocc_);
+  pair_index_ = Eigen::MatrixXi::Constant(nocc_, nocc_, -1);
+}
+
+void PNOSpaces::load_cholesky(ExecutionContext& ec, const TiledIndexSpace& MO,
+                              const TiledIndexSpace& CI, Tensor<double>& cholVpr) {
+  const int nQ = static_cast<int>(CI.max_num_indices());
+  const int q0 = static_cast<int64_t>(rank_) * nQ / nranks_;
+  const int q1 = static_cast<int64_t>(rank_ + 1) * nQ / nranks_;
+  const int nq = q1 - q0;
+
+  // MO tiles are ordered {occ_alpha, occ_beta, virt_alpha, virt_beta}
+  const Tile noat = MO("occ_alpha").num_tiles();
+  const Tile nvat = MO("virt_alpha").num_tiles();
+  const int  voff = MO.tile_offset(2 * noat);
+
+  std::vector<Tile> tiles;
+  for(Tile t = 0; t < noat; t++) tiles.push_back(t);
+  for(Tile t = 2 * noat; t < 2 * noat + nvat; t++) tiles.push_back(t);
+  auto index = [&](Tile t, size_t x) {
+    const int p = MO.tile_offset(t) + x;
+    return t < noat ? p : nocc_ + p - voff;
+  };
+
+  std::vector<Matrix> L(nq, Matrix::Zero(nocc_ + nvir_, nocc_ + nvir_));
+  for(Tile tq = 0; tq < CI.num_tiles(); tq++) {
+    const int qoff = CI.tile_offset(tq);
+    const int qdim = CI.tile_size(tq);
+    if(qoff + qdim <= q0 || qoff >= q1) continue;
+    for(Tile tx: tiles) {
+      for(Tile ty: tiles) {
+        // the occupied-virtual block is symmetric
+        if(tx >= noat && ty < noat) continue;
+        const IndexVector   blockid{tx, ty, tq};
+        const auto          dims = cholVpr.block_dims(blockid);
+        std::vector<double> buf(cholVpr.block_size(blockid));
+        cholVpr.get(blockid, buf);
+        for(size_t x = 0, c = 0; x < dims[0]; x++)
+          for(size_t y = 0; y < dims[1]; y++)
+            for(size_t q = 0; q < dims[2]; q++, c++) {
+              const int qq = qoff + q;
+              if(qq >= q0 && qq < q1) L[qq - q0](index(tx, x), index(ty, y)) = buf[c];
+            }
+      }
+    }
+  }
+
+  chol_.oo.resize(nq);
+  chol_.ov.resize(nq);
+  chol_.vv.resize(nq);
+  for(int q = 0; q < nq; q++) {
+    chol_.oo[q] = L[q].topLeftCorner(nocc_, nocc_);
+    chol_.ov[q] = L[q].topRightCorner(nocc_, nvir_) * P_;
+    chol_.vv[q] = P_.transpose() * L[q].bottomRightCorner(nvir_, nvir_) * P_;
+    L[q].resize(0, 0);
+  }
+}
+
+std::vector<int> PNOSpaces::domain_atoms(int i, double threshold) const {
+  std::vector<int> atoms;
+  int              amax = 0;
+  for(int A = 0; A < population_.rows(); A++) {
+    if(std::abs(population_(A, i)) > threshold) atoms.push_back(A);
+    if(std::abs(population_(A, i)) > std::abs(population_(amax, i))) amax = A;
+  }
+  if(atoms.empty()) atoms.push_back(amax);
+  return atoms;
+}
+
+std::vector<int> PNOSpaces::domain_paos(const std::vector<int>& atoms) const {
+  std::vector<int> pao;
+  for(int A: atoms) pao.insert(pao.end(), atom_aos_[A].begin(), atom_aos_[A].end());
+  std::sort(pao.begin(), pao.end());
+  return pao;
+}
+
+LocalSpace PNOSpaces::domain_space(const std::vector<int>& pao) const {
+  Matrix S(pao.size(), pao.size()), F(pao.size(), pao.size());
+  for(size_t m = 0; m < pao.size(); m++)
+    for(size_t n = 0; n < pao.size(); n++) {
+      S(m, n) = S_pao_(pao[m], pao[n]);
+      F(m, n) = F_pao_(pao[m], pao[n]);
+    }
+
+  Eigen::SelfAdjointEigenSolver<Matrix> eig_s(S);
+  std::vector<int>                      keep;
+  for(int m = 0; m < S.rows(); m++)
+    if(eig_s.eigenvalues()(m) > pao_lindep) keep.push_back(m);
+  Matrix X(pao.size(), keep.size());
+  for(size_t m = 0; m < keep.size(); m++)
+    X.col(m) = eig_s.eigenvectors().col(keep[m]) / std::sqrt(eig_s.eigenvalues()(keep[m]));
+
+  Eigen::SelfAdjointEigenSolver<Matrix> eig_f(X.transpose() * F * X);
+  LocalSpace                            space;
+  space.pao = pao;
+  space.C   = X * eig_f.eigenvectors();
+  space.eps.assign(eig_f.eigenvalues().data(), eig_f.eigenvalues().data() + X.cols());
+  return space;
+}
+
+Matrix PNOSpaces::overlap(const LocalSpace& a, const LocalSpace& b) const {
+  Matrix S(a.pao.size(), b.pao.size());
+  for(size_t n = 0; n < b.pao.size(); n++)
+    for(size_t m = 0; m < a.pao.size(); m++) S(m, n) = S_pao_(a.pao[m], b.pao[n]);
+  return a.C.transpose() * S * b.C;
+}
+
+LocalSpace PNOSpaces::make_pno(int i, int j, const LocalSpace& domain, const Matrix& K,
+                               double e_full, double& e_trunc) const {
+  const double f_ij = F_oo_(i, i) + F_oo_(j, j);
+  const int    nd   = domain.size();
+
+  Matrix T(nd, nd);
+  for(int a = 0; a < nd; a++)
+    for(int b = 0; b < nd; b++) T(a, b) = -K(a, b) / (domain.eps[a] + domain.eps[b] - f_ij);
+
+  const double fac = (i == j) ? 0.5 : 1.0;
+  const Matrix Tt  = fac * (4.0 * T - 2.0 * T.transpose());
+  const Matrix D   = Tt.transpose() * T + Tt * T.transpose();
+
+  Eigen::SelfAdjointEigenSolver<Matrix> eig_d(D);
+  // natural orbitals by decreasing occupation
+  const Matrix          no  = eig_d.eigenvectors().rowwise().reverse();
+  const Eigen::VectorXd occ = eig_d.eigenvalues().reverse();
+
+  // semicanonical PNOs and their pair energy for the first npno natural orbitals
+  const Matrix eps_d = Eigen::Map<const Eigen::VectorXd>(domain.eps.data(), nd).asDiagonal();
+  auto         semicanonical = [&](int npno, LocalSpace& pno) {
+    const Matrix                          Q = no.leftCols(npno);
+    Eigen::SelfAdjointEigenSolver<Matrix> eig_f(Q.transpose() * eps_d * Q);
+    const Matrix                          QU = Q * eig_f.eigenvectors();
+    pno.pao                                  = domain.pao;
+    pno.C                                    = domain.C * QU;
+    pno.eps.assign(eig_f.eigenvalues().data(), eig_f.eigenvalues().data() + npno);
+    return pair_energy(QU.transpose() * K * QU, pno.eps, f_ij, i == j);
+  };
+
+  int npno = 0;
+  while(npno < nd && occ(npno) > tcut_pno_) npno++;
+  npno = std::max(npno, 1);
+
+  LocalSpace pno;
+  double     e_pno = semicanonical(npno, pno);
+  // extend the PNO space until it recovers the fraction TCutEN of the pair energy
+  while(npno < nd && std::abs(e_pno) < tcut_en_ * std::abs(e_full) &&
+        (max_pnos_ <= 0 || npno < max_pnos_)) {
+    npno  = std::min(nd, npno + std::max(1, npno / 10));
+    e_pno = semicanonical(npno, pno);
+  }
+  if(max_pnos_ > 0 && npno > max_pnos_) e_pno = semicanonical(max_pnos_, pno);
+
+  e_trunc = e_full - e_pno;
+  return pno;
+}
+
+void PNOSpaces::pair_integrals(ExecutionContext& ec, const std::vector<std::pair<int, int>>& pairs,
+                               const std::vector<std::vector<int>>&               paos,
+                               const std::function<void(size_t, const Matrix&)>& process) const {
+  const int nq = chol_.ov.size();
+
+  // L_i^Q as columns, npao x nq for the PAOs of a pair
+  std::vector<Matrix> Lcols(nocc_, Matrix(nao_, nq));
+  for(int q = 0; q < nq; q++)
+    for(int i = 0; i < nocc_; i++) Lcols[i].col(q) = chol_.ov[q].row(i).transpose();
+
+  size_t next = 0;
+  while(next < pairs.size()) {
+    // every rank receives the pairs p of the batch with p % nranks == rank, in that order
+    size_t last  = next;
+    double words = 0;
+    while(last < pairs.size() && (last == next || words < max_batch_words)) {
+      words += static_cast<double>(paos[last].size()) * paos[last].size();
+      last++;
+    }
+
+    std::vector<int>    counts(nranks_, 0);
+    std::vector<size_t> order;
+    for(int r = 0; r < nranks_; r++)
+      for(size_t p = next; p < last; p++) {
+        if(static_cast<int>(p % nranks_) != r) continue;
+        order.push_back(p);
+        counts[r] += paos[p].size() * paos[p].size();
+      }
+
+    std::vector<double> buf(static_cast<size_t>(words));
+    size_t              off = 0;
+    for(size_t p: order) {
+      const auto [i, j] = pairs[p];
+      const Matrix                  K = select_rows(Lcols[i], paos[p]) *
+                       select_rows(Lcols[j], paos[p]).transpose();
+      Eigen::Map<Matrix>(buf.data() + off, K.rows(), K.cols()) = K;
+      off += K.size();
+    }
+
+    const auto sum = reduce_to_owners(ec, buf, counts);
+    off            = 0;
+    for(size_t p = next; p < last; p++) {
+      if(!owns(p)) continue;
+      const int n = paos[p].size();
+      process(p, Eigen::Map<const Matrix>(sum.data() + off, n, n));
+      off += static_cast<size_t>(n) * n;
+    }
+    next = last;
+  }
+}
+
+void PNOSpaces::build(ExecutionContext& ec) {
+  std::vector<std::vector<int>> atoms_pre(nocc_), atoms_ij(nocc_);
+  for(int i = 0; i < nocc_; i++) {
+    atoms_pre[i] = domain_atoms(i, tcut_dopre_);
+    atoms_ij[i]  = domain_atoms(i, tcut_doij_);
+  }
+
+  // semicanonical MP2 pair energies in the prescreening domains
+  std::vector<std::pair<int, int>> pairs;
+  std::vector<std::vector<int>>    paos;
+  for(int i = 0; i < nocc_; i++)
+    for(int j = i; j < nocc_; j++) {
+      pairs.push_back({i, j});
+      paos.push_back(domain_paos(merge(atoms_pre[i], atoms_pre[j])));
+    }
+
+  Matrix e_local = Matrix::Zero(nocc_, nocc_);
+  pair_integrals(ec, pairs, paos, [&](size_t p, const Matrix& K_pao) {
+    const auto [i, j]      = pairs[p];
+    const LocalSpace space = domain_space(paos[p]);
+    e_local(i, j) = pair_energy(space.C.transpose() * K_pao * space.C, space.eps,
+                                F_oo_(i, i) + F_oo_(j, j), i == j);
+  });
+  Matrix e_pre = Matrix::Zero(nocc_, nocc_);
+  ec.pg().allreduce(e_local.data(), e_pre.data(), e_pre.size(), ReduceOp::sum);
+
+  // pairs above TCutPre and all diagonal pairs in the TCutDOij domains, with the natural
+  // orbitals of the diagonal pairs for the TNOs
+  pairs.clear();
+  paos.clear();
+  for(int i = 0; i < nocc_; i++)
+    for(int j = i; j < nocc_; j++) {
+      if(i != j && std::abs(e_pre(i, j)) < tcut_pre_) {
+        screened_(i, j) = 1;
+        continue;
+      }
+      pairs.push_back({i, j});
+      paos.push_back(domain_paos(merge(atoms_ij[i], atoms_ij[j])));
+    }
+
+  std::map<size_t, LocalSpace> pno_local;
+  std::vector<LocalSpace>      diag_local(nocc_);
+  Matrix                       trunc_local = Matrix::Zero(nocc_, nocc_);
+  e_local.setZero();
+  pair_integrals(ec, pairs, paos, [&](size_t p, const Matrix& K_pao) {
+    const auto [i, j]      = pairs[p];
+    const LocalSpace space = domain_space(paos[p]);
+    const Matrix     K     = space.C.transpose() * K_pao * space.C;
+    e_local(i, j)          = pair_energy(K, space.eps, F_oo_(i, i) + F_oo_(j, j), i == j);
+
+    if(i == j) {
+      const int nd = space.size();
+      Matrix    T(nd, nd);
+      for(int a = 0; a < nd; a++)
+        for(int b = 0; b < nd; b++)
+          T(a, b) = -K(a, b) / (space.eps[a] + space.eps[b] - 2.0 * F_oo_(i, i));
+      const Matrix D = (2.0 * T - T.transpose()).transpose() * T +
+                       (2.0 * T - T.transpose()) * T.transpose();
+      Eigen::SelfAdjointEigenSolver<Matrix> eig_d(D);
+      // keep well below TCutTNO, the triples density averages three diagonal densities
+      int nno = 0;
+      for(int a = nd - 1; a >= 0 && eig_d.eigenvalues()(a) > 0.01 * tcut_tno_; a--) nno++;
+      diag_local[i].pao = space.pao;
+      diag_local[i].C   = space.C * eig_d.eigenvectors().rightCols(nno) *
+                        eig_d.eigenvalues().tail(nno).cwiseSqrt().asDiagonal();
+    }
+
+    double e_trunc;
+    pno_local[p]      = make_pno(i, j, space, K, e_local(i, j), e_trunc);
+    trunc_local(i, j) = e_trunc;
+  });
+  Matrix e_ref = Matrix::Zero(nocc_, nocc_);
+  ec.pg().allreduce(e_local.data(), e_ref.data(), e_ref.size(), ReduceOp::sum);
+  ec.pg().allreduce(trunc_local.data(), e_trunc_.data(), e_trunc_.size(), ReduceOp::sum);
+  e_pair_ = screened_.cast<double>().cwiseProduct(e_pre) + e_ref;
+
+  // strong pairs, at least keep_npairs of them with the largest pair energies
+  std::vector<size_t> sorted(pairs.size());
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::stable_sort(sorted.begin(), sorted.end(), [&](size_t p1, size_t p2) {
+    return std::abs(e_ref(pairs[p1].first, pairs[p1].second)) >
+           std::abs(e_ref(pairs[p2].first, pairs[p2].second));
+  });
+  std::vector<bool> strong(pairs.size(), false);
+  for(size_t s = 0; s < sorted.size(); s++) {
+    const auto [i, j] = pairs[sorted[s]];
+    strong[sorted[s]] = i == j || s < keep_npairs_ || std::abs(e_ref(i, j)) >= tcut_pairs_;
+  }
+  for(size_t p = 0; p < pairs.size(); p++) {
+    const auto [i, j] = pairs[p];
+    if(!strong[p]) {
+      e_trunc_(i, j) = 0.0;
+      continue;
+    }
+    pair_index_(i, j) = pair_index_(j, i) = strong_pairs_.size();
+    strong_pairs_.push_back(pairs[p]);
+  }
+
+  // replicate the PNOs of the strong pairs and the diagonal natural orbitals, packed {C, eps}
+  const size_t        nstrong = strong_pairs_.size();
+  std::vector<double> dims_local(nstrong + nocc_, 0.0), dims(nstrong + nocc_);
+  for(size_t p = 0; p < pairs.size(); p++) {
+    if(!strong[p] || !owns(p)) continue;
+    const auto [i, j]                        = pairs[p];
+    dims_local[pair_index_(i, j)]            = pno_local[p].size();
+    if(i == j) dims_local[nstrong + i] = diag_local[i].size();
+  }
+  ec.pg().allreduce(dims_local.data(), dims.data(), dims.size(), ReduceOp::sum);
+
+  std::vector<std::vector<int>> paos_strong(nstrong);
+  std::vector<size_t>           offset(nstrong + nocc_);
+  size_t                        ntotal = 0;
+  for(size_t p = 0, s = 0; p < pairs.size(); p++) {
+    if(!strong[p]) continue;
+    paos_strong[s] = paos[p];
+    offset[s]      = ntotal;
+    ntotal += paos[p].size() * dims[s] + dims[s];
+    s++;
+  }
+  for(int i = 0; i < nocc_; i++) {
+    offset[nstrong + i] = ntotal;
+    ntotal += paos_strong[pair_index_(i, i)].size() * dims[nstrong + i];
+  }
+
+  std::vector<double> buf_local(ntotal, 0.0), buf(ntotal);
+  for(size_t p = 0; p < pairs.size(); p++) {
+    if(!strong[p] || !owns(p)) continue;
+    const auto [i, j]     = pairs[p];
+    const LocalSpace& pno = pno_local[p];
+    auto out = buf_local.begin() + offset[pair_index_(i, j)];
+    Eigen::Map<Matrix>(&*out, pno.C.rows(), pno.C.cols()) = pno.C;
+    std::copy(pno.eps.begin(), pno.eps.end(), out + pno.C.size());
+    if(i == j)
+      Eigen::Map<Matrix>(buf_local.data() + offset[nstrong + i], diag_local[i].C.rows(),
+                         diag_local[i].C.cols()) = diag_local[i].C;
+  }
+  ec.pg().allreduce(buf_local.data(), buf.data(), ntotal, ReduceOp::sum);
+
+  pnos_.resize(nstrong);
+  for(size_t s = 0; s < nstrong; s++) {
+    const int npao = paos_strong[s].size();
+    const int npno = dims[s];
+    pnos_[s].pao   = paos_strong[s];
+    pnos_[s].C     = Eigen::Map<const Matrix>(buf.data() + offset[s], npao, npno);
+    pnos_[s].eps.assign(buf.begin() + offset[s] + npao * npno,
+                        buf.begin() + offset[s] + (npao + 1) * npno);
+  }
+  diag_no_.resize(nocc_);
+  for(int i = 0; i < nocc_; i++) {
+    diag_no_[i].pao = pnos_[pair_index_(i, i)].pao;
+    diag_no_[i].C   = Eigen::Map<const Matrix>(buf.data() + offset[nstrong + i],
+                                               diag_no_[i].pao.size(), dims[nstrong + i]);
+  }
+
+  singles_.resize(nocc_);
+  for(int i = 0; i < nocc_; i++) singles_[i] = domain_space(domain_paos(domain_atoms(i, tcut_do_)));
+}
+
+double PNOSpaces::weak_pair_energy() const {
+  double e = 0.0;
+  for(int i = 0; i < nocc_; i++)
+    for(int j = i; j < nocc_; j++)
+      if(!is_strong(i, j)) e += e_pair_(i, j);
+  return e;
+}
+
+double PNOSpaces::truncation_correction() const { return e_trunc_.sum(); }
+
+double PNOSpaces::scmp2_energy() const { return e_pair_.sum(); }
+
+void PNOSpaces::print_summary(ExecutionContext& ec, ChemEnv& chem_env) const {
+  if(ec.pg().rank() != 0) return;
+
+  const int nstrong   = strong_pairs_.size();
+  const int npairs    = nocc_ * (nocc_ + 1) / 2;
+  const int nscreened = screened_.sum();
+  double    npno = 0, npao = 0, nsingles = 0;
+  int       max_pno = 0;
+  for(int p = 0; p < nstrong; p++) {
+    npno += pnos_[p].size();
+    npao += pnos_[p].pao.size();
+    max_pno = std::max(max_pno, pnos_[p].size());
+  }
+  for(int i = 0; i < nocc_; i++) nsingles += singles_[i].size();
+
+  std::cout << std::endl << "Pair prescreening (semicanonical MP2)" << std::endl;
+  std::cout << std::fixed << std::setprecision(10);
+  std::cout << " - number of pairs (i <= j)        = " << npairs << std::endl;
+  std::cout << " - pairs below TCutPre             = " << nscreened << std::endl;
+  std::cout << " - strong pairs                    = " << nstrong << std::endl;
+  std::cout << " - weak pairs                      = " << npairs - nstrong << std::endl;
+  std::cout << " - semicanonical MP2 energy        = " << scmp2_energy() << std::endl;
+  std::cout << " - weak pair energy                = " << weak_pair_energy() << std::endl;
+  std::cout << " - PNO truncation correction       = " << truncation_correction() << std::endl;
+  std::cout << std::setprecision(1);
+  std::cout << " - average PAOs per pair domain    = " << (nstrong > 0 ? npao / nstrong : 0.0)
+            << " (of " << nao_ << ")" << std::endl;
+  std::cout << " - average/maximum PNOs per pair   = " << (nstrong > 0 ? npno / nstrong : 0.0)
+            << " / " << max_pno << " (of " << nvir_ << " virtuals)" << std::endl;
+  std::cout << " - average singles domain          = " << nsingles / nocc_ << std::endl;
+  std::cout << std::defaultfloat;
+
+  auto& jpairs                       = chem_env.sys_data.results["output"]["DLPNO-CCSD"];
+  jpairs["pairs"]["total"]           = npairs;
+  jpairs["pairs"]["prescreened"]     = nscreened;
+  jpairs["pairs"]["strong"]          = nstrong;
+  jpairs["pairs"]["weak"]            = npairs - nstrong;
+  jpairs["pno"]["average"]           = nstrong > 0 ? npno / nstrong : 0.0;
+  jpairs["pno"]["max"]               = max_pno;
+  jpairs["pno"]["average_paos"]      = nstrong > 0 ? npao / nstrong : 0.0;
+  jpairs["energy"]["scmp2"]          = scmp2_energy();
+  jpairs["energy"]["weak_pairs"]     = weak_pair_energy();
+  jpairs["energy"]["pno_truncation"] = truncation_correction();
+}
+
+} // namespace exachem::cc::dlpno
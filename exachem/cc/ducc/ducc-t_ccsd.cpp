@@ -8,6 +8,7 @@
 
 #include "cc/ccsd/cd_ccsd_os_ann.hpp"
 #include "cholesky/v2tensors.hpp"
+#include "common/memory_plan.hpp"
 #include <tamm/op_executor.hpp>
 
 using namespace tamm;
@@ -587,6 +588,19 @@ void DUCC_T_CCSD_Driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledInde
   Tensor<T> vtijab{{O, O, Vi, Vi}, {2, 2}};
   Tensor<T> vtiabc{{O, Vi, Vi, Vi}, {2, 2}};
   Tensor<T> vtabcd{{Vi, Vi, Vi, Vi}, {2, 2}};
+
+  MemoryPlan ducc_plan{ec, "DUCC", chem_env.ioptions.common_options.memory_overhead};
+  ducc_plan.allocate("amplitudes and fock", t1, t2, f1);
+  ducc_plan.allocate("transformed hamiltonian (occupied)", ftij, vtijkl);
+  if(nactv > 0) {
+    ducc_plan.allocate("transformed hamiltonian (active virtual)", ftia, ftab, vtijka, vtaijb,
+                       vtijab, vtiabc, vtabcd);
+  }
+  // the blocks are written one at a time from a dense copy, the largest one is the peak
+  ducc_plan.allocate("dense copy for writing", nactv > 0 ? vtabcd : vtijkl);
+  ducc_plan.check(ec, "the DUCC transformation");
+  ducc_plan.deallocate("dense copy for writing");
+
   sch.allocate(ftij, vtijkl).execute();
   if(nactv > 0) { sch.allocate(ftia, ftab, vtijka, vtaijb, vtijab, vtiabc, vtabcd).execute(); }
 
@@ -886,6 +900,8 @@ void DUCC_T_CCSD_Driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledInde
   free_tensors(ftij, vtijkl);
   if(nactv > 0) { free_tensors(ftia, ftab, vtijka, vtaijb, vtijab, vtiabc, vtabcd); }
 
+  ducc_plan.validate(ec, chem_env.telemetry);
+
   if(rank == 0) chem_env.write_json_data("DUCC");
 }
 
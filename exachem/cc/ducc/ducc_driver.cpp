@@ -51,7 +51,7 @@ void ducc_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   // TODO: Implement check for UHF
   if(nactv > sys_data.n_vir_alpha && is_rhf) tamm_terminate("[DUCC ERROR]: nactive > n_vir_alpha");
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env, false, nactv);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env, false, nactv);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -94,7 +94,7 @@ void ducc_driver(ExecutionContext& ec, ChemEnv& chem_env) {
       read_from_disk(d_t1, t1file);
       read_from_disk(d_t2, t2file);
     }
-    read_from_disk(cholVpr, v2file);
+    exachem::cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
     p_evl_sorted = tamm::diagonal(d_f1);
   }
@@ -104,7 +104,7 @@ void ducc_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    exachem::cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -205,7 +205,7 @@ void ducc_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     v2tensors.read_from_disk(files_prefix);
   }
 
-  free_tensors(cholVpr);
+  exachem::cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
   DUCC_T_CCSD_Driver<T>(chem_env, ec, MO, d_t1, d_t2, d_f1, v2tensors, nactv, ex_hw);
 
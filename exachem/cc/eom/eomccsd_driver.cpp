@@ -34,7 +34,7 @@ void exachem::cc::eom::eom_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env)
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -78,7 +78,7 @@ void exachem::cc::eom::eom_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env)
       read_from_disk(d_t1, t1file);
       read_from_disk(d_t2, t2file);
     }
-    read_from_disk(cholVpr, v2file);
+    cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
     p_evl_sorted = tamm::diagonal(d_f1);
   }
@@ -88,7 +88,7 @@ void exachem::cc::eom::eom_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env)
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -177,8 +177,12 @@ void exachem::cc::eom::eom_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env)
     free_vec_tensors(d_r1s, d_r2s, d_t1s, d_t2s);
   }
 
+  // With eom_cholesky only the blocks up to two virtual indices are stored, the iabc and abcd
+  // blocks are assembled from cholVpr when they are used.
+  const bool                eom_cholesky = ccsd_options.eom_cholesky;
   cholesky_2e::V2Tensors<T> v2tensors;
-  if(computeTData && !v2tensors.exist_on_disk(files_prefix)) {
+  if(eom_cholesky) v2tensors = cholesky_2e::setupV2TensorsCD<T>(ec, cholVpr, ec.exhw());
+  else if(computeTData && !v2tensors.exist_on_disk(files_prefix)) {
     v2tensors = cholesky_2e::setupV2Tensors<T>(ec, cholVpr, ec.exhw());
     if(ccsd_options.writet) { v2tensors.write_to_disk(files_prefix); }
   }
@@ -187,7 +191,7 @@ void exachem::cc::eom::eom_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env)
     v2tensors.read_from_disk(files_prefix);
   }
 
-  free_tensors(cholVpr);
+  if(!eom_cholesky) cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
   if(ccsd_options.eom_nroots <= 0) tamm_terminate("EOMCCSD: nroots should be greater than 1");
 
@@ -209,6 +213,7 @@ void exachem::cc::eom::eom_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env)
   }
 
   v2tensors.deallocate();
+  if(eom_cholesky) cholesky_2e::free_chol_vectors(chem_env, cholVpr);
   free_tensors(d_t1, d_t2, d_f1);
 
   ec.flush_and_sync();
@@ -270,6 +270,25 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
   int        microeomiter = ccsd_options.eom_microiter; // Number of iterations in a microcycle
   const bool profile      = ccsd_options.profile_ccsd;
 
+  // Targeted solve: the roots kept in the subspace and converged are the ones closest to
+  // eom_target_energy, or with the largest singles weight on eom_target_orbitals, instead of the
+  // lowest ones.
+  const std::string eom_target    = ccsd_options.eom_target;
+  const bool        targeted      = (eom_target != "lowest");
+  const bool        target_orbs   = (eom_target == "orbitals");
+  const T           target_energy = ccsd_options.eom_target_energy;
+  std::vector<bool> target_occ;
+  if(target_orbs) {
+    target_occ.assign(n_occ_alpha + n_occ_beta, false);
+    for(auto orb: ccsd_options.eom_target_orbitals) {
+      if(orb < 1 || orb > static_cast<int>(std::max(n_occ_alpha, n_occ_beta)))
+        tamm_terminate("EOMCCSD: eom_target_orbitals must be between 1 and the number of "
+                       "correlated occupied orbitals");
+      if(orb <= static_cast<int>(n_occ_alpha)) target_occ[orb - 1] = true;
+      if(orb <= static_cast<int>(n_occ_beta)) target_occ[n_occ_alpha + orb - 1] = true;
+    }
+  }
+
   const TiledIndexSpace& O = MO("occ");
   const TiledIndexSpace& V = MO("virt");
 
@@ -303,6 +322,8 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
   TiledIndexSpace hbar_tis = {IndexSpace{range(0, hbardim)}};
   Matrix          hbar     = Matrix::Zero(hbardim, hbardim);
   Matrix          hbar_right;
+  // singles weight on the target orbitals, <x1_i|P|x1_j>
+  Matrix wtarget = Matrix::Zero(hbardim, hbardim);
 
   Tensor<T> u1{{V, O}, {1, 1}};
   Tensor<T> u2{{V, V, O, O}, {2, 2}};
@@ -328,6 +349,8 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
   populate_vector_of_tensors(r1);
   vector<Tensor<T>> r2(nroots);
   populate_vector_of_tensors(r2, false);
+  vector<Tensor<T>> px1(target_orbs ? hbardim : 0);
+  populate_vector_of_tensors(px1);
 
   Tensor<T> d_r1{};
   Tensor<T> oscalar{};
@@ -341,7 +364,13 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
   //################################################################################
   auto cc_t1 = std::chrono::high_resolution_clock::now();
 
-  eom_guess_opt(ec, MO, hbar_tis, nroots, n_occ_alpha, n_occ_beta, p_evl_sorted, x1);
+  if(ccsd_options.eom_guess == "cis")
+    eom_guess_cis(ec, MO, nroots, n_occ_alpha, n_occ_beta, p_evl_sorted, f1, v2tensors, x1,
+                  eom_target, target_energy, target_occ);
+  else if(targeted)
+    eom_guess_target(nroots, n_occ_alpha, n_occ_beta, p_evl_sorted, x1,
+                     target_orbs ? T{0} : target_energy, target_occ);
+  else eom_guess_opt(ec, MO, hbar_tis, nroots, n_occ_alpha, n_occ_beta, p_evl_sorted, x1);
 
   auto cc_t2 = std::chrono::high_resolution_clock::now();
 
@@ -483,6 +512,11 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
   if(mrank) {
     std::cout << std::endl << std::endl;
     std::cout << " No. of initial right vectors " << ninitvecs << std::endl;
+    if(eom_target == "energy")
+      std::cout << " Targeting the roots closest to " << target_energy << " hartree" << std::endl;
+    else if(target_orbs)
+      std::cout << " Targeting the roots with the largest singles weight on the target orbitals"
+                << std::endl;
     std::cout << std::endl;
     std::cout << " EOM-CCSD right-hand side iterations" << std::endl;
     std::cout << std::string(75, '-') << std::endl;
@@ -515,8 +549,20 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
                    x1tensors);
         eomccsd_x2(sch, MO, xp2.at(root), t1, t2, x1.at(root), x2.at(root), f1, v2tensors,
                    x2tensors);
+        if(target_orbs) sch(px1.at(root)() = x1.at(root)());
       }
       sch.execute(exhw);
+      if(target_orbs) {
+        for(int root = nxtrials; root < newnxtrials; root++)
+          eom_project_occ(ec, px1.at(root), target_occ);
+        for(int jvec = nxtrials; jvec < newnxtrials; jvec++) {
+          for(int ivec = 0; ivec < newnxtrials; ivec++) {
+            sch(d_r1() = px1.at(jvec)() * px1.at(ivec)()).execute();
+            wtarget(ivec, jvec) = get_scalar(d_r1);
+            wtarget(jvec, ivec) = wtarget(ivec, jvec);
+          }
+        }
+      }
 
       if(mrank && profile) {
         cc_t2 = std::chrono::high_resolution_clock::now();
@@ -603,6 +649,25 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
       for(auto x = 0; x < nev; x++)
         hbar_right.col(x) = hbar_right1.col(omegar_sorted_order[x]).real();
 
+      if(targeted) {
+        // move the targeted roots to the front
+        std::vector<T> rank_key(nev);
+        for(auto x = 0; x < nev; x++) {
+          if(target_orbs) {
+            const Eigen::VectorXd y = hbar_right.col(x);
+            rank_key[x] = -y.dot(wtarget.topLeftCorner(nev, nev) * y) / y.squaredNorm();
+          }
+          else rank_key[x] = std::abs(omegar[x] - target_energy);
+        }
+        std::vector<size_t> target_order = sort_indexes(rank_key);
+        std::vector<T>      omegar_sorted(omegar);
+        Matrix              hbar_right_sorted(hbar_right);
+        for(auto x = 0; x < nev; x++) {
+          omegar[x]         = omegar_sorted[target_order[x]];
+          hbar_right.col(x) = hbar_right_sorted.col(target_order[x]);
+        }
+      }
+
       if(mrank && profile) {
         cc_t2 = std::chrono::high_resolution_clock::now();
         time  = std::chrono::duration_cast<std::chrono::duration<double>>((cc_t2 - cc_t1)).count();
@@ -655,8 +720,12 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
 
           if(newnxtrials <= hbardim) {
             // If we can overwrite r1 and r2 here we can replace x1.at(ivec) in the next few lines
-            jacobi(ec, r1.at(root), x1.at(ivec), 0.0, false, p_evl_sorted, n_occ_alpha, n_occ_beta);
-            jacobi(ec, r2.at(root), x2.at(ivec), 0.0, false, p_evl_sorted, n_occ_alpha, n_occ_beta);
+            // a targeted solve preconditions with (omega - D)^-1 around the root it converges
+            const T shift = targeted ? omegar[root] : 0.0;
+            jacobi(ec, r1.at(root), x1.at(ivec), shift, false, p_evl_sorted, n_occ_alpha,
+                   n_occ_beta);
+            jacobi(ec, r2.at(root), x2.at(ivec), shift, false, p_evl_sorted, n_occ_alpha,
+                   n_occ_beta);
 
             scale_ip(x1.at(ivec), newsc);
             scale_ip(x2.at(ivec), newsc);
@@ -769,7 +838,7 @@ void right_eomccsd_driver(ChemEnv& chem_env, ExecutionContext& ec, const TiledIn
   x2tensors.deallocate();
 
   Tensor<T>::deallocate(u1, u2, uu2, uuu2, d_r1, oscalar);
-  free_vec_tensors(x1, x2, xp1, xp2, xc1, xc2, r1, r2);
+  free_vec_tensors(x1, x2, xp1, xp2, xc1, xc2, r1, r2, px1);
 }
 
 using T = double;
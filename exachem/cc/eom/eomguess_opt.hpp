@@ -11,6 +11,7 @@
 #include "cc/ccsd/cd_ccsd_os_ann.hpp"
 #include <algorithm>
 #include <complex>
+#include <numeric>
 using namespace tamm;
 
 template<typename T>
@@ -94,3 +95,234 @@ void eom_guess_opt(ExecutionContext& ec, const TiledIndexSpace& MO, TiledIndexSp
   //      second loop to search all values of DIFF. Instead, for each pair {a,i} in the minlist,
   //      create the initial guess vector x1.
 }
+
+// Koopmans guess for a targeted solve: unit vectors on the nroots same-spin orbital-energy
+// differences closest to target_energy. If target_occ is not empty, only excitations out of the
+// occupied spin-orbitals flagged in it are considered.
+template<typename T>
+void eom_guess_target(int nroots, const TAMM_SIZE n_occ_alpha, const TAMM_SIZE n_occ_beta,
+                      std::vector<T>& p_evl_sorted, std::vector<Tensor<T>>& x1, T target_energy,
+                      const std::vector<bool>& target_occ) {
+  const TAMM_SIZE nbf         = static_cast<TAMM_SIZE>(p_evl_sorted.size() / 2);
+  const TAMM_SIZE noab        = n_occ_alpha + n_occ_beta;
+  const TAMM_SIZE n_vir_alpha = nbf - n_occ_alpha;
+  const TAMM_SIZE nvab        = p_evl_sorted.size() - noab;
+
+  std::vector<std::pair<size_t, size_t>> pairs; // (virt, occ)
+  std::vector<T>                         dist;
+  for(TAMM_SIZE x = 0; x < noab; x++) {
+    if(!target_occ.empty() && !target_occ[x]) continue;
+    const bool      alpha = (x < n_occ_alpha);
+    const TAMM_SIZE ylo   = alpha ? 0 : n_vir_alpha;
+    const TAMM_SIZE yhi   = alpha ? n_vir_alpha : nvab;
+    for(TAMM_SIZE y = ylo; y < yhi; y++) {
+      pairs.push_back({y, x});
+      dist.push_back(std::abs(p_evl_sorted[noab + y] - p_evl_sorted[x] - target_energy));
+    }
+  }
+
+  if(pairs.size() < static_cast<size_t>(nroots))
+    tamm_terminate("EOMCCSD: fewer target excitations than eom_nroots");
+
+  std::vector<size_t> order(pairs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return dist[a] < dist[b]; });
+
+  for(int root = 0; root < nroots; root++) {
+    const auto [y, x] = pairs[order[root]];
+    update_tensor_val(x1.at(root), {{y, x}}, 1.0);
+  }
+}
+
+// Zeroes the columns of a (V,O) tensor that belong to occupied spin-orbitals not flagged in
+// target_occ.
+template<typename T>
+void eom_project_occ(ExecutionContext& ec, Tensor<T>& x, const std::vector<bool>& target_occ) {
+  block_for(ec, x(), [&](IndexVector blockid) {
+    if(!x.is_non_zero(blockid)) return;
+    std::vector<T> buf(x.block_size(blockid));
+    x.get(blockid, buf);
+    const auto dims = x.block_dims(blockid);
+    const auto joff = x.tiled_index_spaces()[1].tile_offset(blockid[1]);
+    for(size_t i = 0, c = 0; i < dims[0]; i++)
+      for(size_t j = 0; j < dims[1]; j++, c++)
+        if(!target_occ[joff + j]) buf[c] = 0;
+    x.put(blockid, buf);
+  });
+}
+
+// nroots CIS states from a Davidson solver over singles only. The CIS sigma
+//   s(a,i) = f(a,b) x(b,i) - f(j,i) x(a,j) - <ja||ib> x(b,j)
+// uses the f1 and v2iajb blocks already held for EOM-CCSD and costs a small fraction of an
+// EOM-CCSD sigma, which is dominated by the doubles. The converged CIS vectors are returned in
+// x1[0..nroots). With target = lowest these are the lowest states, started from the Koopmans
+// vectors of eom_guess_opt. With target = energy or orbitals the iterations start from
+// eom_guess_target and keep the Ritz vectors closest to target_energy, or with the largest
+// weight on the occupied spin-orbitals flagged in target_occ, as the EOM-CCSD solver does.
+template<typename T>
+void eom_guess_cis(ExecutionContext& ec, const TiledIndexSpace& MO, int nroots,
+                   const TAMM_SIZE n_occ_alpha, const TAMM_SIZE n_occ_beta,
+                   std::vector<T>& p_evl_sorted, Tensor<T>& f1,
+                   exachem::cholesky_2e::V2Tensors<T>& v2tensors, std::vector<Tensor<T>>& x1,
+                   const std::string& target = "lowest", const T target_energy = 0,
+                   const std::vector<bool>& target_occ = {}, const int maxiter = 50,
+                   const T thresh = 1e-4) {
+  const TiledIndexSpace& O = MO("occ");
+  const TiledIndexSpace& V = MO("virt");
+  auto [h1, h2]            = O.labels<2>("all");
+  auto [p1, p2]            = V.labels<2>("all");
+
+  const bool  mrank = (ec.pg().rank() == 0);
+  ExecutionHW exhw  = ec.exhw();
+  Scheduler   sch{ec};
+
+  // subspace vectors b and their sigma vectors s
+  const int              maxsub = std::max(4 * nroots, nroots + 8);
+  std::vector<Tensor<T>> b(maxsub), s(maxsub);
+  for(int k = 0; k < maxsub; k++) {
+    b[k] = Tensor<T>{{V, O}, {1, 1}};
+    s[k] = Tensor<T>{{V, O}, {1, 1}};
+    sch.allocate(b[k], s[k])(b[k]() = 0);
+  }
+  Tensor<T> r{{V, O}, {1, 1}};
+  Tensor<T> d_r1{};
+  sch.allocate(r, d_r1).execute();
+
+  const bool targeted    = (target != "lowest");
+  const bool target_orbs = (target == "orbitals");
+  if(targeted)
+    eom_guess_target(nroots, n_occ_alpha, n_occ_beta, p_evl_sorted, b,
+                     target_orbs ? T{0} : target_energy, target_occ);
+  else {
+    TiledIndexSpace guess_tis{IndexSpace{range(0, maxsub)}};
+    eom_guess_opt(ec, MO, guess_tis, nroots, n_occ_alpha, n_occ_beta, p_evl_sorted, b);
+  }
+
+  auto dot = [&](Tensor<T>& a, Tensor<T>& c) {
+    sch(d_r1() = a() * c()).execute();
+    return get_scalar(d_r1);
+  };
+
+  Matrix         G = Matrix::Zero(maxsub, maxsub);
+  Matrix         W = Matrix::Zero(maxsub, maxsub); // <b_i|P|b_j>, P projects on target_occ
+  Matrix         Y;
+  std::vector<T> theta(nroots);
+  int            nb   = nroots; // vectors in the subspace
+  int            nsig = 0;      // vectors with a sigma
+  bool           conv = false;
+
+  if(mrank) std::cout << std::endl << "CIS guess for EOM-CCSD" << std::endl;
+
+  for(int iter = 0; iter < maxiter && !conv; iter++) {
+    for(int k = nsig; k < nb; k++) {
+      // clang-format off
+      sch
+        (s[k](p2,h1)  =        f1(p2,p1)                   * b[k](p1,h1))
+        (s[k](p2,h1) += -1.0 * f1(h2,h1)                   * b[k](p2,h2))
+        (s[k](p2,h1) += -1.0 * v2tensors.v2iajb(h2,p2,h1,p1) * b[k](p1,h2));
+      // clang-format on
+    }
+    sch.execute(exhw);
+
+    for(int j = nsig; j < nb; j++) {
+      for(int i = 0; i < nb; i++) {
+        G(i, j) = dot(b[i], s[j]);
+        G(j, i) = G(i, j);
+      }
+      if(target_orbs) {
+        sch(r() = b[j]()).execute();
+        eom_project_occ(ec, r, target_occ);
+        for(int i = 0; i < nb; i++) {
+          W(i, j) = dot(b[i], r);
+          W(j, i) = W(i, j);
+        }
+      }
+    }
+    nsig = nb;
+
+    // the lowest Ritz vectors, or the targeted ones first
+    Eigen::SelfAdjointEigenSolver<Matrix> es(G.topLeftCorner(nb, nb));
+    std::vector<int>                      sel(nb);
+    std::iota(sel.begin(), sel.end(), 0);
+    if(targeted) {
+      std::vector<T> key(nb);
+      for(int x = 0; x < nb; x++) {
+        const Eigen::VectorXd y = es.eigenvectors().col(x);
+        key[x] = target_orbs ? -y.dot(W.topLeftCorner(nb, nb) * y)
+                             : std::abs(es.eigenvalues()(x) - target_energy);
+      }
+      std::stable_sort(sel.begin(), sel.end(), [&](int a, int c) { return key[a] < key[c]; });
+    }
+    Y.resize(nb, nroots);
+    for(int root = 0; root < nroots; root++) {
+      Y.col(root) = es.eigenvectors().col(sel[root]);
+      theta[root] = es.eigenvalues()(sel[root]);
+    }
+
+    // residuals, preconditioned with (theta - (e_a - e_i))^-1, become the new directions
+    T    max_res = 0;
+    bool collapse = (nb + nroots > maxsub);
+    for(int root = 0; root < nroots; root++) {
+      sch(r() = 0);
+      for(int i = 0; i < nb; i++) {
+        sch(r() += Y(i, root) * s[i]())(r() += -theta[root] * Y(i, root) * b[i]());
+      }
+      sch.execute(exhw);
+      const T res = norm(r);
+      max_res     = std::max(max_res, res);
+      if(res < thresh || collapse) continue;
+
+      sch(b[nb]() = 0).execute();
+      jacobi(ec, r, b[nb], theta[root], false, p_evl_sorted, n_occ_alpha, n_occ_beta);
+      for(int pass = 0; pass < 2; pass++) {
+        for(int j = 0; j < nb; j++) {
+          const T ov = dot(b[nb], b[j]);
+          sch(b[nb]() += -ov * b[j]()).execute();
+        }
+      }
+      const T bnorm = norm(b[nb]);
+      if(bnorm < 1e-8) continue;
+      scale_ip(b[nb], 1.0 / bnorm);
+      nb++;
+    }
+
+    if(mrank)
+      std::cout << " CIS iteration " << iter + 1 << ": subspace = " << nsig
+                << ", max residual = " << std::scientific << max_res << std::defaultfloat
+                << std::endl;
+
+    conv = (max_res < thresh) || (nb == nsig && !collapse);
+    if(!conv && collapse) {
+      // restart from the current Ritz vectors, their sigmas are rebuilt in the next iteration
+      for(int root = 0; root < nroots; root++) {
+        sch(x1[root]() = 0);
+        for(int i = 0; i < nb; i++) sch(x1[root]() += Y(i, root) * b[i]());
+      }
+      sch.execute(exhw);
+      for(int root = 0; root < nroots; root++) sch(b[root]() = x1[root]());
+      sch.execute(exhw);
+      G.setZero();
+      W.setZero();
+      Y    = Matrix::Identity(nroots, nroots);
+      nb   = nroots;
+      nsig = 0;
+    }
+  }
+
+  for(int root = 0; root < nroots; root++) {
+    sch(x1[root]() = 0);
+    for(int i = 0; i < Y.rows(); i++) sch(x1[root]() += Y(i, root) * b[i]());
+  }
+  sch.execute(exhw);
+
+  if(mrank) {
+    if(!conv) std::cout << " CIS guess did not converge, using the current vectors" << std::endl;
+    for(int root = 0; root < nroots; root++)
+      std::cout << " CIS root " << root + 1 << ": " << std::fixed << std::setprecision(8)
+                << theta[root] << " hartree" << std::defaultfloat << std::endl;
+  }
+
+  Tensor<T>::deallocate(r, d_r1);
+  free_vec_tensors(b, s);
+}
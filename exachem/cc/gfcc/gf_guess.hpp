@@ -12,11 +12,12 @@
 #include <complex>
 using namespace tamm;
 
+// Guess for a general right-hand side b (length nocc): x1 = M^-1 b
 template<typename T>
 void gf_guess_ip(ExecutionContext& ec, const TiledIndexSpace& MO, const TAMM_SIZE nocc,
-                 double omega, double gf_eta, int pi, std::vector<T>& p_evl_sorted_occ,
-                 Tensor<T>& t2v2_o, Tensor<std::complex<T>>& x1, Tensor<std::complex<T>>& Minv,
-                 bool opt = false) {
+                 double omega, double gf_eta, const std::vector<T>& rhs,
+                 std::vector<T>& p_evl_sorted_occ, Tensor<T>& t2v2_o, Tensor<std::complex<T>>& x1,
+                 Tensor<std::complex<T>>& Minv, bool opt = false) {
   using ComplexTensor = Tensor<std::complex<T>>;
 
   const TiledIndexSpace& O = MO("occ");
@@ -44,21 +45,38 @@ void gf_guess_ip(ExecutionContext& ec, const TiledIndexSpace& MO, const TAMM_SIZ
 
   CMatrix guessMI = guessM_eig.inverse();
 
+  std::vector<std::complex<T>> x1v(nocc, 0);
+  for(TAMM_SIZE i = 0; i < nocc; i++)
+    for(TAMM_SIZE j = 0; j < nocc; j++) {
+      if(rhs[j] != 0) x1v[i] += guessMI(i, j) * rhs[j];
+    }
+
   if(opt) {
     Eigen::Tensor<std::complex<T>, 1, Eigen::RowMajor> x1e(nocc);
-    for(TAMM_SIZE i = 0; i < nocc; i++) x1e(i) = guessMI(i, pi);
+    for(TAMM_SIZE i = 0; i < nocc; i++) x1e(i) = x1v[i];
 
     eigen_to_tamm_tensor(x1, x1e);
   }
   else {
     Eigen::Tensor<std::complex<T>, 2, Eigen::RowMajor> x1e(nocc, 1);
-    for(TAMM_SIZE i = 0; i < nocc; i++) x1e(i, 0) = guessMI(i, pi);
+    for(TAMM_SIZE i = 0; i < nocc; i++) x1e(i, 0) = x1v[i];
 
     eigen_to_tamm_tensor(x1, x1e);
   }
   eigen_to_tamm_tensor(Minv, guessMI);
 }
 
+// Guess for the unit right-hand side e_pi
+template<typename T>
+void gf_guess_ip(ExecutionContext& ec, const TiledIndexSpace& MO, const TAMM_SIZE nocc,
+                 double omega, double gf_eta, int pi, std::vector<T>& p_evl_sorted_occ,
+                 Tensor<T>& t2v2_o, Tensor<std::complex<T>>& x1, Tensor<std::complex<T>>& Minv,
+                 bool opt = false) {
+  std::vector<T> rhs(nocc, 0);
+  rhs[pi] = 1.0;
+  gf_guess_ip(ec, MO, nocc, omega, gf_eta, rhs, p_evl_sorted_occ, t2v2_o, x1, Minv, opt);
+}
+
 template<typename T>
 void gf_guess_ea(ExecutionContext& ec, const TiledIndexSpace& MO, const TAMM_SIZE nvir,
                  double omega, double gf_eta, int pi, std::vector<T>& p_evl_sorted_vir,
@@ -8,11 +8,14 @@
 
 #include "cc/lambda/ccsd_lambda.hpp"
 #include "cholesky/cholesky_2e_driver.hpp"
+#include "common/memory_plan.hpp"
 #include "gf_diis.hpp"
 #include "gf_guess.hpp"
 #include "gfccsd_ea.hpp"
 #include "gfccsd_ip.hpp"
 #include <algorithm>
+#include <numeric>
+#include <random>
 
 using namespace tamm;
 
@@ -53,6 +56,10 @@ int                 gf_analyze_num_omega;
 std::vector<size_t> gf_orbitals;
 std::vector<double> gf_analyze_omega;
 
+std::string              gf_trace_mode;
+Eigen::MatrixXd          gf_rhs;      // right-hand sides of the alpha IP solves (noa x nrhs)
+std::vector<std::string> gf_rhs_tags; // restart file tag of each right-hand side
+
 #define GF_PGROUPS 1
 #define GF_IN_SG 0
 #define GF_GS_SG 0
@@ -91,6 +98,117 @@ T find_closest(T w, std::vector<T>& wlist) {
   return wlist[idx];
 }
 
+// Picks the next MOR sampling frequencies for the adaptive grid refinement (gf_adaptive_grid).
+// Every interval between two solved frequencies that still contains unconverged grid points
+// receives a single new frequency, placed where the current reduced-order model shows
+// structure: the strongest peak of |A(w)| inside the interval (an estimate of a pole position),
+// or otherwise the point with the largest error estimate plus curvature in the middle half of
+// the interval. Intervals on which the model has already converged are not refined.
+template<typename T>
+std::vector<T> gf_adaptive_omegas(std::vector<T>& omega_finished, const std::vector<T>& wlist,
+                                  const std::vector<T>& A, const std::vector<T>& A_err,
+                                  const std::vector<bool>& A_conv) {
+  std::vector<T> omega_new;
+  if(wlist.size() < 3) return omega_new;
+
+  std::sort(omega_finished.begin(), omega_finished.end());
+  const T    delta      = wlist[1] - wlist[0];
+  const auto grid_index = [&](T w) {
+    return static_cast<int64_t>(std::round((w - wlist[0]) / delta));
+  };
+
+  for(size_t i = 1; i < omega_finished.size(); i++) {
+    const int64_t j1 = grid_index(omega_finished[i - 1]);
+    const int64_t j2 = grid_index(omega_finished[i]);
+    if(j2 - j1 < 2) continue; // no grid point left inside the interval
+
+    bool conv = true;
+    for(int64_t j = j1; j <= j2; j++) conv = conv && A_conv[j];
+    if(conv) continue;
+
+    int64_t jpeak = -1;
+    int64_t jbest = -1;
+    T       sbest = -1;
+    for(int64_t j = j1 + 1; j < j2; j++) {
+      const T a0 = std::abs(A[j - 1]);
+      const T a1 = std::abs(A[j]);
+      const T a2 = std::abs(A[j + 1]);
+      if(a1 > a0 && a1 >= a2 && (jpeak < 0 || a1 > std::abs(A[jpeak]))) jpeak = j;
+      // restrict non-peak points to the middle half so that every interval keeps shrinking
+      if(4 * (j - j1) < (j2 - j1) || 4 * (j2 - j) < (j2 - j1)) continue;
+      const T score = A_err[j] + std::abs(a0 - 2 * a1 + a2);
+      if(score > sbest) {
+        sbest = score;
+        jbest = j;
+      }
+    }
+    const int64_t jnew = (jpeak >= 0) ? jpeak : (jbest >= 0 ? jbest : (j1 + j2) / 2);
+    omega_new.push_back(wlist[jnew]);
+  }
+
+  return omega_new;
+}
+
+// Right-hand sides b_k of the linear systems (w + H - i eta) X_k = b_k. The full trace solves
+// for every occupied alpha orbital and the diagonal mode only for gf_orbitals (unit vectors in
+// both cases). The stochastic mode uses nprobes Rademacher vectors z_k and the Hutchinson
+// estimate Tr G(w) ~ 1/K sum_k z_k^T G(w) z_k. The probes are generated from a fixed seed so
+// that all ranks and all restarts see the same vectors.
+void gf_setup_rhs(const CCSDOptions& ccsd_options, const size_t noa) {
+  gf_rhs_tags.clear();
+  if(gf_trace_mode == "stochastic") {
+    const int nprobes = ccsd_options.gf_nprobes;
+    gf_rhs            = Eigen::MatrixXd::Zero(noa, nprobes);
+    std::mt19937 gen(20231017);
+    for(int k = 0; k < nprobes; k++) {
+      for(size_t p = 0; p < noa; p++) gf_rhs(p, k) = (gen() & 1) ? 1.0 : -1.0;
+      gf_rhs_tags.push_back("sp" + std::to_string(k));
+    }
+    return;
+  }
+
+  std::vector<size_t> orbs(noa);
+  std::iota(orbs.begin(), orbs.end(), 0);
+  if(gf_trace_mode == "diagonal") orbs = gf_orbitals;
+  gf_rhs = Eigen::MatrixXd::Zero(noa, orbs.size());
+  for(size_t k = 0; k < orbs.size(); k++) {
+    if(orbs[k] >= noa) tamm_terminate("[GFCC] gf_orbitals must be occupied alpha orbitals");
+    gf_rhs(orbs[k], k) = 1.0;
+    gf_rhs_tags.push_back("oi" + std::to_string(orbs[k]));
+  }
+}
+
+// Evaluates the reduced-order model for all right-hand sides at a complex frequency w:
+// X = (hsub + w)^-1 bsub Z and g_k = z_k^T Cp X_k. Returns Im(g_k) in gkk, the spectral
+// function A(w) (the sum over g_k, or the Hutchinson mean for stochastic probes) and the
+// standard error of the stochastic estimate (zero otherwise).
+template<typename T, typename CMatrix>
+std::pair<T, T> gf_model_spectral(const CMatrix& hsub, const CMatrix& bsub_z, const CMatrix& cp,
+                                  const std::complex<T> omega, std::vector<T>& gkk) {
+  const CMatrix hident = CMatrix::Identity(hsub.rows(), hsub.cols());
+  const CMatrix xsub   = (hsub + omega * hident).lu().solve(bsub_z);
+
+  const auto nrhs = gf_rhs.cols();
+  gkk.assign(nrhs, 0);
+  for(Eigen::Index k = 0; k < nrhs; k++) {
+    std::complex<T> g = 0;
+    for(Eigen::Index p = 0; p < gf_rhs.rows(); p++) {
+      if(gf_rhs(p, k) == 0) continue;
+      g += gf_rhs(p, k) * cp.row(p).transpose().cwiseProduct(xsub.col(k)).sum();
+    }
+    gkk[k] = std::imag(g);
+  }
+
+  const T gsum = std::accumulate(gkk.begin(), gkk.end(), T{0});
+  if(gf_trace_mode != "stochastic") return {gsum, 0};
+
+  const T mean = gsum / nrhs;
+  T       var  = 0;
+  for(auto g: gkk) var += (g - mean) * (g - mean);
+  if(nrhs > 1) var /= (nrhs - 1);
+  return {mean, std::sqrt(var / nrhs)};
+}
+
 template<typename... Ts>
 std::string gfacc_str(Ts&&... args) {
   std::string res;
@@ -101,7 +219,7 @@ std::string gfacc_str(Ts&&... args) {
 
 void write_results_to_json(ExecutionContext& ec, ChemEnv& chem_env, int level,
                            std::vector<double>& ni_w, std::vector<double>& ni_A,
-                           std::string gfcc_type) {
+                           std::string gfcc_type, const std::vector<double>& ni_err = {}) {
   auto lomega_npts = ni_w.size();
   // std::vector<double> r_ni_w;
   // std::vector<double> r_ni_A;
@@ -120,6 +238,10 @@ void write_results_to_json(ExecutionContext& ec, ChemEnv& chem_env, int level,
         .results["output"]["GFCCSD"][gfcc_type][lvl_str][std::to_string(ni)]["omega"] = ni_w[ni];
       chem_env.sys_data.results["output"]["GFCCSD"][gfcc_type][lvl_str][std::to_string(ni)]["A_a"] =
         ni_A[ni];
+      if(!ni_err.empty())
+        chem_env.sys_data
+          .results["output"]["GFCCSD"][gfcc_type][lvl_str][std::to_string(ni)]["A_a_err"] =
+          ni_err[ni];
     }
     chem_env.write_json_data("GFCCSD");
   }
@@ -178,7 +300,8 @@ void write_string_to_disk(ExecutionContext& ec, const std::string& tstring,
 
 template<typename T>
 void gfccsd_driver_ip_a(
-  ExecutionContext& gec, CCSDOptions& ccsd_options, ExecutionContext& sub_ec, MPI_Comm& subcomm,
+  ExecutionContext& gec, CCSDOptions& ccsd_options, const std::vector<T>& omega_list,
+  ExecutionContext& sub_ec, MPI_Comm& subcomm,
   const TiledIndexSpace& MO, Tensor<T>& t1_a, Tensor<T>& t1_b, Tensor<T>& t2_aaaa,
   Tensor<T>& t2_bbbb, Tensor<T>& t2_abab, Tensor<T>& f1, Tensor<T>& t2v2_o, Tensor<T>& lt12_o_a,
   Tensor<T>& lt12_o_b, Tensor<T>& ix1_1_1_a, Tensor<T>& ix1_1_1_b, Tensor<T>& ix2_1_aaaa,
@@ -227,96 +350,116 @@ void gfccsd_driver_ip_a(
   Scheduler gsch{gec};
   auto      rank = gec.pg().rank();
 
-  std::stringstream gfo;
-  gfo << std::fixed << std::setprecision(2) << gf_omega;
+  const size_t             nomega = omega_list.size();
+  std::vector<std::string> gfo_w(nomega);
+  for(size_t iw = 0; iw < nomega; iw++) {
+    std::stringstream gfo;
+    gfo << std::fixed << std::setprecision(2) << omega_list[iw];
+    gfo_w[iw] = gfo.str();
+  }
 
   // PRINT THE HEADER FOR GF-CCSD ITERATIONS
   if(rank == 0) {
     std::stringstream gfp;
-    gfp << std::endl << "GF-CCSD (w = " << gfo.str() << ") " << std::endl;
+    gfp << std::endl << "GF-CCSD (w = ";
+    for(size_t iw = 0; iw < nomega; iw++) gfp << (iw > 0 ? "," : "") << gfo_w[iw];
+    gfp << ") " << std::endl;
     std::cout << gfp.str() << std::flush;
   }
 
-  ComplexTensor dtmp_a{o_alpha};
-  ComplexTensor dtmp_aaa{v_alpha, o_alpha, o_alpha};
-  ComplexTensor dtmp_bab{v_beta, o_alpha, o_beta};
-  ComplexTensor::allocate(&gec, dtmp_a, dtmp_aaa, dtmp_bab);
+  // The preconditioners of all frequencies in this batch are kept alive for the whole
+  // task queue, since any process group may pick up any (omega, orbital) pair. They are
+  // counted in the memory estimate that sizes the process groups below.
+  std::vector<ComplexTensor> dtmp_a_w(nomega), dtmp_aaa_w(nomega), dtmp_bab_w(nomega);
 
-  // double au2ev = 27.2113961;
+  for(size_t iw = 0; iw < nomega; iw++) {
+    const T omega = omega_list[iw];
 
-  std::string dtmp_a_file   = files_prefix + ".W" + gfo.str() + ".r_dtmp_a.l" + levelstr;
-  std::string dtmp_aaa_file = files_prefix + ".W" + gfo.str() + ".r_dtmp_aaa.l" + levelstr;
-  std::string dtmp_bab_file = files_prefix + ".W" + gfo.str() + ".r_dtmp_bab.l" + levelstr;
+    ComplexTensor dtmp_a{o_alpha};
+    ComplexTensor dtmp_aaa{v_alpha, o_alpha, o_alpha};
+    ComplexTensor dtmp_bab{v_beta, o_alpha, o_beta};
+    ComplexTensor::allocate(&gec, dtmp_a, dtmp_aaa, dtmp_bab);
 
-  if(fs::exists(dtmp_a_file) && fs::exists(dtmp_aaa_file) && fs::exists(dtmp_bab_file)) {
-    read_from_disk(dtmp_a, dtmp_a_file);
-    read_from_disk(dtmp_aaa, dtmp_aaa_file);
-    read_from_disk(dtmp_bab, dtmp_bab_file);
-  }
-  else {
-    ComplexTensor DEArr_IP1{O};
-    ComplexTensor DEArr_IP2{V, O, O};
-
-    double denominator = 0.0;
-    //
-    auto DEArr_lambda1 = [&](const IndexVector& bid) {
-      const IndexVector            blockid = internal::translate_blockid(bid, DEArr_IP1());
-      const TAMM_SIZE              size    = DEArr_IP1.block_size(blockid);
-      std::vector<std::complex<T>> buf(size);
+    // double au2ev = 27.2113961;
 
-      auto   block_dims   = DEArr_IP1.block_dims(blockid);
-      auto   block_offset = DEArr_IP1.block_offsets(blockid);
-      size_t c            = 0;
-      for(size_t i = block_offset[0]; i < block_offset[0] + block_dims[0]; i++) {
-        denominator = gf_omega - p_evl_sorted_occ[i];
-        if(denominator < 0.0 && denominator > -1.0) { denominator += -1.0 * gf_lshift; }
-        else if(denominator > 0.0 && denominator < 1.0) { denominator += 1.0 * gf_lshift; }
-        buf[c] = 1.0 / std::complex<T>(denominator, -1.0 * gf_eta);
-      }
-      DEArr_IP1.put(blockid, buf);
-    };
-    //
-    auto DEArr_lambda2 = [&](const IndexVector& bid) {
-      const IndexVector            blockid = internal::translate_blockid(bid, DEArr_IP2());
-      const TAMM_SIZE              size    = DEArr_IP2.block_size(blockid);
-      std::vector<std::complex<T>> buf(size);
+    std::string dtmp_a_file   = files_prefix + ".W" + gfo_w[iw] + ".r_dtmp_a.l" + levelstr;
+    std::string dtmp_aaa_file = files_prefix + ".W" + gfo_w[iw] + ".r_dtmp_aaa.l" + levelstr;
+    std::string dtmp_bab_file = files_prefix + ".W" + gfo_w[iw] + ".r_dtmp_bab.l" + levelstr;
 
-      auto   block_dims   = DEArr_IP2.block_dims(blockid);
-      auto   block_offset = DEArr_IP2.block_offsets(blockid);
-      size_t c            = 0;
-      for(size_t i = block_offset[0]; i < block_offset[0] + block_dims[0]; i++) {
-        for(size_t j = block_offset[1]; j < block_offset[1] + block_dims[1]; j++) {
-          for(size_t k = block_offset[2]; k < block_offset[2] + block_dims[2]; k++, c++) {
-            denominator =
-              gf_omega + p_evl_sorted_virt[i] - p_evl_sorted_occ[j] - p_evl_sorted_occ[k];
-            if(denominator < 0.0 && denominator > -1.0) { denominator += -1.0 * gf_lshift; }
-            else if(denominator > 0.0 && denominator < 1.0) { denominator += 1.0 * gf_lshift; }
-            buf[c] = 1.0 / std::complex<T>(denominator, -1.0 * gf_eta);
+    if(fs::exists(dtmp_a_file) && fs::exists(dtmp_aaa_file) && fs::exists(dtmp_bab_file)) {
+      read_from_disk(dtmp_a, dtmp_a_file);
+      read_from_disk(dtmp_aaa, dtmp_aaa_file);
+      read_from_disk(dtmp_bab, dtmp_bab_file);
+    }
+    else {
+      ComplexTensor DEArr_IP1{O};
+      ComplexTensor DEArr_IP2{V, O, O};
+
+      double denominator = 0.0;
+      //
+      auto DEArr_lambda1 = [&](const IndexVector& bid) {
+        const IndexVector            blockid = internal::translate_blockid(bid, DEArr_IP1());
+        const TAMM_SIZE              size    = DEArr_IP1.block_size(blockid);
+        std::vector<std::complex<T>> buf(size);
+
+        auto   block_dims   = DEArr_IP1.block_dims(blockid);
+        auto   block_offset = DEArr_IP1.block_offsets(blockid);
+        size_t c            = 0;
+        for(size_t i = block_offset[0]; i < block_offset[0] + block_dims[0]; i++) {
+          denominator = omega - p_evl_sorted_occ[i];
+          if(denominator < 0.0 && denominator > -1.0) { denominator += -1.0 * gf_lshift; }
+          else if(denominator > 0.0 && denominator < 1.0) { denominator += 1.0 * gf_lshift; }
+          buf[c] = 1.0 / std::complex<T>(denominator, -1.0 * gf_eta);
+        }
+        DEArr_IP1.put(blockid, buf);
+      };
+      //
+      auto DEArr_lambda2 = [&](const IndexVector& bid) {
+        const IndexVector            blockid = internal::translate_blockid(bid, DEArr_IP2());
+        const TAMM_SIZE              size    = DEArr_IP2.block_size(blockid);
+        std::vector<std::complex<T>> buf(size);
+
+        auto   block_dims   = DEArr_IP2.block_dims(blockid);
+        auto   block_offset = DEArr_IP2.block_offsets(blockid);
+        size_t c            = 0;
+        for(size_t i = block_offset[0]; i < block_offset[0] + block_dims[0]; i++) {
+          for(size_t j = block_offset[1]; j < block_offset[1] + block_dims[1]; j++) {
+            for(size_t k = block_offset[2]; k < block_offset[2] + block_dims[2]; k++, c++) {
+              denominator =
+                omega + p_evl_sorted_virt[i] - p_evl_sorted_occ[j] - p_evl_sorted_occ[k];
+              if(denominator < 0.0 && denominator > -1.0) { denominator += -1.0 * gf_lshift; }
+              else if(denominator > 0.0 && denominator < 1.0) { denominator += 1.0 * gf_lshift; }
+              buf[c] = 1.0 / std::complex<T>(denominator, -1.0 * gf_eta);
+            }
           }
         }
-      }
-      DEArr_IP2.put(blockid, buf);
-    };
+        DEArr_IP2.put(blockid, buf);
+      };
 
-    gsch.allocate(DEArr_IP1).execute();
-    gsch.allocate(DEArr_IP2).execute();
-    if(subcomm != MPI_COMM_NULL) {
-      Scheduler sub_sch{sub_ec};
-      sub_sch(DEArr_IP1() = 0).execute();
-      sub_sch(DEArr_IP2() = 0).execute();
-      block_for(sub_ec, DEArr_IP1(), DEArr_lambda1);
-      block_for(sub_ec, DEArr_IP2(), DEArr_lambda2);
-      sub_sch(dtmp_a() = 0)(dtmp_aaa() = 0)(dtmp_bab() = 0)(dtmp_a(h1_oa) = DEArr_IP1(h1_oa))(
-        dtmp_aaa(p1_va, h1_oa, h2_oa) = DEArr_IP2(p1_va, h1_oa, h2_oa))(
-        dtmp_bab(p1_vb, h1_oa, h2_ob) = DEArr_IP2(p1_vb, h1_oa, h2_ob))
-        .execute();
+      gsch.allocate(DEArr_IP1).execute();
+      gsch.allocate(DEArr_IP2).execute();
+      if(subcomm != MPI_COMM_NULL) {
+        Scheduler sub_sch{sub_ec};
+        sub_sch(DEArr_IP1() = 0).execute();
+        sub_sch(DEArr_IP2() = 0).execute();
+        block_for(sub_ec, DEArr_IP1(), DEArr_lambda1);
+        block_for(sub_ec, DEArr_IP2(), DEArr_lambda2);
+        sub_sch(dtmp_a() = 0)(dtmp_aaa() = 0)(dtmp_bab() = 0)(dtmp_a(h1_oa) = DEArr_IP1(h1_oa))(
+          dtmp_aaa(p1_va, h1_oa, h2_oa) = DEArr_IP2(p1_va, h1_oa, h2_oa))(
+          dtmp_bab(p1_vb, h1_oa, h2_ob) = DEArr_IP2(p1_vb, h1_oa, h2_ob))
+          .execute();
+      }
+      gec.pg().barrier();
+      gsch.deallocate(DEArr_IP1).execute();
+      gsch.deallocate(DEArr_IP2).execute();
+      write_to_disk(dtmp_a, dtmp_a_file);
+      write_to_disk(dtmp_aaa, dtmp_aaa_file);
+      write_to_disk(dtmp_bab, dtmp_bab_file);
     }
-    gec.pg().barrier();
-    gsch.deallocate(DEArr_IP1).execute();
-    gsch.deallocate(DEArr_IP2).execute();
-    write_to_disk(dtmp_a, dtmp_a_file);
-    write_to_disk(dtmp_aaa, dtmp_aaa_file);
-    write_to_disk(dtmp_bab, dtmp_bab_file);
+
+    dtmp_a_w[iw]   = dtmp_a;
+    dtmp_aaa_w[iw] = dtmp_aaa;
+    dtmp_bab_w[iw] = dtmp_bab;
   }
 
   //------------------------
@@ -330,52 +473,101 @@ void gfccsd_driver_ip_a(
   MPI_Comm_size(world_comm, &world_size);
   MPI_Comm gf_comm;
 
-  const size_t        num_oi           = noa;
+  // Every (omega, orbital) linear solve of this batch is an independent task. All of them
+  // are placed in a single queue so that a process group that finishes an easy solve can
+  // immediately pull work belonging to another frequency, instead of waiting at a barrier
+  // for the slowest orbital of the current frequency.
+  struct GFTask {
+    size_t iw;     // index into omega_list
+    size_t pi;     // right-hand side (column of gf_rhs)
+    double cost;   // relative cost estimate
+    bool   forced; // one of the gf_orbitals in full trace mode
+  };
+
+  const size_t        num_oi           = gf_rhs.cols();
   size_t              num_pi_processed = 0;
-  std::vector<size_t> pi_tbp;
-  if(!gf_orbitals.empty()) pi_tbp = gf_orbitals;
-  // Check pi's already processed
-  for(size_t pi = 0; pi < num_oi; pi++) {
-    std::string x1_a_conv_wpi_file =
-      files_prefix + ".x1_a.w" + gfo.str() + ".oi" + std::to_string(pi);
-    std::string x2_aaa_conv_wpi_file =
-      files_prefix + ".x2_aaa.w" + gfo.str() + ".oi" + std::to_string(pi);
-    std::string x2_bab_conv_wpi_file =
-      files_prefix + ".x2_bab.w" + gfo.str() + ".oi" + std::to_string(pi);
-
-    if(fs::exists(x1_a_conv_wpi_file) && fs::exists(x2_aaa_conv_wpi_file) &&
-       fs::exists(x2_bab_conv_wpi_file))
-      num_pi_processed++;
-    else if(std::find(gf_orbitals.begin(), gf_orbitals.end(), pi) == gf_orbitals.end())
-      pi_tbp.push_back(pi);
+  std::vector<GFTask> gf_tasks;
+  for(size_t iw = 0; iw < nomega; iw++) {
+    for(size_t pi = 0; pi < num_oi; pi++) {
+      // Check pi's already processed
+      std::string x1_a_conv_wpi_file =
+        files_prefix + ".x1_a.w" + gfo_w[iw] + "." + gf_rhs_tags[pi];
+      std::string x2_aaa_conv_wpi_file =
+        files_prefix + ".x2_aaa.w" + gfo_w[iw] + "." + gf_rhs_tags[pi];
+      std::string x2_bab_conv_wpi_file =
+        files_prefix + ".x2_bab.w" + gfo_w[iw] + "." + gf_rhs_tags[pi];
+
+      if(fs::exists(x1_a_conv_wpi_file) && fs::exists(x2_aaa_conv_wpi_file) &&
+         fs::exists(x2_bab_conv_wpi_file)) {
+        num_pi_processed++;
+        continue;
+      }
+
+      // The number of GMRES iterations grows as omega approaches a pole of G. Use the distance
+      // to the nearest zeroth-order IP covered by the right-hand side as the cost estimate.
+      double dist = std::numeric_limits<double>::max();
+      for(size_t p = 0; p < noa; p++) {
+        if(gf_rhs(p, pi) == 0) continue;
+        dist = std::min(dist, std::abs(omega_list[iw] - p_evl_sorted_occ[p]));
+      }
+      const bool forced =
+        gf_trace_mode == "full" &&
+        std::find(gf_orbitals.begin(), gf_orbitals.end(), pi) != gf_orbitals.end();
+      gf_tasks.push_back({iw, pi, 1.0 / (dist + std::abs(gf_eta)), forced});
+    }
   }
 
-  size_t num_pi_remain = num_oi - num_pi_processed;
+  const size_t num_pi_remain = gf_tasks.size();
   if(num_pi_remain == 0) {
-    gsch.deallocate(dtmp_a, dtmp_aaa, dtmp_bab).execute();
+    free_vec_tensors(dtmp_a_w, dtmp_aaa_w, dtmp_bab_w);
     return;
   }
-  EXPECTS(num_pi_remain == pi_tbp.size());
-  // if(num_pi_remain == 0) num_pi_remain = 1;
+  EXPECTS(num_pi_remain + num_pi_processed == nomega * num_oi);
+
+  // Longest-processing-time-first: the most expensive solves are handed out first so that
+  // the cheap ones fill in the gaps at the end of the queue. gf_orbitals keep their priority.
+  std::stable_sort(gf_tasks.begin(), gf_tasks.end(), [&](const GFTask& a, const GFTask& b) {
+    if(a.forced != b.forced) return a.forced;
+    return a.cost > b.cost;
+  });
+
+  // Size the process groups from the total amount of work in the queue, but never below the
+  // number of ranks needed to hold the working set of a single solve (x, Hx, dx and the GMRES
+  // subspace) in half of the memory available per rank. The preconditioners of all nomega
+  // frequencies stay resident on gec for the whole queue and are taken off that budget first.
+  const double vec_mem_gib =
+    (noa + 2.0 * nvir * noa * noa) * sizeof(std::complex<T>) / (1024 * 1024 * 1024.0);
+  const double task_mem_gib = (ngmres + 9) * vec_mem_gib;
+  const double dtmp_mem_gib = nomega * vec_mem_gib / nranks;
+  const double rank_mem_gib = gec.mem_info().cpu_mem_per_node / gec.ppn();
+  int          min_subranks = 1;
+  if(rank_mem_gib > 0) {
+    const double avail_gib = 0.5 * rank_mem_gib - dtmp_mem_gib;
+    min_subranks = avail_gib > 0 ? static_cast<int>(std::ceil(task_mem_gib / avail_gib)) : nranks;
+  }
+  if(min_subranks < 1) min_subranks = 1;
+  if(min_subranks > nranks) min_subranks = nranks;
+
   int        subranks = std::floor(nranks / num_pi_remain);
-  const bool no_pg    = (subranks == 0 || subranks == 1);
+  const bool no_pg    = (subranks == 0 || subranks == 1) && min_subranks == 1;
   if(no_pg) subranks = nranks;
+  if(subranks < min_subranks) subranks = min_subranks;
   if(gf_nprocs_poi > 0) subranks = gf_nprocs_poi;
 
-  // Figure out how many orbitals in pi_tbp can be processed with subranks
+  // Figure out how many tasks can be processed concurrently with subranks
   // TODO: gf_nprocs_pi must be a multiple of total #ranks for best performance.
   size_t num_oi_can_bp = std::ceil(nranks / (1.0 * subranks));
   if(num_pi_remain < num_oi_can_bp) {
     num_oi_can_bp = num_pi_remain;
-    subranks      = std::floor(nranks / num_pi_remain);
+    subranks      = std::max<int>(std::floor(nranks / num_pi_remain), min_subranks);
     if(no_pg) subranks = nranks;
   }
 
   if(rank == 0) {
     cout << "Total number of process groups = " << num_oi_can_bp << endl;
-    cout << "Total, remaining orbitals, batch size = " << num_oi << ", " << num_pi_remain << ", "
-         << num_oi_can_bp << endl;
-    cout << "No of processes used to compute each orbital = " << subranks << endl;
+    cout << "Total, remaining (omega,orbital) tasks, batch size = " << nomega * num_oi << ", "
+         << num_pi_remain << ", " << num_oi_can_bp << endl;
+    cout << "No of processes used to compute each task = " << subranks << endl;
     // ofs_profile << "No of processes used to compute each orbital = " << subranks << endl;
   }
 
@@ -408,25 +600,23 @@ void gfccsd_driver_ip_a(
 
   int root_ppi = -1;
   MPI_Comm_rank(ec.pg().comm(), &root_ppi);
-  // for (size_t pib=0; pib < num_pi_remain; pib+=num_oi_can_bp){
-  //   size_t piv_end = num_oi_can_bp;
-  //   if(pib+num_oi_can_bp > num_pi_remain) piv_end = pib+num_oi_can_bp-num_pi_remain;
-  // for (size_t piv=0; piv < piv_end; piv++){
-  //   size_t pi = pi_tbp[piv+pib];
   int pg_id = rank.value() / subranks;
   if(root_ppi == 0) next = ac->fetch_add(0, 1);
   ec.pg().broadcast(&next, 0);
 
-  for(size_t piv = 0; piv < pi_tbp.size(); piv++) {
-    // #if GF_PGROUPS
-    // if( (rank >= piv*subranks && rank < (piv*subranks+subranks) ) || no_pg){
-    // if(!no_pg) root_ppi = piv*subranks; //root of sub-group
-    // #endif
+  for(size_t itask = 0; itask < gf_tasks.size(); itask++) {
     if(next == taskcount) {
       total_pi_pg++;
-      size_t pi = pi_tbp[piv];
+      const size_t       iw       = gf_tasks[itask].iw;
+      const size_t       pi       = gf_tasks[itask].pi;
+      const T            omega    = omega_list[iw];
+      const std::string& gfo      = gfo_w[iw];
+      ComplexTensor&     dtmp_a   = dtmp_a_w[iw];
+      ComplexTensor&     dtmp_aaa = dtmp_aaa_w[iw];
+      ComplexTensor&     dtmp_bab = dtmp_bab_w[iw];
       if(root_ppi == 0 && debug)
-        cout << "Process group " << pg_id << " is executing orbital " << pi << endl;
+        cout << "Process group " << pg_id << " is executing (w,oi) = (" << gfo << "," << pi << ")"
+             << endl;
 
       auto gf_t1 = std::chrono::high_resolution_clock::now();
 
@@ -462,7 +652,9 @@ void gfccsd_driver_ip_a(
         auto block_offset = B1.block_offsets(blockid);
         auto dim          = block_dims[0];
         auto offset       = block_offset[0];
-        if(pi >= offset && pi < offset + dim) buf[pi - offset] = 1.0;
+        for(size_t i = 0; i < dim; i++) {
+          if(offset + i < noa) buf[i] = gf_rhs(offset + i, pi);
+        }
         B1.put(blockid, buf);
       }
 
@@ -491,7 +683,9 @@ void gfccsd_driver_ip_a(
         .execute();
       // clang-format on
 
-      gf_guess_ip(ec, MO, nocc, gf_omega, gf_eta, pi, p_evl_sorted_occ, t2v2_o, x1, Minv, true);
+      std::vector<T> rhs(nocc, 0);
+      for(size_t p = 0; p < noa; p++) rhs[p] = gf_rhs(p, pi);
+      gf_guess_ip(ec, MO, nocc, omega, gf_eta, rhs, p_evl_sorted_occ, t2v2_o, x1, Minv, true);
 
       // clang-format off
       sch
@@ -502,11 +696,11 @@ void gfccsd_driver_ip_a(
       // clang-format on
 
       std::string x1_a_inter_wpi_file =
-        files_prefix + ".x1_a.inter.w" + gfo.str() + ".oi" + std::to_string(pi);
+        files_prefix + ".x1_a.inter.w" + gfo + "." + gf_rhs_tags[pi];
       std::string x2_aaa_inter_wpi_file =
-        files_prefix + ".x2_aaa.inter.w" + gfo.str() + ".oi" + std::to_string(pi);
+        files_prefix + ".x2_aaa.inter.w" + gfo + "." + gf_rhs_tags[pi];
       std::string x2_bab_inter_wpi_file =
-        files_prefix + ".x2_bab.inter.w" + gfo.str() + ".oi" + std::to_string(pi);
+        files_prefix + ".x2_bab.inter.w" + gfo + "." + gf_rhs_tags[pi];
 
       if(fs::exists(x1_a_inter_wpi_file) && fs::exists(x2_aaa_inter_wpi_file) &&
          fs::exists(x2_bab_inter_wpi_file)) {
@@ -549,9 +743,9 @@ void gfccsd_driver_ip_a(
           (dx1_a()   = -1.0 * Hx1_a())
           (dx2_aaa() = -1.0 * Hx2_aaa())
           (dx2_bab() = -1.0 * Hx2_bab())
-          (dx1_a(h1_oa)               -= std::complex<double>(gf_omega,-1.0*gf_eta) * x1_a(h1_oa))
-          (dx2_aaa(p1_va,h1_oa,h2_oa) -= std::complex<double>(gf_omega,-1.0*gf_eta) * x2_aaa(p1_va,h1_oa,h2_oa))
-          (dx2_bab(p1_vb,h1_oa,h2_ob) -= std::complex<double>(gf_omega,-1.0*gf_eta) * x2_bab(p1_vb,h1_oa,h2_ob))
+          (dx1_a(h1_oa)               -= std::complex<double>(omega,-1.0*gf_eta) * x1_a(h1_oa))
+          (dx2_aaa(p1_va,h1_oa,h2_oa) -= std::complex<double>(omega,-1.0*gf_eta) * x2_aaa(p1_va,h1_oa,h2_oa))
+          (dx2_bab(p1_vb,h1_oa,h2_ob) -= std::complex<double>(omega,-1.0*gf_eta) * x2_bab(p1_vb,h1_oa,h2_ob))
           (dx1_a() += B1_a());
         // clang-format on
 
@@ -587,7 +781,7 @@ void gfccsd_driver_ip_a(
           cout << "----------------" << endl;
           cout << "  #iter " << gf_iter << ", T(x_update contraction): " << std::fixed
                << std::setprecision(6) << gftime << endl;
-          cout << std::fixed << std::setprecision(2) << "  w,oi (" << gfo.str() << "," << pi
+          cout << std::fixed << std::setprecision(2) << "  w,oi (" << gfo << "," << pi
                << "), residual = " << std::fixed << std::setprecision(6) << gf_residual
                << std::endl;
         }
@@ -640,9 +834,9 @@ void gfccsd_driver_ip_a(
             (dx1_a()    = 1.0 * Hx1_a())
             (dx2_aaa()  = 1.0 * Hx2_aaa())
             (dx2_bab()  = 1.0 * Hx2_bab())
-            (dx1_a()   += std::complex<double>(gf_omega,-1.0*gf_eta) * Q1_a[k]())
-            (dx2_aaa() += std::complex<double>(gf_omega,-1.0*gf_eta) * Q2_aaa[k]())
-            (dx2_bab() += std::complex<double>(gf_omega,-1.0*gf_eta) * Q2_bab[k]());
+            (dx1_a()   += std::complex<double>(omega,-1.0*gf_eta) * Q1_a[k]())
+            (dx2_aaa() += std::complex<double>(omega,-1.0*gf_eta) * Q2_aaa[k]())
+            (dx2_bab() += std::complex<double>(omega,-1.0*gf_eta) * Q2_bab[k]());
           // clang-format on
 
           // clang-format off
@@ -841,11 +1035,11 @@ void gfccsd_driver_ip_a(
 
       if(gf_conv) {
         std::string x1_a_conv_wpi_file =
-          files_prefix + ".x1_a.w" + gfo.str() + ".oi" + std::to_string(pi);
+          files_prefix + ".x1_a.w" + gfo + "." + gf_rhs_tags[pi];
         std::string x2_aaa_conv_wpi_file =
-          files_prefix + ".x2_aaa.w" + gfo.str() + ".oi" + std::to_string(pi);
+          files_prefix + ".x2_aaa.w" + gfo + "." + gf_rhs_tags[pi];
         std::string x2_bab_conv_wpi_file =
-          files_prefix + ".x2_bab.w" + gfo.str() + ".oi" + std::to_string(pi);
+          files_prefix + ".x2_bab.w" + gfo + "." + gf_rhs_tags[pi];
         write_to_disk(x1_a, x1_a_conv_wpi_file);
         write_to_disk(x2_aaa, x2_aaa_conv_wpi_file);
         write_to_disk(x2_bab, x2_bab_conv_wpi_file);
@@ -855,7 +1049,7 @@ void gfccsd_driver_ip_a(
       }
 
       if(!gf_conv) { //&& root_ppi == 0
-        std::string error_string = gfo.str() + "," + std::to_string(pi) + ".";
+        std::string error_string = gfo + "," + std::to_string(pi) + ".";
         tamm_terminate("ERROR: GF-CCSD does not converge for w,oi = " + error_string);
       }
 
@@ -864,7 +1058,7 @@ void gfccsd_driver_ip_a(
         std::chrono::duration_cast<std::chrono::duration<double>>((gf_t2 - gf_t1)).count();
       if(root_ppi == 0) {
         std::string gf_stats;
-        gf_stats = gfacc_str("R-GF-CCSD Time for w,oi (", gfo.str(), ",", std::to_string(pi),
+        gf_stats = gfacc_str("R-GF-CCSD Time for w,rhs (", gfo, ",", gf_rhs_tags[pi],
                              ") = ", std::to_string(gftime),
                              " secs, #iter = ", std::to_string(gf_iter), ", using PG ",
                              std::to_string(pg_id));
@@ -898,13 +1092,13 @@ void gfccsd_driver_ip_a(
     if(root_ppi == 0) taskcount++;
     ec.pg().broadcast(&taskcount, 0);
     // ec.pg().barrier();
-  } // end all remaining pi
+  } // end all remaining (omega, orbital) tasks
 
   auto   cc_t2 = std::chrono::high_resolution_clock::now();
   double time  = std::chrono::duration_cast<std::chrono::duration<double>>((cc_t2 - cc_t1)).count();
 
   if(root_ppi == 0) {
-    cout << "Total orbitals executed by process group " << pg_id << " = " << total_pi_pg << endl;
+    cout << "Total tasks executed by process group " << pg_id << " = " << total_pi_pg << endl;
     cout << "  --> Total R-GF-CCSD Time = " << time << " secs" << endl;
   }
 
@@ -920,12 +1114,12 @@ void gfccsd_driver_ip_a(
   cc_t2 = std::chrono::high_resolution_clock::now();
   time  = std::chrono::duration_cast<std::chrono::duration<double>>((cc_t2 - cc_t1)).count();
   if(rank == 0) {
-    std::cout << "Total R-GF-CCSD Time (w = " << gfo.str() << ") = " << time << " secs"
+    std::cout << "Total R-GF-CCSD Time (" << nomega << " freq's) = " << time << " secs"
               << std::endl;
     std::cout << std::string(55, '-') << std::endl;
   }
 
-  gsch.deallocate(dtmp_a, dtmp_aaa, dtmp_bab).execute();
+  free_vec_tensors(dtmp_a_w, dtmp_aaa_w, dtmp_bab_w);
   MPI_Comm_free(&gf_comm);
 }
 
@@ -1049,7 +1243,7 @@ void gfccsd_driver_ip_b(
   }
 
   //------------------------
-  auto nranks     = GA_Nnodes();
+  auto nranks     = gec.pg().size().value();
   auto world_comm = gec.pg().comm();
   auto world_rank = gec.pg().rank().value();
 
@@ -1547,7 +1741,7 @@ void gfccsd_driver_ea_a(
   }
 
   //------------------------
-  auto nranks     = GA_Nnodes();
+  auto nranks     = gec.pg().size().value();
   auto world_comm = gec.pg().comm();
   auto world_rank = gec.pg().rank().value();
 
@@ -2125,7 +2319,7 @@ void gfccsd_driver_ea_b(
   }
 
   //------------------------
-  auto nranks     = GA_Nnodes();
+  auto nranks     = gec.pg().size().value();
   auto world_comm = gec.pg().comm();
   auto world_rank = gec.pg().rank().value();
 
@@ -2534,9 +2728,10 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
   int nsranks = sys_data.nbf / 15;
   if(nsranks < 1) nsranks = 1;
-  int ga_cnn = GA_Cluster_nnodes();
+  int ga_cnn = ec.nnodes();
   if(nsranks > ga_cnn) nsranks = ga_cnn;
-  nsranks = nsranks * GA_Cluster_nprocs(0);
+  // a task-farm group can hold fewer ranks than a node
+  nsranks = std::min<int>(nsranks * GA_Cluster_nprocs(0), ec.pg().size().value());
   int subranks[nsranks];
   for(int i = 0; i < nsranks; i++) subranks[i] = i;
   auto      world_comm = ec.pg().comm();
@@ -2568,7 +2763,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -2614,7 +2809,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
       read_from_disk(d_t1, t1file);
       read_from_disk(d_t2, t2file);
     }
-    read_from_disk(cholVpr, v2file);
+    exachem::cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
     p_evl_sorted = tamm::diagonal(d_f1);
   }
@@ -2624,7 +2819,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    exachem::cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -2779,6 +2974,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   omega_delta_e        = ccsd_options.gf_omega_delta_e;
   gf_nprocs_poi        = ccsd_options.gf_nprocs_poi;
   gf_orbitals          = ccsd_options.gf_orbitals;
+  gf_trace_mode        = ccsd_options.gf_trace_mode;
   gf_damping_factor    = ccsd_options.gf_damping_factor;
   gf_extrapolate_level = ccsd_options.gf_extrapolate_level;
   gf_analyze_level     = ccsd_options.gf_analyze_level;
@@ -2888,6 +3084,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   std::vector<bool> omega_ea_conv_a(omega_npts_ea, false);
   std::vector<bool> omega_ea_conv_b(omega_npts_ea, false);
   std::vector<T>    omega_ip_A0(omega_npts_ip, UINT_MAX);
+  std::vector<T>    omega_ip_err(omega_npts_ip, 0);
   std::vector<T>    omega_ea_A0(omega_npts_ea, UINT_MAX);
 
   std::vector<T> omega_extra;
@@ -2937,6 +3134,17 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   std::string v2ijab_bbbb_file = files_prefix + ".v2ijab_bbbb";
   std::string v2ijab_abab_file = files_prefix + ".v2ijab_abab";
 
+  // The working set of the GMRES solves is recorded for a single solve and the preconditioners
+  // of the initial frequencies; gfccsd_driver_ip_a sizes the process groups so that every
+  // concurrent solve fits.
+  MemoryPlan gfcc_plan{ec, "GFCC", chem_env.ioptions.common_options.memory_overhead};
+  gfcc_plan.allocate("fock, t1,t2 and cholesky vectors", d_f1, d_t1, d_t2, cholVpr);
+  gfcc_plan.allocate("spin-explicit t1,t2 and cholesky blocks", d_t1_a, d_t1_b, d_t2_aaaa,
+                     d_t2_bbbb, d_t2_abab, cholOO_a, cholOO_b, cholOV_a, cholOV_b, cholVV_a,
+                     cholVV_b);
+  gfcc_plan.allocate("v2 blocks", v2ijab_aaaa, v2ijab_bbbb, v2ijab_abab, v2ijab, v2ijka, v2iajb);
+  gfcc_plan.check(ec, "the GFCC intermediates");
+
   sch
     .allocate(d_t1_a, d_t1_b, d_t2_aaaa, d_t2_bbbb, d_t2_abab, cholOO_a, cholOO_b, cholOV_a,
               cholOV_b, cholVV_a, cholVV_b, v2ijab_aaaa, v2ijab_bbbb, v2ijab_abab, v2ijab, v2ijka,
@@ -3140,6 +3348,20 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     Tensor<T> ix2_6_2{{O, V}, {1, 1}};
     Tensor<T> ix2_6_3{{O, O, O, V}, {2, 2}};
 
+    gfcc_plan.allocate("IP intermediates", t2v2_o, lt12_o_a, lt12_o_b, ix1_1_1_a, ix1_1_1_b,
+                       ix2_1_aaaa, ix2_1_abab, ix2_1_bbbb, ix2_1_baba, ix2_2_a, ix2_2_b, ix2_3_a,
+                       ix2_3_b, ix2_4_aaaa, ix2_4_abab, ix2_4_bbbb, ix2_5_aaaa, ix2_5_abba,
+                       ix2_5_abab, ix2_5_bbbb, ix2_5_baab, ix2_5_baba, ix2_6_2_a, ix2_6_2_b,
+                       ix2_6_3_aaaa, ix2_6_3_abba, ix2_6_3_abab, ix2_6_3_bbbb, ix2_6_3_baab,
+                       ix2_6_3_baba);
+    {
+      const double vec_gib =
+        (noa + 2.0 * nvir * noa * noa) * sizeof(std::complex<T>) / (1024 * 1024 * 1024.0);
+      gfcc_plan.allocate_gib("IP preconditioners", omega_space_ip.size() * vec_gib);
+      gfcc_plan.allocate_gib("IP GMRES vectors of one solve", (ngmres + 9) * vec_gib);
+    }
+    gfcc_plan.check(ec, "the GF-CCSD IP calculation");
+
     sch
       .allocate(t2v2_o, lt12_o_a, lt12_o_b, ix1_1_1_a, ix1_1_1_b, ix2_1_aaaa, ix2_1_abab,
                 ix2_1_bbbb, ix2_1_baba, ix2_2_a, ix2_2_b, ix2_3_a, ix2_3_b, ix2_4_aaaa, ix2_4_abab,
@@ -3393,6 +3615,12 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
       // ofs_profile << endl << "_____retarded_GFCCSD_on_alpha_spin______" << endl;
     }
 
+    gf_setup_rhs(ccsd_options, noa);
+    const size_t nrhs = gf_rhs.cols();
+    if(rank == 0)
+      cout << "GF trace mode: " << gf_trace_mode << ", number of right-hand sides = " << nrhs
+           << endl;
+
     size_t prev_qr_rank_orig    = 0;
     size_t prev_qr_rank_updated = 0;
     // const auto nranks = ec.pg().size().value();
@@ -3425,7 +3653,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
       for(auto x: omega_extra) omega_extra_finished.push_back(x);
 
-      auto qr_rank_orig    = omega_extra_finished.size() * noa;
+      auto qr_rank_orig    = omega_extra_finished.size() * nrhs;
       auto qr_rank_updated = qr_rank_orig;
 
       if(q_exist) {
@@ -3467,22 +3695,21 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
       TiledIndexSpace unit_tis{otis, range(0, 1)};
       // auto [u1] = unit_tis.labels<1>("all");
 
+      // All new frequencies of this level are solved from a single (omega, orbital) task queue
+      ndiis = ccsd_options.gf_ndiis;
+      if(!gf_restart) {
+        gfccsd_driver_ip_a<T>(
+          ec, ccsd_options, omega_extra, *sub_ec, subcomm, MO, d_t1_a, d_t1_b, d_t2_aaaa,
+          d_t2_bbbb, d_t2_abab, d_f1, t2v2_o, lt12_o_a, lt12_o_b, ix1_1_1_a, ix1_1_1_b, ix2_1_aaaa,
+          ix2_1_abab, ix2_1_bbbb, ix2_1_baba, ix2_2_a, ix2_2_b, ix2_3_a, ix2_3_b, ix2_4_aaaa,
+          ix2_4_abab, ix2_4_bbbb, ix2_5_aaaa, ix2_5_abba, ix2_5_abab, ix2_5_bbbb, ix2_5_baab,
+          ix2_5_baba, ix2_6_2_a, ix2_6_2_b, ix2_6_3_aaaa, ix2_6_3_abba, ix2_6_3_abab, ix2_6_3_bbbb,
+          ix2_6_3_baab, ix2_6_3_baba, v2ijab_aaaa, v2ijab_abab, v2ijab_bbbb, p_evl_sorted_occ,
+          p_evl_sorted_virt, total_orbitals, nocc, nvir, nptsi, unit_tis, files_prefix, levelstr,
+          noa);
+      }
       for(auto x: omega_extra) {
-        // omega_extra_finished.push_back(x);
-        ndiis    = ccsd_options.gf_ndiis;
-        gf_omega = x;
-        if(!gf_restart) {
-          gfccsd_driver_ip_a<T>(
-            ec, ccsd_options, *sub_ec, subcomm, MO, d_t1_a, d_t1_b, d_t2_aaaa, d_t2_bbbb, d_t2_abab,
-            d_f1, t2v2_o, lt12_o_a, lt12_o_b, ix1_1_1_a, ix1_1_1_b, ix2_1_aaaa, ix2_1_abab,
-            ix2_1_bbbb, ix2_1_baba, ix2_2_a, ix2_2_b, ix2_3_a, ix2_3_b, ix2_4_aaaa, ix2_4_abab,
-            ix2_4_bbbb, ix2_5_aaaa, ix2_5_abba, ix2_5_abab, ix2_5_bbbb, ix2_5_baab, ix2_5_baba,
-            ix2_6_2_a, ix2_6_2_b, ix2_6_3_aaaa, ix2_6_3_abba, ix2_6_3_abab, ix2_6_3_bbbb,
-            ix2_6_3_baab, ix2_6_3_baba, v2ijab_aaaa, v2ijab_abab, v2ijab_bbbb, p_evl_sorted_occ,
-            p_evl_sorted_virt, total_orbitals, nocc, nvir, nptsi, unit_tis, files_prefix, levelstr,
-            noa);
-        }
-        else if(rank == 0) cout << endl << "Restarting freq: " << gf_omega << endl;
+        if(gf_restart && rank == 0) cout << endl << "Restarting freq: " << x << endl;
         auto ni             = std::round((x - omega_min_ip) / omega_delta);
         omega_ip_conv_a[ni] = true;
       }
@@ -3608,17 +3835,17 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
             ComplexTensor q2_tmp_bab{v_beta, o_alpha, o_beta};
             sch.allocate(q1_tmp_a, q2_tmp_aaa, q2_tmp_bab).execute();
 
-            auto              W_read  = omega_extra_finished[ivec / (noa)];
-            auto              pi_read = ivec % (noa);
+            auto              W_read  = omega_extra_finished[ivec / (nrhs)];
+            auto              pi_read = ivec % (nrhs);
             std::stringstream gfo;
             gfo << std::fixed << std::setprecision(2) << W_read;
 
             std::string x1_a_wpi_file =
-              files_prefix + ".x1_a.w" + gfo.str() + ".oi" + std::to_string(pi_read);
+              files_prefix + ".x1_a.w" + gfo.str() + "." + gf_rhs_tags[pi_read];
             std::string x2_aaa_wpi_file =
-              files_prefix + ".x2_aaa.w" + gfo.str() + ".oi" + std::to_string(pi_read);
+              files_prefix + ".x2_aaa.w" + gfo.str() + "." + gf_rhs_tags[pi_read];
             std::string x2_bab_wpi_file =
-              files_prefix + ".x2_bab.w" + gfo.str() + ".oi" + std::to_string(pi_read);
+              files_prefix + ".x2_bab.w" + gfo.str() + "." + gf_rhs_tags[pi_read];
 
             if(fs::exists(x1_a_wpi_file) && fs::exists(x2_aaa_wpi_file) &&
                fs::exists(x2_bab_wpi_file)) {
@@ -4151,19 +4378,14 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
       Complex2DMatrix hsub_a(qr_rank_updated, qr_rank_updated);
       Complex2DMatrix bsub_a(qr_rank_updated, noa);
+      Complex2DMatrix cp_a(noa, qr_rank_updated);
 
       tamm_to_eigen_tensor(hsub_tamm_a, hsub_a);
       tamm_to_eigen_tensor(bsub_tamm_a, bsub_a);
-      Complex2DMatrix hident = Complex2DMatrix::Identity(hsub_a.rows(), hsub_a.cols());
-
-      ComplexTensor xsub_local_a{otis_opt, o_alpha};
-      ComplexTensor o_local_a{o_alpha};
-      ComplexTensor Cp_local_a{o_alpha, otis_opt};
-
-      ComplexTensor::allocate(&ec_l, xsub_local_a, o_local_a, Cp_local_a);
-
-      Scheduler sch_l{ec_l};
-      sch_l(Cp_local_a(h1_oa, otil) = Cp_a(h1_oa, otil)).execute();
+      tamm_to_eigen_tensor(Cp_a, cp_a);
+      const Complex2DMatrix bsubz_a = bsub_a * gf_rhs.cast<std::complex<T>>();
+      const bool            gf_stochastic = (gf_trace_mode == "stochastic");
+      std::vector<T>        gkk;
 
       if(rank == 0) {
         cout << endl << "spectral function (omega_npts_ip = " << omega_npts_ip << "):" << endl;
@@ -4173,34 +4395,35 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
       std::vector<double> ni_w(omega_npts_ip, 0);
       std::vector<double> ni_A(omega_npts_ip, 0);
+      std::vector<double> ni_err;
+      if(gf_stochastic) ni_err.resize(omega_npts_ip, 0);
 
       // Compute spectral function for designated omega regime
       for(int64_t ni = 0; ni < omega_npts_ip; ni++) {
         std::complex<T> omega_tmp = std::complex<T>(omega_min_ip + ni * omega_delta, -1.0 * gf_eta);
 
-        Complex2DMatrix xsub_a = (hsub_a + omega_tmp * hident).lu().solve(bsub_a);
-        eigen_to_tamm_tensor(xsub_local_a, xsub_a);
-
-        sch_l(o_local_a(h1_oa) = Cp_local_a(h1_oa, otil) * xsub_local_a(otil, h1_oa)).execute();
-
-        auto oscalar = std::imag(tamm::sum(o_local_a));
+        auto [oscalar, oerr_stoch] = gf_model_spectral(hsub_a, bsubz_a, cp_a, omega_tmp, gkk);
 
         if(level == 1) { omega_ip_A0[ni] = oscalar; }
         else {
           if(level > 1) {
-            T oerr          = oscalar - omega_ip_A0[ni];
-            omega_ip_A0[ni] = oscalar;
-            if(std::abs(oerr) < gf_threshold) omega_ip_conv_a[ni] = true;
+            T oerr           = oscalar - omega_ip_A0[ni];
+            omega_ip_A0[ni]  = oscalar;
+            omega_ip_err[ni] = std::abs(oerr);
+            // the stochastic estimate cannot converge below its own error bar
+            if(std::abs(oerr) < std::max<T>(gf_threshold, oerr_stoch)) omega_ip_conv_a[ni] = true;
           }
         }
         if(rank == 0) {
           std::ostringstream spf;
           spf << "W = " << std::fixed << std::setprecision(2) << std::real(omega_tmp)
-              << ", omega_ip_A0 = " << std::fixed << std::setprecision(4) << omega_ip_A0[ni]
-              << endl;
+              << ", omega_ip_A0 = " << std::fixed << std::setprecision(4) << omega_ip_A0[ni];
+          if(gf_stochastic) spf << " +/- " << oerr_stoch;
+          spf << endl;
           cout << spf.str();
           ni_A[ni] = omega_ip_A0[ni];
           ni_w[ni] = std::real(omega_tmp);
+          if(gf_stochastic) ni_err[ni] = oerr_stoch;
         }
       }
 
@@ -4212,14 +4435,18 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
              << omega_extra << endl;
         cout << "Time to compute spectral function in level " << level
              << " (omega_npts_ip = " << omega_npts_ip << "): " << time << " secs" << endl;
-        write_results_to_json(ec, chem_env, level, ni_w, ni_A, "retarded_alpha");
+        write_results_to_json(ec, chem_env, level, ni_w, ni_A, "retarded_alpha", ni_err);
       }
 
       auto               extrap_file = files_prefix + ".extrapolate.retarded.alpha.txt";
       std::ostringstream spfe;
       spfe << "";
 
-      if(level == 1) {
+      if(ccsd_options.gf_adaptive_grid) {
+        omega_extra = gf_adaptive_omegas(omega_extra_finished, omega_space_ip, omega_ip_A0,
+                                         omega_ip_err, omega_ip_conv_a);
+      }
+      else if(level == 1) {
         auto o1 = (omega_extra[0] + omega_extra[1]) / 2;
         omega_extra.clear();
         o1 = find_closest(o1, omega_space_ip);
@@ -4279,22 +4506,18 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
             std::complex<T> omega_tmp =
               std::complex<T>(lomega_min_ip + ni * omega_delta_e, -1.0 * gf_eta);
 
-            Complex2DMatrix xsub_a = (hsub_a + omega_tmp * hident).lu().solve(bsub_a);
-            eigen_to_tamm_tensor(xsub_local_a, xsub_a);
+            auto [oscalar, oerr_stoch] = gf_model_spectral(hsub_a, bsubz_a, cp_a, omega_tmp, gkk);
 
-            sch_l(o_local_a(h1_oa) = Cp_local_a(h1_oa, otil) * xsub_local_a(otil, h1_oa)).execute();
-
-            auto oscalar = std::imag(tamm::sum(o_local_a));
-
-            Eigen::Tensor<std::complex<T>, 1, Eigen::RowMajor> olocala_eig(noa);
-            tamm_to_eigen_tensor(o_local_a, olocala_eig);
-            for(TAMM_SIZE nj = 0; nj < noa; nj++) {
-              auto gpp = olocala_eig(nj).imag();
-              spfe << "orb_index = " << nj << ", gpp_a = " << gpp << endl;
+            for(size_t nj = 0; nj < nrhs; nj++) {
+              if(gf_stochastic) spfe << "probe = " << nj;
+              else spfe << "orb_index = " << gf_rhs_tags[nj].substr(2);
+              spfe << ", gpp_a = " << gkk[nj] << endl;
             }
 
             spfe << "w = " << std::fixed << std::setprecision(3) << std::real(omega_tmp)
-                 << ", A_a =  " << std::fixed << std::setprecision(6) << oscalar << endl;
+                 << ", A_a =  " << std::fixed << std::setprecision(6) << oscalar;
+            if(gf_stochastic) spfe << " +/- " << oerr_stoch;
+            spfe << endl;
             next = ac->fetch_add(0, 1);
           }
           taskcount++;
@@ -4309,8 +4532,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
           sys_data.results["output"]["GFCCSD"]["retarded_alpha"]["nlevels"] = level;
           chem_env.write_json_data("GFCCSD");
         }
-        sch.deallocate(xsub_local_a, o_local_a, Cp_local_a, hsub_tamm_a, bsub_tamm_a, Cp_a)
-          .execute();
+        sch.deallocate(hsub_tamm_a, bsub_tamm_a, Cp_a).execute();
         auto   cc_t2 = std::chrono::high_resolution_clock::now();
         double time =
           std::chrono::duration_cast<std::chrono::duration<double>>((cc_t2 - cc_t1)).count();
@@ -4323,7 +4545,7 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
       level++;
 
-      sch.deallocate(xsub_local_a, o_local_a, Cp_local_a, hsub_tamm_a, bsub_tamm_a, Cp_a).execute();
+      sch.deallocate(hsub_tamm_a, bsub_tamm_a, Cp_a).execute();
 
     } // end while
     // end of alpha
@@ -4998,6 +5220,21 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     Tensor<T> iy4_2{{O, O, O, V}, {2, 2}};
     Tensor<T> iy6{{O, V, CI}, {1, 1}};
 
+    gfcc_plan.allocate("EA intermediates", t2v2_v, lt12_v_a, lt12_v_b, iy1_1_a, iy1_1_b,
+                       iy1_2_1_a, iy1_2_1_b, iy1_a, iy1_b, iy2_a, iy2_b, iy3_1_aaaa, iy3_1_bbbb,
+                       iy3_1_abab, iy3_1_baba, iy3_1_baab, iy3_1_abba, iy3_1_2_a, iy3_1_2_b,
+                       iy3_aaaa, iy3_bbbb, iy3_abab, iy3_baba, iy3_baab, iy3_abba, iy4_1_aaaa,
+                       iy4_1_baab, iy4_1_baba, iy4_1_bbbb, iy4_1_abba, iy4_1_abab, iy4_2_aaaa,
+                       iy4_2_baab, iy4_2_bbbb, iy4_2_abba, iy5_aaaa, iy5_abab, iy5_baab, iy5_bbbb,
+                       iy5_baba, iy5_abba, iy6_a, iy6_b);
+    {
+      const double vec_gib =
+        (nvir + 2.0 * noa * nvir * nvir) * sizeof(std::complex<T>) / (1024 * 1024 * 1024.0);
+      gfcc_plan.allocate_gib("EA preconditioners", omega_space_ea.size() * vec_gib);
+      gfcc_plan.allocate_gib("EA GMRES vectors of one solve", (ngmres + 9) * vec_gib);
+    }
+    gfcc_plan.check(ec, "the GF-CCSD EA calculation");
+
     sch
       .allocate(t2v2_v, lt12_v_a, lt12_v_b, iy1_1_a, iy1_1_b, iy1_2_1_a, iy1_2_1_b, iy1_a, iy1_b,
                 iy2_a, iy2_b, iy3_1_aaaa, iy3_1_bbbb, iy3_1_abab, iy3_1_baba, iy3_1_baab,
@@ -6380,7 +6617,8 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   }
 #endif // gf_ea
 
-  sch.deallocate(cholVpr, d_f1, d_t1, d_t2).execute();
+  sch.deallocate(d_f1, d_t1, d_t2).execute();
+  exachem::cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
   /////////////////Free tensors////////////////////////////
   //#endif
@@ -6408,6 +6646,8 @@ void gfccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   }
 #endif
 
+  gfcc_plan.validate(ec, chem_env.telemetry);
+
   cc_t2 = std::chrono::high_resolution_clock::now();
 
   ccsd_time = std::chrono::duration_cast<std::chrono::duration<T>>((cc_t2 - cc_t1)).count();
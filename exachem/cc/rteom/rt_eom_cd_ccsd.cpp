@@ -243,6 +243,9 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
   auto chol3d_vo = chol3d_se[2];
   auto chol3d_vv = chol3d_se[3];
 
+  // _a009 = L~(k,i) and _a021 = L~(a,b) per spin, the T1-dressed cholesky vectors
+  t1_dress_chol_os(sch, CI, t1_aa, t1_bb, chol3d_se, _a009, _a021);
+
   // clang-format off
   sch 
     (_a017("aa")(p3_va, h2_oa, cind)            = -1.0   * t2_aaaa(p1_va, p3_va, h3_oa, h2_oa) * chol3d_ov("aa")(h3_oa, p1_va, cind), 
@@ -261,35 +264,23 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
     "_a007V(cind)                               =  1.0   * chol3d_ov( aa )(h4_oa, p1_va, cind) * t1_aa(p1_va, h4_oa)")
     (_a007V(cind)                              +=  1.0   * chol3d_ov("bb")(h4_ob, p1_vb, cind) * t1_bb(p1_vb, h4_ob), 
     "_a007V(cind)                              +=  1.0   * chol3d_ov( bb )(h4_ob, p1_vb, cind) * t1_bb(p1_vb, h4_ob)")
-    (_a009("aa")(h3_oa, h2_oa, cind)            =  1.0   * chol3d_ov("aa")(h3_oa, p1_va, cind) * t1_aa(p1_va, h2_oa), 
-    "_a009( aa )(h3_oa, h2_oa, cind)            =  1.0   * chol3d_ov( aa )(h3_oa, p1_va, cind) * t1_aa(p1_va, h2_oa)")
-    (_a009("bb")(h3_ob, h2_ob, cind)            =  1.0   * chol3d_ov("bb")(h3_ob, p1_vb, cind) * t1_bb(p1_vb, h2_ob), 
-    "_a009( bb )(h3_ob, h2_ob, cind)            =  1.0   * chol3d_ov( bb )(h3_ob, p1_vb, cind) * t1_bb(p1_vb, h2_ob)")
-    (_a021("aa")(p3_va, p1_va, cind)            = -0.5   * chol3d_ov("aa")(h3_oa, p1_va, cind) * t1_aa(p3_va, h3_oa), 
-    "_a021( aa )(p3_va, p1_va, cind)            = -0.5   * chol3d_ov( aa )(h3_oa, p1_va, cind) * t1_aa(p3_va, h3_oa)")
-    (_a021("bb")(p3_vb, p1_vb, cind)            = -0.5   * chol3d_ov("bb")(h3_ob, p1_vb, cind) * t1_bb(p3_vb, h3_ob), 
-    "_a021( bb )(p3_vb, p1_vb, cind)            = -0.5   * chol3d_ov( bb )(h3_ob, p1_vb, cind) * t1_bb(p3_vb, h3_ob)")
-    (_a021("aa")(p3_va, p1_va, cind)           +=  0.5   * chol3d_vv("aa")(p3_va, p1_va, cind), 
-    "_a021( aa )(p3_va, p1_va, cind)           +=  0.5   * chol3d_vv( aa )(p3_va, p1_va, cind)")
-    (_a021("bb")(p3_vb, p1_vb, cind)           +=  0.5   * chol3d_vv("bb")(p3_vb, p1_vb, cind), 
-    "_a021( bb )(p3_vb, p1_vb, cind)           +=  0.5   * chol3d_vv( bb )(p3_vb, p1_vb, cind)")
-    (_a017("aa")(p3_va, h2_oa, cind)           += -2.0   * t1_aa(p2_va, h2_oa) * _a021("aa")(p3_va, p2_va, cind), 
-    "_a017( aa )(p3_va, h2_oa, cind)           += -2.0   * t1_aa(p2_va, h2_oa) * _a021( aa )(p3_va, p2_va, cind)")
-    (_a017("bb")(p3_vb, h2_ob, cind)           += -2.0   * t1_bb(p2_vb, h2_ob) * _a021("bb")(p3_vb, p2_vb, cind), 
-    "_a017( bb )(p3_vb, h2_ob, cind)           += -2.0   * t1_bb(p2_vb, h2_ob) * _a021( bb )(p3_vb, p2_vb, cind)")
+    (_a017("aa")(p3_va, h2_oa, cind)           += -1.0   * t1_aa(p2_va, h2_oa) * _a021("aa")(p3_va, p2_va, cind), 
+    "_a017( aa )(p3_va, h2_oa, cind)           += -1.0   * t1_aa(p2_va, h2_oa) * _a021( aa )(p3_va, p2_va, cind)")
+    (_a017("bb")(p3_vb, h2_ob, cind)           += -1.0   * t1_bb(p2_vb, h2_ob) * _a021("bb")(p3_vb, p2_vb, cind), 
+    "_a017( bb )(p3_vb, h2_ob, cind)           += -1.0   * t1_bb(p2_vb, h2_ob) * _a021( bb )(p3_vb, p2_vb, cind)")
     (_a008("aa")(h3_oa, h1_oa, cind)            =  1.0   * _a009("aa")(h3_oa, h1_oa, cind), 
     "_a008( aa )(h3_oa, h1_oa, cind)            =  1.0   * _a009( aa )(h3_oa, h1_oa, cind)")
+    (_a008("aa")(h3_oa, h1_oa, cind)           += -1.0   * chol3d_oo("aa")(h3_oa, h1_oa, cind), 
+    "_a008( aa )(h3_oa, h1_oa, cind)           += -1.0   * chol3d_oo( aa )(h3_oa, h1_oa, cind)")
     (_a008("bb")(h3_ob, h1_ob, cind)            =  1.0   * _a009("bb")(h3_ob, h1_ob, cind), 
     "_a008( bb )(h3_ob, h1_ob, cind)            =  1.0   * _a009( bb )(h3_ob, h1_ob, cind)")
-    (_a009("aa")(h3_oa, h1_oa, cind)           +=  1.0   * chol3d_oo("aa")(h3_oa, h1_oa, cind), 
-    "_a009( aa )(h3_oa, h1_oa, cind)           +=  1.0   * chol3d_oo( aa )(h3_oa, h1_oa, cind)")
-    (_a009("bb")(h3_ob, h1_ob, cind)           +=  1.0   * chol3d_oo("bb")(h3_ob, h1_ob, cind), 
-    "_a009( bb )(h3_ob, h1_ob, cind)           +=  1.0   * chol3d_oo( bb )(h3_ob, h1_ob, cind)")
-
-    (_a001("aa")(p4_va, p2_va)                  = -2.0   * _a021("aa")(p4_va, p2_va, cind) * _a007V(cind), 
-    "_a001( aa )(p4_va, p2_va)                  = -2.0   * _a021( aa )(p4_va, p2_va, cind) * _a007V(cind)")
-    (_a001("bb")(p4_vb, p2_vb)                  = -2.0   * _a021("bb")(p4_vb, p2_vb, cind) * _a007V(cind), 
-    "_a001( bb )(p4_vb, p2_vb)                  = -2.0   * _a021( bb )(p4_vb, p2_vb, cind) * _a007V(cind)")
+    (_a008("bb")(h3_ob, h1_ob, cind)           += -1.0   * chol3d_oo("bb")(h3_ob, h1_ob, cind), 
+    "_a008( bb )(h3_ob, h1_ob, cind)           += -1.0   * chol3d_oo( bb )(h3_ob, h1_ob, cind)")
+
+    (_a001("aa")(p4_va, p2_va)                  = -1.0   * _a021("aa")(p4_va, p2_va, cind) * _a007V(cind), 
+    "_a001( aa )(p4_va, p2_va)                  = -1.0   * _a021( aa )(p4_va, p2_va, cind) * _a007V(cind)")
+    (_a001("bb")(p4_vb, p2_vb)                  = -1.0   * _a021("bb")(p4_vb, p2_vb, cind) * _a007V(cind), 
+    "_a001( bb )(p4_vb, p2_vb)                  = -1.0   * _a021( bb )(p4_vb, p2_vb, cind) * _a007V(cind)")
     (_a001("aa")(p4_va, p2_va)                 += -1.0   * _a017("aa")(p4_va, h2_oa, cind) * chol3d_ov("aa")(h2_oa, p2_va, cind), 
     "_a001( aa )(p4_va, p2_va)                 += -1.0   * _a017( aa )(p4_va, h2_oa, cind) * chol3d_ov( aa )(h2_oa, p2_va, cind)")
     (_a001("bb")(p4_vb, p2_vb)                 += -1.0   * _a017("bb")(p4_vb, h2_ob, cind) * chol3d_ov("bb")(h2_ob, p2_vb, cind), 
@@ -308,14 +299,14 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
     "_a019( abab )(h4_oa, h3_ob, h1_oa, h2_ob)  =  0.25  * _a009( aa )(h4_oa, h1_oa, cind) * _a009( bb )(h3_ob, h2_ob, cind)")
     (_a019("bbbb")(h4_ob, h3_ob, h1_ob, h2_ob)  =  0.25  * _a009("bb")(h4_ob, h1_ob, cind) * _a009("bb")(h3_ob, h2_ob, cind), 
     "_a019( bbbb )(h4_ob, h3_ob, h1_ob, h2_ob)  =  0.25  * _a009( bb )(h4_ob, h1_ob, cind) * _a009( bb )(h3_ob, h2_ob, cind)") 
-    (_a020("aaaa")(p4_va, h4_oa, p1_va, h1_oa)  = -2.0   * _a009("aa")(h4_oa, h1_oa, cind) * _a021("aa")(p4_va, p1_va, cind), 
-    "_a020( aaaa )(p4_va, h4_oa, p1_va, h1_oa)  = -2.0   * _a009( aa )(h4_oa, h1_oa, cind) * _a021( aa )(p4_va, p1_va, cind)")
-    (_a020("abab")(p4_va, h4_ob, p1_va, h1_ob)  = -2.0   * _a009("bb")(h4_ob, h1_ob, cind) * _a021("aa")(p4_va, p1_va, cind), 
-    "_a020( abab )(p4_va, h4_ob, p1_va, h1_ob)  = -2.0   * _a009( bb )(h4_ob, h1_ob, cind) * _a021( aa )(p4_va, p1_va, cind)")
-    (_a020("baba")(p4_vb, h4_oa, p1_vb, h1_oa)  = -2.0   * _a009("aa")(h4_oa, h1_oa, cind) * _a021("bb")(p4_vb, p1_vb, cind), 
-    "_a020( baba )(p4_vb, h4_oa, p1_vb, h1_oa)  = -2.0   * _a009( aa )(h4_oa, h1_oa, cind) * _a021( bb )(p4_vb, p1_vb, cind)")
-    (_a020("bbbb")(p4_vb, h4_ob, p1_vb, h1_ob)  = -2.0   * _a009("bb")(h4_ob, h1_ob, cind) * _a021("bb")(p4_vb, p1_vb, cind), 
-    "_a020( bbbb )(p4_vb, h4_ob, p1_vb, h1_ob)  = -2.0   * _a009( bb )(h4_ob, h1_ob, cind) * _a021( bb )(p4_vb, p1_vb, cind)")
+    (_a020("aaaa")(p4_va, h4_oa, p1_va, h1_oa)  = -1.0   * _a009("aa")(h4_oa, h1_oa, cind) * _a021("aa")(p4_va, p1_va, cind), 
+    "_a020( aaaa )(p4_va, h4_oa, p1_va, h1_oa)  = -1.0   * _a009( aa )(h4_oa, h1_oa, cind) * _a021( aa )(p4_va, p1_va, cind)")
+    (_a020("abab")(p4_va, h4_ob, p1_va, h1_ob)  = -1.0   * _a009("bb")(h4_ob, h1_ob, cind) * _a021("aa")(p4_va, p1_va, cind), 
+    "_a020( abab )(p4_va, h4_ob, p1_va, h1_ob)  = -1.0   * _a009( bb )(h4_ob, h1_ob, cind) * _a021( aa )(p4_va, p1_va, cind)")
+    (_a020("baba")(p4_vb, h4_oa, p1_vb, h1_oa)  = -1.0   * _a009("aa")(h4_oa, h1_oa, cind) * _a021("bb")(p4_vb, p1_vb, cind), 
+    "_a020( baba )(p4_vb, h4_oa, p1_vb, h1_oa)  = -1.0   * _a009( aa )(h4_oa, h1_oa, cind) * _a021( bb )(p4_vb, p1_vb, cind)")
+    (_a020("bbbb")(p4_vb, h4_ob, p1_vb, h1_ob)  = -1.0   * _a009("bb")(h4_ob, h1_ob, cind) * _a021("bb")(p4_vb, p1_vb, cind), 
+    "_a020( bbbb )(p4_vb, h4_ob, p1_vb, h1_ob)  = -1.0   * _a009( bb )(h4_ob, h1_ob, cind) * _a021( bb )(p4_vb, p1_vb, cind)")
 
     (_a017("aa")(p3_va, h2_oa, cind)           +=  1.0   * t1_aa(p3_va, h3_oa) * chol3d_oo("aa")(h3_oa, h2_oa, cind), 
     "_a017( aa )(p3_va, h2_oa, cind)           +=  1.0   * t1_aa(p3_va, h3_oa) * chol3d_oo( aa )(h3_oa, h2_oa, cind)")
@@ -339,12 +330,12 @@ void ccsd_t2_os(Scheduler& sch, const TiledIndexSpace& MO, const TiledIndexSpace
     "_a022( abab )(p3_va,p4_vb,p2_va,p1_vb)     =  1.0   * _a021( aa )(p3_va,p2_va,cind) * _a021( bb )(p4_vb,p1_vb,cind)")
     (_a022("bbbb")(p3_vb,p4_vb,p2_vb,p1_vb)     =  1.0   * _a021("bb")(p3_vb,p2_vb,cind) * _a021("bb")(p4_vb,p1_vb,cind), 
     "_a022( bbbb )(p3_vb,p4_vb,p2_vb,p1_vb)     =  1.0   * _a021( bb )(p3_vb,p2_vb,cind) * _a021( bb )(p4_vb,p1_vb,cind)")
-    (i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  1.0   * _a022("aaaa")(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa), 
-    "i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  1.0   * _a022( aaaa )(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa)")
-    (i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  1.0   * _a022("bbbb")(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob), 
-    "i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  1.0   * _a022( bbbb )(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob)")
-    (i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  4.0   * _a022("abab")(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob), 
-    "i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  4.0   * _a022( abab )(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob)")
+    (i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  0.25  * _a022("aaaa")(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa), 
+    "i0_aaaa(p3_va, p4_va, h1_oa, h2_oa)       +=  0.25  * _a022( aaaa )(p3_va, p4_va, p2_va, p1_va) * t2_aaaa(p2_va,p1_va,h1_oa,h2_oa)")
+    (i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  0.25  * _a022("bbbb")(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob), 
+    "i0_bbbb(p3_vb, p4_vb, h1_ob, h2_ob)       +=  0.25  * _a022( bbbb )(p3_vb, p4_vb, p2_vb, p1_vb) * t2_bbbb(p2_vb,p1_vb,h1_ob,h2_ob)")
+    (i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  1.0   * _a022("abab")(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob), 
+    "i0_abab(p3_va, p4_vb, h1_oa, h2_ob)       +=  1.0   * _a022( abab )(p3_va, p4_vb, p2_va, p1_vb) * t2_abab(p2_va,p1_vb,h1_oa,h2_ob)")
     (_a019("aaaa")(h4_oa, h3_oa, h1_oa, h2_oa) += -0.125 * _a004("aaaa")(p1_va, p2_va, h3_oa, h4_oa) * t2_aaaa(p1_va,p2_va,h1_oa,h2_oa), 
     "_a019( aaaa )(h4_oa, h3_oa, h1_oa, h2_oa) += -0.125 * _a004( aaaa )(p1_va, p2_va, h3_oa, h4_oa) * t2_aaaa(p1_va,p2_va,h1_oa,h2_oa)")
     (_a019("abab")(h4_oa, h3_ob, h1_oa, h2_ob) +=  0.25  * _a004("abab")(p1_va, p2_vb, h4_oa, h3_ob) * t2_abab(p1_va,p2_vb,h1_oa,h2_ob), 
@@ -1001,7 +992,7 @@ void rt_eom_cd_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -1031,7 +1022,7 @@ void rt_eom_cd_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
   if(cc_restart) {
     read_from_disk(d_f1, f1file);
-    read_from_disk(cholVpr, v2file);
+    exachem::cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
     // p_evl_sorted = tamm::diagonal(d_f1);
   }
@@ -1041,7 +1032,7 @@ void rt_eom_cd_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    exachem::cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -1054,8 +1045,9 @@ void rt_eom_cd_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env) {
   ComplexTensor d_f1_c{{d_f1.tiled_index_spaces()}, {1, 1}};
   ComplexTensor cholVpr_c{{cholVpr.tiled_index_spaces()}, {1, 1}};
   sch.allocate(cholVpr_c, d_f1_c)(d_f1_c() = d_f1())(cholVpr_c() = cholVpr())
-    .deallocate(d_f1, cholVpr)
+    .deallocate(d_f1)
     .execute();
+  exachem::cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
   std::vector<rteom_cc::ccsd::CCEType> p_evl_sorted = tamm::diagonal(d_f1_c);
 
@@ -6,10 +6,13 @@ set(CD_INCLUDES
     ${CD_SRCDIR}/cholesky/cholesky_2e.hpp
     ${CD_SRCDIR}/cholesky/v2tensors.cpp
     ${CD_SRCDIR}/cholesky/cholesky_2e_driver.hpp
+    ${CD_SRCDIR}/cholesky/mo_ints_file.hpp
+    ${CD_SRCDIR}/cholesky/orbital_localization.hpp
     )
 set(CD_SRCS
     ${CD_SRCDIR}/cholesky/cholesky_2e.cpp
     ${CD_SRCDIR}/cholesky/v2tensors.cpp
     ${CD_SRCDIR}/cholesky/cholesky_2e_driver.cpp
+    ${CD_SRCDIR}/cholesky/orbital_localization.cpp
     )
 
@@ -8,6 +8,7 @@
  */
 
 #include "cholesky/cholesky_2e.hpp"
+#include "common/memory_plan.hpp"
 using namespace exachem::scf;
 bool cd_debug = false;
 #define CD_USE_PGAS_API
@@ -21,7 +22,8 @@ auto cd_tensor_zero(Tensor<T>& tens) {
 
 namespace exachem::cholesky_2e {
 
-std::tuple<TiledIndexSpace, TAMM_SIZE> setup_mo_red(ChemEnv& chem_env, bool triples) {
+std::tuple<TiledIndexSpace, TAMM_SIZE> setup_mo_red(ExecutionContext& ec, ChemEnv& chem_env,
+                                                    bool triples) {
   SystemData& sys_data    = chem_env.sys_data;
   TAMM_SIZE   n_occ_alpha = sys_data.n_occ_alpha;
   TAMM_SIZE   n_vir_alpha = sys_data.n_vir_alpha;
@@ -32,7 +34,7 @@ std::tuple<TiledIndexSpace, TAMM_SIZE> setup_mo_red(ChemEnv& chem_env, bool trip
        !chem_env.ioptions.ccsd_options.force_tilesize) {
       tce_tile = static_cast<Tile>(sys_data.nbf / 10);
       if(tce_tile < 50) tce_tile = 50; // 50 is the default tilesize for CCSD.
-      if(ProcGroup::world_rank() == 0)
+      if(ec.pg().rank() == 0)
         std::cout << std::endl << "Resetting CCSD tilesize to: " << tce_tile << std::endl;
     }
   }
@@ -60,7 +62,8 @@ std::tuple<TiledIndexSpace, TAMM_SIZE> setup_mo_red(ChemEnv& chem_env, bool trip
   return std::make_tuple(MO, total_orbitals);
 }
 
-std::tuple<TiledIndexSpace, TAMM_SIZE> setupMOIS(ChemEnv& chem_env, bool triples, int nactv) {
+std::tuple<TiledIndexSpace, TAMM_SIZE> setupMOIS(ExecutionContext& ec, ChemEnv& chem_env,
+                                                 bool triples, int nactv) {
   SystemData& sys_data    = chem_env.sys_data;
   TAMM_SIZE   n_occ_alpha = sys_data.n_occ_alpha;
   TAMM_SIZE   n_occ_beta  = sys_data.n_occ_beta;
@@ -75,7 +78,7 @@ std::tuple<TiledIndexSpace, TAMM_SIZE> setupMOIS(ChemEnv& chem_env, bool triples
       tce_tile = static_cast<Tile>(sys_data.nbf / 10);
       if(tce_tile < 50) tce_tile = 50;   // 50 is the default tilesize for CCSD.
       if(tce_tile > 100) tce_tile = 100; // 100 is the max tilesize for CCSD.
-      if(ProcGroup::world_rank() == 0)
+      if(ec.pg().rank() == 0)
         std::cout << std::endl << "Resetting CCSD tilesize to: " << tce_tile << std::endl;
     }
   }
@@ -195,7 +198,7 @@ std::tuple<TiledIndexSpace, TAMM_SIZE> setupMOIS(ChemEnv& chem_env, bool triples
   return std::make_tuple(MO, total_orbitals);
 }
 
-void update_sysdata(ChemEnv& chem_env, TiledIndexSpace& MO, bool is_mso) {
+void update_sysdata(ExecutionContext& ec, ChemEnv& chem_env, TiledIndexSpace& MO, bool is_mso) {
   SystemData& sys_data       = chem_env.sys_data;
   const bool  do_freeze      = sys_data.n_frozen_core > 0 || sys_data.n_frozen_virtual > 0;
   TAMM_SIZE   total_orbitals = sys_data.nmo;
@@ -208,11 +211,61 @@ void update_sysdata(ChemEnv& chem_env, TiledIndexSpace& MO, bool is_mso) {
       sys_data.n_vir_beta -= sys_data.n_frozen_virtual;
     }
     sys_data.update();
-    if(!is_mso) std::tie(MO, total_orbitals) = setup_mo_red(chem_env);
-    else std::tie(MO, total_orbitals) = cholesky_2e::setupMOIS(chem_env);
+    if(!is_mso) std::tie(MO, total_orbitals) = setup_mo_red(ec, chem_env);
+    else std::tie(MO, total_orbitals) = cholesky_2e::setupMOIS(ec, chem_env);
   }
 }
 
+bool is_spatial_chol(ChemEnv& chem_env, bool is_mso) {
+  return is_mso && chem_env.sys_data.is_restricted &&
+         chem_env.ioptions.cd_options.spatial_storage;
+}
+
+TiledIndexSpace setup_mo_spatial(ChemEnv& chem_env, const TiledIndexSpace& MO) {
+  SystemData&     sys_data    = chem_env.sys_data;
+  const TAMM_SIZE n_occ_alpha = sys_data.n_occ_alpha;
+  const TAMM_SIZE nmo_s       = n_occ_alpha + sys_data.n_vir_alpha;
+
+  IndexSpace MO_IS{range(0, nmo_s),
+                   {{"occ", {range(0, n_occ_alpha)}}, {"virt", {range(n_occ_alpha, nmo_s)}}}};
+
+  // same tiles as occ_alpha and virt_alpha, so that spin blocks map onto spatial blocks
+  std::vector<Tile> mo_tiles;
+  for(const std::string sp: {"occ_alpha", "virt_alpha"}) {
+    const TiledIndexSpace& tis = MO(sp);
+    for(Index t = 0; t < tis.num_tiles(); t++) mo_tiles.push_back(tis.tile_size(t));
+  }
+
+  return TiledIndexSpace{MO_IS, mo_tiles};
+}
+
+std::pair<Index, int> spatial_tile(const TiledIndexSpace& MO, Index t) {
+  const Index noat = MO("occ_alpha").num_tiles();
+  const Index nvat = MO("virt_alpha").num_tiles();
+
+  // MO tiles are ordered {occ_alpha, occ_beta, virt_alpha, virt_beta}
+  if(t < noat) return {t, 0};
+  if(t < 2 * noat) return {t - noat, 1};
+  if(t < 2 * noat + nvat) return {t - noat, 0};
+  return {t - noat - nvat, 1};
+}
+
+template<typename T>
+Tensor<T> chol_spin_view(const TiledIndexSpace& MO, Tensor<T> cholV_s) {
+  auto chol_block = [MO, cholV_s](const IndexVector& blockid, span<T> buf) mutable {
+    const auto [p, p_spin] = spatial_tile(MO, blockid[0]);
+    const auto [q, q_spin] = spatial_tile(MO, blockid[1]);
+    if(p_spin != q_spin) {
+      std::fill(buf.begin(), buf.end(), T{0});
+      return;
+    }
+    cholV_s.get(IndexVector{p, q, blockid[2]}, buf);
+  };
+
+  TiledIndexSpace N = MO("all");
+  return Tensor<T>{{N, N, cholV_s.tiled_index_spaces()[2]}, chol_block};
+}
+
 // reshape F/lcao after freezing
 Matrix reshape_mo_matrix(ChemEnv& chem_env, Matrix& emat, bool is_lcao) {
   SystemData& sys_data = chem_env.sys_data;
@@ -303,9 +356,7 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
   ExecutionContext ec_dense{ec.pg(), DistributionKind::dense, MemoryManagerKind::ga};
   auto             rank = ec_dense.pg().rank().value();
 
-  TAMM_GA_SIZE    N = tMO("all").max_num_indices();
-  IndexSpace      CI{range(0, max_cvecs)};
-  TiledIndexSpace tCI{CI, static_cast<Tile>(max_cvecs)};
+  TAMM_GA_SIZE N = tMO("all").max_num_indices();
 
   Matrix lcao_eig(nao, N);
   lcao_eig.setZero();
@@ -331,18 +382,42 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
   std::vector<int64_t> hi_x(4, -2); // The upper limits of blocks
   std::vector<int64_t> ld_x(4);     // The leading dims of blocks
 
+  bool cd_restart = write_cv.first && fs::exists(diag_ao_file) && fs::exists(chol_ao_file) &&
+                    fs::exists(cv_count_file);
+
+#if !defined(USE_UPCXX)
+  if(cd_restart) {
+    std::ifstream in(cv_count_file, std::ios::in);
+    int           rstatus = 0;
+    if(in.is_open()) rstatus = 1;
+    if(rstatus == 1) in >> count;
+    else tamm_terminate("Error reading " + cv_count_file);
+  }
+#endif
+
+  // The storage for the cholesky vectors grows in chunks of nbf vectors as pivots are accepted,
+  // max_cvecs is only an upper bound for the number of vectors. A grow copies the k chunks
+  // computed so far into a new allocation of k+1 chunks, so the peak of the decomposition is
+  // 2k+1 chunks at the last grow, not the final capacity. cd_plan records both allocations.
+  const TAMM_GA_SIZE cv_chunk    = std::min<TAMM_GA_SIZE>(nbf, max_cvecs);
+  auto               cv_capacity = [&](int64_t ncv) {
+    const TAMM_GA_SIZE nchunks = std::max<TAMM_GA_SIZE>(1, (ncv + cv_chunk - 1) / cv_chunk);
+    return std::min<TAMM_GA_SIZE>(max_cvecs, nchunks * cv_chunk);
+  };
+
+  TAMM_GA_SIZE    cv_cap = cv_capacity(count);
+  IndexSpace      CI{range(0, cv_cap)};
+  TiledIndexSpace tCI{CI, static_cast<Tile>(cv_cap)};
+
   Tensor<TensorType> g_d_tamm{tAO, tAO};
   Tensor<TensorType> g_r_tamm{tAO, tAO};
   Tensor<TensorType> g_chol_tamm{tAO, tAO, tCI};
 
-  double cd_mem_req       = sum_tensor_sizes(g_d_tamm, g_r_tamm, g_chol_tamm);
-  auto   check_cd_mem_req = [&](const std::string mstep) {
-    if(ec.print())
-      std::cout << "- CPU memory required for " << mstep << ": " << std::fixed
-                << std::setprecision(2) << cd_mem_req << " GiB" << std::endl;
-    check_memory_requirements(ec, cd_mem_req);
-  };
-  check_cd_mem_req("computing cholesky vectors");
+  MemoryPlan cd_plan{ec, "CD", chem_env.ioptions.common_options.memory_overhead};
+  cd_plan.allocate("diagonal", g_d_tamm);
+  cd_plan.allocate("residual", g_r_tamm);
+  cd_plan.allocate("ao cholesky vectors", g_chol_tamm);
+  cd_plan.check(ec, "computing cholesky vectors");
 
   g_r_tamm.set_dense();
   g_d_tamm.set_dense();
@@ -368,7 +443,7 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
     }
   };
 
-  const int g_chol = g_chol_tamm.ga_handle();
+  int       g_chol = g_chol_tamm.ga_handle();
   const int g_d    = g_d_tamm.ga_handle();
   const int g_r    = g_r_tamm.ga_handle();
 
@@ -396,6 +471,46 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
 #endif
 #endif
 
+  // Moves the vectors computed so far into storage for the next chunk of vectors. The old and
+  // the new storage are both allocated while the vectors are copied.
+  auto grow_chol_vectors = [&]() {
+    const TAMM_GA_SIZE new_cap = cv_capacity(count + 1);
+    IndexSpace         CIn{range(0, new_cap)};
+    TiledIndexSpace    tCIn{CIn, static_cast<Tile>(new_cap)};
+    Tensor<TensorType> g_chol_new{tAO, tAO, tCIn};
+
+    cd_plan.allocate("ao cholesky vectors", g_chol_new);
+    cd_plan.check(ec, "growing the cholesky vectors to " + std::to_string(new_cap));
+
+    g_chol_new.set_dense();
+    Tensor<TensorType>::allocate(&ec_dense, g_chol_new);
+
+    auto copy_cvecs = [&](const IndexVector& blockid) {
+      const auto              block_dims = g_chol_new.block_dims(blockid);
+      std::vector<TensorType> obuf(g_chol_tamm.block_size(blockid));
+      std::vector<TensorType> nbuf(g_chol_new.block_size(blockid), 0);
+      g_chol_tamm.get(blockid, obuf);
+      for(size_t ij = 0; ij < block_dims[0] * block_dims[1]; ij++)
+        std::copy_n(obuf.begin() + ij * cv_cap, count, nbuf.begin() + ij * new_cap);
+      g_chol_new.put(blockid, nbuf);
+    };
+    block_for(ec_dense, g_chol_new(), copy_cvecs);
+
+    cd_plan.deallocate("ao cholesky vectors");
+    Tensor<TensorType>::deallocate(g_chol_tamm);
+    g_chol_tamm = g_chol_new;
+    cv_cap      = new_cap;
+
+#if !defined(USE_UPCXX)
+    g_chol = g_chol_tamm.ga_handle();
+#if defined(CD_USE_PGAS_API)
+    NGA_Distribution64(g_chol, rank, lo_b.data(), hi_b.data());
+    has_gc_data = (lo_b[0] >= 0 && hi_b[0] >= 0);
+#endif
+#endif
+    ec_dense.pg().barrier();
+  };
+
   ec_dense.pg().barrier();
 
   auto cd_t1 = std::chrono::high_resolution_clock::now();
@@ -406,9 +521,6 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
   Engine      engine(Operator::coulomb, max_nprim(shells), max_l(shells), 0);
   const auto& buf = engine.results();
 
-  bool cd_restart = write_cv.first && fs::exists(diag_ao_file) && fs::exists(chol_ao_file) &&
-                    fs::exists(cv_count_file);
-
   auto compute_diagonals = [&](const IndexVector& blockid) {
     auto bi0 = blockid[0];
     auto bi1 = blockid[1];
@@ -481,6 +593,7 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
               << "- Time for computing the diagonal: " << std::fixed << std::setprecision(2)
               << cd_time << " secs" << endl;
   }
+  if(!cd_restart) chem_env.telemetry.record(ec.pg(), "CD", "diagonal", cd_time);
 
 #if !defined(USE_UPCXX)
   if(cd_restart) {
@@ -489,12 +602,6 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
     read_from_disk(g_d_tamm, diag_ao_file);
     read_from_disk(g_chol_tamm, chol_ao_file);
 
-    std::ifstream in(cv_count_file, std::ios::in);
-    int           rstatus = 0;
-    if(in.is_open()) rstatus = 1;
-    if(rstatus == 1) in >> count;
-    else tamm_terminate("Error reading " + cv_count_file);
-
     if(rank == 0)
       cout << endl << "- [CD restart] Number of cholesky vectors read = " << count << endl;
 
@@ -516,6 +623,8 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
   indx_d0[1] = (int64_t) blkoff[1] + (int64_t) eoff[1];
 
   while(val_d0 > diagtol && count < max_cvecs) {
+    if(count == cv_cap) grow_chol_vectors();
+
     auto bfu   = indx_d0[0];
     auto bfv   = indx_d0[1];
     auto s1    = bf2shell[bfu];
@@ -663,7 +772,7 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
     hi_x[3] = count;
 #endif
 
-    std::vector<TensorType> k_row(max_cvecs);
+    std::vector<TensorType> k_row(count + 1);
 
 #if !defined(CD_USE_PGAS_API)
     auto update_diagonals = [&](const IndexVector& blockid) {
@@ -750,17 +859,17 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
     auto right = g_chol_tamm.access_local_buf();
     auto n     = g_r_tamm.local_buf_size();
     for(size_t icount = 0; icount < count; icount++)
-      for(size_t i = 0, k = icount; i < n; i++, k += max_cvecs)
+      for(size_t i = 0, k = icount; i < n; i++, k += cv_cap)
         *(left + i) -= *(right + k) * k_row[icount];
 
-    for(size_t i = 0, k = count; i < n; i++, k += max_cvecs) {
+    for(size_t i = 0, k = count; i < n; i++, k += cv_cap) {
       auto tmp     = *(left + i) / sqrt(val_d0);
       *(right + k) = tmp;
     }
 
     left = g_d_tamm.access_local_buf();
     n    = g_d_tamm.local_buf_size();
-    for(size_t i = 0, k = count; i < n; i++, k += max_cvecs) {
+    for(size_t i = 0, k = count; i < n; i++, k += cv_cap) {
       auto tmp = *(right + k);
       *(left + i) -= tmp * tmp;
     }
@@ -852,8 +961,14 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
               << cd_time << " secs" << endl
               << endl;
   }
+  {
+    // updating the k-th residual column costs ~2*nbf^2*k flops
+    const double cd_flops = rank == 0 ? 1.0 * nbf * nbf * count * count : 0.0;
+    chem_env.telemetry.record(ec.pg(), "CD", "decomposition", cd_time, cd_flops,
+                              {{"num_chol_vectors", count}});
+  }
 
-  update_sysdata(chem_env, tMO, is_mso);
+  update_sysdata(ec, chem_env, tMO, is_mso);
 
   const bool do_freeze = (sys_data.n_frozen_core > 0 || sys_data.n_frozen_virtual > 0);
 
@@ -861,13 +976,14 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
   TiledIndexSpace    tCIp{CIp, static_cast<tamm::Tile>(itile_size)};
   Tensor<TensorType> g_chol_ao_tamm{tAO, tAO, tCIp};
 
-  cd_mem_req -= sum_tensor_sizes(g_d_tamm, g_r_tamm);
-  cd_mem_req += sum_tensor_sizes(g_chol_ao_tamm);
-  check_cd_mem_req("resizing the ao cholesky tensor");
+  cd_plan.deallocate("diagonal");
+  cd_plan.deallocate("residual");
+  cd_plan.allocate("packed ao cholesky vectors", g_chol_ao_tamm);
+  cd_plan.check(ec, "resizing the ao cholesky tensor");
 
   Tensor<TensorType>::allocate(&ec, g_chol_ao_tamm);
 
-  // Convert g_chol_tamm(nD with max_cvecs) to g_chol_ao_tamm(1D with chol_count)
+  // Convert g_chol_tamm(nD with cv_cap) to g_chol_ao_tamm(1D with chol_count)
   auto lambdacv = [&](const IndexVector& bid) {
     const IndexVector blockid = internal::translate_blockid(bid, g_chol_ao_tamm());
 
@@ -908,37 +1024,60 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
 
   Tensor<TensorType>::deallocate(g_chol_tamm);
 
-  Tensor<TensorType> CholVpr_tmp{tMO, tAO, tCIp};
-  Tensor<TensorType> CholVpr_tamm{{tMO, tMO, tCIp},
-                                  {SpinPosition::upper, SpinPosition::lower, SpinPosition::ignore}};
+  // a closed-shell reference is transformed with the alpha MO coefficients only
+  const bool         is_spatial = is_spatial_chol(chem_env, is_mso);
+  TiledIndexSpace    tMOp       = tMO;
+  Tensor<TensorType> lcao_p     = lcao;
+  if(is_spatial) {
+    tMOp   = setup_mo_spatial(chem_env, tMO);
+    lcao_p = Tensor<TensorType>{tAO, tMOp};
+    sch.allocate(lcao_p).execute();
+    if(rank == 0) {
+      const TAMM_SIZE n_occ_alpha = sys_data.n_occ_alpha;
+      const TAMM_SIZE n_vir_alpha = sys_data.n_vir_alpha;
+      Matrix          lcao_so     = tamm_to_eigen_matrix(lcao);
+      Matrix          lcao_s(lcao_so.rows(), n_occ_alpha + n_vir_alpha);
+      lcao_s << lcao_so.leftCols(n_occ_alpha), lcao_so.middleCols(sys_data.nocc, n_vir_alpha);
+      eigen_to_tamm_tensor(lcao_p, lcao_s);
+    }
+    ec.pg().barrier();
+  }
+
+  Tensor<TensorType> CholVpr_tmp{tMOp, tAO, tCIp};
+  Tensor<TensorType> CholVpr_tamm =
+    is_spatial ? Tensor<TensorType>{tMOp, tMOp, tCIp}
+               : Tensor<TensorType>{{tMO, tMO, tCIp},
+                                    {SpinPosition::upper, SpinPosition::lower, SpinPosition::ignore}};
   Tensor<TensorType>::allocate(&ec, CholVpr_tmp);
 
-  cd_mem_req -= sum_tensor_sizes(g_chol_tamm);
-  cd_mem_req += sum_tensor_sizes(CholVpr_tmp);
-  check_cd_mem_req("ao2mo transformation");
+  cd_plan.deallocate("ao cholesky vectors");
+  cd_plan.allocate("half-transformed cholesky vectors", CholVpr_tmp);
+  cd_plan.check(ec, "ao2mo transformation");
 
   auto [mu, nu]   = tAO.labels<2>("all");
-  auto [pmo, rmo] = tMO.labels<2>("all");
+  auto [pmo, rmo] = tMOp.labels<2>("all");
   auto cindexp    = tCIp.label("all");
 
   cd_t1 = std::chrono::high_resolution_clock::now();
 
   // clang-format off
   // Contraction 1
-  sch(CholVpr_tmp(pmo, mu, cindexp) = lcao(nu, pmo) * g_chol_ao_tamm(nu, mu, cindexp))
+  sch(CholVpr_tmp(pmo, mu, cindexp) = lcao_p(nu, pmo) * g_chol_ao_tamm(nu, mu, cindexp))
   .deallocate(g_chol_ao_tamm).execute(ec.exhw());
 
-  cd_mem_req -= sum_tensor_sizes(g_chol_ao_tamm);
-  cd_mem_req += sum_tensor_sizes(CholVpr_tamm);
-  check_cd_mem_req("the 2-step contraction");
+  cd_plan.deallocate("packed ao cholesky vectors");
+  cd_plan.allocate("mo cholesky vectors", CholVpr_tamm);
+  cd_plan.check(ec, "the 2-step contraction");
 
   // Contraction 2
   sch.allocate(CholVpr_tamm)
-  (CholVpr_tamm(pmo, rmo, cindexp) = lcao(mu, rmo) * CholVpr_tmp(pmo, mu, cindexp))
+  (CholVpr_tamm(pmo, rmo, cindexp) = lcao_p(mu, rmo) * CholVpr_tmp(pmo, mu, cindexp))
   .deallocate(CholVpr_tmp)
   .execute(ec.exhw());
   // clang-format on
 
+  if(is_spatial) sch.deallocate(lcao_p).execute();
+
   cd_t2   = std::chrono::high_resolution_clock::now();
   cd_time = std::chrono::duration_cast<std::chrono::duration<double>>((cd_t2 - cd_t1)).count();
   if(rank == 0) {
@@ -946,6 +1085,13 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
               << "- Time for ao to mo transform: " << std::fixed << std::setprecision(2) << cd_time
               << " secs" << endl;
   }
+  {
+    const double nmo_p    = tMOp.max_num_indices();
+    const double tr_flops = rank == 0 ? 2.0 * count * nmo_p * nbf * (nbf + nmo_p) : 0.0;
+    chem_env.telemetry.record(ec.pg(), "CD", "ao2mo", cd_time, tr_flops);
+  }
+
+  cd_plan.validate(ec, chem_env.telemetry);
 
   if(rank == 0) {
     cout << endl << "   End Cholesky Decomposition" << endl;
@@ -953,6 +1099,10 @@ Tensor<TensorType> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, TiledInd
   }
 
   chol_count = count;
+  if(is_spatial) {
+    chem_env.cholV_spatial = CholVpr_tamm;
+    return chol_spin_view(tMO, CholVpr_tamm);
+  }
   return CholVpr_tamm;
 }
 
@@ -960,4 +1110,6 @@ template Tensor<double> cholesky_2e(ChemEnv& chem_env, ExecutionContext& ec, Til
                                     TiledIndexSpace& tAO, TAMM_SIZE& chol_count,
                                     const TAMM_GA_SIZE max_cvecs, libint2::BasisSet& shells,
                                     Tensor<double>& lcao, bool is_mso);
-} // namespace exachem::cholesky_2e
\ No newline at end of file
+
+template Tensor<double> chol_spin_view(const TiledIndexSpace& MO, Tensor<double> cholV_s);
+} // namespace exachem::cholesky_2e
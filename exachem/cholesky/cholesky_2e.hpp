@@ -23,12 +23,28 @@ using namespace tamm;
 using TAMM_GA_SIZE = int64_t;
 
 namespace exachem::cholesky_2e {
-std::tuple<TiledIndexSpace, TAMM_SIZE> setup_mo_red(ChemEnv& chem_env, bool triples = false);
+std::tuple<TiledIndexSpace, TAMM_SIZE> setup_mo_red(ExecutionContext& ec, ChemEnv& chem_env,
+                                                    bool triples = false);
 
-std::tuple<TiledIndexSpace, TAMM_SIZE> setupMOIS(ChemEnv& chem_env, bool triples = false,
-                                                 int nactv = 0);
+std::tuple<TiledIndexSpace, TAMM_SIZE> setupMOIS(ExecutionContext& ec, ChemEnv& chem_env,
+                                                 bool triples = false, int nactv = 0);
 
-void update_sysdata(ChemEnv& chem_env, TiledIndexSpace& MO, bool is_mso = true);
+void update_sysdata(ExecutionContext& ec, ChemEnv& chem_env, TiledIndexSpace& MO,
+                    bool is_mso = true);
+
+// true if the cholesky vectors are stored once over spatial orbitals
+bool is_spatial_chol(ChemEnv& chem_env, bool is_mso = true);
+
+// spatial orbital space tiled like the alpha part of the spin-orbital space MO
+TiledIndexSpace setup_mo_spatial(ChemEnv& chem_env, const TiledIndexSpace& MO);
+
+// spatial tile and spin (0 = alpha, 1 = beta) of tile t of the spin-orbital space MO
+std::pair<Index, int> spatial_tile(const TiledIndexSpace& MO, Index t);
+
+// read-only view of spatial-orbital cholesky vectors over {MO("all"), MO("all"), CI}.
+// Blocks of mixed spin are zero, the alpha and beta blocks map onto the same spatial block.
+template<typename T>
+Tensor<T> chol_spin_view(const TiledIndexSpace& MO, Tensor<T> cholV_s);
 
 // reshape F/lcao after freezing
 Matrix reshape_mo_matrix(ChemEnv& chem_env, Matrix& emat, bool is_lcao = false);
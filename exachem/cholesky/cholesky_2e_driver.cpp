@@ -32,7 +32,7 @@ void exachem::cholesky_2e::cholesky_decomp_2e(ExecutionContext& ec, ChemEnv& che
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -53,7 +53,7 @@ void exachem::cholesky_2e::cholesky_decomp_2e(ExecutionContext& ec, ChemEnv& che
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -63,12 +63,204 @@ void exachem::cholesky_2e::cholesky_decomp_2e(ExecutionContext& ec, ChemEnv& che
     }
   }
 
-  free_tensors(d_f1, cholVpr);
+  free_tensors(d_f1);
+  cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
   ec.flush_and_sync();
   // delete ec;
 } // End of cholesky_decomp_2e
 
+template<typename T>
+void exachem::cholesky_2e::write_mo_ints(ChemEnv& chem_env, ExecutionContext& ec,
+                                         std::string filename, Tensor<T> hcore_mo, Tensor<T> d_f1,
+                                         Tensor<T> lcao, Tensor<T> cholVpr) {
+  SystemData& sys_data = chem_env.sys_data;
+  const auto  tis_v    = cholVpr.tiled_index_spaces();
+
+  // RHF references are written in the spatial orbital basis with the cholesky vectors packed
+  // over the orbital pairs p >= q. The spin-orbital tensors are mapped onto the alpha block.
+  const bool    spatial = sys_data.is_restricted;
+  const int64_t noa     = sys_data.n_occ_alpha;
+  const int64_t nob     = sys_data.n_occ_beta;
+  const int64_t nva     = sys_data.n_vir_alpha;
+  const bool    have_spatial_chol = spatial && is_spatial_chol(chem_env);
+  Tensor<T>     chol              = have_spatial_chol ? chem_env.cholV_spatial : cholVpr;
+
+  MOIntsHeader header{};
+  std::memcpy(header.magic, mo_ints_magic, sizeof(header.magic));
+  header.version      = mo_ints_version;
+  header.nao          = lcao.tiled_index_spaces()[0].max_num_indices();
+  header.nmo          = spatial ? noa + nva : tis_v[0].max_num_indices();
+  header.nchol        = tis_v[2].max_num_indices();
+  header.n_occ_alpha  = noa;
+  header.n_occ_beta   = nob;
+  header.spin_orbital = spatial ? 0 : 1;
+  header.pair_packed  = spatial ? 1 : 0;
+  header.hf_energy    = chem_env.hf_energy;
+  const auto offsets  = mo_ints_offsets(header);
+  const auto nmo      = header.nmo;
+  const auto nchol    = header.nchol;
+
+  const auto rank   = ec.pg().rank().value();
+  const auto nranks = ec.pg().size().value();
+
+  // spatial index of the spin-orbital {occ_a, occ_b, virt_a, virt_b}, -1 for the beta orbitals
+  auto mo_index = [&](int64_t i) -> int64_t {
+    if(!spatial) return i;
+    if(i < noa) return i;
+    if(i < noa + nob) return -1;
+    if(i < noa + nob + nva) return i - nob;
+    return -1;
+  };
+  auto chol_index = [&](int64_t i) { return have_spatial_chol ? i : mo_index(i); };
+
+  MPI_File fh;
+  MPI_File_open(ec.pg().comm(), filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                MPI_INFO_NULL, &fh);
+  // zero blocks are not written and read back as zeros
+  MPI_File_set_size(fh, offsets[4]);
+  if(rank == 0)
+    MPI_File_write_at(fh, 0, &header, sizeof(MOIntsHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+
+  const MPI_Datatype mpi_t = mpi_type<T>();
+
+  // The blocks are distributed round-robin over the ranks. The contiguous segments along the
+  // last mode of a rank's blocks, sorted by their position in the file, form one hindexed file
+  // type, and every section is written with a single collective call. file_pos maps the first
+  // element of a segment to its position in the section, or -1 if the segment is not exported.
+  // Tiles do not straddle spin blocks, so a segment is either exported as a whole or skipped.
+  auto write_section = [&](Tensor<T> tensor, int64_t offset, auto&& file_pos) {
+    const int ndim = tensor.tiled_index_spaces().size();
+
+    std::vector<T>                      local;
+    std::vector<std::array<int64_t, 3>> segs; // file position, position in local, length
+    std::vector<int64_t>                idx(ndim);
+    size_t                              ib = 0;
+    for(const auto& blockid: tensor.loop_nest()) {
+      if(ib++ % nranks != static_cast<size_t>(rank) || !tensor.is_non_zero(blockid)) continue;
+      const auto block_offset = tensor.block_offsets(blockid);
+      const auto block_dims   = tensor.block_dims(blockid);
+      const auto block_size   = tensor.block_size(blockid);
+
+      const int64_t seg      = block_dims[ndim - 1];
+      const size_t  nsegs    = block_size / seg;
+      const size_t  segs_old = segs.size();
+      idx[ndim - 1]          = block_offset[ndim - 1];
+      for(size_t s = 0; s < nsegs; s++) {
+        size_t rem = s;
+        for(int d = ndim - 2; d >= 0; d--) {
+          idx[d] = block_offset[d] + rem % block_dims[d];
+          rem /= block_dims[d];
+        }
+        const int64_t pos = file_pos(idx);
+        if(pos >= 0) segs.push_back({pos, static_cast<int64_t>(local.size() + s * seg), seg});
+      }
+      if(segs.size() == segs_old) continue;
+      std::vector<T> buf(block_size);
+      tensor.get(blockid, buf);
+      local.insert(local.end(), buf.begin(), buf.end());
+    }
+    std::sort(segs.begin(), segs.end());
+
+    size_t nwrite = 0;
+    for(const auto& s: segs) nwrite += s[2];
+    std::vector<T>        packed(nwrite);
+    std::vector<int>      seg_len(segs.size());
+    std::vector<MPI_Aint> seg_disp(segs.size());
+    for(size_t s = 0, p = 0; s < segs.size(); p += segs[s][2], s++) {
+      const auto [pos, src, len] = segs[s];
+      std::copy_n(local.begin() + src, len, packed.begin() + p);
+      seg_len[s]  = len;
+      seg_disp[s] = pos * sizeof(T);
+    }
+    local.clear();
+    local.shrink_to_fit();
+
+    MPI_Datatype filetype;
+    MPI_Type_create_hindexed(segs.size(), seg_len.data(), seg_disp.data(), mpi_t, &filetype);
+    MPI_Type_commit(&filetype);
+    MPI_File_set_view(fh, offset, mpi_t, filetype, "native", MPI_INFO_NULL);
+    MPI_File_write_at_all(fh, 0, packed.data(), packed.size(), mpi_t, MPI_STATUS_IGNORE);
+    MPI_Type_free(&filetype);
+  };
+
+  auto mo_mo_pos = [&](const std::vector<int64_t>& idx) -> int64_t {
+    const int64_t p = mo_index(idx[0]), q = mo_index(idx[1]);
+    return (p < 0 || q < 0) ? -1 : p * nmo + q;
+  };
+  auto ao_mo_pos = [&](const std::vector<int64_t>& idx) -> int64_t {
+    const int64_t q = mo_index(idx[1]);
+    return q < 0 ? -1 : idx[0] * nmo + q;
+  };
+  auto chol_pos = [&](const std::vector<int64_t>& idx) -> int64_t {
+    const int64_t p = chol_index(idx[0]), q = chol_index(idx[1]);
+    if(p < 0 || q < 0) return -1;
+    if(!spatial) return (p * nmo + q) * nchol + idx[2];
+    if(p < q) return -1;
+    return mo_ints_pair_index(p, q) * nchol + idx[2];
+  };
+
+  write_section(hcore_mo, offsets[0], mo_mo_pos);
+  write_section(d_f1, offsets[1], mo_mo_pos);
+  write_section(lcao, offsets[2], ao_mo_pos);
+  write_section(chol, offsets[3], chol_pos);
+
+  MPI_File_close(&fh);
+}
+
+template<typename T>
+void exachem::cholesky_2e::write_chol_vectors(ChemEnv& chem_env, Tensor<T>& cholVpr,
+                                              std::string v2file) {
+  if(is_spatial_chol(chem_env)) write_to_disk(chem_env.cholV_spatial, v2file);
+  else write_to_disk(cholVpr, v2file);
+}
+
+template<typename T>
+void exachem::cholesky_2e::read_chol_vectors(ChemEnv& chem_env, Tensor<T>& cholVpr,
+                                             std::string v2file) {
+  if(is_spatial_chol(chem_env)) read_from_disk(chem_env.cholV_spatial, v2file);
+  else read_from_disk(cholVpr, v2file);
+}
+
+template<typename T>
+void exachem::cholesky_2e::free_chol_vectors(ChemEnv& chem_env, Tensor<T>& cholVpr) {
+  if(is_spatial_chol(chem_env)) {
+    free_tensors(chem_env.cholV_spatial);
+    chem_env.cholV_spatial = {};
+  }
+  else free_tensors(cholVpr);
+}
+
+template<typename T>
+void exachem::cholesky_2e::retile_chol_vectors(ExecutionContext& ec, ChemEnv& chem_env,
+                                               Tensor<T>& cholVpr, const TiledIndexSpace& MO_t,
+                                               Tensor<T>& cholV_t) {
+  if(!is_spatial_chol(chem_env)) {
+    retile_tamm_tensor(cholVpr, cholV_t);
+    return;
+  }
+
+  // spatial copy with the tiles of the alpha blocks of MO_t, so that every spin block of
+  // cholV_t is a single spatial block
+  TiledIndexSpace MO_ts = setup_mo_spatial(chem_env, MO_t);
+  Tensor<T>       cholV_ts{MO_ts, MO_ts, cholV_t.tiled_index_spaces()[2]};
+  Tensor<T>::allocate(&ec, cholV_ts);
+  retile_tamm_tensor(chem_env.cholV_spatial, cholV_ts);
+
+  auto expand_block = [&](const IndexVector& bid) {
+    const IndexVector blockid = internal::translate_blockid(bid, cholV_t());
+    std::vector<T>    buf(cholV_t.block_size(blockid), T{0});
+
+    const auto [p, p_spin] = spatial_tile(MO_t, blockid[0]);
+    const auto [q, q_spin] = spatial_tile(MO_t, blockid[1]);
+    if(p_spin == q_spin) cholV_ts.get(IndexVector{p, q, blockid[2]}, buf);
+    cholV_t.put(blockid, buf);
+  };
+  block_for(ec, cholV_t(), expand_block);
+
+  Tensor<T>::deallocate(cholV_ts);
+}
+
 template<typename T>
 std::tuple<Tensor<T>, Tensor<T>, Tensor<T>, TAMM_SIZE, tamm::Tile, TiledIndexSpace>
 exachem::cholesky_2e::cholesky_2e_driver(ChemEnv& chem_env, ExecutionContext& ec,
@@ -80,9 +272,9 @@ exachem::cholesky_2e::cholesky_2e_driver(ChemEnv& chem_env, ExecutionContext& ec
   SystemData& sys_data        = chem_env.sys_data;
   CDOptions   cd_options      = chem_env.ioptions.cd_options;
   auto        diagtol         = cd_options.diagtol; // tolerance for the max. diagonal
-  cd_options.max_cvecs_factor = 2 * std::abs(std::log10(diagtol));
+  cd_options.max_cvecs_factor = cd_options.cvecs_factor();
   // TODO
-  tamm::Tile max_cvecs = cd_options.max_cvecs_factor * sys_data.nbf;
+  tamm::Tile max_cvecs = cd_options.max_cvecs(sys_data.nbf);
 
   std::cout << std::defaultfloat;
   auto rank = ec.pg().rank();
@@ -115,6 +307,9 @@ exachem::cholesky_2e::cholesky_2e_driver(ChemEnv& chem_env, ExecutionContext& ec
   if(!readv2 && !skip_cd.first) {
     exachem::cholesky_2e::two_index_transform(chem_env, ec, C_AO, F_AO, C_beta_AO, F_beta_AO, d_f1,
                                               shells, lcao, is_dlpno || !is_mso);
+    if(chem_env.ioptions.ccsd_options.localize)
+      exachem::cholesky_2e::localize_orbitals<T>(chem_env, ec, shells, lcao, d_f1,
+                                                 is_dlpno || !is_mso);
     if(!is_dlpno)
       cholVpr = exachem::cholesky_2e::cholesky_2e(chem_env, ec, MO, AO, chol_count, max_cvecs,
                                                   shells, lcao, is_mso);
@@ -140,14 +335,22 @@ exachem::cholesky_2e::cholesky_2e_driver(ChemEnv& chem_env, ExecutionContext& ec
              << endl;
     }
 
-    if(!is_dlpno) exachem::cholesky_2e::update_sysdata(chem_env, MO, is_mso);
+    if(!is_dlpno) exachem::cholesky_2e::update_sysdata(ec, chem_env, MO, is_mso);
 
     IndexSpace      chol_is{range(0, chol_count)};
     TiledIndexSpace CI{chol_is, static_cast<tamm::Tile>(itile_size)};
 
     TiledIndexSpace N = MO("all");
-    cholVpr = {{N, N, CI}, {SpinPosition::upper, SpinPosition::lower, SpinPosition::ignore}};
-    if(!is_dlpno) Tensor<TensorType>::allocate(&ec, cholVpr);
+    if(!is_dlpno && is_spatial_chol(chem_env, is_mso)) {
+      TiledIndexSpace MO_s   = setup_mo_spatial(chem_env, MO);
+      chem_env.cholV_spatial = Tensor<T>{MO_s, MO_s, CI};
+      Tensor<T>::allocate(&ec, chem_env.cholV_spatial);
+      cholVpr = chol_spin_view(MO, chem_env.cholV_spatial);
+    }
+    else {
+      cholVpr = {{N, N, CI}, {SpinPosition::upper, SpinPosition::lower, SpinPosition::ignore}};
+      if(!is_dlpno) Tensor<TensorType>::allocate(&ec, cholVpr);
+    }
     // Scheduler{ec}(cholVpr()=0).execute();
     if(!skip_cd.first) read_from_disk(lcao, lcaofile);
   }
@@ -189,7 +392,7 @@ exachem::cholesky_2e::cholesky_2e_driver(ChemEnv& chem_env, ExecutionContext& ec
     d_f1 = d_f1_new;
   }
 
-  if(!readv2 && chem_env.ioptions.scf_options.mos_txt) {
+  if(!readv2 && chem_env.ioptions.scf_options.mo_ints) {
     Scheduler   sch{ec};
     std::string hcorefile = files_dir + "/scf/" + sys_data.output_file_prefix + ".hcore";
     Tensor<T>   hcore{AO, AO};
@@ -208,25 +411,14 @@ exachem::cholesky_2e::cholesky_2e_driver(ChemEnv& chem_env, ExecutionContext& ec
         .deallocate(tmp,hcore).execute();
     // clang-format on
 
-    ExecutionContext ec_dense{ec.pg(), DistributionKind::dense, MemoryManagerKind::ga};
-    std::string      mop_dir   = files_dir + "/mos_txt/";
-    std::string      mofprefix = mop_dir + out_fp;
-    if(!fs::exists(mop_dir)) fs::create_directories(mop_dir);
+    if(rank == 0 && !fs::exists(files_dir)) fs::create_directories(files_dir);
+    ec.pg().barrier();
 
-    Tensor<T> d_v2        = setupV2<T>(ec, MO, CI, cholVpr, chol_count);
-    Tensor<T> d_f1_dense  = to_dense_tensor(ec_dense, d_f1);
-    Tensor<T> lcao_dense  = to_dense_tensor(ec_dense, lcao);
-    Tensor<T> d_v2_dense  = to_dense_tensor(ec_dense, d_v2);
-    Tensor<T> hcore_dense = to_dense_tensor(ec_dense, hcore_mo);
+    std::string mo_ints_file = files_dir + "/" + sys_data.output_file_prefix + ".mo_ints";
+    write_mo_ints(chem_env, ec, mo_ints_file, hcore_mo, d_f1, lcao, cholVpr);
+    Tensor<T>::deallocate(hcore_mo);
 
-    Tensor<T>::deallocate(hcore_mo, d_v2);
-
-    print_dense_tensor(d_v2_dense, mofprefix + ".v2_mo");
-    print_dense_tensor(lcao_dense, mofprefix + ".ao2mo");
-    print_dense_tensor(d_f1_dense, mofprefix + ".fock_mo");
-    print_dense_tensor(hcore_dense, mofprefix + ".hcore_mo");
-
-    Tensor<T>::deallocate(hcore_dense, d_f1_dense, lcao_dense, d_v2_dense);
+    if(rank == 0) cout << "MO integrals written to " << mo_ints_file << endl;
   }
 
   return std::make_tuple(cholVpr, d_f1, lcao, chol_count, max_cvecs, CI);
@@ -241,3 +433,17 @@ exachem::cholesky_2e::cholesky_2e_driver<T>(ChemEnv& chem_env, ExecutionContext&
                                             Tensor<T> F_beta_AO, libint2::BasisSet& shells,
                                             std::vector<size_t>& shell_tile_map, bool readv2,
                                             std::string cholfile, bool is_dlpno, bool is_mso);
+
+template void exachem::cholesky_2e::write_chol_vectors<T>(ChemEnv& chem_env, Tensor<T>& cholVpr,
+                                                          std::string v2file);
+template void exachem::cholesky_2e::read_chol_vectors<T>(ChemEnv& chem_env, Tensor<T>& cholVpr,
+                                                         std::string v2file);
+template void exachem::cholesky_2e::free_chol_vectors<T>(ChemEnv& chem_env, Tensor<T>& cholVpr);
+template void exachem::cholesky_2e::retile_chol_vectors<T>(ExecutionContext& ec, ChemEnv& chem_env,
+                                                          Tensor<T>&             cholVpr,
+                                                          const TiledIndexSpace& MO_t,
+                                                          Tensor<T>&             cholV_t);
+template void exachem::cholesky_2e::write_mo_ints<T>(ChemEnv& chem_env, ExecutionContext& ec,
+                                                     std::string filename, Tensor<T> hcore_mo,
+                                                     Tensor<T> d_f1, Tensor<T> lcao,
+                                                     Tensor<T> cholVpr);
@@ -10,6 +10,8 @@
 
 #include "cc/ccse_tensors.hpp"
 #include "cc/diis.hpp"
+#include "cholesky/mo_ints_file.hpp"
+#include "cholesky/orbital_localization.hpp"
 #include "cholesky/v2tensors.hpp"
 #include "scf/scf_main.hpp"
 
@@ -25,4 +27,40 @@ cholesky_2e_driver(ChemEnv& chem_env, ExecutionContext& ec, TiledIndexSpace& MO,
 
 void cholesky_decomp_2e(ExecutionContext& ec, ChemEnv& chem_env);
 
+// Disk I/O and deallocation of the cholVpr returned by cholesky_2e_driver. With
+// cd_options.spatial_storage a closed-shell cholVpr is a read-only view and these act on the
+// spatial-orbital tensor behind it.
+template<typename T>
+void write_chol_vectors(ChemEnv& chem_env, Tensor<T>& cholVpr, std::string v2file);
+
+template<typename T>
+void read_chol_vectors(ChemEnv& chem_env, Tensor<T>& cholVpr, std::string v2file);
+
+template<typename T>
+void free_chol_vectors(ChemEnv& chem_env, Tensor<T>& cholVpr);
+
+// Copies cholVpr into the allocated spin-orbital tensor cholV_t over {MO_t, MO_t, CI}, which
+// may be tiled differently (e.g. for (T)). Spatial-orbital vectors are retiled over spatial
+// orbitals and expanded block by block, without reading through the view.
+template<typename T>
+void retile_chol_vectors(ExecutionContext& ec, ChemEnv& chem_env, Tensor<T>& cholVpr,
+                         const TiledIndexSpace& MO_t, Tensor<T>& cholV_t);
+
+// MPI datatype of the tensor element type
+template<typename T>
+MPI_Datatype mpi_type() {
+  if constexpr(std::is_same_v<T, float>) return MPI_FLOAT;
+  else if constexpr(std::is_same_v<T, double>) return MPI_DOUBLE;
+  else if constexpr(std::is_same_v<T, std::complex<float>>) return MPI_C_FLOAT_COMPLEX;
+  else if constexpr(std::is_same_v<T, std::complex<double>>) return MPI_C_DOUBLE_COMPLEX;
+  else static_assert(!sizeof(T), "mpi_type: unsupported element type");
+}
+
+// Writes the one-electron matrices and cholesky vectors in the MO basis to the binary file
+// described in mo_ints_file.hpp using MPI-IO. RHF references are written in the spatial
+// orbital basis with the cholesky vectors packed over p >= q.
+template<typename T>
+void write_mo_ints(ChemEnv& chem_env, ExecutionContext& ec, std::string filename,
+                   Tensor<T> hcore_mo, Tensor<T> d_f1, Tensor<T> lcao, Tensor<T> cholVpr);
+
 } // namespace exachem::cholesky_2e
@@ -0,0 +1,125 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+// Binary export of the MO integrals (SCF PRINT option mo_ints). This header only depends on the
+// standard library so that external tools can include it to read the files.
+//
+// Layout: a 128 byte MOIntsHeader followed by the sections below, all stored as row-major
+// doubles in the native (little-endian) byte order of the writer.
+//
+//   hcore[nmo][nmo]        core Hamiltonian in the MO basis
+//   fock[nmo][nmo]         Fock matrix in the MO basis
+//   lcao[nao][nmo]         MO coefficients
+//   chol[npair][nchol]     cholesky vectors, (pq|rs) = sum_Q chol[pq][Q] * chol[rs][Q]
+//
+// With spin_orbital = 1 the MO dimension is the spin-orbital space used by the coupled cluster
+// codes, ordered as {occ_alpha, occ_beta, virt_alpha, virt_beta}. Cholesky vectors of mixed
+// spin blocks are zero. RHF references are written with spin_orbital = 0 in the spatial
+// orbital basis {occ, virt}.
+//
+// With pair_packed = 0 the pairs are all nmo*nmo (p,q) in row-major order. With pair_packed = 1
+// only the pairs p >= q are stored at p*(p+1)/2 + q, using chol[p][q] = chol[q][p]. Version 1
+// files are read as pair_packed = 0.
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace exachem::cholesky_2e {
+
+struct MOIntsHeader {
+  char    magic[8];     // "EXAMOINT"
+  int64_t version;      // format version, currently 2
+  int64_t nao;          // number of atomic orbitals
+  int64_t nmo;          // number of (spin-)orbitals in the MO dimensions
+  int64_t nchol;        // number of cholesky vectors
+  int64_t n_occ_alpha;  // number of alpha occupied orbitals
+  int64_t n_occ_beta;   // number of beta occupied orbitals
+  int64_t spin_orbital; // 1 for the spin-orbital MO space, 0 for spatial orbitals
+  double  hf_energy;    // SCF energy
+  int64_t pair_packed;  // 1 if only the pairs p >= q are stored (version 2)
+  int64_t reserved[6];
+};
+static_assert(sizeof(MOIntsHeader) == 128, "MOIntsHeader must be 128 bytes");
+
+inline constexpr char    mo_ints_magic[8] = {'E', 'X', 'A', 'M', 'O', 'I', 'N', 'T'};
+inline constexpr int64_t mo_ints_version  = 2;
+
+// position of the pair (p,q), p >= q, in the packed cholesky section
+inline constexpr int64_t mo_ints_pair_index(int64_t p, int64_t q) { return p * (p + 1) / 2 + q; }
+
+inline int64_t mo_ints_npair(const MOIntsHeader& h) {
+  return h.pair_packed ? h.nmo * (h.nmo + 1) / 2 : h.nmo * h.nmo;
+}
+
+// byte offsets of the sections following the header, and the file size
+inline std::array<int64_t, 5> mo_ints_offsets(const MOIntsHeader& h) {
+  const int64_t o_hcore = sizeof(MOIntsHeader);
+  const int64_t o_fock  = o_hcore + h.nmo * h.nmo * sizeof(double);
+  const int64_t o_lcao  = o_fock + h.nmo * h.nmo * sizeof(double);
+  const int64_t o_chol  = o_lcao + h.nao * h.nmo * sizeof(double);
+  const int64_t o_end   = o_chol + mo_ints_npair(h) * h.nchol * sizeof(double);
+  return {o_hcore, o_fock, o_lcao, o_chol, o_end};
+}
+
+class MOIntsFile {
+  std::ifstream          in_;
+  MOIntsHeader           header_{};
+  std::array<int64_t, 5> offsets_{};
+
+  std::vector<double> read_section(int64_t offset, size_t n) {
+    std::vector<double> buf(n);
+    in_.seekg(offset);
+    in_.read(reinterpret_cast<char*>(buf.data()), n * sizeof(double));
+    if(!in_) throw std::runtime_error("MOIntsFile: error reading section");
+    return buf;
+  }
+
+public:
+  explicit MOIntsFile(const std::string& filename): in_(filename, std::ios::binary) {
+    if(!in_) throw std::runtime_error("MOIntsFile: cannot open " + filename);
+    in_.read(reinterpret_cast<char*>(&header_), sizeof(MOIntsHeader));
+    if(!in_ || std::memcmp(header_.magic, mo_ints_magic, 8) != 0)
+      throw std::runtime_error("MOIntsFile: " + filename + " is not an MO integral file");
+    if(header_.version < 1 || header_.version > mo_ints_version)
+      throw std::runtime_error("MOIntsFile: unsupported version " +
+                               std::to_string(header_.version));
+    if(header_.version == 1) header_.pair_packed = 0;
+    offsets_ = mo_ints_offsets(header_);
+  }
+
+  const MOIntsHeader& header() const { return header_; }
+
+  std::vector<double> hcore() { return read_section(offsets_[0], header_.nmo * header_.nmo); }
+  std::vector<double> fock() { return read_section(offsets_[1], header_.nmo * header_.nmo); }
+  std::vector<double> lcao() { return read_section(offsets_[2], header_.nao * header_.nmo); }
+
+  // all cholesky vectors of the orbital pair (p,q)
+  std::vector<double> chol(int64_t p, int64_t q) {
+    int64_t pq = p * header_.nmo + q;
+    if(header_.pair_packed) pq = p >= q ? mo_ints_pair_index(p, q) : mo_ints_pair_index(q, p);
+    return read_section(offsets_[3] + pq * header_.nchol * sizeof(double), header_.nchol);
+  }
+
+  // (pq|rs) in chemist's notation
+  double eri(int64_t p, int64_t q, int64_t r, int64_t s) {
+    const auto lpq = chol(p, q);
+    const auto lrs = chol(r, s);
+    double     v   = 0.0;
+    for(int64_t x = 0; x < header_.nchol; x++) v += lpq[x] * lrs[x];
+    return v;
+  }
+};
+
+} // namespace exachem::cholesky_2e
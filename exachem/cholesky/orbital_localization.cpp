@@ -0,0 +1,349 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "cholesky/orbital_localization.hpp"
+
+namespace exachem::cholesky_2e {
+
+namespace {
+
+constexpr int max_sweeps = 200;
+
+// orbitals in columns [begin, begin + size) of lcao that are localized together. The columns
+// starting at copy_to receive the same rotation (beta orbitals of a closed-shell reference).
+struct LocalSpace {
+  std::string name;
+  int64_t     begin;
+  int64_t     size;
+  int64_t     copy_to{-1};
+};
+
+// AO rows owned by a rank: a contiguous range of atoms, balanced by the number of basis functions
+struct RowSlab {
+  int64_t                                  bf_begin{0};
+  int64_t                                  bf_end{0};
+  size_t                                   shell_begin{0};
+  size_t                                   shell_end{0};
+  std::vector<std::pair<int64_t, int64_t>> atom_rows; // first row in the slab, #rows per atom
+};
+
+RowSlab make_row_slab(const libint2::BasisSet& shells, const std::vector<libint2::Atom>& atoms,
+                      int rank, int nranks) {
+  const auto    shell2bf   = shells.shell2bf();
+  const auto    atom2shell = shells.atom2shell(atoms);
+  const int64_t nbf        = shells.nbf();
+
+  RowSlab slab;
+  bool    first = true;
+  for(size_t a = 0; a < atoms.size(); a++) {
+    if(atom2shell[a].empty()) continue;
+    const int64_t bf_first = shell2bf[atom2shell[a].front()];
+    int64_t       atom_nbf = 0;
+    for(auto s: atom2shell[a]) atom_nbf += shells[s].size();
+
+    const int owner = std::min<int64_t>(nranks - 1, (bf_first + atom_nbf / 2) * nranks / nbf);
+    if(owner != rank) continue;
+
+    if(first) {
+      slab.bf_begin    = bf_first;
+      slab.shell_begin = atom2shell[a].front();
+      first            = false;
+    }
+    slab.atom_rows.push_back({bf_first - slab.bf_begin, atom_nbf});
+    slab.bf_end    = bf_first + atom_nbf;
+    slab.shell_end = atom2shell[a].back() + 1;
+  }
+  return slab;
+}
+
+// rows of the overlap (PM) or of the overlap and dipole matrices (Boys) owned by the slab
+std::vector<Matrix> compute_op_rows(const libint2::BasisSet& shells, const RowSlab& slab,
+                                    libint2::Operator otype) {
+  const auto    shell2bf = shells.shell2bf();
+  const int64_t nrows    = slab.bf_end - slab.bf_begin;
+  const size_t  nops     = otype == libint2::Operator::overlap ? 1 : 4;
+
+  std::vector<Matrix> op_rows(nops, Matrix::Zero(nrows, shells.nbf()));
+
+  libint2::Engine engine(otype, shells.max_nprim(), shells.max_l(), 0);
+  const auto&     buf = engine.results();
+
+  for(size_t s1 = slab.shell_begin; s1 < slab.shell_end; s1++) {
+    const auto row = shell2bf[s1] - slab.bf_begin;
+    const auto n1  = shells[s1].size();
+    for(size_t s2 = 0; s2 < shells.size(); s2++) {
+      const auto n2 = shells[s2].size();
+      engine.compute(shells[s1], shells[s2]);
+      for(size_t k = 0; k < nops; k++) {
+        if(buf[k] == nullptr) continue;
+        Eigen::Map<const Matrix> buf_mat(buf[k], n1, n2);
+        op_rows[k].block(row, shell2bf[s2], n1, n2) = buf_mat;
+      }
+    }
+  }
+  return op_rows;
+}
+
+// Jacobi sweeps over all pairs of the n orbitals in C (nao x n). The pairs of a sweep are
+// scheduled in n-1 rounds of disjoint pairs, whose rotations commute. Every rank sums the
+// contributions of its AO rows for all pairs of a round, one allreduce completes them and all
+// ranks apply the same rotations to their rows. Returns the n x n rotation.
+Matrix localize_space(ExecutionContext& ec, const std::string& method, const RowSlab& slab,
+                      const Matrix& C, const std::vector<Matrix>& op_rows, int& nsweeps,
+                      std::array<double, 2>& objective) {
+  const bool    is_pm = (method == "PM");
+  const int64_t n     = C.cols();
+  const int64_t nrows = slab.bf_end - slab.bf_begin;
+  const int     nvals = is_pm ? 2 : 9;
+
+  const double tol = 1e-10;
+
+  // column-major, the sweeps work on pairs of columns
+  Eigen::MatrixXd              Cs = C.middleRows(slab.bf_begin, nrows);
+  std::vector<Eigen::MatrixXd> Ms; // S C for PM, (x C, y C, z C) for Boys
+  if(is_pm) Ms.push_back(op_rows[0] * C);
+  else
+    for(int k = 1; k < 4; k++) Ms.push_back(op_rows[k] * C);
+  Eigen::MatrixXd U = Eigen::MatrixXd::Identity(n, n);
+
+  // <i|O|j> over the rows [r0, r0+nr) of the slab, symmetrized
+  auto pair_value = [&](const Eigen::MatrixXd& M, int64_t i, int64_t j, int64_t r0, int64_t nr) {
+    return 0.5 * (Cs.col(i).segment(r0, nr).dot(M.col(j).segment(r0, nr)) +
+                  Cs.col(j).segment(r0, nr).dot(M.col(i).segment(r0, nr)));
+  };
+
+  // PM: sum_A sum_i (Q^A_ii)^2 with Mulliken charges, Boys: sum_i |<i|r|i>|^2
+  auto compute_objective = [&]() {
+    std::vector<double> local(is_pm ? 1 : 3 * n, 0.0);
+    for(int64_t i = 0; i < n; i++) {
+      if(is_pm) {
+        for(const auto& [r0, nr]: slab.atom_rows)
+          local[0] += std::pow(pair_value(Ms[0], i, i, r0, nr), 2);
+      }
+      else
+        for(int k = 0; k < 3; k++) local[3 * i + k] = pair_value(Ms[k], i, i, 0, nrows);
+    }
+    std::vector<double> global(local.size());
+    ec.pg().allreduce(local.data(), global.data(), local.size(), ReduceOp::sum);
+    if(is_pm) return global[0];
+    double obj = 0.0;
+    for(auto r: global) obj += r * r;
+    return obj;
+  };
+
+  auto rotate = [](Eigen::MatrixXd& X, int64_t i, int64_t j, double c, double s) {
+    const Eigen::VectorXd xi = X.col(i);
+    X.col(i)                 = c * xi + s * X.col(j);
+    X.col(j)                 = -s * xi + c * X.col(j);
+  };
+
+  objective[0] = compute_objective();
+
+  // round-robin schedule, slot 0 stays fixed and the others rotate after every round. With an
+  // odd number of orbitals the last slot is a dummy.
+  const int64_t        m = n + (n % 2);
+  std::vector<int64_t> slots(m);
+  std::iota(slots.begin(), slots.end(), 0);
+
+  std::vector<std::pair<int64_t, int64_t>> pairs;
+  std::vector<double>                      vals, global_vals;
+
+  for(nsweeps = 1; nsweeps <= max_sweeps; nsweeps++) {
+    double max_delta = 0.0;
+    for(int64_t round = 0; round < m - 1; round++) {
+      pairs.clear();
+      for(int64_t k = 0; k < m / 2; k++) {
+        const auto i = slots[k];
+        const auto j = slots[m - 1 - k];
+        if(i < n && j < n) pairs.push_back({std::min(i, j), std::max(i, j)});
+      }
+      std::rotate(slots.begin() + 1, slots.end() - 1, slots.end());
+
+      vals.assign(pairs.size() * nvals, 0.0);
+      for(size_t p = 0; p < pairs.size(); p++) {
+        const auto [i, j] = pairs[p];
+        if(is_pm) {
+          // A_ij, B_ij are sums over atoms, and all rows of an atom belong to one rank
+          for(const auto& [r0, nr]: slab.atom_rows) {
+            const double qii = pair_value(Ms[0], i, i, r0, nr);
+            const double qjj = pair_value(Ms[0], j, j, r0, nr);
+            const double qij = pair_value(Ms[0], i, j, r0, nr);
+            vals[2 * p] += qij * qij - 0.25 * (qii - qjj) * (qii - qjj);
+            vals[2 * p + 1] += qij * (qii - qjj);
+          }
+        }
+        else {
+          for(int k = 0; k < 3; k++) {
+            vals[9 * p + 3 * k]     = pair_value(Ms[k], i, i, 0, nrows);
+            vals[9 * p + 3 * k + 1] = pair_value(Ms[k], j, j, 0, nrows);
+            vals[9 * p + 3 * k + 2] = pair_value(Ms[k], i, j, 0, nrows);
+          }
+        }
+      }
+      global_vals.resize(vals.size());
+      ec.pg().allreduce(vals.data(), global_vals.data(), vals.size(), ReduceOp::sum);
+
+      for(size_t p = 0; p < pairs.size(); p++) {
+        const auto [i, j] = pairs[p];
+        double A = 0.0, B = 0.0;
+        if(is_pm) {
+          A = global_vals[2 * p];
+          B = global_vals[2 * p + 1];
+        }
+        else {
+          for(int k = 0; k < 3; k++) {
+            const double rii = global_vals[9 * p + 3 * k];
+            const double rjj = global_vals[9 * p + 3 * k + 1];
+            const double rij = global_vals[9 * p + 3 * k + 2];
+            A += rij * rij - 0.25 * (rii - rjj) * (rii - rjj);
+            B += rij * (rii - rjj);
+          }
+        }
+
+        // the rotation by gamma increases the objective by A + sqrt(A^2 + B^2)
+        const double AB = std::sqrt(A * A + B * B);
+        if(AB < 1e-14) continue;
+        max_delta          = std::max(max_delta, A + AB);
+        const double gamma = 0.25 * std::atan2(B, -A);
+        const double c     = std::cos(gamma);
+        const double s     = std::sin(gamma);
+        rotate(Cs, i, j, c, s);
+        for(auto& M: Ms) rotate(M, i, j, c, s);
+        rotate(U, i, j, c, s);
+      }
+    }
+    if(max_delta < tol) break;
+  }
+
+  objective[1] = compute_objective();
+
+  return U;
+}
+
+} // namespace
+
+template<typename TensorType>
+void localize_orbitals(ChemEnv& chem_env, ExecutionContext& ec, libint2::BasisSet& shells,
+                       Tensor<TensorType> lcao, Tensor<TensorType> F_MO, bool spatial) {
+  SystemData&        sys_data     = chem_env.sys_data;
+  const CCSDOptions& ccsd_options = chem_env.ioptions.ccsd_options;
+  const std::string  method       = ccsd_options.localize_method;
+  const bool         is_rhf       = sys_data.is_restricted;
+
+  auto rank   = ec.pg().rank().value();
+  auto nranks = ec.pg().size().value();
+
+  if(method != "PM" && method != "Boys")
+    tamm_terminate("INPUT FILE ERROR: localize_method must be PM or Boys, not " + method);
+
+  auto loc_t1 = std::chrono::high_resolution_clock::now();
+
+  const int64_t noa = sys_data.n_occ_alpha;
+  const int64_t nob = sys_data.n_occ_beta;
+  const int64_t nva = sys_data.n_vir_alpha;
+  const int64_t nvb = sys_data.n_vir_beta;
+  const int64_t nfc = sys_data.n_frozen_core;
+  const int64_t nfv = sys_data.n_frozen_virtual;
+  const int64_t N   = F_MO.tiled_index_spaces()[0]("all").max_num_indices();
+
+  const bool              virt = ccsd_options.localize_virtuals;
+  std::vector<LocalSpace> spaces;
+  if(spatial) {
+    spaces.push_back({"occupied", nfc, noa - nfc});
+    if(virt) spaces.push_back({"virtual", noa, N - noa - nfv});
+  }
+  else {
+    const int64_t nocc = noa + nob;
+    if(is_rhf) {
+      spaces.push_back({"occupied", nfc, noa - nfc, noa + nfc});
+      if(virt) spaces.push_back({"virtual", nocc, nva - nfv, nocc + nva});
+    }
+    else {
+      spaces.push_back({"occupied alpha", nfc, noa - nfc});
+      spaces.push_back({"occupied beta", noa + nfc, nob - nfc});
+      if(virt) {
+        spaces.push_back({"virtual alpha", nocc, nva - nfv});
+        spaces.push_back({"virtual beta", nocc + nva, nvb - nfv});
+      }
+    }
+  }
+
+  const std::string method_name = method == "PM" ? "Pipek-Mezey" : "Foster-Boys";
+  if(rank == 0) {
+    cout << std::endl << "-----------------------------------------------------" << endl;
+    cout << method_name << " localization of the ";
+    cout << (virt ? "occupied and virtual" : "occupied") << " orbitals" << endl;
+  }
+
+  Matrix        C    = tamm_to_eigen_matrix(lcao);
+  const RowSlab slab = make_row_slab(shells, chem_env.atoms, rank, nranks);
+  const auto    op_rows =
+    compute_op_rows(shells, slab,
+                    method == "PM" ? libint2::Operator::overlap : libint2::Operator::emultipole1);
+
+  std::vector<Matrix> rotations;
+  json                jspaces;
+  for(const auto& space: spaces) {
+    if(space.size < 2) {
+      rotations.push_back(Matrix());
+      continue;
+    }
+    int                   nsweeps = 0;
+    std::array<double, 2> objective;
+    rotations.push_back(localize_space(ec, method, slab, C.middleCols(space.begin, space.size),
+                                       op_rows, nsweeps, objective));
+    if(rank == 0) {
+      cout << " - " << space.name << " (" << space.size << " orbitals): ";
+      if(nsweeps > max_sweeps) cout << "not converged";
+      else cout << "converged in " << nsweeps << " sweeps";
+      cout << std::fixed << std::setprecision(6) << ", objective " << objective[0] << " -> "
+           << objective[1] << std::defaultfloat << endl;
+      jspaces[space.name] = {{"norbitals", space.size},
+                             {"sweeps", nsweeps},
+                             {"objective", objective[1]}};
+    }
+  }
+
+  if(rank == 0) {
+    Matrix F = tamm_to_eigen_matrix(F_MO);
+    for(size_t k = 0; k < spaces.size(); k++) {
+      const auto&   U = rotations[k];
+      const int64_t n = U.rows();
+      if(n < 2) continue;
+      for(auto b: {spaces[k].begin, spaces[k].copy_to}) {
+        if(b < 0) continue;
+        C.middleCols(b, n) = C.middleCols(b, n) * U;
+        F.middleCols(b, n) = F.middleCols(b, n) * U;
+        F.middleRows(b, n) = U.transpose() * F.middleRows(b, n);
+      }
+    }
+    eigen_to_tamm_tensor(lcao, C);
+    eigen_to_tamm_tensor(F_MO, F);
+
+    sys_data.results["output"]["localization"]["method"] = method;
+    sys_data.results["output"]["localization"]["spaces"] = jspaces;
+  }
+  ec.pg().barrier();
+
+  auto   loc_t2   = std::chrono::high_resolution_clock::now();
+  double loc_time = std::chrono::duration_cast<std::chrono::duration<double>>((loc_t2 - loc_t1))
+                      .count();
+  chem_env.telemetry.record(ec.pg(), "CD", "localization", loc_time);
+  if(rank == 0) {
+    cout << std::endl
+         << "Time taken for orbital localization: " << std::fixed << std::setprecision(2)
+         << loc_time << " secs" << std::defaultfloat << endl;
+    cout << std::endl << "-----------------------------------------------------" << endl;
+  }
+}
+
+template void localize_orbitals<double>(ChemEnv& chem_env, ExecutionContext& ec,
+                                        libint2::BasisSet& shells, Tensor<double> lcao,
+                                        Tensor<double> F_MO, bool spatial);
+
+} // namespace exachem::cholesky_2e
@@ -0,0 +1,26 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "cholesky/two_index_transform.hpp"
+
+namespace exachem::cholesky_2e {
+
+// Localizes the correlated orbitals in lcao (CC DLPNO option localize) and rotates the MO Fock
+// matrix F_MO into the local basis. Occupied and virtual orbitals are localized separately, per
+// spin for UHF, frozen orbitals are left untouched. With spatial = true lcao and F_MO use the
+// spatial layout of two_index_transform(isdlpno = true), otherwise the spin-orbital layout
+// {occ_alpha, occ_beta, virt_alpha, virt_beta}.
+//
+// Call before cholesky_2e(), so that the cholesky vectors are built in the local basis.
+template<typename TensorType>
+void localize_orbitals(ChemEnv& chem_env, ExecutionContext& ec, libint2::BasisSet& shells,
+                       Tensor<TensorType> lcao, Tensor<TensorType> F_MO, bool spatial = false);
+
+} // namespace exachem::cholesky_2e
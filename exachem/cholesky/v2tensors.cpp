@@ -59,6 +59,68 @@ exachem::cholesky_2e::setupV2Tensors(ExecutionContext& ec, Tensor<T> cholVpr, Ex
   return v2tensors;
 }
 
+template<typename T>
+exachem::cholesky_2e::V2Tensors<T>
+exachem::cholesky_2e::setupV2TensorsCD(ExecutionContext& ec, Tensor<T> cholVpr, ExecutionHW ex_hw) {
+  V2Tensors<T> v2tensors = setupV2Tensors<T>(ec, cholVpr, ex_hw, {"ijab", "iajb", "ijka", "ijkl"});
+
+  TiledIndexSpace        MO     = cholVpr.tiled_index_spaces()[0]; // MO
+  TiledIndexSpace        CI     = cholVpr.tiled_index_spaces()[2]; // CI
+  const TiledIndexSpace& O      = MO("occ");
+  const TiledIndexSpace& V      = MO("virt");
+  const Index            otiles = O.num_tiles();
+  const Index            ctiles = CI.num_tiles();
+
+  // v2(p,q,r,s) = sum_Q L(p,r,Q) L(q,s,Q) - L(p,s,Q) L(q,r,Q) for one block, where offset maps
+  // the occ/virt tile indices of the block to the tiles of cholVpr.
+  auto v2_block = [cholVpr, ctiles](const std::array<Index, 4> offset) {
+    return [cholVpr, ctiles, offset](const IndexVector& blockid, span<T> buf) mutable {
+      std::fill(buf.begin(), buf.end(), 0);
+      IndexVector bid(4);
+      for(int i = 0; i < 4; i++) bid[i] = blockid[i] + offset[i];
+
+      // buf(p,q,r,s) += alpha * L(p,x,Q) L(q,y,Q), with (x,y) = (r,s) or (s,r)
+      auto add_term = [&](bool exchange, T alpha) {
+        const Index bx = exchange ? bid[3] : bid[2];
+        const Index by = exchange ? bid[2] : bid[3];
+        std::vector<T> tmp;
+        size_t         dp = 0, dq = 0, dx = 0, dy = 0;
+        for(Index c = 0; c < ctiles; c++) {
+          const IndexVector aid{bid[0], bx, c};
+          const IndexVector cid{bid[1], by, c};
+          if(!cholVpr.is_non_zero(aid) || !cholVpr.is_non_zero(cid)) continue;
+          const auto adims = cholVpr.block_dims(aid);
+          const auto cdims = cholVpr.block_dims(cid);
+          dp = adims[0], dx = adims[1], dq = cdims[0], dy = cdims[1];
+          const size_t   dc = adims[2];
+          std::vector<T> abuf(dp * dx * dc), cbuf(dq * dy * dc);
+          cholVpr.get(aid, abuf);
+          cholVpr.get(cid, cbuf);
+          if(tmp.empty()) tmp.assign(dp * dx * dq * dy, 0);
+          blas::gemm(blas::Layout::RowMajor, blas::Op::NoTrans, blas::Op::Trans, dp * dx, dq * dy,
+                     dc, 1.0, abuf.data(), dc, cbuf.data(), dc, 1.0, tmp.data(), dq * dy);
+        }
+        if(tmp.empty()) return;
+        // tmp is (p,x,q,y)
+        for(size_t p = 0; p < dp; p++)
+          for(size_t q = 0; q < dq; q++)
+            for(size_t x = 0; x < dx; x++)
+              for(size_t y = 0; y < dy; y++) {
+                const size_t rs = exchange ? y * dx + x : x * dy + y;
+                buf[(p * dq + q) * dx * dy + rs] += alpha * tmp[((p * dx + x) * dq + q) * dy + y];
+              }
+      };
+      add_term(false, 1.0);
+      add_term(true, -1.0);
+    };
+  };
+
+  v2tensors.v2iabc = Tensor<T>{{O, V, V, V}, v2_block({0, otiles, otiles, otiles})};
+  v2tensors.v2abcd = Tensor<T>{{V, V, V, V}, v2_block({otiles, otiles, otiles, otiles})};
+
+  return v2tensors;
+}
+
 template Tensor<T> exachem::cholesky_2e::setupV2<T>(ExecutionContext& ec, TiledIndexSpace& MO,
                                                     TiledIndexSpace& CI, Tensor<T> cholVpr,
                                                     const tamm::Tile chol_count, ExecutionHW hw,
@@ -67,3 +129,7 @@ template Tensor<T> exachem::cholesky_2e::setupV2<T>(ExecutionContext& ec, TiledI
 template exachem::cholesky_2e::V2Tensors<T>
 exachem::cholesky_2e::setupV2Tensors<T>(ExecutionContext& ec, Tensor<T> cholVpr, ExecutionHW ex_hw,
                                         std::vector<std::string> blocks);
+
+template exachem::cholesky_2e::V2Tensors<T>
+exachem::cholesky_2e::setupV2TensorsCD<T>(ExecutionContext& ec, Tensor<T> cholVpr,
+                                          ExecutionHW ex_hw);
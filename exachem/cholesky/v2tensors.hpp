@@ -65,6 +65,13 @@ V2Tensors<T>
 setupV2Tensors(ExecutionContext& ec, Tensor<T> cholVpr, ExecutionHW ex_hw = ExecutionHW::CPU,
                std::vector<std::string> blocks = {"ijab", "iajb", "ijka", "ijkl", "iabc", "abcd"});
 
+// Same as setupV2Tensors, but only the blocks with at most two virtual indices (ijab, iajb, ijka,
+// ijkl) are stored. v2iabc and v2abcd are lambda tensors whose blocks are assembled from cholVpr
+// whenever they are read, so cholVpr has to stay allocated while they are in use.
+template<typename T>
+V2Tensors<T> setupV2TensorsCD(ExecutionContext& ec, Tensor<T> cholVpr,
+                              ExecutionHW ex_hw = ExecutionHW::CPU);
+
 template<typename T>
 Tensor<T> setupV2(ExecutionContext& ec, TiledIndexSpace& MO, TiledIndexSpace& CI, Tensor<T> cholVpr,
                   const tamm::Tile chol_count, ExecutionHW hw = ExecutionHW::CPU,
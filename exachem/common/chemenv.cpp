@@ -62,6 +62,7 @@ void ChemEnv::write_json_data(const std::string cmodule) {
   auto  scf     = ioptions.scf_options;
   auto  cd      = ioptions.cd_options;
   auto  ccsd    = ioptions.ccsd_options;
+  auto  gw      = ioptions.gw_options;
   json& results = sys_data.results;
 
   auto str_bool = [=](const bool val) {
@@ -165,19 +166,39 @@ void ChemEnv::write_json_data(const std::string cmodule) {
 
   if(cmodule == "DLPNO-CCSD") {
     // DLPNO-CCSD options
-    results["input"][cmodule]["localize"]         = str_bool(ccsd.localize);
-    results["input"][cmodule]["skip_dlpno"]       = str_bool(ccsd.skip_dlpno);
-    results["input"][cmodule]["max_pnos"]         = ccsd.max_pnos;
-    results["input"][cmodule]["keep_npairs"]      = ccsd.keep_npairs;
-    results["input"][cmodule]["TCutEN"]           = ccsd.TCutEN;
-    results["input"][cmodule]["TCutPNO"]          = ccsd.TCutPNO;
-    results["input"][cmodule]["TCutPre"]          = ccsd.TCutPre;
-    results["input"][cmodule]["TCutPairs"]        = ccsd.TCutPairs;
-    results["input"][cmodule]["TCutDO"]           = ccsd.TCutDO;
-    results["input"][cmodule]["TCutDOij"]         = ccsd.TCutDOij;
-    results["input"][cmodule]["TCutDOPre"]        = ccsd.TCutDOPre;
-    results["input"][cmodule]["dlpno_dfbasis"]    = ccsd.dlpno_dfbasis;
-    results["input"][cmodule]["doubles_opt_eqns"] = ccsd.doubles_opt_eqns;
+    results["input"][cmodule]["localize"]          = str_bool(ccsd.localize);
+    results["input"][cmodule]["localize_method"]   = ccsd.localize_method;
+    results["input"][cmodule]["localize_virtuals"] = str_bool(ccsd.localize_virtuals);
+    results["input"][cmodule]["skip_dlpno"]        = str_bool(ccsd.skip_dlpno);
+    results["input"][cmodule]["max_pnos"]          = ccsd.max_pnos;
+    results["input"][cmodule]["keep_npairs"]       = ccsd.keep_npairs;
+    results["input"][cmodule]["TCutEN"]            = ccsd.TCutEN;
+    results["input"][cmodule]["TCutPNO"]           = ccsd.TCutPNO;
+    results["input"][cmodule]["TCutTNO"]           = ccsd.TCutTNO;
+    results["input"][cmodule]["TCutPre"]           = ccsd.TCutPre;
+    results["input"][cmodule]["TCutPairs"]         = ccsd.TCutPairs;
+    results["input"][cmodule]["TCutDO"]            = ccsd.TCutDO;
+    results["input"][cmodule]["TCutDOij"]          = ccsd.TCutDOij;
+    results["input"][cmodule]["TCutDOPre"]         = ccsd.TCutDOPre;
+    results["input"][cmodule]["dlpno_dfbasis"]     = ccsd.dlpno_dfbasis;
+    results["input"][cmodule]["doubles_opt_eqns"]  = ccsd.doubles_opt_eqns;
+  }
+
+  if(cmodule == "GW") {
+    // GW options
+    results["input"][cmodule]["method"]    = gw.method;
+    results["input"][cmodule]["ngl"]       = gw.ngl;
+    results["input"][cmodule]["noqpa"]     = gw.noqpa;
+    results["input"][cmodule]["noqpb"]     = gw.noqpb;
+    results["input"][cmodule]["nvqpa"]     = gw.nvqpa;
+    results["input"][cmodule]["nvqpb"]     = gw.nvqpb;
+    results["input"][cmodule]["ieta"]      = gw.ieta;
+    results["input"][cmodule]["evgw"]      = str_bool(gw.evgw);
+    results["input"][cmodule]["evgw0"]     = str_bool(gw.evgw0);
+    results["input"][cmodule]["core"]      = str_bool(gw.core);
+    results["input"][cmodule]["maxnewton"] = gw.maxnewton;
+    results["input"][cmodule]["maxev"]     = gw.maxev;
+    results["input"][cmodule]["minres"]    = str_bool(gw.minres);
   }
 
   if(cmodule == "DUCC") {
@@ -221,32 +242,41 @@ void ChemEnv::write_json_data(const std::string cmodule) {
   std::string l_module = cmodule;
   txt_utils::to_lower(l_module);
 
+  std::string files_prefix = json_files_dir() + "/" + sys_data.output_file_prefix;
+  std::string json_file    = files_prefix + "." + l_module + ".json";
+
+  // write to a temporary file and rename it over the previous results, so that a job dying
+  // while writing never leaves a truncated json file behind
+  std::string tmp_file = json_file + ".tmp";
+  {
+    std::ofstream res_file(tmp_file);
+    res_file << std::setw(2) << results << std::endl;
+  }
+  std::filesystem::rename(tmp_file, json_file);
+
+  telemetry.record(cmodule, "write_json");
+}
+
+std::string ChemEnv::json_files_dir() {
   std::string files_dir =
     sys_data.output_file_prefix + "_files/" + ioptions.scf_options.scf_type + "/json";
   if(!fs::exists(files_dir)) fs::create_directories(files_dir);
-  std::string files_prefix = files_dir + "/" + sys_data.output_file_prefix;
-  std::string json_file    = files_prefix + "." + l_module + ".json";
-  bool        json_exists  = std::filesystem::exists(json_file);
-  if(json_exists) {
-    // std::ifstream jread(json_file);
-    // jread >> results;
-    std::filesystem::remove(json_file);
-  }
+  return files_dir;
+}
 
-  // std::cout << std::endl << std::endl << results.dump() << std::endl;
-  std::ofstream res_file(json_file);
-  res_file << std::setw(2) << results << std::endl;
+// called on all ranks of the process group, the stream is written by io_rank only
+void ChemEnv::open_telemetry(bool io_rank) {
+  telemetry.enable(ioptions.common_options.telemetry);
+  if(!telemetry.enabled() || !io_rank) return;
+  telemetry.open(json_files_dir() + "/" + sys_data.output_file_prefix + ".telemetry.jsonl");
 }
 
-void ChemEnv::sinfo() {
+void ChemEnv::sinfo(ExecutionContext& ec) {
   SCFOptions& scf_options = ioptions.scf_options;
 
-  // TODO: dont create ec
-  ProcGroup        pg = ProcGroup::create_world_coll();
-  ExecutionContext ec{pg, DistributionKind::nw, MemoryManagerKind::ga};
-  auto             rank   = ec.pg().rank();
-  std::string      basis  = scf_options.basis;
-  int              charge = scf_options.charge;
+  auto        rank   = ec.pg().rank();
+  std::string basis  = scf_options.basis;
+  int         charge = scf_options.charge;
 
   const int N = shells.nbf();
 
@@ -273,7 +303,8 @@ void ChemEnv::sinfo() {
   ec.flush_and_sync();
 }
 
-Matrix ChemEnv::compute_shellblock_norm(const libint2::BasisSet& obs, const Matrix& A) {
+Matrix ChemEnv::compute_shellblock_norm(const libint2::BasisSet&      obs,
+                                        const Eigen::Ref<const Matrix>& A) {
   const auto nsh = obs.size();
   Matrix     Ash = Matrix::Zero(nsh, nsh);
 
@@ -9,6 +9,7 @@
 #pragma once
 #include "common/ec_basis.hpp"
 #include "common/system_data.hpp"
+#include "common/telemetry.hpp"
 #include "ecatom.hpp"
 #include "options/input_options.hpp"
 // #include "libint2_includes.hpp"
@@ -23,7 +24,8 @@ public:
 
   void write_sinfo();
   // void write_json_data(const std::string cmodule);
-  void sinfo();
+  // runs on the process group of ec, which is a task farm group when inputs are farmed out
+  void sinfo(tamm::ExecutionContext& ec);
   int  get_nfcore();
 
   ChemEnv() = default;
@@ -48,12 +50,19 @@ public:
   TiledIndexSpace          AO_tis;
   TiledIndexSpace          AO_ortho;
   bool                     no_scf;
+  // spatial-orbital cholesky vectors behind the spin-blocked view (cd_options.spatial_storage)
+  tamm::Tensor<TensorType> cholV_spatial;
 
   std::string workspace_dir{};
 
-  void write_json_data(const std::string cmodule);
+  // per-phase performance records, see telemetry.hpp (common option telemetry)
+  Telemetry telemetry;
 
-  Matrix compute_shellblock_norm(const libint2::BasisSet& obs, const Matrix& A);
+  std::string json_files_dir();
+  void        open_telemetry(bool io_rank);
+  void        write_json_data(const std::string cmodule);
+
+  Matrix compute_shellblock_norm(const libint2::BasisSet& obs, const Eigen::Ref<const Matrix>& A);
 
   void update(double hf_energy, libint2::BasisSet shells, std::vector<size_t> shell_tile_map,
               tamm::Tensor<TensorType> C_AO, tamm::Tensor<TensorType> F_AO,
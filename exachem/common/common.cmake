@@ -8,6 +8,8 @@ set(COMMON_INCLUDES
     ${COMMON_SRCDIR}/fcidump.hpp
     ${COMMON_SRCDIR}/txt_utils.hpp    
     ${COMMON_SRCDIR}/system_data.hpp
+    ${COMMON_SRCDIR}/telemetry.hpp
+    ${COMMON_SRCDIR}/memory_plan.hpp
     ${COMMON_SRCDIR}/chemenv.hpp
     ${COMMON_SRCDIR}/ec_basis.hpp
     ${COMMON_SRCDIR}/options/parse_options.hpp
@@ -29,6 +31,8 @@ set(COMMON_SRCS
     ${COMMON_SRCDIR}/fcidump.cpp
     ${COMMON_SRCDIR}/txt_utils.cpp    
     ${COMMON_SRCDIR}/system_data.cpp
+    ${COMMON_SRCDIR}/telemetry.cpp
+    ${COMMON_SRCDIR}/memory_plan.cpp
     ${COMMON_SRCDIR}/chemenv.cpp
     ${COMMON_SRCDIR}/ec_basis.cpp
     ${COMMON_SRCDIR}/options/parse_options.cpp
@@ -34,12 +34,21 @@ inline auto free_vec_tensors = [](auto&&... vecx) {
 
 inline auto free_tensors = [](auto&&... t) { ((t.deallocate()), ...); };
 
+// minimum number of nodes with enough CPU memory for calc_mem GiB
+inline int min_nodes_required(ExecutionContext& ec, double calc_mem) {
+  const double mem_per_node = static_cast<double>(ec.mem_info().cpu_mem_per_node);
+  if(mem_per_node <= 0) return ec.nnodes();
+  return static_cast<int>(std::ceil(calc_mem / mem_per_node));
+}
+
 inline void check_memory_requirements(ExecutionContext& ec, double calc_mem) {
   auto minfo = ec.mem_info();
   if(calc_mem > static_cast<double>(minfo.total_cpu_mem)) {
     ec.print_mem_info();
     std::string err_msg = "ERROR: Insufficient CPU memory, required = " + std::to_string(calc_mem) +
-                          "GiB, available = " + std::to_string(minfo.total_cpu_mem) + " GiB";
+                          "GiB, available = " + std::to_string(minfo.total_cpu_mem) +
+                          " GiB, minimum number of nodes required = " +
+                          std::to_string(min_nodes_required(ec, calc_mem));
     tamm_terminate(err_msg);
   }
 }
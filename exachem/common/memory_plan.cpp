@@ -0,0 +1,355 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "memory_plan.hpp"
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+MemoryPlan::MemoryPlan(ExecutionContext& ec, const std::string& name, double overhead):
+  name_(name), overhead_(overhead > 0 ? overhead : calibrated_overhead(name)) {
+  nranks_ = ec.pg().size().value();
+  // measure the phase covered by this plan only, not the high-water mark left behind by SCF
+  // or an earlier driver
+  phase_hwm_ = Telemetry::reset_rss_hwm();
+  baseline_  = phase_hwm_ ? Telemetry::rss_gib() : Telemetry::peak_rss_gib();
+}
+
+MemoryPlan::MemoryPlan(const std::string& name, int nranks, double overhead):
+  name_(name),
+  overhead_(overhead > 0 ? overhead : calibrated_overhead(name)),
+  nranks_(nranks),
+  baseline_(0),
+  phase_hwm_(false) {}
+
+void MemoryPlan::load_calibration(ExecutionContext& ec, const std::string& filename) {
+  calibration_file_ = filename;
+  calibration_.clear();
+
+  std::string contents;
+  if(ec.pg().rank() == 0 && fs::exists(filename)) {
+    std::ifstream in(filename);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  int64_t len = contents.size();
+  MPI_Bcast(&len, 1, MPI_INT64_T, 0, ec.pg().comm());
+  contents.resize(len);
+  if(len > 0) MPI_Bcast(contents.data(), len, MPI_CHAR, 0, ec.pg().comm());
+  if(contents.empty()) return;
+
+  const auto jcal = nlohmann::json::parse(contents, nullptr, false);
+  if(!jcal.is_object()) return;
+  for(const auto& [phase, factor]: jcal.items())
+    if(factor.is_number() && factor.get<double>() > 0) calibration_[phase] = factor.get<double>();
+}
+
+double MemoryPlan::calibrated_overhead(const std::string& name) {
+  auto it = calibration_.find(name);
+  return it == calibration_.end() ? 1.0 : it->second;
+}
+
+double MemoryPlan::total(const std::vector<Entry>& entries) const {
+  double gib = 0;
+  for(const auto& e: entries) gib += e.per_rank ? e.gib * nranks_ : e.gib;
+  return gib;
+}
+
+void MemoryPlan::update_peak() {
+  const double cur = total(live_);
+  if(cur > peak_) {
+    peak_         = cur;
+    peak_entries_ = live_;
+  }
+}
+
+void MemoryPlan::allocate_gib(const std::string& label, double gib) {
+  live_.push_back({label, gib, false});
+  update_peak();
+}
+
+void MemoryPlan::allocate_per_rank(const std::string& label, double gib_per_rank) {
+  live_.push_back({label, gib_per_rank, true});
+  update_peak();
+}
+
+// removes the oldest entry with this label, so a tensor can be replaced by a resized copy
+void MemoryPlan::deallocate(const std::string& label) {
+  auto it =
+    std::find_if(live_.begin(), live_.end(), [&](const Entry& e) { return e.label == label; });
+  if(it == live_.end()) tamm_terminate("MemoryPlan " + name_ + ": " + label + " is not allocated");
+  live_.erase(it);
+}
+
+void MemoryPlan::print_entries(const std::vector<Entry>& entries) const {
+  for(const auto& e: entries) {
+    std::cout << "   -> " << std::left << std::setw(40) << e.label << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << overhead_ * e.gib << " GiB";
+    if(e.per_rank) std::cout << " per rank";
+    std::cout << std::endl;
+  }
+}
+
+void MemoryPlan::check(ExecutionContext& ec, const std::string& step, bool print) const {
+  const double required = current();
+  if(print && ec.print())
+    std::cout << "- CPU memory required for " << step << ": " << std::fixed << std::setprecision(2)
+              << required << " GiB" << std::endl;
+
+  auto minfo = ec.mem_info();
+  if(required > static_cast<double>(minfo.total_cpu_mem)) {
+    if(ec.print()) {
+      std::cout << std::endl << name_ << " memory plan at " << step << ":" << std::endl;
+      print_entries(live_);
+    }
+    check_memory_requirements(ec, required);
+  }
+}
+
+void MemoryPlan::validate(ExecutionContext& ec, Telemetry& telemetry) const {
+  // growth of the resident set of each rank over the planned phase. Without a resettable
+  // high-water mark this is only the growth beyond the peak of the process before the plan.
+  const double peak_rss = phase_hwm_ ? Telemetry::rss_hwm_gib() : Telemetry::peak_rss_gib();
+  double       measured = std::max(0.0, peak_rss - baseline_);
+  MPI_Allreduce(MPI_IN_PLACE, &measured, 1, MPI_DOUBLE, MPI_MAX, ec.pg().comm());
+
+  // overhead factor that would have made the prediction match the measurement
+  const double predicted = peak() / nranks_;
+  const double planned   = peak_ / nranks_;
+  const double observed  = planned > 0 ? measured / planned : 0;
+
+  // only a measurement of this phase alone calibrates later plans. Every rank updates its copy
+  // so that the checks of later plans agree across ranks.
+  const bool calibrate = phase_hwm_ && observed > 0;
+  if(calibrate) calibration_[name_] = observed;
+
+  if(ec.pg().rank() != 0) return;
+
+  std::cout << std::endl
+            << name_ << " peak CPU memory per rank: predicted = " << std::fixed
+            << std::setprecision(2) << predicted << " GiB, measured = " << measured
+            << " GiB (observed memory_overhead = " << observed << ")" << std::endl;
+  if(!phase_hwm_)
+    std::cout << "The measured value excludes memory below the peak reached before " << name_
+              << " started." << std::endl;
+  if(ec.print() && !peak_entries_.empty()) {
+    std::cout << "Tensors live at the predicted peak (" << peak() << " GiB in total):" << std::endl;
+    print_entries(peak_entries_);
+  }
+
+  if(calibrate && !calibration_file_.empty()) {
+    nlohmann::json jcal(calibration_);
+    const auto     dir = fs::path(calibration_file_).parent_path();
+    if(!dir.empty() && !fs::exists(dir)) fs::create_directories(dir);
+    std::ofstream out(calibration_file_);
+    out << std::setw(2) << jcal << std::endl;
+  }
+
+  telemetry.record(name_, "memory_plan",
+                   {{"predicted_peak_gib", peak()},
+                    {"predicted_peak_per_rank_gib", predicted},
+                    {"measured_peak_per_rank_gib", measured},
+                    {"applied_memory_overhead", overhead_},
+                    {"observed_memory_overhead", observed}});
+}
+
+std::vector<MemoryPlan> predict_memory_plans(ExecutionContext& ec, ChemEnv& chem_env) {
+  const auto& task = chem_env.ioptions.task_options;
+  std::vector<MemoryPlan> plans;
+  if(!(task.cd_2e || task.ccsd || task.ccsd_t || task.ducc || task.gfccsd)) return plans;
+
+  const auto&  scf_options  = chem_env.ioptions.scf_options;
+  const auto&  cd_options   = chem_env.ioptions.cd_options;
+  const auto&  ccsd_options = chem_env.ioptions.ccsd_options;
+  const double overhead     = chem_env.ioptions.common_options.memory_overhead;
+  const int    nranks       = ec.pg().size().value();
+  const double gib          = sizeof(double) / (1024.0 * 1024.0 * 1024.0); // GiB per element
+
+  // orbital spaces as set up by the drivers after SCF
+  int nelectrons = 0;
+  for(const auto& atom: chem_env.atoms) nelectrons += atom.atomic_number;
+  nelectrons -= scf_options.charge;
+  const int    ne_alpha = (nelectrons + scf_options.multiplicity - 1) / 2;
+  const int    ne_beta  = nelectrons - ne_alpha;
+  const int    nfc      = chem_env.get_nfcore();
+  const double nbf      = chem_env.shells.nbf();
+  const double noa      = ne_alpha - nfc;
+  const double nob      = ne_beta - nfc;
+  const double nva      = nbf - ne_alpha - ccsd_options.freeze_virtual;
+  const double nvb      = nbf - ne_beta - ccsd_options.freeze_virtual;
+  const double nmoa     = noa + nva;
+  const double nmob     = nob + nvb;
+  const double O        = noa + nob;
+  const double V        = nva + nvb;
+  const bool   is_rhf   = scf_options.scf_type == "restricted";
+
+  // the count of an earlier decomposition if there is one, else the bound the decomposition uses
+  const std::string files_prefix = chem_env.workspace_dir + scf_options.scf_type + "/" +
+                                   chem_env.sys_data.output_file_prefix;
+  double nchol = cd_options.max_cvecs(nbf);
+  if(fs::exists(files_prefix + ".cholcount")) {
+    std::ifstream in(files_prefix + ".cholcount");
+    int64_t       count = 0;
+    if(in >> count && count > 0) nchol = count;
+  }
+
+  // non-zero spin blocks of the spin-orbital tensors
+  const double ov   = noa * nva + nob * nvb;
+  const double oovv = noa * noa * nva * nva + nob * nob * nvb * nvb + 4 * noa * nob * nva * nvb;
+  const double mo_chol =
+    (is_rhf && cd_options.spatial_storage ? nmoa * nmoa : nmoa * nmoa + nmob * nmob) * nchol;
+  const double spin_4 = 6.0 / 16.0; // non-zero fraction of a spin-orbital 4-index tensor
+
+  // CD: the AO vectors peak at twice their final size while they grow
+  {
+    MemoryPlan plan{"CD", nranks, overhead};
+    plan.allocate_gib("diagonal", nbf * nbf * gib);
+    plan.allocate_gib("residual", nbf * nbf * gib);
+    plan.allocate_gib("ao cholesky vectors", nbf * nbf * nchol * gib);
+    plan.allocate_gib("grown copy of the ao cholesky vectors", nbf * nbf * nchol * gib);
+    plan.deallocate("grown copy of the ao cholesky vectors");
+    plan.deallocate("diagonal");
+    plan.deallocate("residual");
+    plan.allocate_gib("mo cholesky vectors", mo_chol * gib);
+    plans.push_back(plan);
+  }
+  if(task.cd_2e) return plans;
+
+  {
+    const double ndiis = ccsd_options.ndiis;
+    MemoryPlan   plan{"CCSD", nranks, overhead};
+    plan.allocate_gib("fock and cholesky vectors", (nmoa * nmoa + nmob * nmob) * gib + mo_chol * gib);
+    if(is_rhf) {
+      const double t2 = noa * noa * nva * nva;
+      plan.allocate_gib("amplitudes and residuals", (2 * noa * nva + 5 * t2) * gib);
+      plan.allocate_gib("cholesky blocks", nmoa * nmoa * nchol * gib);
+      plan.allocate_gib("diis history", ndiis * 2 * (noa * nva + t2) * gib);
+      plan.allocate_gib("iteration intermediates",
+                        ((2 * nva * nva + 3 * nva * noa + 4 * noa * noa) * nchol + 4 * t2 +
+                         noa * noa * noa * noa) *
+                          gib);
+    }
+    else {
+      plan.allocate_gib("amplitudes and residuals", (2 * ov + 3 * oovv) * gib);
+      plan.allocate_gib("cholesky blocks", (nmoa * nmoa + nmob * nmob) * nchol * gib);
+      plan.allocate_gib("diis history", ndiis * 2 * (ov + oovv) * gib);
+      plan.allocate_gib("iteration intermediates",
+                        ((nva * nva + nvb * nvb + 2 * ov + 2 * (noa * noa + nob * nob)) * nchol +
+                         oovv + 3 * noa * noa * nob * nob) *
+                          gib);
+    }
+    plans.push_back(plan);
+  }
+
+  if(task.ccsd_t) {
+    MemoryPlan plan{"CCSD(T)", nranks, overhead};
+    plan.allocate_gib("input tensors", (ov + oovv + O * V + O * O * V * V) * gib);
+    plan.allocate_gib("retiled cholesky vectors", (nmoa * nmoa + nmob * nmob) * nchol * gib);
+    plan.allocate_gib("v2 blocks (ijab, ijka, iabc)",
+                      spin_4 * (O * O * V * V + O * O * O * V + O * V * V * V) * gib);
+    plan.deallocate("retiled cholesky vectors");
+
+    const double tile = ccsd_options.ccsdt_tilesize;
+    const double noab = std::ceil(noa / tile) + std::ceil(nob / tile);
+    const double nvab = std::ceil(nva / tile) + std::ceil(nvb / tile);
+    const double pdim = std::min(tile, std::max(nva, nvb));
+    const double hdim = std::min(tile, std::max(noa, nob));
+    const double nd1  = 9 * std::ceil(noa / tile);
+    const double nd2  = 9 * std::ceil(nva / tile);
+    plan.allocate_per_rank("intermediate buffers",
+                           (9 * pdim * hdim + 9 * pdim * pdim * hdim * hdim +
+                            nd1 * (pdim * pdim * hdim * hdim + pdim * hdim * hdim * hdim) +
+                            nd2 * (pdim * pdim * hdim * hdim + pdim * pdim * pdim * hdim)) *
+                             gib);
+    const double cache_buf = tile * tile * tile * tile;
+    const double cache_size = ccsd_options.cache_size;
+    plan.allocate_per_rank("t1,t2,v2 block cache",
+                           ((tile * tile + cache_buf) * cache_size +
+                            (noab + nvab) * 2 * cache_size * cache_buf) *
+                             gib);
+    plans.push_back(plan);
+  }
+
+  if(task.ducc) {
+    const double nactv = 2.0 * ccsd_options.nactive;
+    MemoryPlan   plan{"DUCC", nranks, overhead};
+    plan.allocate_gib("amplitudes and fock", (ov + oovv + (nmoa * nmoa + nmob * nmob)) * gib);
+    plan.allocate_gib("transformed hamiltonian (occupied)", spin_4 * O * O * O * O * gib);
+    if(nactv > 0)
+      plan.allocate_gib("transformed hamiltonian (active virtual)",
+                        spin_4 *
+                          (O * O * O * nactv + 2 * O * O * nactv * nactv +
+                           O * nactv * nactv * nactv + nactv * nactv * nactv * nactv) *
+                          gib);
+    plan.allocate_gib("dense copy for writing",
+                      (nactv > 0 ? nactv * nactv * nactv * nactv : O * O * O * O) * gib);
+    plans.push_back(plan);
+  }
+
+  if(task.gfccsd) {
+    // intermediates are modelled with noa = nob and nva = nvb
+    const double o = noa, v = nva;
+    MemoryPlan   plan{"GFCC", nranks, overhead};
+    plan.allocate_gib("t1,t2 and cholesky vectors", (ov + oovv + mo_chol) * gib);
+    plan.allocate_gib("spin-explicit t1,t2 and cholesky blocks",
+                      (ov + oovv - 2 * noa * nob * nva * nvb +
+                       (noa * noa + nob * nob + ov + nva * nva + nvb * nvb) * nchol) *
+                        gib);
+    plan.allocate_gib("v2 blocks",
+                      (spin_4 * (2 * O * O * V * V + O * O * O * V) + oovv -
+                       2 * noa * nob * nva * nvb) *
+                        gib);
+    if(ccsd_options.gf_ip)
+      plan.allocate_gib("IP intermediates",
+                        (10 * o * o * o * v + 3 * o * o * o * o + 6 * o * o * v * v) * gib);
+    if(ccsd_options.gf_ea)
+      plan.allocate_gib("EA intermediates",
+                        (10 * o * o * o * v + 18 * o * o * v * v + 4 * o * v * nchol) * gib);
+
+    // one GMRES solve and the preconditioners of the frequencies of the first level
+    const double vec_ip = ccsd_options.gf_ip ? o + 2 * v * o * o : 0;
+    const double vec_ea = ccsd_options.gf_ea ? v + 2 * o * v * v : 0;
+    const double vec    = 2 * std::max(vec_ip, vec_ea); // complex
+    const double nomega = std::max(
+      ccsd_options.gf_ip ? std::ceil((ccsd_options.gf_omega_max_ip - ccsd_options.gf_omega_min_ip) /
+                                       ccsd_options.gf_omega_delta +
+                                     1)
+                         : 0.0,
+      ccsd_options.gf_ea ? std::ceil((ccsd_options.gf_omega_max_ea - ccsd_options.gf_omega_min_ea) /
+                                       ccsd_options.gf_omega_delta +
+                                     1)
+                         : 0.0);
+    plan.allocate_gib("preconditioners", nomega * vec * gib);
+    plan.allocate_gib("GMRES vectors of one solve", (ccsd_options.gf_ngmres + 9) * vec * gib);
+    plans.push_back(plan);
+  }
+
+  return plans;
+}
+
+bool print_memory_prediction(ExecutionContext& ec, ChemEnv& chem_env) {
+  const auto plans = predict_memory_plans(ec, chem_env);
+  if(plans.empty()) return true;
+
+  const auto   minfo     = ec.mem_info();
+  const double available = static_cast<double>(minfo.total_cpu_mem);
+  bool         fits      = true;
+  for(const auto& plan: plans) fits = fits && plan.peak() <= available;
+  if(!ec.print()) return fits;
+
+  std::cout << std::endl
+            << "Predicted peak CPU memory (available: " << std::fixed << std::setprecision(2)
+            << available << " GiB on " << ec.nnodes() << " nodes)" << std::endl;
+  for(const auto& plan: plans) {
+    std::cout << " -- " << std::left << std::setw(8) << plan.name() << std::right << ": "
+              << std::setw(10) << plan.peak() << " GiB (memory_overhead = " << plan.overhead()
+              << ", minimum number of nodes = " << min_nodes_required(ec, plan.peak()) << ")"
+              << std::endl;
+    if(chem_env.ioptions.common_options.memory_dry_run) plan.print_peak_entries();
+  }
+  return fits;
+}
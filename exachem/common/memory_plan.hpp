@@ -0,0 +1,101 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "common/chemenv.hpp"
+#include "common/cutils.hpp"
+#include "common/telemetry.hpp"
+#include <map>
+
+/**
+ * Allocation plan of a driver.
+ *
+ * The driver records its allocations and deallocations in program order, before the
+ * corresponding tensors are allocated. The plan tracks the memory that is live at every point
+ * and the peak over the run, and check() stops the run before it allocates more memory than
+ * the execution context has. Distributed tensors are recorded in GiB summed over all ranks,
+ * buffers that every rank holds in GiB per rank.
+ *
+ * Predictions are scaled by an overhead factor that covers GA overhead and fragmentation.
+ * validate() compares the predicted per-rank peak with the growth of the resident set measured
+ * between the creation of the plan and the end of the driver, and stores the factor observed
+ * for the plan's phase in the calibration file of the workspace. Later plans of the same phase,
+ * in this run or a later one, are scaled by that measured factor. A positive common option
+ * memory_overhead overrides the calibration. Creating a plan restarts the high-water mark of
+ * the process, so measured plans must not overlap.
+ *
+ * predict_memory_plans() builds the plans of all phases of a task from the system sizes alone,
+ * before SCF, so that a run that will not fit is reported before it starts (common option
+ * memory_dry_run).
+ */
+class MemoryPlan {
+public:
+  // measured plan of the running phase, overhead <= 0 uses the calibrated factor
+  MemoryPlan(ExecutionContext& ec, const std::string& name, double overhead = 0);
+  // predicted plan for nranks ranks, not measured
+  MemoryPlan(const std::string& name, int nranks, double overhead = 0);
+
+  template<typename... Ts>
+  void allocate(const std::string& label, Ts&&... tensors) {
+    allocate_gib(label, sum_tensor_sizes(std::forward<Ts>(tensors)...));
+  }
+  void allocate_gib(const std::string& label, double gib);
+  void allocate_per_rank(const std::string& label, double gib_per_rank);
+  void deallocate(const std::string& label);
+
+  // memory over all ranks in GiB, scaled by the overhead factor
+  double current() const { return overhead_ * total(live_); }
+  double peak() const { return overhead_ * peak_; }
+
+  // terminates if the memory required at this step exceeds the available memory
+  void check(ExecutionContext& ec, const std::string& step, bool print = true) const;
+
+  // collective: compares the predicted and measured peak memory per rank and calibrates the
+  // overhead factor of this phase
+  void validate(ExecutionContext& ec, Telemetry& telemetry) const;
+
+  const std::string& name() const { return name_; }
+  double             overhead() const { return overhead_; }
+  void print_peak_entries() const { print_entries(peak_entries_); }
+
+  // collective: reads the overhead factors measured by earlier runs of this input
+  static void load_calibration(ExecutionContext& ec, const std::string& filename);
+  // measured overhead factor of a phase, 1.0 if the phase was never measured
+  static double calibrated_overhead(const std::string& name);
+
+private:
+  struct Entry {
+    std::string label;
+    double      gib;
+    bool        per_rank;
+  };
+
+  double total(const std::vector<Entry>& entries) const;
+  void   update_peak();
+  void   print_entries(const std::vector<Entry>& entries) const;
+
+  std::string        name_;
+  double             overhead_;
+  int                nranks_;
+  double             baseline_;  // resident memory per rank when the plan was created
+  bool               phase_hwm_; // high-water mark restarted when the plan was created
+  std::vector<Entry> live_;
+  std::vector<Entry> peak_entries_; // entries live at the peak
+  double             peak_{0};
+
+  static inline std::map<std::string, double> calibration_;
+  static inline std::string                   calibration_file_;
+};
+
+// Plans of the phases (CD, CCSD, (T), DUCC, GFCC) of the task in chem_env predicted from the
+// number of basis functions and electrons. Returns no plans for tasks that are not covered.
+std::vector<MemoryPlan> predict_memory_plans(ExecutionContext& ec, ChemEnv& chem_env);
+
+// prints the predicted peak of every phase and the nodes it needs, true if all phases fit
+bool print_memory_prediction(ExecutionContext& ec, ChemEnv& chem_env);
@@ -7,6 +7,7 @@
  */
 
 #include "input_options.hpp"
+#include <cmath>
 
 void SCFOptions::print() {
   std::cout << std::defaultfloat;
@@ -62,6 +63,12 @@ void SCFOptions::print() {
   }
 
   txt_utils::print_bool(" direct_df        ", direct_df);
+  if(node_shared) txt_utils::print_bool(" node_shared      ", node_shared);
+  if(gradient) txt_utils::print_bool(" gradient         ", gradient);
+  if(cfmm) {
+    txt_utils::print_bool(" cfmm             ", cfmm);
+    std::cout << " cfmm_order        = " << cfmm_order << std::endl;
+  }
 
   if(!xc_type.empty() || snK) {
     std::cout << " DFT " << std::endl << " {" << std::endl;
@@ -102,9 +109,9 @@ void SCFOptions::print() {
   txt_utils::print_bool(" debug            ", debug);
   if(restart) txt_utils::print_bool(" noscf            ", noscf);
   // txt_utils::print_bool(" sad         ", sad);
-  if(mulliken_analysis || mos_txt || mo_vectors_analysis.first) {
+  if(mulliken_analysis || mo_ints || mo_vectors_analysis.first) {
     std::cout << " PRINT {" << std::endl;
-    if(mos_txt) std::cout << std::boolalpha << "  mos_txt             = " << mos_txt << std::endl;
+    if(mo_ints) std::cout << std::boolalpha << "  mo_ints             = " << mo_ints << std::endl;
     if(mulliken_analysis)
       std::cout << std::boolalpha << "  mulliken_analysis   = " << mulliken_analysis << std::endl;
     if(mo_vectors_analysis.first) {
@@ -122,6 +129,8 @@ void CCSDOptions::print() {
   std::cout << "{" << std::endl;
   std::cout << " cache_size           = " << cache_size << std::endl;
   std::cout << " ccsdt_tilesize       = " << ccsdt_tilesize << std::endl;
+  if(ccsdt_screen_thresh > 0)
+    std::cout << " ccsdt_screen_thresh  = " << ccsdt_screen_thresh << std::endl;
 
   std::cout << " ndiis                = " << ndiis << std::endl;
   std::cout << " threshold            = " << threshold << std::endl;
@@ -141,7 +150,13 @@ void CCSDOptions::print() {
   std::cout << " writet_iter          = " << writet_iter << std::endl;
   txt_utils::print_bool(" profile_ccsd        ", profile_ccsd);
   txt_utils::print_bool(" balance_tiles       ", balance_tiles);
+  if(cc2_lowmem) txt_utils::print_bool(" cc2_lowmem          ", cc2_lowmem);
 
+  if(localize) {
+    txt_utils::print_bool(" localize            ", localize);
+    std::cout << " localize_method      = " << localize_method << std::endl;
+    txt_utils::print_bool(" localize_virtuals   ", localize_virtuals);
+  }
   if(!dlpno_dfbasis.empty()) std::cout << " dlpno_dfbasis        = " << dlpno_dfbasis << std::endl;
   if(!doubles_opt_eqns.empty()) {
     std::cout << " doubles_opt_eqns        = [";
@@ -155,6 +170,16 @@ void CCSDOptions::print() {
     std::cout << " eom_nroots           = " << eom_nroots << std::endl;
     std::cout << " eom_microiter        = " << eom_microiter << std::endl;
     std::cout << " eom_threshold        = " << eom_threshold << std::endl;
+    std::cout << " eom_guess            = " << eom_guess << std::endl;
+    txt_utils::print_bool(" eom_cholesky        ", eom_cholesky);
+    std::cout << " eom_target           = " << eom_target << std::endl;
+    if(eom_target == "energy")
+      std::cout << " eom_target_energy    = " << eom_target_energy << std::endl;
+    if(eom_target == "orbitals") {
+      std::cout << " eom_target_orbitals  = [";
+      for(auto x: eom_target_orbitals) std::cout << x << ",";
+      std::cout << "]" << std::endl;
+    }
   }
 
   if(gf_p_oi_range > 0) {
@@ -200,6 +225,10 @@ void CCSDOptions::print() {
     }
     if(gf_extrapolate_level > 0)
       std::cout << " gf_extrapolate_level = " << gf_extrapolate_level << std::endl;
+    txt_utils::print_bool(" gf_adaptive_grid    ", gf_adaptive_grid);
+    std::cout << " gf_trace_mode        = " << gf_trace_mode << std::endl;
+    if(gf_trace_mode == "stochastic")
+      std::cout << " gf_nprobes           = " << gf_nprobes << std::endl;
   }
 
   txt_utils::print_bool(" debug               ", debug);
@@ -218,6 +247,10 @@ void CommonOptions::print() {
   if(!basisfile.empty()) std::cout << " basisfile  = " << basisfile << std::endl;
   std::cout << " geom_units = " << geom_units << std::endl;
   txt_utils::print_bool(" debug     ", debug);
+  txt_utils::print_bool(" telemetry ", telemetry);
+  if(memory_overhead > 0) std::cout << " memory_overhead = " << memory_overhead << std::endl;
+  else std::cout << " memory_overhead = measured" << std::endl;
+  txt_utils::print_bool(" memory_dry_run", memory_dry_run);
   if(!file_prefix.empty()) std::cout << " file_prefix    = " << file_prefix << std::endl;
   std::cout << "}" << std::endl;
 }
@@ -234,6 +267,7 @@ void CCSDOptions::initialize() {
   freeze_virtual = 0;
   balance_tiles  = true;
   profile_ccsd   = false;
+  cc2_lowmem     = false;
 
   writet       = false;
   writev       = false;
@@ -241,28 +275,35 @@ void CCSDOptions::initialize() {
   readt        = false;
   computeTData = false;
 
-  localize      = false;
-  skip_dlpno    = false;
-  keep_npairs   = 1;
-  max_pnos      = 1;
-  dlpno_dfbasis = "";
-  TCutEN        = 0.97;
-  TCutPNO       = 1.0e-6;
-  TCutTNO       = 1.0e-6;
-  TCutPre       = 1.0e-3;
-  TCutPairs     = 1.0e-3;
-  TCutDO        = 1e-2;
-  TCutDOij      = 1e-7;
-  TCutDOPre     = 3e-2;
-
-  cache_size     = 8;
-  skip_ccsd      = false;
-  ccsdt_tilesize = 40;
-
-  eom_nroots    = 1;
-  eom_threshold = 1e-6;
-  eom_type      = "right";
-  eom_microiter = ccsd_maxiter;
+  localize          = false;
+  localize_virtuals = false;
+  localize_method   = "PM";
+  skip_dlpno        = false;
+  keep_npairs       = 1;
+  max_pnos          = 0; // no limit
+  dlpno_dfbasis     = "";
+  TCutEN            = 0.97;
+  TCutPNO           = 1.0e-6;
+  TCutTNO           = 1.0e-6;
+  TCutPre           = 1.0e-3;
+  TCutPairs         = 1.0e-3;
+  TCutDO            = 1e-2;
+  TCutDOij          = 1e-7;
+  TCutDOPre         = 3e-2;
+
+  cache_size          = 8;
+  skip_ccsd           = false;
+  ccsdt_tilesize      = 40;
+  ccsdt_screen_thresh = 0;
+
+  eom_nroots        = 1;
+  eom_threshold     = 1e-6;
+  eom_type          = "right";
+  eom_guess         = "koopmans";
+  eom_cholesky      = false;
+  eom_target        = "lowest";
+  eom_target_energy = 0;
+  eom_microiter     = ccsd_maxiter;
 
   pcore         = 0;
   ntimesteps    = 10;
@@ -305,6 +346,9 @@ void CCSDOptions::initialize() {
   gf_omega_delta       = 0.01;
   gf_omega_delta_e     = 0.002;
   gf_extrapolate_level = 0;
+  gf_adaptive_grid     = false;
+  gf_trace_mode        = "full";
+  gf_nprobes           = 16;
   gf_analyze_level     = 0;
   gf_analyze_num_omega = 0;
 } // end of CCSDOptions::initialize()
@@ -328,6 +372,8 @@ void FCIOptions::initialize() {
   print_mcscf = true;
 }
 
+int CDOptions::cvecs_factor() const { return 2 * std::abs(std::log10(diagtol)); }
+
 void CDOptions::print() {
   std::cout << std::defaultfloat;
   std::cout << std::endl << "CD Options" << std::endl;
@@ -340,6 +386,7 @@ void CDOptions::print() {
   std::cout << " diagtol          = " << diagtol << std::endl;
   std::cout << " itilesize        = " << itilesize << std::endl;
   std::cout << " max_cvecs_factor = " << max_cvecs_factor << std::endl;
+  std::cout << std::boolalpha << " spatial_storage  = " << spatial_storage << std::endl;
   std::cout << "}" << std::endl;
 }
 
@@ -351,7 +398,7 @@ void GWOptions::print() {
   std::cout << " noqpa     = " << noqpa << std::endl;
   std::cout << " noqpb     = " << noqpb << std::endl;
   std::cout << " nvqpa     = " << nvqpa << std::endl;
-  std::cout << " nvqp/b     = " << nvqpb << std::endl;
+  std::cout << " nvqpb     = " << nvqpb << std::endl;
   std::cout << " ieta      = " << ieta << std::endl;
   std::cout << " maxnewton = " << maxnewton << std::endl;
   std::cout << " maxev     = " << maxev << std::endl;
@@ -19,6 +19,9 @@
 class CommonOptions {
 public:
   bool        debug{false};
+  bool        telemetry{true}; // append per-phase performance records to <prefix>.telemetry.jsonl
+  double      memory_overhead{0}; // scales the predicted memory, <= 0 uses the measured factor
+  bool        memory_dry_run{false}; // print the predicted memory of every phase and exit
   int         maxiter{50};
   std::string basis{"sto-3g"};
   std::string dfbasis{};
@@ -56,6 +59,10 @@ public:
   bool     force_tilesize{false};
   bool     direct_df{false};
   bool     snK{false};
+  bool     node_shared{false}; // one copy per node of the replicated 4c HF D and G matrices
+  bool     gradient{false};    // analytic nuclear gradient of the converged SCF
+  bool     cfmm{false};        // multipole expansion of the far-field 4c Coulomb matrix
+  int      cfmm_order{8};      // order of the CFMM multipole expansions
   int  restart_size{2000}; // read/write orthogonalizer, schwarz, etc matrices when N>=restart_size
   int  scalapack_nb{256};
   int  nnodes{1};
@@ -86,8 +93,8 @@ public:
   std::map<std::string, std::tuple<int, int>> guess_atom_options;
 
   std::vector<std::string> xc_type;
-  // mos_txt: write lcao, mo transformed core H, fock, and v2 to disk as text files.
-  bool                             mos_txt{false};
+  // mo_ints: write lcao, mo transformed core H, fock, and cholesky vectors to a binary file.
+  bool                             mo_ints{false};
   bool                             mulliken_analysis{false};
   std::pair<bool, double>          mo_vectors_analysis{false, 0.15};
   std::vector<double>              qed_omegas{};
@@ -111,6 +118,7 @@ public:
   bool readt, writet, writev, gf_restart, gf_ip, gf_ea, gf_os, gf_cs, gf_itriples, gf_profile,
     balance_tiles, computeTData;
   bool                    profile_ccsd;
+  bool                    cc2_lowmem;
   double                  lshift;
   double                  threshold;
   bool                    ccsd_diagnostics{false};
@@ -136,12 +144,15 @@ public:
   double h_max;    // max time-step factor
 
   // CCSD(T)
-  bool skip_ccsd;
-  int  cache_size;
-  int  ccsdt_tilesize;
+  bool   skip_ccsd;
+  int    cache_size;
+  int    ccsdt_tilesize;
+  double ccsdt_screen_thresh;
 
   // DLPNO
   bool             localize;
+  bool             localize_virtuals;
+  std::string      localize_method;
   bool             skip_dlpno;
   int              max_pnos;
   size_t           keep_npairs;
@@ -157,10 +168,15 @@ public:
   std::vector<int> doubles_opt_eqns;
 
   // EOM
-  int         eom_nroots;
-  int         eom_microiter;
-  std::string eom_type;
-  double      eom_threshold;
+  int              eom_nroots;
+  int              eom_microiter;
+  std::string      eom_type;
+  std::string      eom_guess;
+  bool             eom_cholesky;
+  std::string      eom_target;
+  double           eom_target_energy;
+  std::vector<int> eom_target_orbitals;
+  double           eom_threshold;
 
   // GF
   int    gf_p_oi_range;
@@ -185,6 +201,9 @@ public:
   double              gf_omega_delta;
   double              gf_omega_delta_e;
   int                 gf_extrapolate_level;
+  bool                gf_adaptive_grid;
+  std::string         gf_trace_mode; // full, diagonal, stochastic
+  int                 gf_nprobes;
   int                 gf_analyze_level;
   int                 gf_analyze_num_omega;
   std::vector<double> gf_analyze_omega;
@@ -205,7 +224,14 @@ public:
   // enabled only if set to true and nbf > 1000
   // write to disk after every count number of vectors are computed.
   std::pair<bool, int> write_cv{false, 5000};
+  // store the vectors of a closed-shell reference once over spatial orbitals
+  bool                 spatial_storage{false};
   void                 print();
+
+  // upper bound on the number of cholesky vectors of a decomposition over nbf functions.
+  // The decomposition replaces max_cvecs_factor by 2*|log10(diagtol)|.
+  int     cvecs_factor() const;
+  int64_t max_cvecs(int64_t nbf) const { return cvecs_factor() * nbf; }
 };
 
 class FCIOptions: public CommonOptions {
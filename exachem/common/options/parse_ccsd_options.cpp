@@ -25,7 +25,7 @@ void ParseCCSDOptions::parse_check(json& jinput) {
       "comments", "threshold",    "force_tilesize", "tilesize",     "computeTData",
       "lshift",   "ndiis",        "ccsd_maxiter",   "freeze",       "PRINT",
       "readt",    "writet",       "writev",         "writet_iter",  "debug",
-      "nactive",  "profile_ccsd", "balance_tiles",  "ext_data_path"};
+      "nactive",  "profile_ccsd", "balance_tiles",  "ext_data_path", "cc2_lowmem"};
   // clang-format on
   for(auto& el: jinput["CC"].items()) {
     if(std::find(valid_cc.begin(), valid_cc.end(), el.key()) == valid_cc.end())
@@ -54,6 +54,7 @@ void ParseCCSDOptions::parse(ChemEnv& chem_env) {
   parse_option<bool>(cc_options.force_tilesize, jcc, "force_tilesize");
   parse_option<string>(cc_options.ext_data_path, jcc, "ext_data_path");
   parse_option<bool>(cc_options.computeTData, jcc, "computeTData");
+  parse_option<bool>(cc_options.cc2_lowmem, jcc, "cc2_lowmem");
 
   json jcc_print = jcc["PRINT"];
   parse_option<bool>(cc_options.ccsd_diagnostics, jcc_print, "ccsd_diagnostics");
@@ -83,6 +84,8 @@ void ParseCCSDOptions::parse(ChemEnv& chem_env) {
   parse_option<int>(cc_options.max_pnos, jdlpno, "max_pnos");
   parse_option<size_t>(cc_options.keep_npairs, jdlpno, "keep_npairs");
   parse_option<bool>(cc_options.localize, jdlpno, "localize");
+  parse_option<string>(cc_options.localize_method, jdlpno, "localize_method");
+  parse_option<bool>(cc_options.localize_virtuals, jdlpno, "localize_virtuals");
   parse_option<bool>(cc_options.skip_dlpno, jdlpno, "skip_dlpno");
   parse_option<string>(cc_options.dlpno_dfbasis, jdlpno, "df_basisset");
   parse_option<double>(cc_options.TCutDO, jdlpno, "TCutDO");
@@ -99,12 +102,18 @@ void ParseCCSDOptions::parse(ChemEnv& chem_env) {
   parse_option<bool>(cc_options.skip_ccsd, jccsd_t, "skip_ccsd");
   parse_option<int>(cc_options.cache_size, jccsd_t, "cache_size");
   parse_option<int>(cc_options.ccsdt_tilesize, jccsd_t, "ccsdt_tilesize");
+  parse_option<double>(cc_options.ccsdt_screen_thresh, jccsd_t, "ccsdt_screen_thresh");
 
   json jeomccsd = jcc["EOMCCSD"];
   parse_option<int>(cc_options.eom_nroots, jeomccsd, "eom_nroots");
   parse_option<int>(cc_options.eom_microiter, jeomccsd, "eom_microiter");
   parse_option<string>(cc_options.eom_type, jeomccsd, "eom_type");
   parse_option<double>(cc_options.eom_threshold, jeomccsd, "eom_threshold");
+  parse_option<string>(cc_options.eom_guess, jeomccsd, "eom_guess");
+  parse_option<bool>(cc_options.eom_cholesky, jeomccsd, "eom_cholesky");
+  parse_option<string>(cc_options.eom_target, jeomccsd, "eom_target");
+  parse_option<double>(cc_options.eom_target_energy, jeomccsd, "eom_target_energy");
+  parse_option<std::vector<int>>(cc_options.eom_target_orbitals, jeomccsd, "eom_target_orbitals");
 
   json jgfcc = jcc["GFCCSD"];
   // clang-format off
@@ -136,6 +145,9 @@ void ParseCCSDOptions::parse(ChemEnv& chem_env) {
   parse_option<double>(cc_options.gf_omega_delta      , jgfcc, "gf_omega_delta");
   parse_option<double>(cc_options.gf_omega_delta_e    , jgfcc, "gf_omega_delta_e");
   parse_option<int>   (cc_options.gf_extrapolate_level, jgfcc, "gf_extrapolate_level");
+  parse_option<bool>  (cc_options.gf_adaptive_grid    , jgfcc, "gf_adaptive_grid");
+  parse_option<string>(cc_options.gf_trace_mode       , jgfcc, "gf_trace_mode");
+  parse_option<int>   (cc_options.gf_nprobes          , jgfcc, "gf_nprobes");
   parse_option<int>   (cc_options.gf_analyze_level    , jgfcc, "gf_analyze_level");
   parse_option<int>   (cc_options.gf_analyze_num_omega, jgfcc, "gf_analyze_num_omega");
   parse_option<int>   (cc_options.gf_p_oi_range       , jgfcc, "gf_p_oi_range");
@@ -148,6 +160,26 @@ void ParseCCSDOptions::parse(ChemEnv& chem_env) {
     if(cc_options.gf_p_oi_range != 1 && cc_options.gf_p_oi_range != 2)
       tamm_terminate("gf_p_oi_range can only be one of 1 or 2");
   }
+
+  txt_utils::to_lower(cc_options.gf_trace_mode);
+  const std::vector<string> gf_trace_modes = {"full", "diagonal", "stochastic"};
+  if(std::find(gf_trace_modes.begin(), gf_trace_modes.end(), cc_options.gf_trace_mode) ==
+     gf_trace_modes.end())
+    tamm_terminate("gf_trace_mode can only be one of full, diagonal, stochastic");
+  if(cc_options.gf_trace_mode == "diagonal" && cc_options.gf_orbitals.empty())
+    tamm_terminate("gf_trace_mode=diagonal requires gf_orbitals");
+  if(cc_options.gf_trace_mode == "stochastic" && cc_options.gf_nprobes < 1)
+    tamm_terminate("gf_nprobes must be at least 1");
+
+  txt_utils::to_lower(cc_options.eom_guess);
+  if(cc_options.eom_guess != "koopmans" && cc_options.eom_guess != "cis")
+    tamm_terminate("eom_guess can only be one of koopmans, cis");
+  txt_utils::to_lower(cc_options.eom_target);
+  if(cc_options.eom_target != "lowest" && cc_options.eom_target != "energy" &&
+     cc_options.eom_target != "orbitals")
+    tamm_terminate("eom_target can only be one of lowest, energy, orbitals");
+  if(cc_options.eom_target == "orbitals" && cc_options.eom_target_orbitals.empty())
+    tamm_terminate("eom_target=orbitals requires eom_target_orbitals");
 }
 
 void ParseCCSDOptions::update_common_options(ChemEnv& chem_env) {
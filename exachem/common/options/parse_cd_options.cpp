@@ -19,8 +19,9 @@ ParseCDOptions::ParseCDOptions(ChemEnv& chem_env) {
 }
 
 void ParseCDOptions::parse_check(json& jinput) {
-  const std::vector<string> valid_cd{"comments", "debug",   "itilesize", "diagtol",
-                                     "write_cv", "skip_cd", "max_cvecs", "ext_data_path"};
+  const std::vector<string> valid_cd{"comments",  "debug",         "itilesize",
+                                     "diagtol",   "write_cv",      "skip_cd",
+                                     "max_cvecs", "ext_data_path", "spatial_storage"};
   for(auto& el: jinput["CD"].items()) {
     if(std::find(valid_cd.begin(), valid_cd.end(), el.key()) == valid_cd.end())
       tamm_terminate("INPUT FILE ERROR: Invalid CD option [" + el.key() + "] in the input file");
@@ -36,4 +37,5 @@ void ParseCDOptions::parse(ChemEnv& chem_env) {
   parse_option<std::pair<bool, int>>(chem_env.ioptions.cd_options.write_cv, jcd, "write_cv");
   parse_option<int>(chem_env.ioptions.cd_options.max_cvecs_factor, jcd, "max_cvecs");
   parse_option<string>(chem_env.ioptions.cd_options.ext_data_path, jcd, "ext_data_path");
+  parse_option<bool>(chem_env.ioptions.cd_options.spatial_storage, jcd, "spatial_storage");
 }
@@ -43,6 +43,9 @@ void ParseCommonOptions::parse(ChemEnv& chem_env) {
   // common
   parse_option<int>(common_options.maxiter, jinput["common"], "maxiter");
   parse_option<bool>(common_options.debug, jinput["common"], "debug");
+  parse_option<bool>(common_options.telemetry, jinput["common"], "telemetry");
+  parse_option<double>(common_options.memory_overhead, jinput["common"], "memory_overhead");
+  parse_option<bool>(common_options.memory_dry_run, jinput["common"], "memory_dry_run");
   parse_option<std::string>(common_options.file_prefix, jinput["common"], "file_prefix");
 
   // parse cube options here for now
@@ -26,7 +26,7 @@ void ParseSCFOptions::parse_check(json& jinput) {
     "debug","scf_type", "n_lindep","restart_size","scalapack_nb",
     "scalapack_np_row", "scalapack_np_col", "ext_data_path", "PRINT",
     "qed_omegas", "qed_lambdas", "qed_volumes", "qed_polvecs",
-    "direct_df", "DFT", "comments"};
+    "direct_df", "node_shared", "gradient", "cfmm", "cfmm_order", "DFT", "comments"};
   const std::vector<std::string> valid_dft{"xc_pruning_scheme", "xc_rad_quad", "xc_batch_size", 
     "xc_snK_etol", "xc_snK_ktol", "xc_weight_scheme", "xc_exec_space", "snK", "xc_type", 
     "xc_lb_kernel", "xc_mw_kernel", "xc_int_kernel", "xc_red_kernel", "xc_lwd_kernel", 
@@ -68,6 +68,10 @@ void ParseSCFOptions::parse(ChemEnv& chem_env) {
   parse_option<bool>(scf_options.debug, jscf, "debug");
   parse_option<std::string>(scf_options.scf_type, jscf, "scf_type");
   parse_option<bool>(scf_options.direct_df, jscf, "direct_df");
+  parse_option<bool>(scf_options.node_shared, jscf, "node_shared");
+  parse_option<bool>(scf_options.gradient, jscf, "gradient");
+  parse_option<bool>(scf_options.cfmm, jscf, "cfmm");
+  parse_option<int>(scf_options.cfmm_order, jscf, "cfmm_order");
   parse_option<bool>(scf_options.molden, jscf, "molden");
   parse_option<std::string>(scf_options.moldenfile, jscf, "moldenfile");
 
@@ -110,7 +114,9 @@ void ParseSCFOptions::parse(ChemEnv& chem_env) {
   }
 
   json jscf_analysis = jscf["PRINT"];
-  parse_option<bool>(scf_options.mos_txt, jscf_analysis, "mos_txt");
+  if(jscf_analysis.contains("mos_txt"))
+    tamm_terminate("INPUT FILE ERROR: SCF PRINT option mos_txt has been replaced by mo_ints");
+  parse_option<bool>(scf_options.mo_ints, jscf_analysis, "mo_ints");
   parse_option<bool>(scf_options.mulliken_analysis, jscf_analysis, "mulliken");
   parse_option<std::pair<bool, double>>(scf_options.mo_vectors_analysis, jscf_analysis,
                                         "mo_vectors");
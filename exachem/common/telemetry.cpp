@@ -0,0 +1,105 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "telemetry.hpp"
+#include <sys/resource.h>
+
+void Telemetry::open(const std::string& filename) {
+  if(out_.is_open()) out_.close();
+  // append, so that a restarted job continues the stream of the run it restarts
+  out_.open(filename, std::ios::out | std::ios::app);
+  start_ = std::chrono::high_resolution_clock::now();
+}
+
+void Telemetry::close() {
+  if(out_.is_open()) out_.close();
+}
+
+// peak before the last reset of the high-water mark, which also resets ru_maxrss on Linux
+static double rss_peak_floor_gib = 0;
+
+// value of a "<key>: <n> kB" line of /proc/self/status in GiB
+static double proc_status_gib(const std::string& key) {
+  std::ifstream status("/proc/self/status");
+  std::string   line;
+  while(std::getline(status, line)) {
+    if(line.compare(0, key.size(), key) != 0) continue;
+    return std::stod(line.substr(key.size())) / (1024.0 * 1024.0);
+  }
+  return 0;
+}
+
+double Telemetry::peak_rss_gib() {
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0) return rss_peak_floor_gib;
+#if defined(__APPLE__)
+  const double bytes = static_cast<double>(usage.ru_maxrss);
+#else
+  const double bytes = static_cast<double>(usage.ru_maxrss) * 1024.0;
+#endif
+  return std::max(rss_peak_floor_gib, bytes / (1024.0 * 1024.0 * 1024.0));
+}
+
+double Telemetry::rss_gib() { return proc_status_gib("VmRSS:"); }
+
+double Telemetry::rss_hwm_gib() { return proc_status_gib("VmHWM:"); }
+
+bool Telemetry::reset_rss_hwm() {
+  const double peak = peak_rss_gib();
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if(!clear_refs.is_open() || !(clear_refs << "5" << std::flush)) return false;
+  rss_peak_floor_gib = peak;
+  return true;
+}
+
+void Telemetry::record(const std::string& module, const std::string& phase,
+                       nlohmann::ordered_json data) {
+  if(!out_.is_open()) return;
+
+  const auto   now     = std::chrono::high_resolution_clock::now();
+  const double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(now - start_)
+                           .count();
+
+  nlohmann::ordered_json rec;
+  rec["module"]  = module;
+  rec["phase"]   = phase;
+  rec["elapsed"] = elapsed;
+  for(auto& [key, val]: data.items()) rec[key] = val;
+  if(!rec.contains("peak_memory_gib")) rec["peak_memory_gib"] = peak_rss_gib();
+
+  out_ << rec.dump() << std::endl;
+}
+
+void Telemetry::record(const tamm::ProcGroup& pg, const std::string& module,
+                       const std::string& phase, double wall_time, double flops,
+                       nlohmann::ordered_json data) {
+  // enabled_ is the same on all ranks of pg
+  if(!enabled_) return;
+
+  double peak_mem = peak_rss_gib();
+  auto   comm     = pg.comm();
+  if(pg.rank() == 0) {
+    MPI_Reduce(MPI_IN_PLACE, &peak_mem, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+    MPI_Reduce(MPI_IN_PLACE, &flops, 1, MPI_DOUBLE, MPI_SUM, 0, comm);
+  }
+  else {
+    MPI_Reduce(&peak_mem, nullptr, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+    MPI_Reduce(&flops, nullptr, 1, MPI_DOUBLE, MPI_SUM, 0, comm);
+    return;
+  }
+
+  nlohmann::ordered_json rec;
+  rec["wall_time"] = wall_time;
+  if(flops > 0) {
+    rec["flops"] = flops;
+    if(wall_time > 0) rec["gflops"] = flops / wall_time / 1e9;
+  }
+  for(auto& [key, val]: data.items()) rec[key] = val;
+  rec["peak_memory_gib"] = peak_mem;
+  record(module, phase, rec);
+}
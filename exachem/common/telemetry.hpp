@@ -0,0 +1,61 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "tamm/tamm.hpp"
+#include <chrono>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+/**
+ * Append-only stream of per-phase performance records (common option telemetry).
+ *
+ * Every record is a single JSON object written as one line of <prefix>.telemetry.jsonl and
+ * flushed immediately, so the records of all completed phases survive a job that dies mid-run.
+ * Each record carries the module, the phase, the elapsed time since the stream was opened, the
+ * peak resident memory and whatever the caller adds (wall_time, flops, iteration data).
+ *
+ * enable() is called on every rank of the process group that runs the input, the stream itself
+ * is opened only on its rank 0: world rank 0 for a single input, the rank 0 of every group when
+ * the inputs run as a task farm. The rank-local record() is a no-op everywhere else, the
+ * collective one returns on all ranks without communicating when telemetry is off.
+ */
+class Telemetry {
+public:
+  void enable(bool on) { enabled_ = on; }
+  bool enabled() const { return enabled_; }
+  void open(const std::string& filename);
+  void close();
+  bool is_open() const { return out_.is_open(); }
+
+  // rank-local record, called from code that already runs on rank 0 only
+  void record(const std::string& module, const std::string& phase,
+              nlohmann::ordered_json data = {});
+
+  // collective over pg: peak memory is the maximum and flops the sum over all ranks
+  void record(const tamm::ProcGroup& pg, const std::string& module, const std::string& phase,
+              double wall_time, double flops = 0, nlohmann::ordered_json data = {});
+
+  // peak resident set size of the calling process in GiB
+  static double peak_rss_gib();
+
+  // current resident set size and its high-water mark since the last reset_rss_hwm() in GiB,
+  // read from /proc/self/status. Both return 0 where it is not available.
+  static double rss_gib();
+  static double rss_hwm_gib();
+  // restarts the high-water mark at the current resident set size, false if not supported.
+  // peak_rss_gib() keeps reporting the peak over the lifetime of the process.
+  static bool reset_rss_hwm();
+
+private:
+  bool                                           enabled_{false};
+  std::ofstream                                  out_;
+  std::chrono::high_resolution_clock::time_point start_;
+};
@@ -86,12 +86,18 @@ void fci_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
   SystemData   sys_data     = chem_env.sys_data;
   CCSDOptions& ccsd_options = chem_env.ioptions.ccsd_options;
+  const auto&  task         = chem_env.ioptions.task_options;
   if(rank == 0) ccsd_options.print();
 
+  if(task.fci && !sys_data.is_restricted)
+    tamm_terminate("INPUT FILE ERROR: [FCI] only closed-shell references are supported");
+  if(task.fci && (chem_env.get_nfcore() > 0 || ccsd_options.freeze_virtual > 0))
+    tamm_terminate("INPUT FILE ERROR: [FCI] use NINACTIVE instead of frozen orbitals");
+
   if(rank == 0)
     cout << endl << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   std::string out_fp       = chem_env.workspace_dir;
   std::string files_dir    = out_fp + chem_env.ioptions.scf_options.scf_type;
@@ -113,7 +119,7 @@ void fci_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
   if(ccsd_restart) {
     read_from_disk(d_f1, f1file);
-    read_from_disk(cholVpr, v2file);
+    cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
   }
 
@@ -122,7 +128,7 @@ void fci_driver(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -134,26 +140,35 @@ void fci_driver(ExecutionContext& ec, ChemEnv& chem_env) {
 
   ec.pg().barrier();
 
-  auto [cindex]     = CI.labels<1>("all");
-  auto [p, q, r, s] = MO.labels<4>("all");
+  if(task.fcidump) {
+    auto [cindex]     = CI.labels<1>("all");
+    auto [p, q, r, s] = MO.labels<4>("all");
 
-  Tensor<T> full_v2{N, N, N, N};
-  Tensor<T>::allocate(&ec, full_v2);
+    Tensor<T> full_v2{N, N, N, N};
+    Tensor<T>::allocate(&ec, full_v2);
 
-  // clang-format off
-  Scheduler sch{ec};
-  sch(full_v2(p, r, q, s)  = cholVpr(p, r, cindex) * cholVpr(q, s, cindex)).execute(ex_hw);
-  // clang-format off
+    // clang-format off
+    Scheduler sch{ec};
+    sch(full_v2(p, r, q, s)  = cholVpr(p, r, cindex) * cholVpr(q, s, cindex)).execute(ex_hw);
+    // clang-format on
 
-  free_tensors(cholVpr);
+    files_prefix = generate_fcidump(chem_env, ec, MO, lcao, d_f1, full_v2, ex_hw);
+    free_tensors(full_v2);
+  }
+
+#if defined(USE_MACIS)
+  // the integrals are handed to MACIS in memory, without an FCIDUMP round trip
+  if(task.fci) {
+    auto ints = macis_integrals(ec, chem_env, lcao, cholVpr);
+    cholesky_2e::free_chol_vectors(chem_env, cholVpr);
+    macis_driver(ec, chem_env, ints);
+    ints.V.deallocate();
+  }
+  else
+#endif
+    cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
-  files_prefix = generate_fcidump(chem_env, ec, MO, lcao, d_f1, full_v2, ex_hw);
-  #if defined(USE_MACIS)
-  if(options_map.task_options.fci)
-    macis_driver(ec, sys_data, files_prefix);
-  #endif
-  
-  free_tensors(lcao, d_f1, full_v2);
+  free_tensors(lcao, d_f1);
 
   ec.flush_and_sync();
   // delete ec;
@@ -42,6 +42,8 @@
 #include <map>
 #include <sparsexx/io/write_dist_mm.hpp>
 
+#include "scf/scf_shared_matrix.hpp"
+
 using macis::NumActive;
 using macis::NumCanonicalOccupied;
 using macis::NumCanonicalVirtual;
@@ -64,9 +66,117 @@ T vec_sum(const std::vector<T>& x) {
   return std::accumulate(x.begin(), x.end(), T(0));
 }
 
+// widest determinant the CI driver is instantiated for
+constexpr size_t max_wfn_bits = 256;
+
+// narrowest determinant width (64, 128 or 256 bits) that holds both spin strings of nactive
+// orbitals
+inline size_t wfn_bits_for(size_t nactive) {
+  size_t nbits = 64;
+  while(nbits < 2 * nactive && nbits < max_wfn_bits) nbits *= 2;
+  return nbits;
+}
+
 namespace exachem::fci {
 
-void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string files_prefix) {
+/**
+ * Spatial-orbital integrals handed to MACIS in memory. The norb^4 two-electron tensor is
+ * stored once per node, V(pq, rs) = (pq|rs) in chemist's notation.
+ */
+struct MACISIntegrals {
+  size_t                norb{};
+  double                E_core{};
+  std::vector<double>   T; // norb x norb core hamiltonian
+  scf::NodeSharedMatrix V;
+};
+
+/**
+ * Builds the MACIS integrals of a closed-shell reference from the alpha blocks of the MO
+ * cholesky vectors. The ranks of a node first read the alpha rows L(p, q, :) into a node-shared
+ * matrix, each rank reading a subset of the row tiles, and then form disjoint row slabs of
+ * V = L L^T in the node-shared window.
+ */
+template<typename TT>
+MACISIntegrals macis_integrals(ExecutionContext& ec, ChemEnv& chem_env, Tensor<TT>& lcao,
+                               Tensor<TT>& cholVpr) {
+  SystemData& sys_data = chem_env.sys_data;
+  const int   noa      = sys_data.n_occ_alpha;
+  const int   nva      = sys_data.n_vir_alpha;
+  const int   nocc     = sys_data.nocc;
+
+  MACISIntegrals ints;
+  ints.norb         = noa + nva;
+  const size_t norb = ints.norb;
+  ints.E_core       = sys_data.results["output"]["SCF"]["nucl_rep_energy"];
+
+  // spin-orbital index of every alpha orbital, -1 for the beta orbitals
+  std::vector<int> alpha_pos(nocc + sys_data.nvir, -1);
+  for(int p = 0; p < noa; p++) alpha_pos[p] = p;
+  for(int a = 0; a < nva; a++) alpha_pos[nocc + a] = noa + a;
+
+  // core hamiltonian in the alpha MO basis
+  std::string files_dir = chem_env.workspace_dir + chem_env.ioptions.scf_options.scf_type;
+  TiledIndexSpace AO    = lcao.tiled_index_spaces()[0];
+  Tensor<TT>      hcore{AO, AO};
+  Tensor<TT>::allocate(&ec, hcore);
+  read_from_disk(hcore, files_dir + "/scf/" + sys_data.output_file_prefix + ".hcore");
+  const Matrix H = tamm_to_eigen_matrix(hcore);
+  const Matrix C = tamm_to_eigen_matrix(lcao);
+  Tensor<TT>::deallocate(hcore);
+
+  Matrix C_a(C.rows(), norb);
+  C_a << C.leftCols(noa), C.middleCols(nocc, nva);
+  ints.T.resize(norb * norb);
+  Eigen::Map<Matrix>(ints.T.data(), norb, norb) = C_a.transpose() * H * C_a;
+
+  const auto&  tis = cholVpr.tiled_index_spaces();
+  const size_t nQ  = tis[2].max_num_indices();
+
+  auto world_comm = ec.pg().comm();
+
+  scf::NodeSharedMatrix L;
+  L.allocate(world_comm, norb * norb, nQ);
+  int node_rank, node_size;
+  MPI_Comm_rank(L.node_comm(), &node_rank);
+  MPI_Comm_size(L.node_comm(), &node_size);
+
+  // the tiles of MO do not mix spins, so the first index decides
+  auto Lmat = L.map();
+  for(Tile tp = node_rank; tp < tis[0].num_tiles(); tp += node_size) {
+    for(Tile tq = 0; tq < tis[1].num_tiles(); tq++) {
+      for(Tile tc = 0; tc < tis[2].num_tiles(); tc++) {
+        const IndexVector blockid{tp, tq, tc};
+        const auto        offs = cholVpr.block_offsets(blockid);
+        if(alpha_pos[offs[0]] < 0 || alpha_pos[offs[1]] < 0) break;
+        const auto     dims = cholVpr.block_dims(blockid);
+        std::vector<TT> buf(cholVpr.block_size(blockid));
+        cholVpr.get(blockid, buf);
+        for(size_t i = 0, c = 0; i < dims[0]; i++) {
+          const size_t p = alpha_pos[offs[0] + i];
+          for(size_t j = 0; j < dims[1]; j++) {
+            const size_t q = alpha_pos[offs[1] + j];
+            for(size_t k = 0; k < dims[2]; k++, c++) Lmat(p * norb + q, offs[2] + k) = buf[c];
+          }
+        }
+      }
+    }
+  }
+  L.sync();
+
+  ints.V.allocate(world_comm, norb * norb, norb * norb);
+  const size_t nrows = norb * norb;
+  const size_t slab  = (nrows + node_size - 1) / node_size;
+  const size_t r0    = std::min(nrows, node_rank * slab);
+  const size_t nr    = std::min(nrows, r0 + slab) - r0;
+  const auto   Lc    = L.cmap();
+  if(nr > 0) ints.V.map().middleRows(r0, nr).noalias() = Lc.middleRows(r0, nr) * Lc.transpose();
+  ints.V.sync();
+  L.deallocate();
+
+  return ints;
+}
+
+void macis_driver(ExecutionContext& ec, ChemEnv& chem_env, MACISIntegrals& ints) {
   using hrt_t = std::chrono::high_resolution_clock;
   using dur_t = std::chrono::duration<double, std::milli>;
 
@@ -74,8 +184,6 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
   spdlog::cfg::load_env_levels();
   spdlog::set_pattern("[%n] %v");
 
-  constexpr size_t nwfn_bits = 64;
-
   auto world_comm = ec.pg().comm();
   auto world_rank = macis::comm_rank(world_comm);
   auto world_size = macis::comm_size(world_comm);
@@ -83,28 +191,23 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
   // Create Logger
   auto console = world_rank ? spdlog::null_logger_mt("CI") : spdlog::stdout_color_mt("CI");
 
-  auto ci_options = sys_data.options_map.fci_options;
+  auto ci_options = chem_env.ioptions.fci_options;
 
   // Required Keywords
-  auto nalpha        = ci_options.nalpha;
-  auto nbeta         = ci_options.nbeta;
-  auto fcidump_fname = files_prefix + ".fcidump";
+  auto nalpha = ci_options.nalpha;
+  auto nbeta  = ci_options.nbeta;
 
   if(nalpha != nbeta) tamm_terminate("INPUT FILE ERROR: [FCI] NALPHA != BETA");
 
-  // Read FCIDUMP File
-  size_t norb  = macis::read_fcidump_norb(fcidump_fname);
+  size_t norb  = ints.norb;
   size_t norb2 = norb * norb;
-  size_t norb3 = norb2 * norb;
   size_t norb4 = norb2 * norb2;
 
-  // console->info("norb = {}", norb);
-
-  // XXX: Consider reading this into shared memory to avoid replication
-  std::vector<double> T(norb2), V(norb4);
-  auto                E_core = macis::read_fcidump_core(fcidump_fname);
-  macis::read_fcidump_1body(fcidump_fname, T.data(), norb);
-  macis::read_fcidump_2body(fcidump_fname, V.data(), norb);
+  // T is private to every rank, V is shared by the ranks of a node
+  std::vector<double>& T      = ints.T;
+  double*              V      = ints.V.map().data();
+  const bool           v_root = ints.V.node_root();
+  auto                 E_core = ints.E_core;
 
   // Set up job
   std::string job_str = ci_options.job;
@@ -137,7 +240,11 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
   std::string rdm_fname = ""; // ci_options.rdm_fname
   std::string fci_out_fname{};
 
-  if(n_active > nwfn_bits / 2) tamm_terminate("[FCI] Not Enough Bits");
+  if(2 * n_active > max_wfn_bits)
+    tamm_terminate("INPUT FILE ERROR: [FCI] NACTIVE > " + std::to_string(max_wfn_bits / 2));
+  // the CASSCF solver of MACIS works with 64-bit determinants
+  if(job == Job::MCSCF && 2 * n_active > 64)
+    tamm_terminate("INPUT FILE ERROR: [FCI] MCSCF supports at most 32 active orbitals");
 
   // MCSCF Settings
   macis::MCSCFSettings mcscf_settings;
@@ -164,16 +271,16 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
     console->info("[Wavefunction Data]:");
     console->info("  * JOB     = {}", job_str);
     console->info("  * CIEXP   = {}", ciexp_str);
-    console->info("  * FCIDUMP = {}", fcidump_fname);
+    console->info("  * NORB    = {}", norb);
     if(fci_out_fname.size()) console->info("  * FCIDUMP_OUT = {}", fci_out_fname);
     console->info("  * MP2_GUESS = {}", mp2_guess);
 
-    console->debug("READ {} 1-body integrals and {} 2-body integrals", T.size(), V.size());
+    console->debug("{} 1-body integrals and {} 2-body integrals", T.size(), norb4);
     console->info("ECORE  = {:.12f}", E_core);
     console->debug("TSUM  = {:.12f}", vec_sum(T));
-    console->debug("VSUM  = {:.12f}", vec_sum(V));
+    console->debug("VSUM  = {:.12f}", std::accumulate(V, V + norb4, 0.0));
     console->info("TMEM   = {:.2e} GiB", macis::to_gib(T));
-    console->info("VMEM   = {:.2e} GiB", macis::to_gib(V));
+    console->info("VMEM   = {:.2e} GiB per node", norb4 * sizeof(double) / 1073741824.0);
   }
 
   // Setup printing
@@ -199,26 +306,43 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
     std::vector<double> MP2_RDM(norb * norb, 0.0);
     std::vector<double> W_occ(norb);
     macis::mp2_natural_orbitals(NumOrbital(norb), NumCanonicalOccupied(nocc_canon),
-                                NumCanonicalVirtual(nvir_canon), T.data(), norb, V.data(), norb,
+                                NumCanonicalVirtual(nvir_canon), T.data(), norb, V, norb,
                                 W_occ.data(), MP2_RDM.data(), norb);
 
-    // Transform Hamiltonian
+    // Transform Hamiltonian, the shared V is transformed once per node after every rank on the
+    // node is done reading it
     macis::two_index_transform(norb, norb, T.data(), norb, MP2_RDM.data(), norb, T.data(), norb);
-    macis::four_index_transform(norb, norb, V.data(), norb, MP2_RDM.data(), norb, V.data(), norb);
+    ints.V.sync();
+    if(v_root)
+      macis::four_index_transform(norb, norb, V, norb, MP2_RDM.data(), norb, V, norb);
+    ints.V.sync();
   }
 
-  // Copy integrals into active subsets
-  std::vector<double> T_active(n_active * n_active);
-  std::vector<double> V_active(n_active * n_active * n_active * n_active);
-
-  // Compute active-space Hamiltonian and inactive Fock matrix
-  std::vector<double> F_inactive(norb2);
-  macis::active_hamiltonian(NumOrbital(norb), NumActive(n_active), NumInactive(n_inactive),
-                            T.data(), norb, V.data(), norb, F_inactive.data(), norb,
-                            T_active.data(), n_active, V_active.data(), n_active);
+  // Active-space Hamiltonian and inactive Fock matrix. Without inactive orbitals the active
+  // integrals are the full ones, otherwise the node root copies the active subset of V into a
+  // second node-shared window.
+  const size_t          n_active2 = n_active * n_active;
+  std::vector<double>   F_inactive(norb2);
+  std::vector<double>   T_active(n_active2);
+  scf::NodeSharedMatrix V_active_shm;
+  double*               V_active = V;
+
+  macis::inactive_fock_matrix(NumOrbital(norb), NumInactive(n_inactive), T.data(), norb, V, norb,
+                              F_inactive.data(), norb);
+  macis::active_submatrix_1body(NumActive(n_active), NumInactive(n_inactive), F_inactive.data(),
+                                norb, T_active.data(), n_active);
+  if(n_inactive > 0) {
+    V_active_shm.allocate(world_comm, n_active2, n_active2);
+    V_active = V_active_shm.map().data();
+    if(V_active_shm.node_root())
+      macis::active_subtensor_2body(NumActive(n_active), NumInactive(n_inactive), V, norb,
+                                    V_active, n_active);
+    V_active_shm.sync();
+  }
 
   console->debug("FINACTIVE_SUM = {:.12f}", vec_sum(F_inactive));
-  console->debug("VACTIVE_SUM   = {:.12f}", vec_sum(V_active));
+  console->debug("VACTIVE_SUM   = {:.12f}",
+                 std::accumulate(V_active, V_active + n_active2 * n_active2, 0.0));
   console->debug("TACTIVE_SUM   = {:.12f}", vec_sum(T_active));
 
   // Compute Inactive energy
@@ -232,14 +356,16 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
 
   double E0 = 0;
 
-  // CI
-  if(job == Job::CI) {
-    using generator_t = macis::DoubleLoopHamiltonianGenerator<nwfn_bits>;
+  // CI in the narrowest determinant width that holds the alpha and beta strings of the active
+  // space, the excitation kernels work on whole 64-bit words
+  auto run_ci = [&](auto wfn_bits) {
+    constexpr size_t nwfn_bits = decltype(wfn_bits)::value;
+    using generator_t          = macis::DoubleLoopHamiltonianGenerator<nwfn_bits>;
     if(ci_exp == CIExpansion::CAS) {
       std::vector<double> C_local;
       // TODO: VERIFY MPI + CAS
       E0 = macis::CASRDMFunctor<generator_t>::rdms(
-        mcscf_settings, NumOrbital(n_active), nalpha, nbeta, T_active.data(), V_active.data(),
+        mcscf_settings, NumOrbital(n_active), nalpha, nbeta, T_active.data(), V_active,
         active_ordm.data(), active_trdm.data(), C_local, world_comm);
       E0 += E_inactive + E_core;
 
@@ -259,7 +385,7 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
     else {
       generator_t ham_gen(
         macis::matrix_span<double>(T_active.data(), n_active, n_active),
-        macis::rank4_span<double>(V_active.data(), n_active, n_active, n_active, n_active));
+        macis::rank4_span<double>(V_active, n_active, n_active, n_active, n_active));
 
       std::vector<macis::wfn_t<nwfn_bits>> dets;
       std::vector<double>                  C;
@@ -320,8 +446,14 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
         sparsexx::write_dist_mm("ham.mtx", H, 1);
       }
     }
+  };
 
-    // MCSCF
+  if(job == Job::CI) {
+    const size_t nwfn_bits = wfn_bits_for(n_active);
+    console->info("Determinant width = {} bits", nwfn_bits);
+    if(nwfn_bits == 64) run_ci(std::integral_constant<size_t, 64>{});
+    else if(nwfn_bits == 128) run_ci(std::integral_constant<size_t, 128>{});
+    else run_ci(std::integral_constant<size_t, 256>{});
   }
   else if(job == Job::MCSCF) {
     // Possibly read active RDMs
@@ -336,20 +468,22 @@ void macis_driver(ExecutionContext& ec, SystemData& sys_data, const std::string
 
       // Compute CI energy from RDMs
       double ERDM = blas::dot(active_ordm.size(), active_ordm.data(), 1, T_active.data(), 1);
-      ERDM += blas::dot(active_trdm.size(), active_trdm.data(), 1, V_active.data(), 1);
+      ERDM += blas::dot(active_trdm.size(), active_trdm.data(), 1, V_active, 1);
       console->info("E(RDM)  = {:.12f} Eh", ERDM + E_inactive + E_core);
     }
 
     // CASSCF
     E0 = macis::casscf_diis(mcscf_settings, NumElectron(nalpha), NumElectron(nbeta),
                             NumOrbital(norb), NumInactive(n_inactive), NumActive(n_active),
-                            NumVirtual(n_virtual), E_core, T.data(), norb, V.data(), norb,
+                            NumVirtual(n_virtual), E_core, T.data(), norb, V, norb,
                             active_ordm.data(), n_active, active_trdm.data(), n_active, world_comm);
   }
 
   console->info("E(CI)  = {:.12f} Eh", E0);
 
   if(fci_out_fname.size())
-    macis::write_fcidump(fci_out_fname, norb, T.data(), norb, V.data(), norb, E_core);
+    macis::write_fcidump(fci_out_fname, norb, T.data(), norb, V, norb, E_core);
+
+  V_active_shm.deallocate();
 }
 } // namespace exachem::fci
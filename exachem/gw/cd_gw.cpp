@@ -0,0 +1,584 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "cd_gw.hpp"
+#include <Eigen/IterativeLinearSolvers>
+#include <complex>
+#include <filesystem>
+
+namespace exachem::gw {
+
+namespace {
+
+constexpr double au2ev = 27.211386245988;
+
+using Complex = std::complex<double>;
+
+// Gauss-Legendre nodes and weights on [-1,1]
+void gauss_legendre(int n, std::vector<double>& x, std::vector<double>& w) {
+  x.resize(n);
+  w.resize(n);
+  for(int i = 0; i < n; i++) {
+    double z = std::cos(M_PI * (i + 0.75) / (n + 0.5));
+    double dp;
+    for(int iter = 0; iter < 100; iter++) {
+      double p0 = 1.0, p1 = 0.0;
+      for(int j = 1; j <= n; j++) {
+        const double p2 = p1;
+        p1              = p0;
+        p0              = ((2.0 * j - 1.0) * z * p1 - (j - 1.0) * p2) / j;
+      }
+      dp              = n * (z * p0 - p1) / (z * z - 1.0);
+      const double dz = p0 / dp;
+      z -= dz;
+      if(std::abs(dz) < 1e-15) break;
+    }
+    x[i] = z;
+    w[i] = 2.0 / ((1.0 - z * z) * dp * dp);
+  }
+}
+
+// rows L(p,:,:) of the MO cholesky vectors for the spin-orbitals p in rows, restricted to the
+// spin-orbitals in cols, as cols.size() x nQ matrices
+std::map<int, Matrix> read_chol_rows(Tensor<double>& cholVpr, const std::set<int>& rows,
+                                     const std::vector<int>& cols, int nQ) {
+  const auto&      tis = cholVpr.tiled_index_spaces();
+  std::vector<int> col_pos(tis[1].max_num_indices(), -1);
+  for(size_t c = 0; c < cols.size(); c++) col_pos[cols[c]] = c;
+
+  std::map<int, Matrix> out;
+  for(int p: rows) out[p] = Matrix::Zero(cols.size(), nQ);
+
+  for(Tile tp = 0; tp < tis[0].num_tiles(); tp++) {
+    for(Tile tq = 0; tq < tis[1].num_tiles(); tq++) {
+      for(Tile tc = 0; tc < tis[2].num_tiles(); tc++) {
+        const IndexVector blockid{tp, tq, tc};
+        const auto        dims  = cholVpr.block_dims(blockid);
+        const auto        offs  = cholVpr.block_offsets(blockid);
+        auto              first = rows.lower_bound(static_cast<int>(offs[0]));
+        if(first == rows.end() || *first >= static_cast<int>(offs[0] + dims[0])) continue;
+        if(std::none_of(col_pos.begin() + offs[1], col_pos.begin() + offs[1] + dims[1],
+                        [](int c) { return c >= 0; }))
+          continue;
+
+        std::vector<double> buf(cholVpr.block_size(blockid));
+        cholVpr.get(blockid, buf);
+        for(auto it = first; it != rows.end() && *it < static_cast<int>(offs[0] + dims[0]); ++it) {
+          const size_t p = *it - offs[0];
+          for(size_t q = 0; q < dims[1]; q++) {
+            const int c = col_pos[offs[1] + q];
+            if(c < 0) continue;
+            for(size_t Q = 0; Q < dims[2]; Q++)
+              out[*it](c, offs[2] + Q) = buf[(p * dims[1] + q) * dims[2] + Q];
+          }
+        }
+      }
+    }
+  }
+  return out;
+}
+
+// orbitals of one spin, occupied first
+struct GWSpin {
+  std::string         name;
+  int                 no{}, nv{};
+  std::vector<int>    so;     // spin-orbital index of every orbital
+  std::vector<double> eps_mf; // mean-field orbital energies
+  std::vector<double> eps_g;  // orbital energies of G
+  std::vector<double> eps_w;  // orbital energies of the response function
+  std::vector<int>    qp;     // quasiparticle states
+
+  // L_ia of the occupied orbitals i owned by this rank, rows (i,a)
+  std::vector<std::pair<int, int>> ia;
+  Matrix                           Lov;
+
+  // L_nm of the quasiparticle states n, nmo x nQ
+  std::vector<Matrix> Ln;
+  std::vector<double> sigma_x, vxc;
+
+  // cdgw: W_nm(i omega_k) of the quasiparticle states, row k * nqp + n
+  Matrix wim;
+  // sdgw: w_nm^s of the quasiparticle states, nmo x nexc
+  std::vector<Matrix> wn;
+
+  int nmo() const { return no + nv; }
+};
+
+/**
+ * Correlation self-energy of the quasiparticle states in the GW approximation.
+ *
+ * The response function is built from the cholesky vectors L of the MO integrals,
+ * (pq|rs) = sum_Q L_pq^Q L_rs^Q, so that the screened interaction is a matrix in the cholesky
+ * index, W^c(w) = [1 - Pi(w)]^-1 - 1 with Pi_PQ(w) = s sum_ia L_ia^P L_ia^Q [1/(w - d_ia) -
+ * 1/(w + d_ia)], s = 2 for closed shells. The L_ia are distributed over the ranks by occupied
+ * orbital, every rank builds the contribution of its rows and Pi is summed over the ranks.
+ *
+ * cdgw evaluates Sigma^c by contour deformation: an integral along the imaginary axis on a
+ * Gauss-Legendre grid plus the residues of the poles of G enclosed by the contour, which need
+ * W^c at real frequencies. sdgw diagonalizes the RPA problem once and evaluates Sigma^c from
+ * its excitations.
+ */
+class GWSelfEnergy {
+public:
+  GWSelfEnergy(ExecutionContext& ec, const GWOptions& options, std::vector<GWSpin>& spins,
+               double spin_factor, int nQ):
+    ec_(ec), spins_(spins), sf_(spin_factor), nQ_(nQ) {
+    cdgw_   = options.method == "cdgw" || options.method == "CDGW";
+    eta_    = options.ieta;
+    minres_ = options.minres;
+    nranks_ = ec.pg().size().value();
+    rank_   = ec.pg().rank().value();
+    if(cdgw_) {
+      // Gauss-Legendre grid mapped onto [0, inf)
+      std::vector<double> x, w;
+      gauss_legendre(options.ngl, x, w);
+      omega_.resize(options.ngl);
+      weight_.resize(options.ngl);
+      for(int k = 0; k < options.ngl; k++) {
+        omega_[k]  = (1.0 + x[k]) / (1.0 - x[k]);
+        weight_[k] = 2.0 * w[k] / ((1.0 - x[k]) * (1.0 - x[k]));
+      }
+    }
+  }
+
+  // screened interaction for the current eps_w, collective
+  void screen() {
+    if(cdgw_) imaginary_axis();
+    else rpa();
+  }
+
+  // Re Sigma^c_n(w) of the quasiparticle state q of spin s, collective for cdgw
+  double sigma_c(int s, int q, double w) {
+    const GWSpin& sp = spins_[s];
+    double        sigma{0};
+
+    if(!cdgw_) {
+      const Matrix& wn = sp.wn[q];
+      for(int m = 0; m < sp.nmo(); m++) {
+        const double sgn = (m < sp.no) ? 1.0 : -1.0;
+        for(int x = 0; x < wn.cols(); x++) {
+          const double d = w - sp.eps_g[m] + sgn * omega_rpa_(x);
+          sigma += wn(m, x) * wn(m, x) * d / (d * d + eta_ * eta_);
+        }
+      }
+      return sigma;
+    }
+
+    const int nqp = sp.qp.size();
+    for(size_t k = 0; k < omega_.size(); k++) {
+      for(int m = 0; m < sp.nmo(); m++) {
+        const double d = w - sp.eps_g[m];
+        sigma -= weight_[k] * sp.wim(k * nqp + q, m) * d / (d * d + omega_[k] * omega_[k]) / M_PI;
+      }
+    }
+
+    // residues of the occupied poles above w and the virtual poles below w
+    for(int m = 0; m < sp.nmo(); m++) {
+      const bool occ = m < sp.no;
+      if(occ ? sp.eps_g[m] <= w : sp.eps_g[m] >= w) continue;
+      const Eigen::MatrixXcd pi = polarizability(Complex(std::abs(sp.eps_g[m] - w), eta_));
+      const Eigen::MatrixXcd a  = Eigen::MatrixXcd::Identity(nQ_, nQ_) - pi;
+      const Eigen::VectorXcd l  = sp.Ln[q].row(m).transpose().cast<Complex>();
+      const Eigen::VectorXcd x  = a.partialPivLu().solve(l);
+      const double           wr = (l.dot(x) - l.dot(l)).real();
+      sigma += occ ? -wr : wr;
+    }
+    return sigma;
+  }
+
+private:
+  // Pi(w) summed over the ranks
+  Eigen::MatrixXcd polarizability(Complex w) {
+    Matrix pi_local = Matrix::Zero(2 * nQ_, nQ_);
+    for(const auto& sp: spins_) {
+      if(sp.ia.empty()) continue;
+      Eigen::VectorXd cre(sp.ia.size()), cim(sp.ia.size());
+      for(size_t r = 0; r < sp.ia.size(); r++) {
+        const auto [i, a] = sp.ia[r];
+        const double  d   = sp.eps_w[sp.no + a] - sp.eps_w[i];
+        const Complex c   = sf_ * (1.0 / (w - d) - 1.0 / (w + d));
+        cre(r)            = c.real();
+        cim(r)            = c.imag();
+      }
+      pi_local.topRows(nQ_) += sp.Lov.transpose() * cre.asDiagonal() * sp.Lov;
+      if(w.real() != 0.0)
+        pi_local.bottomRows(nQ_) += sp.Lov.transpose() * cim.asDiagonal() * sp.Lov;
+    }
+    Matrix pi(2 * nQ_, nQ_);
+    ec_.pg().allreduce(pi_local.data(), pi.data(), pi.size(), ReduceOp::sum);
+    return pi.topRows(nQ_).cast<Complex>() + Complex(0, 1) * pi.bottomRows(nQ_).cast<Complex>();
+  }
+
+  // W_nm(i omega_k) for all grid points, every rank screens the frequencies k = rank mod nranks
+  void imaginary_axis() {
+    for(auto& sp: spins_) sp.wim = Matrix::Zero(omega_.size() * sp.qp.size(), sp.nmo());
+
+    for(size_t k = 0; k < omega_.size(); k++) {
+      const Matrix a = Matrix::Identity(nQ_, nQ_) - polarizability(Complex(0, omega_[k])).real();
+      if(static_cast<int>(k % nranks_) != rank_) continue;
+
+      // 1 - Pi(i omega) is positive definite
+      Eigen::LLT<Matrix>                                           llt;
+      Eigen::ConjugateGradient<Matrix, Eigen::Lower | Eigen::Upper> cg;
+      if(minres_) cg.compute(a);
+      else llt.compute(a);
+
+      for(auto& sp: spins_) {
+        const int nqp = sp.qp.size();
+        for(int q = 0; q < nqp; q++) {
+          const Matrix lt = sp.Ln[q].transpose();
+          const Matrix x  = minres_ ? Matrix(cg.solve(lt)) : Matrix(llt.solve(lt));
+          sp.wim.row(k * nqp + q) =
+            (sp.Ln[q].array() * (x - lt).transpose().array()).rowwise().sum().transpose();
+        }
+      }
+    }
+
+    for(auto& sp: spins_) {
+      Matrix wim(sp.wim.rows(), sp.wim.cols());
+      ec_.pg().allreduce(sp.wim.data(), wim.data(), wim.size(), ReduceOp::sum);
+      sp.wim = wim;
+    }
+  }
+
+  // RPA excitations from the L_ia of all ranks, diagonalized on rank 0
+  void rpa() {
+    int nov = 0;
+    for(const auto& sp: spins_) nov += sp.no * sp.nv;
+
+    Matrix          l_local = Matrix::Zero(nov, nQ_);
+    Eigen::VectorXd d(nov);
+    int             off = 0;
+    for(const auto& sp: spins_) {
+      for(size_t r = 0; r < sp.ia.size(); r++) {
+        const auto [i, a]                = sp.ia[r];
+        l_local.row(off + i * sp.nv + a) = sp.Lov.row(r);
+      }
+      for(int i = 0; i < sp.no; i++)
+        for(int a = 0; a < sp.nv; a++) d(off + i * sp.nv + a) = sp.eps_w[sp.no + a] - sp.eps_w[i];
+      off += sp.no * sp.nv;
+    }
+    Matrix l(nov, nQ_);
+    ec_.pg().allreduce(l_local.data(), l.data(), l.size(), ReduceOp::sum);
+    l_local.resize(0, 0);
+
+    omega_rpa_.resize(nov);
+    Matrix rho(nQ_, nov);
+    if(rank_ == 0) {
+      const Eigen::VectorXd sqd = d.cwiseSqrt();
+      const Matrix          ls  = sqd.asDiagonal() * l;
+      Matrix                m   = 2.0 * sf_ * ls * ls.transpose();
+      m.diagonal() += d.cwiseAbs2();
+      Eigen::SelfAdjointEigenSolver<Matrix> eig(m);
+      omega_rpa_ = eig.eigenvalues().cwiseSqrt();
+      rho        = std::sqrt(sf_) * ls.transpose() * eig.eigenvectors() *
+            omega_rpa_.cwiseSqrt().cwiseInverse().asDiagonal();
+    }
+    ec_.pg().broadcast(omega_rpa_.data(), nov, 0);
+    ec_.pg().broadcast(rho.data(), rho.size(), 0);
+
+    for(auto& sp: spins_) {
+      sp.wn.resize(sp.qp.size());
+      for(size_t q = 0; q < sp.qp.size(); q++) sp.wn[q] = sp.Ln[q] * rho;
+    }
+  }
+
+  ExecutionContext&    ec_;
+  std::vector<GWSpin>& spins_;
+  double               sf_;
+  int                  nQ_;
+  bool                 cdgw_, minres_;
+  double               eta_;
+  int                  nranks_, rank_;
+
+  std::vector<double> omega_, weight_; // imaginary frequency grid
+  Eigen::VectorXd     omega_rpa_;      // RPA excitation energies
+};
+
+} // namespace
+
+void cd_gw(ExecutionContext& ec, ChemEnv& chem_env) {
+  namespace fs = std::filesystem;
+  using T      = double;
+
+  auto rank = ec.pg().rank();
+
+  scf::scf_driver(ec, chem_env);
+  SystemData& sys_data = chem_env.sys_data;
+
+  libint2::BasisSet   shells         = chem_env.shells;
+  Tensor<T>           C_AO           = chem_env.C_AO;
+  Tensor<T>           C_beta_AO      = chem_env.C_beta_AO;
+  Tensor<T>           F_AO           = chem_env.F_AO;
+  Tensor<T>           F_beta_AO      = chem_env.F_beta_AO;
+  TiledIndexSpace     AO_opt         = chem_env.AO_opt;
+  std::vector<size_t> shell_tile_map = chem_env.shell_tile_map;
+
+  GWOptions& gw_options = chem_env.ioptions.gw_options;
+  if(rank == 0) gw_options.print();
+
+  if(chem_env.ioptions.ccsd_options.localize)
+    tamm_terminate("INPUT FILE ERROR: GW requires canonical orbitals, disable DLPNO localize");
+  if(gw_options.evgw && gw_options.evgw0)
+    tamm_terminate("INPUT FILE ERROR: GW options evgw and evgw0 are mutually exclusive");
+  if(sys_data.is_ks && sys_data.n_frozen_core > 0)
+    tamm_terminate("INPUT FILE ERROR: GW with a DFT reference does not support frozen core");
+  if(rank == 0 && !gw_options.cdbasis.empty())
+    std::cout << std::endl
+              << "Note: GW uses the cholesky vectors of the CD module, cdbasis is ignored"
+              << std::endl;
+
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
+
+  const bool is_rhf = sys_data.is_restricted;
+
+  std::string files_dir = chem_env.workspace_dir + chem_env.ioptions.scf_options.scf_type;
+  std::string cholfile  = files_dir + "/" + sys_data.output_file_prefix + ".cholcount";
+
+  // deallocates F_AO, C_AO
+  auto [cholVpr, d_f1, lcao, chol_count, max_cvecs, CI] =
+    cholesky_2e::cholesky_2e_driver<T>(chem_env, ec, MO, AO_opt, C_AO, F_AO, C_beta_AO, F_beta_AO,
+                                       shells, shell_tile_map, false, cholfile);
+
+  auto gw_t1 = std::chrono::high_resolution_clock::now();
+
+  std::vector<T> p_evl_sorted = tamm::diagonal(d_f1);
+  const int      nQ           = static_cast<int>(CI.max_num_indices());
+
+  // core hamiltonian in the MO basis for the exchange-correlation potential of a DFT reference
+  Matrix H, C;
+  if(sys_data.is_ks) {
+    TiledIndexSpace AO = lcao.tiled_index_spaces()[0];
+    Tensor<T>       hcore{AO, AO};
+    Tensor<T>::allocate(&ec, hcore);
+    read_from_disk(hcore, files_dir + "/scf/" + sys_data.output_file_prefix + ".hcore");
+    H = tamm_to_eigen_matrix(hcore);
+    C = tamm_to_eigen_matrix(lcao);
+    Tensor<T>::deallocate(hcore);
+  }
+  free_tensors(lcao, d_f1);
+
+  const int noa  = sys_data.n_occ_alpha;
+  const int nob  = sys_data.n_occ_beta;
+  const int nva  = sys_data.n_vir_alpha;
+  const int nvb  = sys_data.n_vir_beta;
+  const int nocc = noa + nob;
+
+  // closed shells are treated with the alpha orbitals and a spin factor of 2
+  std::vector<GWSpin> spins(is_rhf ? 1 : 2);
+  for(size_t s = 0; s < spins.size(); s++) {
+    GWSpin& sp = spins[s];
+    sp.name    = s == 0 ? "alpha" : "beta";
+    sp.no      = s == 0 ? noa : nob;
+    sp.nv      = s == 0 ? nva : nvb;
+    for(int i = 0; i < sp.no; i++) sp.so.push_back((s == 0 ? 0 : noa) + i);
+    for(int a = 0; a < sp.nv; a++) sp.so.push_back(nocc + (s == 0 ? 0 : nva) + a);
+    for(int p: sp.so) sp.eps_mf.push_back(p_evl_sorted[p]);
+    sp.eps_g = sp.eps_mf;
+    sp.eps_w = sp.eps_mf;
+
+    const int noqp = std::min(sp.no, s == 0 ? gw_options.noqpa : gw_options.noqpb);
+    const int nvqp = std::min(sp.nv, s == 0 ? gw_options.nvqpa : gw_options.nvqpb);
+    for(int i = 0; i < noqp; i++) sp.qp.push_back(gw_options.core ? i : sp.no - noqp + i);
+    for(int a = 0; a < nvqp; a++) sp.qp.push_back(sp.no + a);
+  }
+
+  // distributed L_ia, the occupied orbitals are dealt round-robin over the ranks, and the
+  // density sum_i L_ii^Q for the Coulomb potential
+  Eigen::VectorXd dens_local = Eigen::VectorXd::Zero(nQ);
+  for(auto& sp: spins) {
+    std::set<int> rows;
+    for(int i = rank.value(); i < sp.no; i += ec.pg().size().value()) rows.insert(sp.so[i]);
+    const auto lrows = read_chol_rows(cholVpr, rows, sp.so, nQ);
+    sp.Lov.resize(rows.size() * sp.nv, nQ);
+    int r = 0;
+    for(int i = rank.value(); i < sp.no; i += ec.pg().size().value()) {
+      const Matrix& l = lrows.at(sp.so[i]);
+      for(int a = 0; a < sp.nv; a++, r++) {
+        sp.ia.push_back({i, a});
+        sp.Lov.row(r) = l.row(sp.no + a);
+      }
+      dens_local += (is_rhf ? 2.0 : 1.0) * l.row(i).transpose();
+    }
+
+    std::set<int> qrows;
+    for(int n: sp.qp) qrows.insert(sp.so[n]);
+    const auto lqp = read_chol_rows(cholVpr, qrows, sp.so, nQ);
+    for(int n: sp.qp) sp.Ln.push_back(lqp.at(sp.so[n]));
+  }
+  Eigen::VectorXd dens(nQ);
+  ec.pg().allreduce(dens_local.data(), dens.data(), nQ, ReduceOp::sum);
+  cholesky_2e::free_chol_vectors(chem_env, cholVpr);
+
+  // exchange self-energy and exchange-correlation potential of the mean-field reference
+  for(auto& sp: spins) {
+    for(size_t q = 0; q < sp.qp.size(); q++) {
+      const int    n     = sp.qp[q];
+      const double sigx  = -sp.Ln[q].topRows(sp.no).squaredNorm();
+      double       vxc_n = sigx;
+      if(sys_data.is_ks) {
+        const double h_nn = C.col(sp.so[n]).dot(H * C.col(sp.so[n]));
+        const double j_nn = sp.Ln[q].row(n).dot(dens.transpose());
+        vxc_n             = sp.eps_mf[n] - h_nn - j_nn;
+      }
+      sp.sigma_x.push_back(sigx);
+      sp.vxc.push_back(vxc_n);
+    }
+  }
+
+  GWSelfEnergy sigma(ec, gw_options, spins, is_rhf ? 2.0 : 1.0, nQ);
+
+  const bool self_consistent = gw_options.evgw || gw_options.evgw0;
+  const int  ncycles =
+    self_consistent ? (gw_options.maxev > 0 ? gw_options.maxev : gw_options.maxiter) : 1;
+  const double qp_thresh = 1e-6;
+  const double h         = 1e-4;
+
+  std::string gw_name = gw_options.evgw ? "evGW" : (gw_options.evgw0 ? "evGW0" : "G0W0");
+
+  std::vector<std::vector<double>> eqp(spins.size()), sigc(spins.size()), zfac(spins.size());
+  bool                             converged = !self_consistent;
+  int                              cycle     = 0;
+  for(; cycle < ncycles; cycle++) {
+    if(cycle == 0 || gw_options.evgw) sigma.screen();
+
+    double max_change = 0.0;
+    for(size_t s = 0; s < spins.size(); s++) {
+      GWSpin& sp = spins[s];
+      eqp[s].assign(sp.qp.size(), 0.0);
+      sigc[s].assign(sp.qp.size(), 0.0);
+      zfac[s].assign(sp.qp.size(), 0.0);
+
+      for(size_t q = 0; q < sp.qp.size(); q++) {
+        const int    n     = sp.qp[q];
+        const double shift = sp.sigma_x[q] - sp.vxc[q];
+
+        // Newton iterations for w = e_n + Sigma^x_n - V^xc_n + Sigma^c_n(w)
+        double w = sp.eps_g[n], w_lin = 0.0, sc = 0.0, dsc = 0.0;
+        bool   qp_conv = false;
+        for(int iter = 0; iter < gw_options.maxnewton; iter++) {
+          sc             = sigma.sigma_c(s, q, w);
+          dsc            = (sigma.sigma_c(s, q, w + h) - sc) / h;
+          const double f  = w - sp.eps_mf[n] - shift - sc;
+          const double dw = -f / (1.0 - dsc);
+          if(iter == 0) w_lin = w + dw;
+          w += dw;
+          if(std::abs(dw) < qp_thresh) {
+            qp_conv = true;
+            break;
+          }
+        }
+        if(!qp_conv) {
+          if(rank == 0)
+            std::cout << "Warning: quasiparticle equation of " << sp.name << " orbital " << n + 1
+                      << " not converged, using the linearized solution" << std::endl;
+          w  = w_lin;
+          sc = sigma.sigma_c(s, q, w);
+        }
+        eqp[s][q]  = w;
+        sigc[s][q] = sc;
+        zfac[s][q] = 1.0 / (1.0 - dsc);
+        max_change = std::max(max_change, std::abs(w - sp.eps_g[n]));
+      }
+    }
+
+    if(self_consistent && rank == 0)
+      std::cout << gw_name << " cycle " << cycle + 1
+                << ": max change of the QP energies = " << std::scientific << std::setprecision(4)
+                << max_change * au2ev << " eV" << std::defaultfloat << std::endl;
+    if(!self_consistent) break;
+
+    // the orbitals without a quasiparticle energy are shifted by the average correction of the
+    // occupied or virtual quasiparticle states of their spin
+    for(size_t s = 0; s < spins.size(); s++) {
+      GWSpin&             sp = spins[s];
+      std::vector<double> new_eps(sp.eps_g);
+      double              docc = 0, dvir = 0;
+      int                 nocc_qp = 0, nvir_qp = 0;
+      for(size_t q = 0; q < sp.qp.size(); q++) {
+        const int n = sp.qp[q];
+        if(n < sp.no) {
+          docc += eqp[s][q] - sp.eps_mf[n];
+          nocc_qp++;
+        }
+        else {
+          dvir += eqp[s][q] - sp.eps_mf[n];
+          nvir_qp++;
+        }
+      }
+      if(nocc_qp > 0) docc /= nocc_qp;
+      if(nvir_qp > 0) dvir /= nvir_qp;
+      for(int p = 0; p < sp.nmo(); p++) new_eps[p] = sp.eps_mf[p] + (p < sp.no ? docc : dvir);
+      for(size_t q = 0; q < sp.qp.size(); q++) new_eps[sp.qp[q]] = eqp[s][q];
+      sp.eps_g = new_eps;
+      if(gw_options.evgw) sp.eps_w = new_eps;
+    }
+
+    if(max_change < qp_thresh) {
+      converged = true;
+      cycle++;
+      break;
+    }
+  }
+
+  auto   gw_t2 = std::chrono::high_resolution_clock::now();
+  double gw_time =
+    std::chrono::duration_cast<std::chrono::duration<double>>((gw_t2 - gw_t1)).count();
+
+  if(rank == 0) {
+    if(self_consistent && !converged)
+      std::cout << "Warning: " << gw_name << " not converged in " << ncycles << " cycles"
+                << std::endl;
+
+    auto& jgw     = sys_data.results["output"]["GW"];
+    jgw["method"] = gw_name;
+    if(self_consistent) jgw["n_cycles"] = cycle;
+
+    const int nfc = sys_data.n_frozen_core;
+    for(size_t s = 0; s < spins.size(); s++) {
+      const GWSpin& sp = spins[s];
+      std::cout << std::endl
+                << gw_name << " quasiparticle energies (" << sp.name << ", eV)" << std::endl;
+      std::cout << std::string(86, '-') << std::endl;
+      std::cout << "  orbital  occ   e_mf        Sigma_x     V_xc        Sigma_c     Z      e_qp"
+                << std::endl;
+      std::cout << std::string(86, '-') << std::endl;
+      for(size_t q = 0; q < sp.qp.size(); q++) {
+        const int n = sp.qp[q];
+        std::cout << std::setw(8) << n + nfc + 1 << std::setw(5) << (n < sp.no ? "o" : "v")
+                  << std::fixed << std::setprecision(4) << std::setw(12)
+                  << sp.eps_mf[n] * au2ev << std::setw(12) << sp.sigma_x[q] * au2ev
+                  << std::setw(12) << sp.vxc[q] * au2ev << std::setw(12) << sigc[s][q] * au2ev
+                  << std::setprecision(3) << std::setw(7) << zfac[s][q] << std::setprecision(4)
+                  << std::setw(12) << eqp[s][q] * au2ev << std::endl;
+
+        auto& jqp       = jgw[sp.name][std::to_string(n + nfc + 1)];
+        jqp["occupied"] = n < sp.no;
+        jqp["e_mf"]     = sp.eps_mf[n] * au2ev;
+        jqp["sigma_x"]  = sp.sigma_x[q] * au2ev;
+        jqp["vxc"]      = sp.vxc[q] * au2ev;
+        jqp["sigma_c"]  = sigc[s][q] * au2ev;
+        jqp["z"]        = zfac[s][q];
+        jqp["e_qp"]     = eqp[s][q] * au2ev;
+      }
+      std::cout << std::string(86, '-') << std::endl;
+    }
+
+    std::cout << std::endl
+              << "Time taken for " << gw_name << ": " << std::fixed << std::setprecision(2)
+              << gw_time << " secs" << std::endl;
+
+    jgw["performance"]["total_time"] = gw_time;
+    chem_env.telemetry.record("GW", "total", {{"wall_time", gw_time}});
+    chem_env.write_json_data("GW");
+  }
+
+  ec.flush_and_sync();
+}
+
+} // namespace exachem::gw
@@ -0,0 +1,19 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "cholesky/cholesky_2e.hpp"
+#include "cholesky/cholesky_2e_driver.hpp"
+#include "tamm/eigen_utils.hpp"
+
+namespace exachem::gw {
+// G0W0, evGW and evGW0 quasiparticle energies (task gw) from the cholesky vectors of the
+// two-electron integrals
+void cd_gw(ExecutionContext& ec, ChemEnv& chem_env);
+} // namespace exachem::gw
@@ -0,0 +1,11 @@
+
+include(TargetMacros)
+
+set(GW_SRCDIR ${CMAKE_CURRENT_SOURCE_DIR}/../exachem/gw)
+
+set(GW_INCLUDES
+    ${GW_SRCDIR}/cd_gw.hpp
+)
+set(GW_SRCS
+    ${GW_SRCDIR}/cd_gw.cpp
+)
@@ -33,11 +33,14 @@ void cd_mp2(ExecutionContext& ec, ChemEnv& chem_env) {
   CCSDOptions& ccsd_options = chem_env.ioptions.ccsd_options;
   if(rank == 0) ccsd_options.print();
 
+  if(ccsd_options.localize)
+    tamm_terminate("INPUT FILE ERROR: MP2 requires canonical orbitals, disable DLPNO localize");
+
   if(rank == 0)
     std::cout << std::endl
               << "#occupied, #virtual = " << sys_data.nocc << ", " << sys_data.nvir << std::endl;
 
-  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(chem_env);
+  auto [MO, total_orbitals] = cholesky_2e::setupMOIS(ec, chem_env);
 
   const bool is_rhf = sys_data.is_restricted;
 
@@ -61,7 +64,7 @@ void cd_mp2(ExecutionContext& ec, ChemEnv& chem_env) {
 
   if(mp2_restart) {
     read_from_disk(d_f1, f1file);
-    read_from_disk(cholVpr, v2file);
+    cholesky_2e::read_chol_vectors(chem_env, cholVpr, v2file);
     ec.pg().barrier();
   }
 
@@ -69,7 +72,7 @@ void cd_mp2(ExecutionContext& ec, ChemEnv& chem_env) {
     if(!fs::exists(files_dir)) fs::create_directories(files_dir);
 
     write_to_disk(d_f1, f1file);
-    write_to_disk(cholVpr, v2file);
+    cholesky_2e::write_chol_vectors(chem_env, cholVpr, v2file);
 
     if(rank == 0) {
       std::ofstream out(cholfile, std::ios::out);
@@ -154,9 +157,8 @@ void cd_mp2(ExecutionContext& ec, ChemEnv& chem_env) {
 
   block_for(ec, dtmp(), dtmp_lambda);
 
-  sch(v2ijab(h1, h2, p1, p2) = cholVpr(h1, p1, cind) * cholVpr(h2, p2, cind))
-    .deallocate(cholVpr)
-    .execute(ec.exhw());
+  sch(v2ijab(h1, h2, p1, p2) = cholVpr(h1, p1, cind) * cholVpr(h2, p2, cind)).execute(ec.exhw());
+  cholesky_2e::free_chol_vectors(chem_env, cholVpr);
 
   T mp2_energy{0};
   T mp2_alpha_energy{0};
@@ -14,6 +14,8 @@ set(SCF_INCLUDES
     ${SCF_SRCDIR}/scf_restart.hpp
     ${SCF_SRCDIR}/scf_outputs.hpp
     ${SCF_SRCDIR}/scf_hartree_fock.hpp
+    ${SCF_SRCDIR}/scf_gradient.hpp
+    ${SCF_SRCDIR}/scf_cfmm.hpp
     )
 
 set(SCF_SRCS
@@ -28,5 +30,7 @@ set(SCF_SRCS
     ${SCF_SRCDIR}/scf_restart.cpp         
     ${SCF_SRCDIR}/scf_outputs.cpp
     ${SCF_SRCDIR}/scf_hartree_fock.cpp    
+    ${SCF_SRCDIR}/scf_gradient.cpp
+    ${SCF_SRCDIR}/scf_cfmm.cpp
     )
 
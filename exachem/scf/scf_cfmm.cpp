@@ -0,0 +1,452 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "scf/scf_cfmm.hpp"
+#include <numeric>
+
+namespace {
+
+// smallest leaf edge (bohr) of the octree
+constexpr double cfmm_leaf_edge = 4.0;
+constexpr int    cfmm_max_depth = 10;
+
+inline double distance(const std::array<double, 3>& a, const std::array<double, 3>& b) {
+  return std::sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) +
+                   (a[2] - b[2]) * (a[2] - b[2]));
+}
+
+// Cartesian components of angular momentum l in libint2 order
+std::vector<std::array<int, 3>> cartesian_components(int l) {
+  std::vector<std::array<int, 3>> comps;
+  for(int i = l; i >= 0; i--)
+    for(int j = l - i; j >= 0; j--) comps.push_back({i, j, l - i - j});
+  return comps;
+}
+
+} // namespace
+
+exachem::scf::CFMM::CFMM(const libint2::BasisSet& obs, const SCFVars& scf_vars, int order,
+                         double precision):
+  obs_(obs), order_(order), precision_(precision) {
+  const int n1 = order_ + 1;
+
+  std::vector<double> fact(n1, 1.0);
+  for(int i = 1; i < n1; i++) fact[i] = fact[i - 1] * i;
+
+  // multipoles sorted by total order, the derivative recursion relies on it
+  mom_index_.assign(n1 * n1 * n1, -1);
+  for(int l = 0; l <= order_; l++) {
+    for(const auto& abc: cartesian_components(l)) {
+      mom_index_[(abc[0] * n1 + abc[1]) * n1 + abc[2]] = mom_.size();
+      mom_.push_back(abc);
+      mom_sign_.push_back(l % 2 == 0 ? 1.0 : -1.0);
+      mom_scale_.push_back(1.0 / (fact[abc[0]] * fact[abc[1]] * fact[abc[2]]));
+    }
+  }
+  const int nmom = mom_.size();
+  for(int i = 0; i < nmom; i++) {
+    for(int j = 0; j < nmom; j++) {
+      const int a = mom_[i][0] + mom_[j][0];
+      const int b = mom_[i][1] + mom_[j][1];
+      const int c = mom_[i][2] + mom_[j][2];
+      if(a + b + c > order_) continue;
+      mom_pairs_.push_back({i, j, index(a, b, c)});
+    }
+  }
+
+  // center, multipole radius and extent of the significant shell pairs
+  const size_t nsh = obs_.size();
+  pair_leaf_.resize(nsh);
+  for(size_t s1 = 0; s1 < nsh; s1++) {
+    const auto& s2list = scf_vars.obs_shellpair_list.at(s1);
+    pair_leaf_[s1].assign(s2list.size(), -1);
+    for(size_t k = 0; k < s2list.size(); k++) {
+      const auto& sh1  = obs_[s1];
+      const auto& sh2  = obs_[s2list[k]];
+      const double a1   = *std::min_element(sh1.alpha.begin(), sh1.alpha.end());
+      const double a2   = *std::min_element(sh2.alpha.begin(), sh2.alpha.end());
+      const double zeta = a1 + a2;
+      const int    L    = sh1.contr[0].l + sh2.contr[0].l;
+
+      PairInfo pair{s1, s2list[k], k, {}, 0.0, 0.0};
+      double   dA2 = 0.0, dB2 = 0.0;
+      for(int x = 0; x < 3; x++) {
+        pair.P[x] = (a1 * sh1.O[x] + a2 * sh2.O[x]) / zeta;
+        dA2 += (pair.P[x] - sh1.O[x]) * (pair.P[x] - sh1.O[x]);
+        dB2 += (pair.P[x] - sh2.O[x]) * (pair.P[x] - sh2.O[x]);
+      }
+      // the products of tighter primitives are centered between the two shells
+      const double d = std::sqrt(std::max(dA2, dB2));
+      pair.rho       = std::sqrt((L + 1.5) / zeta) + d;
+      pair.rext      = std::sqrt((L - std::log(precision_)) / zeta) + d;
+      pairs_.push_back(pair);
+    }
+  }
+  if(pairs_.empty()) return;
+
+  // bounding cube of the pair centers, refined down to leaves of at least cfmm_leaf_edge
+  std::array<double, 3> lo = pairs_[0].P, hi = pairs_[0].P;
+  for(const auto& pair: pairs_) {
+    for(int x = 0; x < 3; x++) {
+      lo[x] = std::min(lo[x], pair.P[x]);
+      hi[x] = std::max(hi[x], pair.P[x]);
+    }
+  }
+  double                edge = cfmm_leaf_edge;
+  std::array<double, 3> center;
+  for(int x = 0; x < 3; x++) {
+    edge      = std::max(edge, hi[x] - lo[x]);
+    center[x] = 0.5 * (lo[x] + hi[x]);
+  }
+  int depth = 0;
+  while(depth < cfmm_max_depth && edge / (1 << (depth + 1)) >= cfmm_leaf_edge) depth++;
+  hd_leaf_ = 0.5 * std::sqrt(3.0) * edge / (1 << depth);
+
+  std::vector<size_t> ipairs(pairs_.size());
+  std::iota(ipairs.begin(), ipairs.end(), 0);
+  build(center, 0.5 * edge, 0, depth, ipairs);
+}
+
+int exachem::scf::CFMM::build(const std::array<double, 3>& center, double half_edge, int level,
+                              int depth, std::vector<size_t>& ipairs) {
+  const int inode = nodes_.size();
+  nodes_.emplace_back();
+  nodes_[inode].center = center;
+  nodes_[inode].hd     = std::sqrt(3.0) * half_edge;
+  for(const auto ip: ipairs) {
+    const double dP   = distance(pairs_[ip].P, center);
+    nodes_[inode].rad = std::max(nodes_[inode].rad, dP + pairs_[ip].rho);
+    nodes_[inode].ext = std::max(nodes_[inode].ext, dP + pairs_[ip].rext);
+  }
+
+  if(level == depth) {
+    nodes_[inode].leaf     = leaves_.size();
+    nodes_[inode].leaf_rad = nodes_[inode].rad;
+    nodes_[inode].leaf_ext = nodes_[inode].ext;
+    leaf_pairs_.emplace_back();
+    for(const auto ip: ipairs) {
+      pair_leaf_[pairs_[ip].s1][pairs_[ip].k] = leaves_.size();
+      leaf_pairs_.back().push_back({pairs_[ip].s1, pairs_[ip].k});
+    }
+    leaves_.push_back(inode);
+    nodes_[inode].pairs = std::move(ipairs);
+    return inode;
+  }
+
+  std::array<std::vector<size_t>, 8> octants;
+  for(const auto ip: ipairs) {
+    const auto& P = pairs_[ip].P;
+    octants[(P[0] >= center[0]) + 2 * (P[1] >= center[1]) + 4 * (P[2] >= center[2])].push_back(ip);
+  }
+  ipairs.clear();
+  ipairs.shrink_to_fit();
+
+  for(int o = 0; o < 8; o++) {
+    if(octants[o].empty()) continue;
+    std::array<double, 3> child_center;
+    for(int x = 0; x < 3; x++)
+      child_center[x] = center[x] + ((o >> x) & 1 ? 0.5 : -0.5) * half_edge;
+    const int ichild = build(child_center, 0.5 * half_edge, level + 1, depth, octants[o]);
+    nodes_[inode].children.push_back(ichild);
+    nodes_[inode].leaf_rad = std::max(nodes_[inode].leaf_rad, nodes_[ichild].leaf_rad);
+    nodes_[inode].leaf_ext = std::max(nodes_[inode].leaf_ext, nodes_[ichild].leaf_ext);
+  }
+  return inode;
+}
+
+void exachem::scf::CFMM::compute_moments(ExecutionContext& ec, const Eigen::Ref<const Matrix>& D,
+                                         const Matrix& D_shblk_norm) {
+  const size_t nmom   = mom_.size();
+  const size_t rank   = ec.pg().rank().value();
+  const size_t nranks = ec.pg().size().value();
+  const auto   shell2bf = obs_.shell2bf();
+
+  for(auto& node: nodes_) {
+    node.q      = 0.0;
+    node.leaf_q = 0.0;
+    node.moments.assign(nmom, 0.0);
+  }
+  locals_.assign(leaves_.size(), {});
+  has_local_.assign(leaves_.size(), 0);
+  if(nodes_.empty()) return;
+
+  // each rank sums the moments of a strided subset of the shell pairs about their leaf centers
+  std::vector<double> M;
+  for(size_t ip = 0; ip < pairs_.size(); ip++) {
+    const auto&  pair = pairs_[ip];
+    Node&        leaf = nodes_[leaves_[pair_leaf_[pair.s1][pair.k]]];
+    const double deg  = (pair.s1 == pair.s2) ? 1.0 : 2.0;
+    leaf.q += deg * D_shblk_norm(pair.s1, pair.s2);
+    if(ip % nranks != rank) continue;
+
+    pair_moments(pair.s1, pair.s2, leaf.center, M);
+    const size_t n1  = obs_[pair.s1].size();
+    const size_t n2  = obs_[pair.s2].size();
+    const auto   Dsp = D.block(shell2bf[pair.s1], shell2bf[pair.s2], n1, n2);
+    for(size_t m = 0; m < nmom; m++) {
+      double dm = 0.0;
+      for(size_t f1 = 0; f1 < n1; f1++)
+        for(size_t f2 = 0; f2 < n2; f2++) dm += Dsp(f1, f2) * M[(m * n1 + f1) * n2 + f2];
+      leaf.moments[m] += deg * dm;
+    }
+  }
+
+  std::vector<double> lmoments(leaves_.size() * nmom), lsum(leaves_.size() * nmom);
+  for(size_t l = 0; l < leaves_.size(); l++)
+    std::copy_n(nodes_[leaves_[l]].moments.begin(), nmom, lmoments.begin() + l * nmom);
+  ec.pg().allreduce(lmoments.data(), lsum.data(), lsum.size(), ReduceOp::sum);
+  for(size_t l = 0; l < leaves_.size(); l++)
+    std::copy_n(lsum.begin() + l * nmom, nmom, nodes_[leaves_[l]].moments.begin());
+
+  upward(0);
+
+  // the well-separated test depends on the density weights of the leaves
+  near_.assign(leaves_.size(), {});
+  for(size_t a = 0; a < leaves_.size(); a++)
+    for(size_t b = 0; b < leaves_.size(); b++)
+      if(!well_separated(a, b)) near_[a].push_back(b);
+}
+
+size_t exachem::scf::CFMM::nnear() const {
+  size_t n = 0;
+  for(const auto& near: near_) n += near.size();
+  return n;
+}
+
+void exachem::scf::CFMM::upward(int inode) {
+  if(nodes_[inode].leaf >= 0) {
+    nodes_[inode].leaf_q = nodes_[inode].q;
+    return;
+  }
+
+  // M(C) = sum_g (c - C)^(b-g)/(b-g)! M_g(c), moments scaled by 1/b!
+  std::vector<double> dpow(mom_.size());
+  for(const int ichild: nodes_[inode].children) {
+    upward(ichild);
+    Node&       node  = nodes_[inode];
+    const Node& child = nodes_[ichild];
+    node.q += child.q;
+    node.leaf_q = std::max(node.leaf_q, child.leaf_q);
+
+    for(size_t m = 0; m < mom_.size(); m++) {
+      dpow[m] = mom_scale_[m];
+      for(int x = 0; x < 3; x++) dpow[m] *= std::pow(child.center[x] - node.center[x], mom_[m][x]);
+    }
+    for(const auto& [i, j, k]: mom_pairs_) node.moments[k] += dpow[j] * child.moments[i];
+  }
+}
+
+// every leaf of B is well separated from the leaf A: the leaf centers of B are within
+// B.hd - hd_leaf of the center of B and the criterion only gets weaker with distance
+bool exachem::scf::CFMM::all_separated(const Node& A, const Node& B) const {
+  const double R = distance(A.center, B.center) - (B.hd - hd_leaf_);
+  if(R <= A.ext + B.leaf_ext) return false;
+  const double sigma = A.rad + B.leaf_rad;
+  return std::max(A.q, B.leaf_q) * std::pow(sigma / R, order_ + 1) < precision_ * R;
+}
+
+// the expansion of all of B about its center converges at the leaf A
+bool exachem::scf::CFMM::box_accurate(const Node& A, const Node& B) const {
+  const double R     = distance(A.center, B.center);
+  const double sigma = A.rad + B.rad;
+  if(R <= sigma) return false;
+  return std::max(A.q, B.q) * std::pow(sigma / R, order_ + 1) < precision_ * R;
+}
+
+bool exachem::scf::CFMM::well_separated(int leaf_a, int leaf_b) const {
+  if(leaf_a == leaf_b) return false;
+  return all_separated(nodes_[leaves_[leaf_a]], nodes_[leaves_[leaf_b]]);
+}
+
+bool exachem::scf::CFMM::collect(const Node& A, int inode, std::vector<double>& L,
+                                 std::vector<double>& T) const {
+  const Node& B = nodes_[inode];
+  if(B.q == 0.0) return false;
+
+  if(all_separated(A, B) && box_accurate(A, B)) {
+    std::array<double, 3> R;
+    for(int x = 0; x < 3; x++) R[x] = B.center[x] - A.center[x];
+    coulomb_derivatives(R, T);
+    for(const auto& [i, j, k]: mom_pairs_) L[i] += B.moments[j] * T[k];
+    return true;
+  }
+
+  bool found = false;
+  for(const int ichild: B.children) found = collect(A, ichild, L, T) || found;
+  return found;
+}
+
+void exachem::scf::CFMM::local_expansion(int leaf_a) {
+  std::vector<double> L(mom_.size(), 0.0), T(mom_.size());
+  if(collect(nodes_[leaves_[leaf_a]], 0, L, T)) locals_[leaf_a] = std::move(L);
+  has_local_[leaf_a] = 1;
+}
+
+void exachem::scf::CFMM::add_far_field(size_t s1, size_t s2, int leaf_a, Matrix& J12) {
+  if(!has_local_[leaf_a]) local_expansion(leaf_a);
+  const auto& L = locals_[leaf_a];
+  if(L.empty()) return;
+
+  // (12|far) = sum_a (-1)^|a|/a! M_a(12) L_a, moments about the leaf center
+  std::vector<double> M;
+  pair_moments(s1, s2, nodes_[leaves_[leaf_a]].center, M);
+  const size_t n1  = obs_[s1].size();
+  const size_t n2  = obs_[s2].size();
+  const double deg = (s1 == s2) ? 1.0 : 2.0;
+  for(size_t m = 0; m < mom_.size(); m++) {
+    const double lm = deg * mom_sign_[m] * L[m];
+    for(size_t f1 = 0; f1 < n1; f1++)
+      for(size_t f2 = 0; f2 < n2; f2++) J12(f1, f2) += lm * M[(m * n1 + f1) * n2 + f2];
+  }
+}
+
+// T_g = d^g/dR^g 1/|R| for |g| <= order from the McMurchie-Davidson recursion
+// R^n_{t+1,u,v} = t R^{n+1}_{t-1,u,v} + X R^{n+1}_{t,u,v}, R^n_{000} = (-1)^n (2n-1)!!/|R|^(2n+1)
+void exachem::scf::CFMM::coulomb_derivatives(const std::array<double, 3>& R,
+                                             std::vector<double>& T) const {
+  const int nmom = mom_.size();
+  const int p    = order_;
+
+  std::vector<double> Rn((p + 1) * nmom);
+  const double        iR2 = 1.0 / (R[0] * R[0] + R[1] * R[1] + R[2] * R[2]);
+  double              g   = std::sqrt(iR2);
+  for(int n = 0; n <= p; n++) {
+    Rn[n * nmom] = g;
+    g *= -(2 * n + 1) * iR2;
+  }
+
+  for(int n = p - 1; n >= 0; n--) {
+    const double* Rn1 = &Rn[(n + 1) * nmom];
+    for(int m = 1; m < nmom; m++) {
+      const auto [t, u, v] = mom_[m];
+      if(t + u + v > p - n) break;
+      double val;
+      if(t > 0) {
+        val = R[0] * Rn1[index(t - 1, u, v)];
+        if(t > 1) val += (t - 1) * Rn1[index(t - 2, u, v)];
+      }
+      else if(u > 0) {
+        val = R[1] * Rn1[index(t, u - 1, v)];
+        if(u > 1) val += (u - 1) * Rn1[index(t, u - 2, v)];
+      }
+      else {
+        val = R[2] * Rn1[index(t, u, v - 1)];
+        if(v > 1) val += (v - 1) * Rn1[index(t, u, v - 2)];
+      }
+      Rn[n * nmom + m] = val;
+    }
+  }
+  T.assign(Rn.begin(), Rn.begin() + nmom);
+}
+
+// Scaled multipole integrals 1/a! <f1|(r-Q)^a|f2> of a shell pair, stored as M[(a*n1+f1)*n2+f2].
+// The 1D integrals of every primitive pair are expanded about its product center P:
+//   int (u+PA)^i (u+PB)^j (u+PQ)^k exp(-zeta u^2) du,  u = x - P_x
+void exachem::scf::CFMM::pair_moments(size_t s1, size_t s2, const std::array<double, 3>& Q,
+                                      std::vector<double>& M) const {
+  const auto&  sh1  = obs_[s1];
+  const auto&  sh2  = obs_[s2];
+  const int    l1   = sh1.contr[0].l;
+  const int    l2   = sh2.contr[0].l;
+  const int    p    = order_;
+  const size_t nmom = mom_.size();
+
+  const auto   c1  = cartesian_components(l1);
+  const auto   c2  = cartesian_components(l2);
+  const size_t nc1 = c1.size();
+  const size_t nc2 = c2.size();
+
+  const int           nb = std::max(p, std::max(l1, l2)) + 1;
+  std::vector<double> binom(nb * nb, 0.0);
+  for(int n = 0; n < nb; n++) {
+    binom[n * nb] = 1.0;
+    for(int k = 1; k <= n; k++)
+      binom[n * nb + k] = binom[(n - 1) * nb + k - 1] + binom[(n - 1) * nb + k];
+  }
+
+  const int           nh = l1 + l2 + 1;
+  const int           ng = nh + p;
+  const size_t        n1d = (l1 + 1) * (l2 + 1) * (p + 1);
+  std::vector<double> G(ng), W(nh * (p + 1)), H(nh), I(3 * n1d);
+  std::vector<double> PApow(l1 + 1), PBpow(l2 + 1), PQpow(p + 1);
+  std::vector<double> Mc(nmom * nc1 * nc2, 0.0);
+
+  for(size_t i1 = 0; i1 < sh1.alpha.size(); i1++) {
+    for(size_t i2 = 0; i2 < sh2.alpha.size(); i2++) {
+      const double a    = sh1.alpha[i1];
+      const double b    = sh2.alpha[i2];
+      const double zeta = a + b;
+
+      std::array<double, 3> P;
+      double                AB2 = 0.0;
+      for(int x = 0; x < 3; x++) {
+        P[x] = (a * sh1.O[x] + b * sh2.O[x]) / zeta;
+        AB2 += (sh1.O[x] - sh2.O[x]) * (sh1.O[x] - sh2.O[x]);
+      }
+      const double K =
+        sh1.contr[0].coeff[i1] * sh2.contr[0].coeff[i2] * std::exp(-a * b / zeta * AB2);
+
+      // int u^n exp(-zeta u^2) du
+      G[0] = std::sqrt(M_PI / zeta);
+      for(int n = 1; n < ng; n++) G[n] = (n % 2) ? 0.0 : G[n - 2] * (n - 1) / (2.0 * zeta);
+
+      for(int x = 0; x < 3; x++) {
+        PApow[0] = PBpow[0] = PQpow[0] = 1.0;
+        for(int i = 1; i <= l1; i++) PApow[i] = PApow[i - 1] * (P[x] - sh1.O[x]);
+        for(int j = 1; j <= l2; j++) PBpow[j] = PBpow[j - 1] * (P[x] - sh2.O[x]);
+        for(int k = 1; k <= p; k++) PQpow[k] = PQpow[k - 1] * (P[x] - Q[x]);
+
+        // W(n,k) = int u^n (u+PQ)^k exp(-zeta u^2) du
+        for(int n = 0; n < nh; n++)
+          for(int k = 0; k <= p; k++) {
+            double w = 0.0;
+            for(int m = 0; m <= k; m++) w += binom[k * nb + m] * PQpow[k - m] * G[n + m];
+            W[n * (p + 1) + k] = w;
+          }
+
+        double* Ix = &I[x * n1d];
+        for(int i = 0; i <= l1; i++)
+          for(int j = 0; j <= l2; j++) {
+            // H(n): coefficients of u^n in (u+PA)^i (u+PB)^j
+            std::fill_n(H.begin(), i + j + 1, 0.0);
+            for(int r = 0; r <= i; r++)
+              for(int s = 0; s <= j; s++)
+                H[r + s] += binom[i * nb + r] * PApow[i - r] * binom[j * nb + s] * PBpow[j - s];
+            for(int k = 0; k <= p; k++) {
+              double v = 0.0;
+              for(int n = 0; n <= i + j; n++) v += H[n] * W[n * (p + 1) + k];
+              Ix[(i * (l2 + 1) + j) * (p + 1) + k] = v;
+            }
+          }
+      }
+
+      auto I1d = [&](int x, int i, int j, int k) {
+        return I[x * n1d + (i * (l2 + 1) + j) * (p + 1) + k];
+      };
+      for(size_t m = 0; m < nmom; m++) {
+        const auto& mk = mom_[m];
+        for(size_t ic1 = 0; ic1 < nc1; ic1++)
+          for(size_t ic2 = 0; ic2 < nc2; ic2++)
+            Mc[(m * nc1 + ic1) * nc2 + ic2] += K * I1d(0, c1[ic1][0], c2[ic2][0], mk[0]) *
+                                               I1d(1, c1[ic1][1], c2[ic2][1], mk[1]) *
+                                               I1d(2, c1[ic1][2], c2[ic2][2], mk[2]);
+      }
+    }
+  }
+
+  // the basis is either all spherical or all Cartesian
+  const size_t n1 = sh1.size();
+  const size_t n2 = sh2.size();
+  M.resize(nmom * n1 * n2);
+  for(size_t m = 0; m < nmom; m++) {
+    double* src = &Mc[m * nc1 * nc2];
+    for(size_t f = 0; f < nc1 * nc2; f++) src[f] *= mom_scale_[m];
+    if(sh1.contr[0].pure) libint2::solidharmonics::tform(l1, l2, src, &M[m * n1 * n2]);
+    else std::copy_n(src, nc1 * nc2, &M[m * n1 * n2]);
+  }
+}
@@ -0,0 +1,120 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "scf/scf_vars.hpp"
+#include "tamm/eigen_utils.hpp"
+
+namespace exachem::scf {
+
+// Multipole-accelerated Coulomb part of the 4-center Fock build (SCF option cfmm).
+// The significant shell pairs are sorted once into the leaves of an octree by the center of
+// their most diffuse primitive product. Two leaves are well separated when their charge
+// distributions do not overlap and the estimated truncation error of a Cartesian multipole
+// expansion of order cfmm_order stays below the Fock precision; J between well-separated leaves
+// is then taken from multipole moments instead of 4-center integrals, and only the ket pairs of
+// the near leaves of a bra pair are visited. In every Fock build the moments of the
+// density-weighted ket pairs are summed per leaf over all ranks and translated up the tree, and
+// every bra shell pair contracts its moments with a local expansion about its leaf center that
+// collects the coarsest boxes whose leaves are all well separated from it.
+class CFMM {
+public:
+  CFMM(const libint2::BasisSet& obs, const SCFVars& scf_vars, int order, double precision);
+
+  // ket moments of the Coulomb density D (alpha + beta for UHF) and the near leaves of every
+  // leaf, collective over ec. D_shblk_norm are the shell block norms used for screening the
+  // Fock build.
+  void compute_moments(ExecutionContext& ec, const Eigen::Ref<const Matrix>& D,
+                       const Matrix& D_shblk_norm);
+
+  // leaf of the k-th shell pair in obs_shellpair_list.at(s1)
+  int leaf(size_t s1, size_t k) const { return pair_leaf_[s1][k]; }
+
+  // symmetric in its arguments, so the bra and ket tasks agree on which quartets are far
+  bool well_separated(int leaf_a, int leaf_b) const;
+
+  // leaves that are not well separated from leaf_a, including itself
+  const std::vector<int>& near_leaves(int leaf_a) const { return near_[leaf_a]; }
+
+  // shell pairs (s1, k) of a leaf, sorted by s1
+  const std::vector<std::pair<size_t, size_t>>& leaf_pairs(int leaf) const {
+    return leaf_pairs_[leaf];
+  }
+
+  // number of near leaf pairs (a, b), for the debug output
+  size_t nnear() const;
+
+  // adds the far-field Coulomb contribution of all shell pairs well separated from the bra pair
+  // (s1,s2) to J12, with the permutational degeneracy factors used by compute_2bf
+  void add_far_field(size_t s1, size_t s2, int leaf_a, Matrix& J12);
+
+  size_t nleaves() const { return leaves_.size(); }
+
+private:
+  struct Node {
+    std::array<double, 3> center{};
+    double                hd{0};       // half diagonal of the box
+    double                rad{0};      // multipole radius of the box pairs about the center
+    double                ext{0};      // extent of the box pairs about the center
+    double                q{0};        // density weight of the box, summed over its pairs
+    double                leaf_rad{0}; // largest rad, ext and q of a leaf in the box
+    double                leaf_ext{0};
+    double                leaf_q{0};
+    int                   leaf{-1};
+    std::vector<int>      children;
+    std::vector<size_t>   pairs; // leaves only
+    std::vector<double>   moments;
+  };
+
+  struct PairInfo {
+    size_t                s1, s2, k;
+    std::array<double, 3> P;
+    double                rho, rext;
+  };
+
+  const libint2::BasisSet& obs_;
+  int                      order_;
+  double                   precision_;
+
+  // Cartesian multipole indices (a,b,c), a+b+c <= order
+  std::vector<std::array<int, 3>> mom_;
+  std::vector<int>                mom_index_;
+  std::vector<double>             mom_sign_;  // (-1)^(a+b+c)
+  std::vector<double>             mom_scale_; // 1/(a! b! c!)
+  // (i,j,k) with mom_[k] = mom_[i] + mom_[j]
+  std::vector<std::array<int, 3>> mom_pairs_;
+
+  std::vector<PairInfo>         pairs_;
+  std::vector<std::vector<int>> pair_leaf_;
+  std::vector<Node>             nodes_;
+  std::vector<int>              leaves_;
+  double                        hd_leaf_{0};
+
+  std::vector<std::vector<std::pair<size_t, size_t>>> leaf_pairs_;
+  std::vector<std::vector<int>>                        near_;
+
+  std::vector<std::vector<double>> locals_; // computed on demand, empty if nothing is far
+  std::vector<char>                has_local_;
+
+  int  build(const std::array<double, 3>& center, double half_edge, int level, int depth,
+             std::vector<size_t>& ipairs);
+  void upward(int inode);
+  bool all_separated(const Node& A, const Node& B) const;
+  bool box_accurate(const Node& A, const Node& B) const;
+  void local_expansion(int leaf_a);
+  bool collect(const Node& A, int inode, std::vector<double>& L, std::vector<double>& T) const;
+  void coulomb_derivatives(const std::array<double, 3>& R, std::vector<double>& T) const;
+  void pair_moments(size_t s1, size_t s2, const std::array<double, 3>& Q,
+                    std::vector<double>& M) const;
+  int  index(int a, int b, int c) const {
+    return mom_index_[(a * (order_ + 1) + b) * (order_ + 1) + c];
+  }
+};
+
+} // namespace exachem::scf
@@ -420,8 +420,8 @@ void exachem::scf::SCFCompute::compute_density(ExecutionContext& ec, ChemEnv& ch
   // compute D in eigen for subsequent fock build
   if(!scf_vars.do_dens_fit || scf_vars.direct_df || chem_env.sys_data.is_ks ||
      chem_env.sys_data.do_snK) {
-    tamm_to_eigen_tensor(ttensors.D_alpha, D_alpha);
-    if(is_uhf) tamm_to_eigen_tensor(ttensors.D_beta, etensors.D_beta);
+    tamm_to_eigen_density(ttensors.D_alpha, D_alpha, etensors.D_alpha_shm);
+    if(is_uhf) tamm_to_eigen_density(ttensors.D_beta, etensors.D_beta, etensors.D_beta_shm);
   }
 
   ec.pg().barrier();
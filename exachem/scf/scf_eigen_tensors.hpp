@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "scf/scf_shared_matrix.hpp"
 #include "tamm/eigen_utils.hpp"
 namespace exachem::scf {
 class EigenTensors {
@@ -17,6 +18,10 @@ public:
   Matrix G_alpha, D_alpha;       // allocated on all ranks for 4c HF, only on rank 0 otherwise.
   Matrix G_beta, D_beta; // allocated on all ranks for 4c HF, only D_beta on rank 0 otherwise.
   Matrix D_alpha_cart, D_beta_cart;
+  // node-shared replacement for the all-rank D_alpha/D_beta and G_alpha/G_beta with 4c HF and
+  // scf.node_shared
+  NodeSharedMatrix D_alpha_shm, D_beta_shm;
+  NodeSharedMatrix G_alpha_shm, G_beta_shm;
   Matrix VXC_alpha_cart, VXC_beta_cart;
   std::vector<double>                   eps_a, eps_b;
   Eigen::Vector<double, Eigen::Dynamic> dfNorm; // Normalization coefficients for DF basis
@@ -379,10 +379,40 @@ TensorType exachem::scf::gauxc::compute_xcf(ExecutionContext& ec, ChemEnv& chem_
   return EXC;
 }
 
+template<typename TensorType>
+Matrix exachem::scf::gauxc::compute_xc_grad(ExecutionContext& ec, ChemEnv& chem_env,
+                                            exachem::scf::EigenTensors&  etensors,
+                                            Matrix&                      D_alpha,
+                                            GauXC::XCIntegrator<Matrix>& xc_integrator) {
+  if(!chem_env.sys_data.is_restricted)
+    tamm_terminate("[SCF] XC gradients are only available for restricted Kohn-Sham");
+
+#ifdef GAUXC_HAS_DEVICE
+  Matrix&                  D_cart = etensors.D_alpha_cart;
+  exachem::scf::SCFCompute scf_compute;
+  scf_compute.compute_sdens_to_cdens<TensorType>(chem_env.shells, D_alpha, D_cart, etensors);
+  auto exc_grad = xc_integrator.eval_exc_grad(0.5 * D_cart);
+  D_cart.resize(0, 0);
+#else
+  auto exc_grad = xc_integrator.eval_exc_grad(0.5 * D_alpha);
+#endif
+
+  const auto natoms = chem_env.atoms.size();
+  Matrix     grad(natoms, 3);
+  for(size_t i = 0; i < natoms; i++)
+    for(int xyz = 0; xyz < 3; xyz++) grad(i, xyz) = exc_grad[3 * i + xyz];
+
+  return grad;
+}
+
 template double exachem::scf::gauxc::compute_xcf<double>(
   ExecutionContext& ec, ChemEnv& chem_env, exachem::scf::TAMMTensors& ttensors,
   exachem::scf::EigenTensors& etensors, GauXC::XCIntegrator<Matrix>& xc_integrator);
 
+template Matrix exachem::scf::gauxc::compute_xc_grad<double>(
+  ExecutionContext& ec, ChemEnv& chem_env, exachem::scf::EigenTensors& etensors, Matrix& D_alpha,
+  GauXC::XCIntegrator<Matrix>& xc_integrator);
+
 template void exachem::scf::gauxc::compute_exx<double>(ExecutionContext& ec, ChemEnv& chem_env,
                                                        SCFVars&                     scf_vars,
                                                        exachem::scf::TAMMTensors&   ttensors,
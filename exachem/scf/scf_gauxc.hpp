@@ -36,6 +36,12 @@ TensorType compute_xcf(ExecutionContext& ec, ChemEnv& chem_env, exachem::scf::TA
                        exachem::scf::EigenTensors&  etensors,
                        GauXC::XCIntegrator<Matrix>& xc_integrator);
 
+// XC contribution to the nuclear gradient (natoms x 3), restricted Kohn-Sham only
+template<typename TensorType>
+Matrix compute_xc_grad(ExecutionContext& ec, ChemEnv& chem_env,
+                       exachem::scf::EigenTensors& etensors, Matrix& D_alpha,
+                       GauXC::XCIntegrator<Matrix>& xc_integrator);
+
 template<typename TensorType>
 void compute_exx(ExecutionContext& ec, ChemEnv& chem_env, SCFVars& scf_vars,
                  exachem::scf::TAMMTensors& ttensors, exachem::scf::EigenTensors& etensors,
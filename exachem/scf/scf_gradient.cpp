@@ -0,0 +1,369 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#include "scf/scf_gradient.hpp"
+
+Matrix exachem::scf::SCFGradient::nuclear_repulsion(const std::vector<libint2::Atom>& atoms) {
+  Matrix grad = Matrix::Zero(atoms.size(), 3);
+  for(size_t i = 0; i < atoms.size(); i++) {
+    for(size_t j = i + 1; j < atoms.size(); j++) {
+      const std::array<double, 3> rij = {atoms[i].x - atoms[j].x, atoms[i].y - atoms[j].y,
+                                         atoms[i].z - atoms[j].z};
+      const double r2 = rij[0] * rij[0] + rij[1] * rij[1] + rij[2] * rij[2];
+      const double r  = sqrt(r2);
+      const double zz = atoms[i].atomic_number * atoms[j].atomic_number / (r2 * r);
+      for(int xyz = 0; xyz < 3; xyz++) {
+        grad(i, xyz) -= zz * rij[xyz];
+        grad(j, xyz) += zz * rij[xyz];
+      }
+    }
+  }
+  return grad;
+}
+
+template<typename TensorType>
+Matrix exachem::scf::SCFGradient::one_body(ExecutionContext& ec, ChemEnv& chem_env,
+                                           const SCFVars& scf_vars, TAMMTensors& ttensors,
+                                           const Matrix& P, const Matrix& W) {
+  using libint2::Engine;
+  using libint2::Operator;
+
+  const libint2::BasisSet&          obs        = chem_env.shells;
+  const std::vector<libint2::Atom>& atoms      = chem_env.atoms;
+  const auto                        shell2bf   = obs.shell2bf();
+  const auto                        shell2atom = obs.shell2atom(atoms);
+
+  Matrix grad = Matrix::Zero(atoms.size(), 3);
+
+  Engine s_engine(Operator::overlap, obs.max_nprim(), obs.max_l(), 1);
+  Engine t_engine(Operator::kinetic, obs.max_nprim(), obs.max_l(), 1);
+  Engine v_engine(Operator::nuclear, obs.max_nprim(), obs.max_l(), 1);
+
+  std::vector<std::pair<double, std::array<double, 3>>> q;
+  for(const auto& atom: atoms)
+    q.push_back({static_cast<double>(atom.atomic_number), {{atom.x, atom.y, atom.z}}});
+  v_engine.set_params(q);
+
+  auto comp_1body_grad_lambda = [&](const IndexVector& blockid) {
+    const auto  s1    = blockid[0];
+    const auto  s2    = blockid[1];
+    const auto& s2spl = scf_vars.obs_shellpair_list.at(s1);
+    if(std::find(s2spl.begin(), s2spl.end(), s2) == s2spl.end()) return;
+
+    const auto bf1_first = shell2bf[s1];
+    const auto bf2_first = shell2bf[s2];
+    const auto n1        = obs[s1].size();
+    const auto n2        = obs[s2].size();
+
+    // the (s1,s2) pair also stands for (s2,s1)
+    const double                s12_deg = (s1 == s2) ? 1.0 : 2.0;
+    const std::array<size_t, 2> centers = {static_cast<size_t>(shell2atom[s1]),
+                                           static_cast<size_t>(shell2atom[s2])};
+
+    // buffers hold the derivatives with respect to the two shell centers followed by those with
+    // respect to the point charges (nuclear attraction only)
+    auto contract = [&](const Engine& engine, const Matrix& M, double factor, size_t nderiv) {
+      const auto& buf = engine.results();
+      for(size_t d = 0; d < nderiv; d++) {
+        if(buf[d] == nullptr) continue;
+        const auto               center = d / 3;
+        const auto               atom   = center < 2 ? centers[center] : center - 2;
+        Eigen::Map<const Matrix> buf_mat(buf[d], n1, n2);
+        grad(atom, d % 3) +=
+          factor * s12_deg * M.block(bf1_first, bf2_first, n1, n2).cwiseProduct(buf_mat).sum();
+      }
+    };
+
+    s_engine.compute(obs[s1], obs[s2]);
+    contract(s_engine, W, -1.0, 6);
+    t_engine.compute(obs[s1], obs[s2]);
+    contract(t_engine, P, 1.0, 6);
+    v_engine.compute(obs[s1], obs[s2]);
+    contract(v_engine, P, 1.0, 6 + 3 * atoms.size());
+  };
+
+  block_for(ec, ttensors.F_dummy(), comp_1body_grad_lambda);
+
+  return grad;
+}
+
+template<typename TensorType>
+Matrix exachem::scf::SCFGradient::ecp(ExecutionContext& ec, ChemEnv& chem_env,
+                                      const SCFVars& scf_vars, TAMMTensors& ttensors,
+                                      const Matrix& P, std::vector<libecpint::GaussianShell>& shells,
+                                      std::vector<libecpint::ECP>& ecps) {
+  const auto shell2bf   = chem_env.shells.shell2bf();
+  const auto shell2atom = chem_env.shells.shell2atom(chem_env.atoms);
+
+  // ecps holds the potentials of the atoms with an ECP, in input order
+  std::vector<size_t> ecp2atom;
+  for(size_t i = 0; i < chem_env.ec_atoms.size(); i++)
+    if(chem_env.ec_atoms[i].has_ecp) ecp2atom.push_back(i);
+
+  Matrix grad = Matrix::Zero(chem_env.atoms.size(), 3);
+
+  int maxam     = 0;
+  int ecp_maxam = 0;
+  for(const auto& shell: shells)
+    if(shell.l > maxam) maxam = shell.l;
+  for(const auto& ecp: ecps)
+    if(ecp.L > ecp_maxam) ecp_maxam = ecp.L;
+
+  libecpint::ECPIntegral engine(maxam, ecp_maxam, 1);
+  std::vector<double>    buffer_sph((maxam + 1) * (maxam + 2) * (maxam + 1) * (maxam + 2) / 4);
+
+  auto comp_ecp_grad_lambda = [&](const IndexVector& blockid) {
+    const auto  s1    = blockid[0];
+    const auto  s2    = blockid[1];
+    const auto& s2spl = scf_vars.obs_shellpair_list.at(s1);
+    if(std::find(s2spl.begin(), s2spl.end(), s2) == s2spl.end()) return;
+
+    const auto   bf1_first = shell2bf[s1];
+    const auto   bf2_first = shell2bf[s2];
+    const auto   n1        = 2 * shells[s1].l + 1;
+    const auto   n2        = 2 * shells[s2].l + 1;
+    const double s12_deg   = (s1 == s2) ? 1.0 : 2.0;
+    const Matrix P12       = P.block(bf1_first, bf2_first, n1, n2);
+
+    for(size_t k = 0; k < ecps.size(); k++) {
+      // derivatives with respect to the centers of shell 1, shell 2 and the ECP
+      std::array<libecpint::TwoIndex<double>, 9> results;
+      engine.compute_shell_pair_derivative(ecps[k], shells[s1], shells[s2], results);
+
+      const std::array<size_t, 3> centers = {static_cast<size_t>(shell2atom[s1]),
+                                             static_cast<size_t>(shell2atom[s2]), ecp2atom[k]};
+      for(size_t d = 0; d < 9; d++) {
+        libint2::solidharmonics::tform(shells[s1].l, shells[s2].l, results[d].data.data(),
+                                       buffer_sph.data());
+        Eigen::Map<const Matrix> buf_mat(buffer_sph.data(), n1, n2);
+        grad(centers[d / 3], d % 3) += s12_deg * P12.cwiseProduct(buf_mat).sum();
+      }
+    }
+  };
+
+  block_for(ec, ttensors.F_dummy(), comp_ecp_grad_lambda);
+
+  return grad;
+}
+
+template<typename TensorType>
+Matrix exachem::scf::SCFGradient::two_body(ExecutionContext& ec, ChemEnv& chem_env,
+                                           const SCFVars& scf_vars, TAMMTensors& ttensors,
+                                           const Matrix& D_alpha, const Matrix& D_beta,
+                                           const Matrix& SchwarzK, double xHF) {
+  using libint2::Engine;
+  using libint2::Operator;
+
+  const libint2::BasisSet& obs         = chem_env.shells;
+  SCFOptions&              scf_options = chem_env.ioptions.scf_options;
+  const bool               is_uhf      = chem_env.sys_data.is_unrestricted;
+  const auto               shell2bf    = obs.shell2bf();
+  const auto               shell2atom  = obs.shell2atom(chem_env.atoms);
+  const bool               doK         = xHF != 0.0;
+
+  // Coulomb uses the total density and exchange the spin densities (half the RHF density)
+  const Matrix  P  = is_uhf ? Matrix(D_alpha + D_beta) : D_alpha;
+  const Matrix  Pa = is_uhf ? D_alpha : Matrix(0.5 * D_alpha);
+  const Matrix& Pb = is_uhf ? D_beta : Pa;
+
+  Matrix D_shblk_norm = chem_env.compute_shellblock_norm(obs, P);
+  if(is_uhf)
+    D_shblk_norm = D_shblk_norm.cwiseMax(chem_env.compute_shellblock_norm(obs, Pa))
+                     .cwiseMax(chem_env.compute_shellblock_norm(obs, Pb));
+
+  // density-fitted calculations do not compute the Schwarz bounds
+  SCFCompute   scf_compute;
+  const Matrix K         = SchwarzK.size() != 0 ? SchwarzK
+                                                : scf_compute.compute_schwarz_ints<>(ec, scf_vars, obs);
+  const double precision = scf_options.tol_sch;
+
+  Matrix grad = Matrix::Zero(chem_env.atoms.size(), 3);
+
+  Engine engine(Operator::coulomb, obs.max_nprim(), obs.max_l(), 1);
+  engine.set_precision(scf_options.tol_int);
+  const auto& buf = engine.results();
+
+  std::vector<double> gamma;
+
+  auto comp_2body_grad_lambda = [&](const IndexVector& blockid) {
+    auto s1        = blockid[0];
+    auto bf1_first = shell2bf[s1];
+    auto n1        = obs[s1].size();
+    auto sp12_iter = scf_vars.obs_shellpair_data.at(s1).begin();
+
+    auto s2     = blockid[1];
+    auto s2spl  = scf_vars.obs_shellpair_list.at(s1);
+    auto s2_itr = std::find(s2spl.begin(), s2spl.end(), s2);
+    if(s2_itr == s2spl.end()) return;
+    auto s2_pos    = std::distance(s2spl.begin(), s2_itr);
+    auto bf2_first = shell2bf[s2];
+    auto n2        = obs[s2].size();
+
+    std::advance(sp12_iter, s2_pos);
+    const auto* sp12 = sp12_iter->get();
+
+    for(decltype(s1) s3 = 0; s3 <= s1; ++s3) {
+      auto bf3_first = shell2bf[s3];
+      auto n3        = obs[s3].size();
+
+      const auto Dnorm123 =
+        std::max(D_shblk_norm(s1, s2), std::max(D_shblk_norm(s1, s3), D_shblk_norm(s2, s3)));
+
+      auto sp34_iter = scf_vars.obs_shellpair_data.at(s3).begin();
+
+      const auto s4_max = (s1 == s3) ? s2 : s3;
+      for(const auto& s4: scf_vars.obs_shellpair_list.at(s3)) {
+        if(s4 > s4_max) break;
+
+        // must update the iter even if going to skip s4
+        const auto* sp34 = sp34_iter->get();
+        ++sp34_iter;
+
+        const auto Dnorm1234 =
+          std::max(D_shblk_norm(s1, s4),
+                   std::max(D_shblk_norm(s2, s4), std::max(D_shblk_norm(s3, s4), Dnorm123)));
+        if(Dnorm1234 * K(s1, s2) * K(s3, s4) < precision) continue;
+
+        auto bf4_first = shell2bf[s4];
+        auto n4        = obs[s4].size();
+
+        // permutational degeneracy of the unique shell set
+        auto s12_deg    = (s1 == s2) ? 1 : 2;
+        auto s34_deg    = (s3 == s4) ? 1 : 2;
+        auto s12_34_deg = (s1 == s3) ? (s2 == s4 ? 1 : 2) : 2;
+        auto s1234_deg  = s12_deg * s34_deg * s12_34_deg;
+
+        engine.compute2<Operator::coulomb, libint2::BraKet::xx_xx, 1>(obs[s1], obs[s2], obs[s3],
+                                                                      obs[s4], sp12, sp34);
+        if(buf[0] == nullptr) continue; // if all integrals screened out, skip to next quartet
+
+        // two-particle density of the shell set, symmetrized over the permutations of (ab|cd):
+        //   E2 = 1/2 sum (ab|cd) [ P(a,b) P(c,d) - xHF/2 sum_s (P_s(a,c) P_s(b,d) + P_s(a,d) P_s(b,c)) ]
+        gamma.resize(n1 * n2 * n3 * n4);
+        for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
+          const auto bf1 = f1 + bf1_first;
+          for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
+            const auto bf2 = f2 + bf2_first;
+            for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
+              const auto bf3 = f3 + bf3_first;
+              for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
+                const auto bf4 = f4 + bf4_first;
+                double     g   = P(bf1, bf2) * P(bf3, bf4);
+                if(doK)
+                  g -= 0.5 * xHF *
+                       (Pa(bf1, bf3) * Pa(bf2, bf4) + Pa(bf1, bf4) * Pa(bf2, bf3) +
+                        Pb(bf1, bf3) * Pb(bf2, bf4) + Pb(bf1, bf4) * Pb(bf2, bf3));
+                gamma[f1234] = 0.5 * s1234_deg * g;
+              }
+            }
+          }
+        }
+
+        const std::array<size_t, 4> centers = {
+          static_cast<size_t>(shell2atom[s1]), static_cast<size_t>(shell2atom[s2]),
+          static_cast<size_t>(shell2atom[s3]), static_cast<size_t>(shell2atom[s4])};
+        for(size_t d = 0; d < 12; d++) {
+          double value = 0.0;
+          for(size_t f = 0; f < gamma.size(); f++) value += gamma[f] * buf[d][f];
+          grad(centers[d / 3], d % 3) += value;
+        }
+      }
+    }
+  };
+
+  block_for(ec, ttensors.F_dummy(), comp_2body_grad_lambda);
+
+  return grad;
+}
+
+template<typename TensorType>
+Matrix exachem::scf::SCFGradient::compute_gradient(
+  ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars, TAMMTensors& ttensors,
+  EigenTensors& etensors, std::vector<libecpint::GaussianShell>& libecp_shells,
+  std::vector<libecpint::ECP>& ecps, const Matrix& SchwarzK, double xHF
+#if defined(USE_GAUXC)
+  ,
+  GauXC::XCIntegrator<Matrix>& gauxc_integrator
+#endif
+) {
+  SystemData& sys_data = chem_env.sys_data;
+  const bool  is_uhf   = sys_data.is_unrestricted;
+  auto        rank     = ec.pg().rank();
+
+  auto grad_t1 = std::chrono::high_resolution_clock::now();
+
+  // The gradient is taken at the density of the last Fock build, whose energy was reported.
+  // FD holds F D of that density before the DIIS extrapolation and the level shift.
+  Matrix D_alpha  = tamm_to_eigen_matrix(ttensors.D_last_alpha);
+  Matrix FD_alpha = tamm_to_eigen_matrix(ttensors.FD_alpha);
+  Matrix D_beta, FD_beta;
+  if(is_uhf) {
+    D_beta  = tamm_to_eigen_matrix(ttensors.D_last_beta);
+    FD_beta = tamm_to_eigen_matrix(ttensors.FD_beta);
+  }
+
+  // total and energy-weighted densities, W = sum_i n_i e_i C_i C_i^T
+  const Matrix P = is_uhf ? Matrix(D_alpha + D_beta) : D_alpha;
+  const Matrix W = is_uhf ? Matrix(D_alpha * FD_alpha + D_beta * FD_beta)
+                          : Matrix(0.5 * D_alpha * FD_alpha);
+
+  Matrix grad_local = one_body<TensorType>(ec, chem_env, scf_vars, ttensors, P, W);
+  if(sys_data.has_ecp)
+    grad_local += ecp<TensorType>(ec, chem_env, scf_vars, ttensors, P, libecp_shells, ecps);
+  grad_local +=
+    two_body<TensorType>(ec, chem_env, scf_vars, ttensors, D_alpha, D_beta, SchwarzK, xHF);
+
+  Matrix grad = Matrix::Zero(grad_local.rows(), grad_local.cols());
+  ec.pg().allreduce(grad_local.data(), grad.data(), grad.size(), tamm::ReduceOp::sum);
+
+  grad += nuclear_repulsion(chem_env.atoms);
+
+#if defined(USE_GAUXC)
+  if(sys_data.is_ks)
+    grad +=
+      scf::gauxc::compute_xc_grad<TensorType>(ec, chem_env, etensors, D_alpha, gauxc_integrator);
+#endif
+
+  auto   grad_t2   = std::chrono::high_resolution_clock::now();
+  double grad_time = std::chrono::duration_cast<std::chrono::duration<double>>((grad_t2 - grad_t1))
+                       .count();
+
+  chem_env.telemetry.record(ec.pg(), "SCF", "gradient", grad_time);
+  if(rank == 0)
+    std::cout << std::endl
+              << "Time taken for the SCF gradient: " << std::fixed << std::setprecision(2)
+              << grad_time << " secs" << std::endl;
+
+  return grad;
+}
+
+void exachem::scf::SCFGradient::print_gradient(ChemEnv& chem_env, const Matrix& grad) {
+  std::cout << std::endl << "SCF nuclear gradient (Hartree/Bohr)" << std::endl;
+  std::cout << std::string(70, '-') << std::endl;
+  std::cout << std::setw(6) << "atom" << std::setw(6) << " " << std::setw(19) << "x"
+            << std::setw(19) << "y" << std::setw(19) << "z" << std::endl;
+  for(Eigen::Index i = 0; i < grad.rows(); i++) {
+    std::cout << std::setw(6) << i + 1 << std::setw(6) << chem_env.ec_atoms[i].esymbol
+              << std::fixed << std::setprecision(12);
+    for(int xyz = 0; xyz < 3; xyz++) std::cout << std::setw(19) << grad(i, xyz);
+    std::cout << std::endl;
+  }
+  std::cout << std::string(70, '-') << std::endl;
+  std::cout << "RMS gradient = " << std::scientific << std::setprecision(6)
+            << std::sqrt(grad.squaredNorm() / grad.size()) << std::defaultfloat << std::endl;
+}
+
+template Matrix exachem::scf::SCFGradient::compute_gradient<double>(
+  ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars, TAMMTensors& ttensors,
+  EigenTensors& etensors, std::vector<libecpint::GaussianShell>& libecp_shells,
+  std::vector<libecpint::ECP>& ecps, const Matrix& SchwarzK, double xHF
+#if defined(USE_GAUXC)
+  ,
+  GauXC::XCIntegrator<Matrix>& gauxc_integrator
+#endif
+);
@@ -0,0 +1,55 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "scf/scf_gauxc.hpp"
+#include "scf/scf_outputs.hpp"
+
+namespace exachem::scf {
+
+// Analytic nuclear gradient of a converged RHF/UHF/KS wavefunction (SCF option gradient).
+// The derivative integrals are distributed over the shell pairs with block_for and screened
+// with the same shell pair lists and Schwarz bounds as the Fock build, every rank accumulates
+// the contributions of its shell pairs and the result is summed over the process group.
+class SCFGradient {
+private:
+  // all gradient contributions are natoms x 3 matrices in Hartree/Bohr
+  Matrix nuclear_repulsion(const std::vector<libint2::Atom>& atoms);
+
+  template<typename TensorType>
+  Matrix one_body(ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars,
+                  TAMMTensors& ttensors, const Matrix& P, const Matrix& W);
+
+  template<typename TensorType>
+  Matrix ecp(ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars,
+             TAMMTensors& ttensors, const Matrix& P, std::vector<libecpint::GaussianShell>& shells,
+             std::vector<libecpint::ECP>& ecps);
+
+  template<typename TensorType>
+  Matrix two_body(ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars,
+                  TAMMTensors& ttensors, const Matrix& D_alpha, const Matrix& D_beta,
+                  const Matrix& SchwarzK, double xHF);
+
+public:
+  // collective over ec, returns the total gradient on every rank. Call after convergence,
+  // before D_last and FD of the last iteration are overwritten.
+  template<typename TensorType>
+  Matrix compute_gradient(ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars,
+                          TAMMTensors& ttensors, EigenTensors& etensors,
+                          std::vector<libecpint::GaussianShell>& libecp_shells,
+                          std::vector<libecpint::ECP>& ecps, const Matrix& SchwarzK, double xHF
+#if defined(USE_GAUXC)
+                          ,
+                          GauXC::XCIntegrator<Matrix>& gauxc_integrator
+#endif
+  );
+
+  void print_gradient(ChemEnv& chem_env, const Matrix& grad);
+};
+} // namespace exachem::scf
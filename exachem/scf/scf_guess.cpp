@@ -9,6 +9,11 @@
 #include "scf/scf_guess.hpp"
 #include <algorithm>
 #include <iterator>
+#include <memory>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 /// computes orbital occupation numbers for a subshell of size \c size created
 /// by smearing
@@ -110,115 +115,136 @@ Matrix exachem::scf::SCFGuess::compute_soad(const std::vector<Atom>& atoms) {
   return D; // we use densities normalized to # of electrons/2
 }
 
-template<typename TensorType>
-void exachem::scf::SCFGuess::compute_dipole_ints(
-  ExecutionContext& ec, const SCFVars& spvars, Tensor<TensorType>& tensorX,
-  Tensor<TensorType>& tensorY, Tensor<TensorType>& tensorZ, std::vector<libint2::Atom>& atoms,
-  libint2::BasisSet& shells, libint2::Operator otype) {
-  using libint2::Atom;
-  using libint2::BasisSet;
-  using libint2::Engine;
-  using libint2::Operator;
-  using libint2::Shell;
-
-  const std::vector<Tile>&   AO_tiles       = spvars.AO_tiles;
-  const std::vector<size_t>& shell_tile_map = spvars.shell_tile_map;
-
-  Engine engine(otype, max_nprim(shells), max_l(shells), 0);
-
-  // engine.set(otype);
-  // auto& buf = (engine.results());
-
-  auto compute_dipole_ints_lambda = [&](const IndexVector& blockid) {
-    auto bi0 = blockid[0];
-    auto bi1 = blockid[1];
-
-    const TAMM_SIZE         size       = tensorX.block_size(blockid);
-    auto                    block_dims = tensorX.block_dims(blockid);
-    std::vector<TensorType> dbufX(size);
-    std::vector<TensorType> dbufY(size);
-    std::vector<TensorType> dbufZ(size);
-
-    auto bd1 = block_dims[1];
+namespace {
 
-    // auto s1 = blockid[0];
-    auto                  s1range_end   = shell_tile_map[bi0];
-    decltype(s1range_end) s1range_start = 0l;
-    if(bi0 > 0) s1range_start = shell_tile_map[bi0 - 1] + 1;
-
-    // cout << "s1-start,end = " << s1range_start << ", " << s1range_end << endl;
-    for(auto s1 = s1range_start; s1 <= s1range_end; ++s1) {
-      // auto bf1 = shell2bf[s1]; //shell2bf[s1]; // first basis function in
-      // this shell
-      auto n1 = shells[s1].size();
-
-      auto                  s2range_end   = shell_tile_map[bi1];
-      decltype(s2range_end) s2range_start = 0l;
-      if(bi1 > 0) s2range_start = shell_tile_map[bi1 - 1] + 1;
-
-      // cout << "s2-start,end = " << s2range_start << ", " << s2range_end << endl;
+inline int onebody_nthreads() {
+#if defined(_OPENMP)
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
 
-      // cout << "screend shell pair list = " << s2spl << endl;
-      for(auto s2 = s2range_start; s2 <= s2range_end; ++s2) {
-        // for (auto s2: spvars.obs_shellpair_list.at(s1)) {
-        // auto s2 = blockid[1];
-        // if (s2>s1) continue;
+inline int onebody_thread_id() {
+#if defined(_OPENMP)
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
 
-        if(s2 > s1) {
-          auto s2spl = spvars.obs_shellpair_list.at(s2);
-          if(std::find(s2spl.begin(), s2spl.end(), s1) == s2spl.end()) continue;
-        }
-        else {
-          auto s2spl = spvars.obs_shellpair_list.at(s1);
-          if(std::find(s2spl.begin(), s2spl.end(), s2) == s2spl.end()) continue;
-        }
+/// Fills the tensors of symmetric one-electron operators on the AO tiling of \c scf_vars.
+/// Only the blocks bi1 <= bi0 are computed, from the shell pairs s2 <= s1 kept in the screened
+/// obs_shellpair_list that is also used by the two-electron code, and every off-diagonal block
+/// is put a second time transposed. The shell pairs of a block are spread over the OpenMP
+/// threads of the rank: \c compute_pair(thread, s1, s2, bufs) fills one n1 x n2 row-major
+/// buffer per tensor with the engines of \c thread and returns false if the pair vanishes.
+template<typename TensorType, typename PairFunc>
+void compute_symmetric_1body(ExecutionContext& ec, const exachem::scf::SCFVars& scf_vars,
+                             const std::vector<Tensor<TensorType>*>& tensors,
+                             PairFunc&&                              compute_pair) {
+  const std::vector<Tile>&   AO_tiles       = scf_vars.AO_tiles;
+  const std::vector<size_t>& shell_tile_map = scf_vars.shell_tile_map;
+  const size_t               ntensors       = tensors.size();
+  Tensor<TensorType>&        tensor0        = *tensors[0];
+
+  auto compute_1body_block_lambda = [&](const IndexVector& blockid) {
+    const auto bi0 = blockid[0];
+    const auto bi1 = blockid[1];
+    if(bi1 > bi0) return;
+
+    const TAMM_SIZE size       = tensor0.block_size(blockid);
+    auto            block_dims = tensor0.block_dims(blockid);
+    const auto      bd0        = block_dims[0];
+    const auto      bd1        = block_dims[1];
+
+    const size_t s1range_start = bi0 > 0 ? shell_tile_map[bi0 - 1] + 1 : 0;
+    const size_t s1range_end   = shell_tile_map[bi0];
+    const size_t s2range_start = bi1 > 0 ? shell_tile_map[bi1 - 1] + 1 : 0;
+    const size_t s2range_end   = shell_tile_map[bi1];
+
+    // offsets of the shells within the block
+    std::vector<size_t> offset1(s1range_end - s1range_start + 1, 0);
+    std::vector<size_t> offset2(s2range_end - s2range_start + 1, 0);
+    for(size_t s = s1range_start + 1; s <= s1range_end; ++s)
+      offset1[s - s1range_start] = offset1[s - s1range_start - 1] + AO_tiles[s - 1];
+    for(size_t s = s2range_start + 1; s <= s2range_end; ++s)
+      offset2[s - s2range_start] = offset2[s - s2range_start - 1] + AO_tiles[s - 1];
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for(size_t s1 = s1range_start; s1 <= s1range_end; ++s1) {
+      for(const auto s2: scf_vars.obs_shellpair_list.at(s1)) {
+        if(s2 < s2range_start || s2 > s2range_end) continue;
+        pairs.emplace_back(s1, s2);
+      }
+    }
 
-        // auto bf2 = shell2bf[s2];
-        auto n2 = shells[s2].size();
-
-        std::vector<TensorType> tbufX(n1 * n2);
-        std::vector<TensorType> tbufY(n1 * n2);
-        std::vector<TensorType> tbufZ(n1 * n2);
-
-        // compute shell pair; return is the pointer to the buffer
-        const auto& buf = engine.compute(shells[s1], shells[s2]);
-        EXPECTS(buf.size() >= 4);
-        if(buf[0] == nullptr) continue;
-        // "map" buffer to a const Eigen Matrix, and copy it to the
-        // corresponding blocks of the result
-
-        Eigen::Map<const Matrix> buf_mat_X(buf[1], n1, n2);
-        Eigen::Map<Matrix>(&tbufX[0], n1, n2) = buf_mat_X;
-        Eigen::Map<const Matrix> buf_mat_Y(buf[2], n1, n2);
-        Eigen::Map<Matrix>(&tbufY[0], n1, n2) = buf_mat_Y;
-        Eigen::Map<const Matrix> buf_mat_Z(buf[3], n1, n2);
-        Eigen::Map<Matrix>(&tbufZ[0], n1, n2) = buf_mat_Z;
-
-        auto curshelloffset_i = 0U;
-        auto curshelloffset_j = 0U;
-        for(auto x = s1range_start; x < s1; x++) curshelloffset_i += AO_tiles[x];
-        for(auto x = s2range_start; x < s2; x++) curshelloffset_j += AO_tiles[x];
-
-        size_t c    = 0;
-        auto   dimi = curshelloffset_i + AO_tiles[s1];
-        auto   dimj = curshelloffset_j + AO_tiles[s2];
-
-        for(size_t i = curshelloffset_i; i < dimi; i++) {
-          for(size_t j = curshelloffset_j; j < dimj; j++, c++) {
-            dbufX[i * bd1 + j] = tbufX[c];
-            dbufY[i * bd1 + j] = tbufY[c];
-            dbufZ[i * bd1 + j] = tbufZ[c];
+    std::vector<std::vector<TensorType>> dbuf(ntensors, std::vector<TensorType>(size, 0));
+
+#pragma omp parallel for schedule(dynamic)
+    for(size_t ip = 0; ip < pairs.size(); ++ip) {
+      const size_t s1 = pairs[ip].first;
+      const size_t s2 = pairs[ip].second;
+      const size_t n1 = AO_tiles[s1];
+      const size_t n2 = AO_tiles[s2];
+
+      std::vector<std::vector<TensorType>> tbuf(ntensors, std::vector<TensorType>(n1 * n2));
+      if(!compute_pair(onebody_thread_id(), s1, s2, tbuf)) continue;
+
+      // a diagonal block holds both (s1,s2) and (s2,s1)
+      const size_t i0 = offset1[s1 - s1range_start];
+      const size_t j0 = offset2[s2 - s2range_start];
+      for(size_t t = 0; t < ntensors; t++) {
+        for(size_t i = 0; i < n1; i++) {
+          for(size_t j = 0; j < n2; j++) {
+            dbuf[t][(i0 + i) * bd1 + j0 + j] = tbuf[t][i * n2 + j];
+            if(bi0 == bi1) dbuf[t][(j0 + j) * bd1 + i0 + i] = tbuf[t][i * n2 + j];
           }
         }
-      } // s2
-    }   // s1
+      }
+    }
 
-    tensorX.put(blockid, dbufX);
-    tensorY.put(blockid, dbufY);
-    tensorZ.put(blockid, dbufZ);
+    for(size_t t = 0; t < ntensors; t++) {
+      tensors[t]->put(blockid, dbuf[t]);
+      if(bi0 == bi1) continue;
+      std::vector<TensorType> tbuf(size);
+      for(size_t i = 0; i < bd0; i++)
+        for(size_t j = 0; j < bd1; j++) tbuf[j * bd0 + i] = dbuf[t][i * bd1 + j];
+      tensors[t]->put(IndexVector{bi1, bi0}, tbuf);
+    }
   };
 
-  block_for(ec, tensorX(), compute_dipole_ints_lambda);
+  block_for(ec, tensor0(), compute_1body_block_lambda);
+  ec.pg().barrier();
+}
+
+} // namespace
+
+template<typename TensorType>
+void exachem::scf::SCFGuess::compute_dipole_ints(
+  ExecutionContext& ec, const SCFVars& spvars, Tensor<TensorType>& tensorX,
+  Tensor<TensorType>& tensorY, Tensor<TensorType>& tensorZ, std::vector<libint2::Atom>& atoms,
+  libint2::BasisSet& shells, libint2::Operator otype) {
+  using libint2::Engine;
+
+  const int           nthreads = onebody_nthreads();
+  std::vector<Engine> engines(nthreads);
+  engines[0] = Engine(otype, max_nprim(shells), max_l(shells), 0);
+  for(int i = 1; i < nthreads; i++) engines[i] = engines[0];
+
+  compute_symmetric_1body<TensorType>(
+    ec, spvars, {&tensorX, &tensorY, &tensorZ},
+    [&](int thread, size_t s1, size_t s2, std::vector<std::vector<TensorType>>& bufs) {
+      const auto  n1  = shells[s1].size();
+      const auto  n2  = shells[s2].size();
+      const auto& buf = engines[thread].compute(shells[s1], shells[s2]);
+      EXPECTS(buf.size() >= 4);
+      if(buf[0] == nullptr) return false;
+      // buf[0] is the overlap, buf[1..3] the x, y, z components
+      for(size_t k = 0; k < 3; k++)
+        Eigen::Map<Matrix>(bufs[k].data(), n1, n2) = Eigen::Map<const Matrix>(buf[k + 1], n1, n2);
+      return true;
+    });
 }
 
 template<typename TensorType>
@@ -227,116 +253,32 @@ void exachem::scf::SCFGuess::compute_1body_ints(ExecutionContext& ec, const SCFV
                                                 std::vector<libint2::Atom>& atoms,
                                                 libint2::BasisSet&          shells,
                                                 libint2::Operator           otype) {
-  using libint2::Atom;
-  using libint2::BasisSet;
   using libint2::Engine;
   using libint2::Operator;
-  using libint2::Shell;
-
-  const std::vector<Tile>&   AO_tiles       = scf_vars.AO_tiles;
-  const std::vector<size_t>& shell_tile_map = scf_vars.shell_tile_map;
 
-  Engine engine(otype, max_nprim(shells), max_l(shells), 0);
-
-  // engine.set(otype);
+  const int           nthreads = onebody_nthreads();
+  std::vector<Engine> engines(nthreads);
+  engines[0] = Engine(otype, max_nprim(shells), max_l(shells), 0);
 
   if(otype == Operator::nuclear) {
     std::vector<std::pair<double, std::array<double, 3>>> q;
     for(const auto& atom: atoms)
       q.push_back({static_cast<double>(atom.atomic_number), {{atom.x, atom.y, atom.z}}});
 
-    engine.set_params(q);
+    engines[0].set_params(q);
   }
-
-  auto& buf = (engine.results());
-
-  auto compute_1body_ints_lambda = [&](const IndexVector& blockid) {
-    auto bi0 = blockid[0];
-    auto bi1 = blockid[1];
-
-    const TAMM_SIZE         size       = tensor1e.block_size(blockid);
-    auto                    block_dims = tensor1e.block_dims(blockid);
-    std::vector<TensorType> dbuf(size);
-
-    auto bd1 = block_dims[1];
-
-    // auto s1 = blockid[0];
-    auto                  s1range_end   = shell_tile_map[bi0];
-    decltype(s1range_end) s1range_start = 0l;
-    if(bi0 > 0) s1range_start = shell_tile_map[bi0 - 1] + 1;
-
-    // cout << "s1-start,end = " << s1range_start << ", " << s1range_end << endl;
-    for(auto s1 = s1range_start; s1 <= s1range_end; ++s1) {
-      // auto bf1 = shell2bf[s1]; //shell2bf[s1]; // first basis function in
-      // this shell
-      auto n1 = shells[s1].size();
-
-      auto                  s2range_end   = shell_tile_map[bi1];
-      decltype(s2range_end) s2range_start = 0l;
-      if(bi1 > 0) s2range_start = shell_tile_map[bi1 - 1] + 1;
-
-      // cout << "s2-start,end = " << s2range_start << ", " << s2range_end << endl;
-
-      // cout << "screend shell pair list = " << s2spl << endl;
-      for(auto s2 = s2range_start; s2 <= s2range_end; ++s2) {
-        // for (auto s2: scf_vars.obs_shellpair_list.at(s1)) {
-        // auto s2 = blockid[1];
-        // if (s2>s1) continue;
-
-        if(s2 > s1) {
-          auto s2spl = scf_vars.obs_shellpair_list.at(s2);
-          if(std::find(s2spl.begin(), s2spl.end(), s1) == s2spl.end()) continue;
-        }
-        else {
-          auto s2spl = scf_vars.obs_shellpair_list.at(s1);
-          if(std::find(s2spl.begin(), s2spl.end(), s2) == s2spl.end()) continue;
-        }
-
-        // auto bf2 = shell2bf[s2];
-        auto n2 = shells[s2].size();
-
-        std::vector<TensorType> tbuf(n1 * n2);
-
-        // compute shell pair; return is the pointer to the buffer
-        engine.compute(shells[s1], shells[s2]);
-        if(buf[0] == nullptr) continue;
-        // "map" buffer to a const Eigen Matrix, and copy it to the
-        // corresponding blocks of the result
-        Eigen::Map<const Matrix> buf_mat(buf[0], n1, n2);
-        Eigen::Map<Matrix>(&tbuf[0], n1, n2) = buf_mat;
-        // tensor1e.put(blockid, tbuf);
-
-        auto curshelloffset_i = 0U;
-        auto curshelloffset_j = 0U;
-        for(auto x = s1range_start; x < s1; x++) curshelloffset_i += AO_tiles[x];
-        for(auto x = s2range_start; x < s2; x++) curshelloffset_j += AO_tiles[x];
-
-        size_t c    = 0;
-        auto   dimi = curshelloffset_i + AO_tiles[s1];
-        auto   dimj = curshelloffset_j + AO_tiles[s2];
-
-        for(size_t i = curshelloffset_i; i < dimi; i++) {
-          for(size_t j = curshelloffset_j; j < dimj; j++, c++) { dbuf[i * bd1 + j] = tbuf[c]; }
-        }
-
-        // if(s1!=s2){
-        //     std::vector<TensorType> ttbuf(n1*n2);
-        //     Eigen::Map<Matrix>(ttbuf.data(),n2,n1) = buf_mat.transpose();
-        //     // Matrix buf_mat_trans = buf_mat.transpose();
-        //     size_t c = 0;
-        //     for(size_t j = curshelloffset_j; j < dimj; j++) {
-        //       for(size_t i = curshelloffset_i; i < dimi; i++, c++) {
-        //             dbuf[j*block_dims[0]+i] = ttbuf[c];
-        //       }
-        //     }
-        // }
-        // tensor1e.put({s2,s1}, ttbuf);
-      }
-    }
-    tensor1e.put(blockid, dbuf);
-  };
-
-  block_for(ec, tensor1e(), compute_1body_ints_lambda);
+  for(int i = 1; i < nthreads; i++) engines[i] = engines[0];
+
+  compute_symmetric_1body<TensorType>(
+    ec, scf_vars, {&tensor1e},
+    [&](int thread, size_t s1, size_t s2, std::vector<std::vector<TensorType>>& bufs) {
+      const auto  n1  = shells[s1].size();
+      const auto  n2  = shells[s2].size();
+      const auto& buf = engines[thread].compute(shells[s1], shells[s2]);
+      if(buf[0] == nullptr) return false;
+      Eigen::Map<Matrix>(bufs[0].data(), n1, n2) = Eigen::Map<const Matrix>(buf[0], n1, n2);
+      return true;
+    });
 }
 
 template<typename TensorType>
@@ -344,244 +286,170 @@ void exachem::scf::SCFGuess::compute_ecp_ints(ExecutionContext& ec, const SCFVar
                                               Tensor<TensorType>&                    tensor1e,
                                               std::vector<libecpint::GaussianShell>& shells,
                                               std::vector<libecpint::ECP>&           ecps) {
-  const std::vector<Tile>&   AO_tiles       = scf_vars.AO_tiles;
-  const std::vector<size_t>& shell_tile_map = scf_vars.shell_tile_map;
-
   int maxam     = 0;
   int ecp_maxam = 0;
-  for(auto shell: shells)
+  for(const auto& shell: shells)
     if(shell.l > maxam) maxam = shell.l;
-  for(auto ecp: ecps)
+  for(const auto& ecp: ecps)
     if(ecp.L > ecp_maxam) ecp_maxam = ecp.L;
 
-  size_t  size_       = (maxam + 1) * (maxam + 2) * (maxam + 1) * (maxam + 2) / 4;
-  double* buffer_     = new double[size_];
-  double* buffer_sph_ = new double[size_];
-  memset(buffer_, 0, size_ * sizeof(double));
-
-  libecpint::ECPIntegral engine(maxam, ecp_maxam);
-
-  auto compute_ecp_ints_lambda = [&](const IndexVector& blockid) {
-    auto bi0 = blockid[0];
-    auto bi1 = blockid[1];
-
-    const TAMM_SIZE         size       = tensor1e.block_size(blockid);
-    auto                    block_dims = tensor1e.block_dims(blockid);
-    std::vector<TensorType> dbuf(size);
-
-    auto bd1 = block_dims[1];
-
-    // auto s1 = blockid[0];
-    auto                  s1range_end   = shell_tile_map[bi0];
-    decltype(s1range_end) s1range_start = 0l;
-    if(bi0 > 0) s1range_start = shell_tile_map[bi0 - 1] + 1;
-
-    // cout << "s1-start,end = " << s1range_start << ", " << s1range_end << endl;
-    for(auto s1 = s1range_start; s1 <= s1range_end; ++s1) {
-      // auto bf1 = shell2bf[s1]; //shell2bf[s1]; // first basis function in
-      // this shell
-      auto n1 = 2 * shells[s1].l + 1;
-
-      auto                  s2range_end   = shell_tile_map[bi1];
-      decltype(s2range_end) s2range_start = 0l;
-      if(bi1 > 0) s2range_start = shell_tile_map[bi1 - 1] + 1;
-
-      // cout << "s2-start,end = " << s2range_start << ", " << s2range_end << endl;
-
-      // cout << "screend shell pair list = " << s2spl << endl;
-      for(auto s2 = s2range_start; s2 <= s2range_end; ++s2) {
-        // for (auto s2: scf_vars.obs_shellpair_list.at(s1)) {
-        // auto s2 = blockid[1];
-        // if (s2>s1) continue;
-
-        if(s2 > s1) {
-          auto s2spl = scf_vars.obs_shellpair_list.at(s2);
-          if(std::find(s2spl.begin(), s2spl.end(), s1) == s2spl.end()) continue;
-        }
-        else {
-          auto s2spl = scf_vars.obs_shellpair_list.at(s1);
-          if(std::find(s2spl.begin(), s2spl.end(), s2) == s2spl.end()) continue;
-        }
-
-        // auto bf2 = shell2bf[s2];
-        auto n2 = 2 * shells[s2].l + 1;
-
-        std::vector<TensorType> tbuf(n1 * n2);
-        // cout << "s1,s2,n1,n2 = "  << s1 << "," << s2 <<
-        //       "," << n1 <<"," << n2 <<endl;
-
-        // compute shell pair; return is the pointer to the buffer
-        const libecpint::GaussianShell& LibECPShell1 = shells[s1];
-        const libecpint::GaussianShell& LibECPShell2 = shells[s2];
-        size_ = shells[s1].ncartesian() * shells[s2].ncartesian();
-        memset(buffer_, 0, size_ * sizeof(double));
-        for(const auto& ecp: ecps) {
-          libecpint::TwoIndex<double> results;
-          engine.compute_shell_pair(ecp, LibECPShell1, LibECPShell2, results);
-          // for (auto v: results.data) std::cout << std::setprecision(6) << v << std::endl;
-          std::transform(results.data.begin(), results.data.end(), buffer_, buffer_,
-                         std::plus<double>());
-        }
-        libint2::solidharmonics::tform(shells[s1].l, shells[s2].l, buffer_, buffer_sph_);
-
-        // "map" buffer to a const Eigen Matrix, and copy it to the
-        // corresponding blocks of the result
-        Eigen::Map<const Matrix> buf_mat(&buffer_sph_[0], n1, n2);
-        Eigen::Map<Matrix>(&tbuf[0], n1, n2) = buf_mat;
-        // tensor1e.put(blockid, tbuf);
-
-        auto curshelloffset_i = 0U;
-        auto curshelloffset_j = 0U;
-        for(auto x = s1range_start; x < s1; x++) curshelloffset_i += AO_tiles[x];
-        for(auto x = s2range_start; x < s2; x++) curshelloffset_j += AO_tiles[x];
-
-        size_t c    = 0;
-        auto   dimi = curshelloffset_i + AO_tiles[s1];
-        auto   dimj = curshelloffset_j + AO_tiles[s2];
-
-        // cout << "curshelloffset_i,curshelloffset_j,dimi,dimj = "  << curshelloffset_i << "," <<
-        // curshelloffset_j <<
-        //       "," << dimi <<"," << dimj <<endl;
-
-        for(size_t i = curshelloffset_i; i < dimi; i++) {
-          for(size_t j = curshelloffset_j; j < dimj; j++, c++) { dbuf[i * bd1 + j] = tbuf[c]; }
-        }
-
-        // if(s1!=s2){
-        //     std::vector<TensorType> ttbuf(n1*n2);
-        //     Eigen::Map<Matrix>(ttbuf.data(),n2,n1) = buf_mat.transpose();
-        //     // Matrix buf_mat_trans = buf_mat.transpose();
-        //     size_t c = 0;
-        //     for(size_t j = curshelloffset_j; j < dimj; j++) {
-        //       for(size_t i = curshelloffset_i; i < dimi; i++, c++) {
-        //             dbuf[j*block_dims[0]+i] = ttbuf[c];
-        //       }
-        //     }
-        // }
-        // tensor1e.put({s2,s1}, ttbuf);
+  // every thread owns an ECP engine and its cartesian/spherical buffers
+  const int    nthreads = onebody_nthreads();
+  const size_t size_    = (maxam + 1) * (maxam + 2) * (maxam + 1) * (maxam + 2) / 4;
+  std::vector<std::vector<double>> buffers(nthreads, std::vector<double>(size_));
+  std::vector<std::vector<double>> buffers_sph(nthreads, std::vector<double>(size_));
+
+  std::vector<std::unique_ptr<libecpint::ECPIntegral>> engines(nthreads);
+  for(int i = 0; i < nthreads; i++)
+    engines[i] = std::make_unique<libecpint::ECPIntegral>(maxam, ecp_maxam);
+
+  compute_symmetric_1body<TensorType>(
+    ec, scf_vars, {&tensor1e},
+    [&](int thread, size_t s1, size_t s2, std::vector<std::vector<TensorType>>& bufs) {
+      const auto n1          = 2 * shells[s1].l + 1;
+      const auto n2          = 2 * shells[s2].l + 1;
+      double*    buffer_     = buffers[thread].data();
+      double*    buffer_sph_ = buffers_sph[thread].data();
+
+      const libecpint::GaussianShell& LibECPShell1 = shells[s1];
+      const libecpint::GaussianShell& LibECPShell2 = shells[s2];
+      std::fill_n(buffer_, shells[s1].ncartesian() * shells[s2].ncartesian(), 0.0);
+      for(const auto& ecp: ecps) {
+        libecpint::TwoIndex<double> results;
+        engines[thread]->compute_shell_pair(ecp, LibECPShell1, LibECPShell2, results);
+        std::transform(results.data.begin(), results.data.end(), buffer_, buffer_,
+                       std::plus<double>());
       }
-    }
-    tensor1e.put(blockid, dbuf);
-  };
-  block_for(ec, tensor1e(), compute_ecp_ints_lambda);
-  delete[] buffer_;
-  delete[] buffer_sph_;
+      libint2::solidharmonics::tform(shells[s1].l, shells[s2].l, buffer_, buffer_sph_);
+
+      Eigen::Map<Matrix>(bufs[0].data(), n1, n2) = Eigen::Map<const Matrix>(buffer_sph_, n1, n2);
+      return true;
+    });
 } // END of compute_ecp_ints
 
+/// Point charges that are far from a shell pair enter through a multipole expansion of the
+/// pair's charge distribution about its most diffuse product center P:
+///   1/|r-C| ~ 1/R + R.u/R^3 + (3(R.u)^2 - R^2 u^2)/(2R^5),  u = r-P, R = C-P,
+/// with the overlap, dipole and quadrupole integrals about P from one emultipole2 call. A charge
+/// is far when it lies outside the extent of the distribution and the first neglected
+/// (octupole) term, |q| r_ext^3/R^4, is below \c tol; all others are computed exactly.
 template<typename TensorType>
 void exachem::scf::SCFGuess::compute_pchg_ints(
   ExecutionContext& ec, const SCFVars& scf_vars, Tensor<TensorType>& tensor1e,
   std::vector<std::pair<double, std::array<double, 3>>>& q, libint2::BasisSet& shells,
-  libint2::Operator otype) {
-  using libint2::Atom;
-  using libint2::BasisSet;
+  libint2::Operator otype, double tol) {
   using libint2::Engine;
   using libint2::Operator;
-  using libint2::Shell;
-
-  const std::vector<Tile>&   AO_tiles       = scf_vars.AO_tiles;
-  const std::vector<size_t>& shell_tile_map = scf_vars.shell_tile_map;
-
-  Engine engine(otype, max_nprim(shells), max_l(shells), 0);
-
-  // engine.set(otype);
-  engine.set_params(q);
-
-  auto& buf = (engine.results());
 
-  auto compute_pchg_ints_lambda = [&](const IndexVector& blockid) {
-    auto bi0 = blockid[0];
-    auto bi1 = blockid[1];
+  using PointCharges = std::vector<std::pair<double, std::array<double, 3>>>;
 
-    const TAMM_SIZE         size       = tensor1e.block_size(blockid);
-    auto                    block_dims = tensor1e.block_dims(blockid);
-    std::vector<TensorType> dbuf(size);
+  const bool do_multipole = (otype == Operator::nuclear && tol > 0.0);
+  const int  nthreads     = onebody_nthreads();
 
-    auto bd1 = block_dims[1];
-
-    // auto s1 = blockid[0];
-    auto                  s1range_end   = shell_tile_map[bi0];
-    decltype(s1range_end) s1range_start = 0l;
-    if(bi0 > 0) s1range_start = shell_tile_map[bi0 - 1] + 1;
-
-    // cout << "s1-start,end = " << s1range_start << ", " << s1range_end << endl;
-    for(auto s1 = s1range_start; s1 <= s1range_end; ++s1) {
-      // auto bf1 = shell2bf[s1]; //shell2bf[s1]; // first basis function in
-      // this shell
-      auto n1 = shells[s1].size();
-
-      auto                  s2range_end   = shell_tile_map[bi1];
-      decltype(s2range_end) s2range_start = 0l;
-      if(bi1 > 0) s2range_start = shell_tile_map[bi1 - 1] + 1;
-
-      // cout << "s2-start,end = " << s2range_start << ", " << s2range_end << endl;
-
-      // cout << "screend shell pair list = " << s2spl << endl;
-      for(auto s2 = s2range_start; s2 <= s2range_end; ++s2) {
-        // for (auto s2: scf_vars.obs_shellpair_list.at(s1)) {
-        // auto s2 = blockid[1];
-        // if (s2>s1) continue;
+  // per thread: all charges, near charges of the current pair, multipoles about P
+  std::vector<Engine>              engines(nthreads), near_engines(nthreads), mp_engines(nthreads);
+  std::vector<PointCharges>        near_q(nthreads);
+  std::vector<std::vector<size_t>> far_q(nthreads);
+  engines[0] = Engine(otype, max_nprim(shells), max_l(shells), 0);
+  engines[0].set_params(q);
+  if(do_multipole) {
+    near_engines[0] = Engine(otype, max_nprim(shells), max_l(shells), 0);
+    mp_engines[0]   = Engine(Operator::emultipole2, max_nprim(shells), max_l(shells), 0);
+  }
+  for(int i = 1; i < nthreads; i++) {
+    engines[i] = engines[0];
+    if(!do_multipole) continue;
+    near_engines[i] = near_engines[0];
+    mp_engines[i]   = mp_engines[0];
+  }
 
-        if(s2 > s1) {
-          auto s2spl = scf_vars.obs_shellpair_list.at(s2);
-          if(std::find(s2spl.begin(), s2spl.end(), s1) == s2spl.end()) continue;
+  size_t nfar_total = 0;
+  compute_symmetric_1body<TensorType>(
+    ec, scf_vars, {&tensor1e},
+    [&](int thread, size_t s1, size_t s2, std::vector<std::vector<TensorType>>& bufs) {
+      const auto n1 = shells[s1].size();
+      const auto n2 = shells[s2].size();
+
+      auto& far = far_q[thread];
+      auto& nrq = near_q[thread];
+      far.clear();
+      nrq.clear();
+
+      std::array<double, 3> P{};
+      if(do_multipole) {
+        const auto&  A   = shells[s1].O;
+        const auto&  B   = shells[s2].O;
+        const double a1  = *std::min_element(shells[s1].alpha.begin(), shells[s1].alpha.end());
+        const double a2  = *std::min_element(shells[s2].alpha.begin(), shells[s2].alpha.end());
+        double       AB2 = 0.0;
+        for(int x = 0; x < 3; x++) {
+          P[x] = (a1 * A[x] + a2 * B[x]) / (a1 + a2);
+          AB2 += (A[x] - B[x]) * (A[x] - B[x]);
         }
-        else {
-          auto s2spl = scf_vars.obs_shellpair_list.at(s1);
-          if(std::find(s2spl.begin(), s2spl.end(), s2) == s2spl.end()) continue;
+        // the tighter product centers all lie on the segment AB
+        const double r_ext  = std::sqrt(-std::log(tol) / (a1 + a2)) + std::sqrt(AB2);
+        const double r_ext3 = r_ext * r_ext * r_ext;
+        for(size_t c = 0; c < q.size(); c++) {
+          const auto& C  = q[c].second;
+          double      R2 = 0.0;
+          for(int x = 0; x < 3; x++) R2 += (C[x] - P[x]) * (C[x] - P[x]);
+          if(R2 > r_ext * r_ext && R2 * R2 * tol > std::abs(q[c].first) * r_ext3) far.push_back(c);
+          else nrq.push_back(q[c]);
         }
+      }
 
-        // auto bf2 = shell2bf[s2];
-        auto n2 = shells[s2].size();
-
-        std::vector<TensorType> tbuf(n1 * n2);
-        // cout << "s1,s2,n1,n2 = "  << s1 << "," << s2 <<
-        //       "," << n1 <<"," << n2 <<endl;
-
-        // compute shell pair; return is the pointer to the buffer
-        engine.compute(shells[s1], shells[s2]);
-        if(buf[0] == nullptr) continue;
-        // "map" buffer to a const Eigen Matrix, and copy it to the
-        // corresponding blocks of the result
-        Eigen::Map<const Matrix> buf_mat(buf[0], n1, n2);
-        Eigen::Map<Matrix>(&tbuf[0], n1, n2) = buf_mat;
-        // tensor1e.put(blockid, tbuf);
-
-        auto curshelloffset_i = 0U;
-        auto curshelloffset_j = 0U;
-        for(auto x = s1range_start; x < s1; x++) curshelloffset_i += AO_tiles[x];
-        for(auto x = s2range_start; x < s2; x++) curshelloffset_j += AO_tiles[x];
-
-        size_t c    = 0;
-        auto   dimi = curshelloffset_i + AO_tiles[s1];
-        auto   dimj = curshelloffset_j + AO_tiles[s2];
-
-        // cout << "curshelloffset_i,curshelloffset_j,dimi,dimj = "  << curshelloffset_i << "," <<
-        // curshelloffset_j <<
-        //       "," << dimi <<"," << dimj <<endl;
-
-        for(size_t i = curshelloffset_i; i < dimi; i++) {
-          for(size_t j = curshelloffset_j; j < dimj; j++, c++) { dbuf[i * bd1 + j] = tbuf[c]; }
-        }
+      auto buf_mat = Eigen::Map<Matrix>(bufs[0].data(), n1, n2);
+      if(far.empty()) {
+        const auto& buf = engines[thread].compute(shells[s1], shells[s2]);
+        if(buf[0] == nullptr) return false;
+        buf_mat = Eigen::Map<const Matrix>(buf[0], n1, n2);
+        return true;
+      }
 
-        // if(s1!=s2){
-        //     std::vector<TensorType> ttbuf(n1*n2);
-        //     Eigen::Map<Matrix>(ttbuf.data(),n2,n1) = buf_mat.transpose();
-        //     // Matrix buf_mat_trans = buf_mat.transpose();
-        //     size_t c = 0;
-        //     for(size_t j = curshelloffset_j; j < dimj; j++) {
-        //       for(size_t i = curshelloffset_i; i < dimi; i++, c++) {
-        //             dbuf[j*block_dims[0]+i] = ttbuf[c];
-        //       }
-        //     }
-        // }
-        // tensor1e.put({s2,s1}, ttbuf);
+#pragma omp atomic
+      nfar_total += far.size();
+
+      buf_mat.setZero();
+      if(!nrq.empty()) {
+        near_engines[thread].set_params(nrq);
+        const auto& buf = near_engines[thread].compute(shells[s1], shells[s2]);
+        if(buf[0] != nullptr) buf_mat = Eigen::Map<const Matrix>(buf[0], n1, n2);
+      }
+
+      // expansion coefficients summed over the far charges, in the emultipole2 order
+      // S, x, y, z, xx, xy, xz, yy, yz, zz
+      std::array<double, 10> cf{};
+      for(const auto c: far) {
+        const double qc = q[c].first;
+        double       R[3];
+        for(int x = 0; x < 3; x++) R[x] = q[c].second[x] - P[x];
+        const double R2  = R[0] * R[0] + R[1] * R[1] + R[2] * R[2];
+        const double iR  = 1.0 / std::sqrt(R2);
+        const double iR3 = iR * iR * iR;
+        const double iR5 = iR3 * iR * iR;
+        cf[0] += qc * iR;
+        for(int x = 0; x < 3; x++) cf[1 + x] += qc * R[x] * iR3;
+        cf[4] += qc * (3.0 * R[0] * R[0] - R2) * 0.5 * iR5;
+        cf[5] += qc * 3.0 * R[0] * R[1] * iR5;
+        cf[6] += qc * 3.0 * R[0] * R[2] * iR5;
+        cf[7] += qc * (3.0 * R[1] * R[1] - R2) * 0.5 * iR5;
+        cf[8] += qc * 3.0 * R[1] * R[2] * iR5;
+        cf[9] += qc * (3.0 * R[2] * R[2] - R2) * 0.5 * iR5;
       }
-    }
-    tensor1e.put(blockid, dbuf);
-  };
 
-  block_for(ec, tensor1e(), compute_pchg_ints_lambda);
+      mp_engines[thread].set_params(P);
+      const auto& mp_buf = mp_engines[thread].compute(shells[s1], shells[s2]);
+      if(mp_buf[0] == nullptr) return !nrq.empty();
+      for(size_t k = 0; k < cf.size(); k++)
+        buf_mat -= cf[k] * Eigen::Map<const Matrix>(mp_buf[k], n1, n2);
+      return true;
+    });
+
+  size_t nfar_sum = 0;
+  ec.pg().allreduce(&nfar_total, &nfar_sum, 1, ReduceOp::sum);
+  if(ec.pg().rank() == 0 && nfar_sum > 0)
+    std::cout << "# of point charge/shell-pair interactions by multipole expansion = " << nfar_sum
+              << std::endl;
 }
 
 template<typename TensorType>
@@ -1143,18 +1011,22 @@ void exachem::scf::SCFGuess::compute_sad_guess(ExecutionContext& ec, ChemEnv& ch
       ecps.push_back(newecp);
     }
 
+    // the one-electron integrals are screened with the shell pairs of the atom
+    std::swap(scf_vars.obs_shellpair_list, scf_vars.obs_shellpair_list_atom);
     compute_1body_ints(ec, scf_vars, S_atom, atom, shells_atom, Operator::overlap);
     compute_1body_ints(ec, scf_vars, T_atom, atom, shells_atom, Operator::kinetic);
     if(has_ecp) atom[0].atomic_number -= k.ecp_nelec;
     compute_1body_ints(ec, scf_vars, V_atom, atom, shells_atom, Operator::nuclear);
 
     if(custom_opts && do_charges) {
-      compute_pchg_ints(ec, scf_vars, Q_atom, q, shells_atom, Operator::nuclear);
+      compute_pchg_ints(ec, scf_vars, Q_atom, q, shells_atom, Operator::nuclear,
+                        scf_options.tol_sch);
     }
     else { Scheduler{ec}(Q_atom() = 0.0).execute(); }
 
     if(has_ecp) { compute_ecp_ints<TensorType>(ec, scf_vars, E_atom, libecp_shells, ecps); }
     else { Scheduler{ec}(E_atom() = 0.0).execute(); }
+    std::swap(scf_vars.obs_shellpair_list, scf_vars.obs_shellpair_list_atom);
 
     // if(rank == 0) cout << "compute one body ints" << endl;
 
@@ -1571,10 +1443,11 @@ void exachem::scf::SCFGuess::compute_sad_guess(ExecutionContext& ec, ChemEnv& ch
   }
 
   // needed only for 4c HF
-  if(rank != 0 && (!scf_vars.do_dens_fit || scf_vars.direct_df || chem_env.sys_data.is_ks ||
-                   chem_env.sys_data.do_snK)) {
-    tamm_to_eigen_tensor(ttensors.D_alpha, etensors.D_alpha);
-    if(is_uhf) { tamm_to_eigen_tensor(ttensors.D_beta, etensors.D_beta); }
+  if((rank != 0 || etensors.D_alpha_shm.allocated()) &&
+     (!scf_vars.do_dens_fit || scf_vars.direct_df || chem_env.sys_data.is_ks ||
+      chem_env.sys_data.do_snK)) {
+    tamm_to_eigen_density(ttensors.D_alpha, etensors.D_alpha, etensors.D_alpha_shm);
+    if(is_uhf) { tamm_to_eigen_density(ttensors.D_beta, etensors.D_beta, etensors.D_beta_shm); }
   }
 
   ec.pg().barrier();
@@ -1629,7 +1502,7 @@ template void exachem::scf::SCFGuess::compute_1body_ints<double>(
 template void exachem::scf::SCFGuess::compute_pchg_ints<double>(
   ExecutionContext& ec, const SCFVars& scf_vars, Tensor<TensorType>& tensor1e,
   std::vector<std::pair<double, std::array<double, 3>>>& q, libint2::BasisSet& shells,
-  libint2::Operator otype);
+  libint2::Operator otype, double tol);
 
 template void exachem::scf::SCFGuess::compute_ecp_ints(
   ExecutionContext& ec, const SCFVars& scf_vars, Tensor<TensorType>& tensor1e,
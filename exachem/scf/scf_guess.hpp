@@ -70,7 +70,7 @@ public:
   void compute_pchg_ints(ExecutionContext& ec, const SCFVars& scf_vars,
                          Tensor<TensorType>&                                    tensor1e,
                          std::vector<std::pair<double, std::array<double, 3>>>& q,
-                         libint2::BasisSet& shells, libint2::Operator otype);
+                         libint2::BasisSet& shells, libint2::Operator otype, double tol);
   template<typename TensorType>
   void scf_diagonalize(Scheduler& sch, ChemEnv& chem_env, SCFVars& scf_vars,
                        ScalapackInfo& scalapack_info, TAMMTensors& ttensors,
@@ -229,6 +229,7 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
   if(rank == 0)
     std::cout << std::fixed << std::setprecision(2) << std::endl
               << "Time for initial setup: " << hf_time << " secs" << endl;
+  chem_env.telemetry.record(exc.pg(), "SCF", "setup", hf_time);
 
   double ehf = 0.0; // initialize Hartree-Fock energy
 
@@ -281,6 +282,10 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
 
     chem_env.sys_data.results["output"]["SCF"]["xHF"] = xHF;
 
+    if(chem_env.ioptions.scf_options.gradient && chem_env.sys_data.is_ks &&
+       chem_env.sys_data.is_unrestricted)
+      tamm_terminate("[SCF] gradients are not available for unrestricted Kohn-Sham");
+
     // Compute SPH<->CART transformation
     scf_compute.compute_trafo(chem_env.shells, etensors);
 
@@ -293,6 +298,19 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
       scf_vars.direct_df = false;
     }
 
+    if(chem_env.ioptions.scf_options.cfmm && !do_density_fitting) {
+      if(xHF != 0.0 && !chem_env.sys_data.do_snK) {
+        if(rank == 0) {
+          cout << "[Warning] CFMM cannot be used with exact exchange in the 4-center Fock build"
+               << endl;
+          cout << "Falling back to the exact Coulomb matrix" << endl;
+        }
+      }
+      else
+        scf_iter.init_cfmm(chem_env.shells, scf_vars, chem_env.ioptions.scf_options.cfmm_order,
+                           fock_precision);
+    }
+
     // SETUP LibECPint
     std::vector<libecpint::ECP>           ecps;
     std::vector<libecpint::GaussianShell> libecp_shells;
@@ -422,11 +440,24 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
     if(!do_density_fitting || scf_vars.direct_df || chem_env.sys_data.is_ks ||
        chem_env.sys_data.do_snK) {
       // needed for 4c HF, direct_df, KS, or snK
-      etensors.D_alpha = Matrix::Zero(N, N);
-      etensors.G_alpha = Matrix::Zero(N, N);
-      if(chem_env.sys_data.is_unrestricted) {
-        etensors.D_beta = Matrix::Zero(N, N);
-        etensors.G_beta = Matrix::Zero(N, N);
+      const bool node_shared = chem_env.ioptions.scf_options.node_shared && !do_density_fitting &&
+                               !chem_env.sys_data.is_ks && !chem_env.sys_data.do_snK;
+      if(node_shared) {
+        // only the guess still works on rank-private D and G, on rank 0
+        etensors.D_alpha_shm.allocate(ec.pg().comm(), N, N);
+        etensors.G_alpha_shm.allocate(ec.pg().comm(), N, N);
+        if(chem_env.sys_data.is_unrestricted) {
+          etensors.D_beta_shm.allocate(ec.pg().comm(), N, N);
+          etensors.G_beta_shm.allocate(ec.pg().comm(), N, N);
+        }
+      }
+      if(!node_shared || rank == 0) {
+        etensors.D_alpha = Matrix::Zero(N, N);
+        etensors.G_alpha = Matrix::Zero(N, N);
+        if(chem_env.sys_data.is_unrestricted) {
+          etensors.D_beta = Matrix::Zero(N, N);
+          etensors.G_beta = Matrix::Zero(N, N);
+        }
       }
     }
 
@@ -435,17 +466,16 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
     std::string schwarz_matfile = files_prefix + ".schwarz";
     Matrix      SchwarzK;
 
-    if(!do_density_fitting || scf_vars.direct_df) {
-      if(N >= chem_env.ioptions.scf_options.restart_size && fs::exists(schwarz_matfile)) {
-        if(rank == 0) cout << "Read Schwarz matrix from disk ... " << endl;
+    // also needed with conventional density fitting to screen the 3-center integrals
+    if(N >= chem_env.ioptions.scf_options.restart_size && fs::exists(schwarz_matfile)) {
+      if(rank == 0) cout << "Read Schwarz matrix from disk ... " << endl;
 
-        SchwarzK = scf_output.read_scf_mat<TensorType>(schwarz_matfile);
-      }
-      else {
-        // if(rank == 0) cout << "pre-computing data for Schwarz bounds... " << endl;
-        SchwarzK = scf_compute.compute_schwarz_ints<>(ec, scf_vars, chem_env.shells);
-        if(rank == 0) scf_output.write_scf_mat<TensorType>(SchwarzK, schwarz_matfile);
-      }
+      SchwarzK = scf_output.read_scf_mat<TensorType>(schwarz_matfile);
+    }
+    else {
+      // if(rank == 0) cout << "pre-computing data for Schwarz bounds... " << endl;
+      SchwarzK = scf_compute.compute_schwarz_ints<>(ec, scf_vars, chem_env.shells);
+      if(rank == 0) scf_output.write_scf_mat<TensorType>(SchwarzK, schwarz_matfile);
     }
     hf_t1 = std::chrono::high_resolution_clock::now();
 
@@ -509,7 +539,8 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
       ttensors.Vm1 = Tensor<TensorType>{scf_vars.tdfAO, scf_vars.tdfAO}; // ndf, ndf
       if(!scf_vars.direct_df) Tensor<TensorType>::allocate(&ec, ttensors.xyK);
 
-      scf_iter.init_ri<TensorType>(ec, chem_env, scalapack_info, scf_vars, etensors, ttensors);
+      scf_iter.init_ri<TensorType>(ec, chem_env, scalapack_info, scf_vars, SchwarzK, etensors,
+                                   ttensors);
     }
     const auto do_schwarz_screen = SchwarzK.cols() != 0 && SchwarzK.rows() != 0;
     // engine precision controls primitive truncation, assume worst-case scenario
@@ -523,9 +554,9 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
       scf_restart(ec, chem_env, scalapack_info, ttensors, etensors, files_prefix);
       if(!do_density_fitting || scf_vars.direct_df || chem_env.sys_data.is_ks ||
          chem_env.sys_data.do_snK) {
-        tamm_to_eigen_tensor(ttensors.D_alpha, etensors.D_alpha);
+        tamm_to_eigen_density(ttensors.D_alpha, etensors.D_alpha, etensors.D_alpha_shm);
         if(chem_env.sys_data.is_unrestricted) {
-          tamm_to_eigen_tensor(ttensors.D_beta, etensors.D_beta);
+          tamm_to_eigen_density(ttensors.D_beta, etensors.D_beta, etensors.D_beta_shm);
         }
       }
       ec.pg().barrier();
@@ -566,6 +597,7 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
     if(rank == 0 && !chem_env.ioptions.scf_options.noscf && !chem_env.ioptions.scf_options.restart)
       std::cout << std::fixed << std::setprecision(2)
                 << "Total Time to compute initial guess: " << hf_time << " secs" << endl;
+    chem_env.telemetry.record(ec.pg(), "SCF", "initial_guess", hf_time);
 
     /*** =========================== ***/
     /*** main iterative loop         ***/
@@ -577,14 +609,13 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
        N < chem_env.ioptions.scf_options.restart_size) {
       Matrix S(chem_env.sys_data.nbf_orig, chem_env.sys_data.nbf_orig);
       tamm_to_eigen_tensor(ttensors.S1, S);
+      const auto D_a = density_view(etensors.D_alpha, etensors.D_alpha_shm);
+      const auto D_b = density_view(etensors.D_beta, etensors.D_beta_shm);
       if(chem_env.sys_data.is_restricted)
-        cout << "debug #electrons       = " << (int) std::ceil((etensors.D_alpha * S).trace())
-             << endl;
+        cout << "debug #electrons       = " << (int) std::ceil((D_a * S).trace()) << endl;
       if(chem_env.sys_data.is_unrestricted) {
-        cout << "debug #alpha electrons = " << (int) std::ceil((etensors.D_alpha * S).trace())
-             << endl;
-        cout << "debug #beta  electrons = " << (int) std::ceil((etensors.D_beta * S).trace())
-             << endl;
+        cout << "debug #alpha electrons = " << (int) std::ceil((D_a * S).trace()) << endl;
+        cout << "debug #beta  electrons = " << (int) std::ceil((D_b * S).trace()) << endl;
       }
     }
     if(rank == 0 && !no_scf) {
@@ -768,6 +799,7 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
       scf_iter.compute_2bf<TensorType>(ec, chem_env, scalapack_info, scf_vars, do_schwarz_screen,
                                        shell2bf, SchwarzK, max_nprim4, ttensors, etensors,
                                        is_3c_init, do_density_fitting, xHF);
+      const auto fock_stop = std::chrono::high_resolution_clock::now();
 
       std::tie(ehf, rmsd) = scf_iter.scf_iter_body<TensorType>(ec, chem_env, scalapack_info, iter,
                                                                scf_vars, ttensors, etensors
@@ -828,6 +860,19 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
           {"energy", ehf}, {"e_diff", ediff}, {"rmsd", rmsd}, {"ediis", ediis}};
         chem_env.sys_data.results["output"]["SCF"]["iter"][std::to_string(iter)]["performance"] = {
           {"total_time", loop_time}};
+
+        // fock: two-electron part of the Fock build, diag: everything after it (xc, fock
+        // matrix update, DIIS, diagonalization and new density)
+        const auto fock_time =
+          std::chrono::duration_cast<std::chrono::duration<double>>((fock_stop - loop_start))
+            .count();
+        chem_env.telemetry.record("SCF", "iteration",
+                                  {{"iter", iter},
+                                   {"wall_time", loop_time},
+                                   {"fock_time", fock_time},
+                                   {"diag_time", loop_time - fock_time},
+                                   {"energy", ehf},
+                                   {"rmsd", rmsd}});
       }
 
       // if(rank==0) cout << "D at the end of iteration: " << endl << std::setprecision(6) <<
@@ -861,6 +906,18 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
       }
     }
 
+    // the post-SCF analysis works on rank-private densities
+    if(etensors.D_alpha_shm.allocated()) {
+      etensors.D_alpha = density_view(etensors.D_alpha, etensors.D_alpha_shm);
+      etensors.D_alpha_shm.deallocate();
+      etensors.G_alpha_shm.deallocate();
+      if(is_uhf) {
+        etensors.D_beta = density_view(etensors.D_beta, etensors.D_beta_shm);
+        etensors.D_beta_shm.deallocate();
+        etensors.G_beta_shm.deallocate();
+      }
+    }
+
     auto dplot_opt = chem_env.ioptions.dplot_options;
     if(dplot_opt.cube) {
       // if(dplot_opt.density == "spin") // TODO
@@ -908,6 +965,25 @@ void exachem::scf::SCFHartreeFock::scf_hf(ExecutionContext& exc, ChemEnv& chem_e
       }
     }
 
+    if(chem_env.ioptions.scf_options.gradient && is_conv) {
+      SCFGradient scf_gradient;
+      Matrix      grad =
+        scf_gradient.compute_gradient<TensorType>(ec, chem_env, scf_vars, ttensors, etensors,
+                                                  libecp_shells, ecps, SchwarzK, xHF
+#if defined(USE_GAUXC)
+                                                  ,
+                                                  gauxc_integrator
+#endif
+        );
+      if(rank == 0) {
+        scf_gradient.print_gradient(chem_env, grad);
+        std::vector<std::vector<double>> jgrad;
+        for(Eigen::Index i = 0; i < grad.rows(); i++)
+          jgrad.push_back({grad(i, 0), grad(i, 1), grad(i, 2)});
+        chem_env.sys_data.results["output"]["SCF"]["gradient"] = jgrad;
+      }
+    }
+
     if(chem_env.sys_data.is_ks) { // or rohf
       sch(ttensors.F_alpha_tmp() = 0).execute();
       if(chem_env.sys_data.is_unrestricted) sch(ttensors.F_beta_tmp() = 0).execute();
@@ -12,6 +12,7 @@
 #include "common/ec_molden.hpp"
 #include "common/system_data.hpp"
 #include "scf_compute.hpp"
+#include "scf_gradient.hpp"
 #include "scf_iter.hpp"
 #include "scf_outputs.hpp"
 #include "scf_restart.hpp"
@@ -235,15 +235,15 @@ std::tuple<TensorType, TensorType> exachem::scf::SCFIter::scf_iter_body(
     if(is_rhf) {
       tamm::scale_ip(D_alpha_tamm(), alpha);
       sch(D_alpha_tamm() += (1.0 - alpha) * D_last_alpha_tamm()).execute();
-      tamm_to_eigen_tensor(D_alpha_tamm, D_alpha);
+      tamm_to_eigen_density(D_alpha_tamm, D_alpha, etensors.D_alpha_shm);
     }
     if(is_uhf) {
       tamm::scale_ip(D_alpha_tamm(), alpha);
       sch(D_alpha_tamm() += (1.0 - alpha) * D_last_alpha_tamm()).execute();
-      tamm_to_eigen_tensor(D_alpha_tamm, D_alpha);
+      tamm_to_eigen_density(D_alpha_tamm, D_alpha, etensors.D_alpha_shm);
       tamm::scale_ip(D_beta_tamm(), alpha);
       sch(D_beta_tamm() += (1.0 - alpha) * D_last_beta_tamm()).execute();
-      tamm_to_eigen_tensor(D_beta_tamm, D_beta);
+      tamm_to_eigen_density(D_beta_tamm, D_beta, etensors.D_beta_shm);
     }
   }
 
@@ -258,8 +258,8 @@ exachem::scf::SCFIter::compute_2bf_taskinfo(ExecutionContext& ec, ChemEnv& chem_
                                             const Matrix& SchwarzK, const size_t& max_nprim4,
                                             TAMMTensors& ttensors, EigenTensors& etensors,
                                             const bool cs1s2) {
-  Matrix&             D       = etensors.D_alpha;
-  Matrix&             D_beta  = etensors.D_beta;
+  const auto          D       = density_view(etensors.D_alpha, etensors.D_alpha_shm);
+  const auto          D_beta  = density_view(etensors.D_beta, etensors.D_beta_shm);
   Tensor<TensorType>& F_dummy = ttensors.F_dummy;
 
   SystemData&              sys_data    = chem_env.sys_data;
@@ -336,7 +336,9 @@ exachem::scf::SCFIter::compute_2bf_taskinfo(ExecutionContext& ec, ChemEnv& chem_
 
 template<typename TensorType>
 void exachem::scf::SCFIter::compute_3c_ints(ExecutionContext& ec, ChemEnv& chem_env,
-                                            const SCFVars& scf_vars, Tensor<TensorType>& xyZ) {
+                                            const SCFVars& scf_vars, const Matrix& SchwarzK,
+                                            const Eigen::VectorXd& dfNorm,
+                                            Tensor<TensorType>& xyZ) {
   using libint2::BraKet;
   using libint2::Engine;
   using libint2::Operator;
@@ -346,16 +348,15 @@ void exachem::scf::SCFIter::compute_3c_ints(ExecutionContext& ec, ChemEnv& chem_
 
   auto                       rank           = ec.pg().rank();
   auto                       debug          = scf_options.debug;
-  const std::vector<Tile>&   AO_tiles       = scf_vars.AO_tiles;
   const std::vector<size_t>& shell_tile_map = scf_vars.shell_tile_map;
 
   const libint2::BasisSet&   dfbs              = scf_vars.dfbs;
-  const std::vector<Tile>&   dfAO_tiles        = scf_vars.dfAO_tiles;
   const std::vector<size_t>& df_shell_tile_map = scf_vars.df_shell_tile_map;
 
   Scheduler sch{ec};
 
   double      engine_precision = scf_options.tol_int; // default: 1e-22
+  double      screen_precision = scf_options.tol_sch; // default: 1e-10
   const auto& unitshell        = libint2::Shell::unit();
   auto        engine           = libint2::Engine(libint2::Operator::coulomb,
                                                  std::max(obs.max_nprim(), dfbs.max_nprim()),
@@ -367,75 +368,110 @@ void exachem::scf::SCFIter::compute_3c_ints(ExecutionContext& ec, ChemEnv& chem_
   auto        shell2bf_df = dfbs.shell2bf();
   const auto& results     = engine.results();
 
+  // xyZ keeps the dense (m,n,P) layout contracted by init_ri and compute_2bf_ri, the screening
+  // and the symmetry save integral time, not storage. Blocks that are screened out entirely are
+  // not written.
+  sch(xyZ() = 0.0).execute();
+
+  size_t ntriples = 0, ntriples_computed = 0;
+
+  // (P|mn) = (P|nm): only the blocks with bi1 <= bi0 are computed, the (bi1, bi0) block is
+  // written as the transpose. Within a block only the significant shell pairs s2 <= s1 of
+  // obs_shellpair_list are visited, and the triples are screened with the bound
+  // |(P|mn)| <= sqrt((P|P)) * sqrt((mn|mn)) = dfNorm(P) * SchwarzK(m, n).
   auto compute_2body_fock_dfC_lambda = [&](const IndexVector& blockid) {
     auto bi0 = blockid[0];
     auto bi1 = blockid[1];
     auto bi2 = blockid[2];
+    if(bi1 > bi0) return;
 
     const TAMM_SIZE         size       = xyZ.block_size(blockid);
     auto                    block_dims = xyZ.block_dims(blockid);
     std::vector<TensorType> dbuf(size);
 
+    auto bd0 = block_dims[0];
     auto bd1 = block_dims[1];
     auto bd2 = block_dims[2];
 
-    auto s0range_end = df_shell_tile_map[bi2];
-    // auto n0 = dfbs[s0].size();
-    auto                  s1range_end   = shell_tile_map[bi0];
-    decltype(s1range_end) s1range_start = 0l;
+    size_t s1range_start = 0, s2range_start = 0, s0range_start = 0;
     if(bi0 > 0) s1range_start = shell_tile_map[bi0 - 1] + 1;
+    if(bi1 > 0) s2range_start = shell_tile_map[bi1 - 1] + 1;
+    if(bi2 > 0) s0range_start = df_shell_tile_map[bi2 - 1] + 1;
+    const auto s1range_end = shell_tile_map[bi0];
+    const auto s2range_end = shell_tile_map[bi1];
+    const auto s0range_end = df_shell_tile_map[bi2];
+
+    const double dfnorm_max =
+      dfNorm.segment(s0range_start, s0range_end - s0range_start + 1).maxCoeff();
 
-    tamm::Tile curshelloffset_i = 0U;
+    bool is_zero = true;
     for(auto s1 = s1range_start; s1 <= s1range_end; ++s1) {
-      // auto n1 = shells[s1].size();
-      auto                  dimi          = curshelloffset_i + AO_tiles[s1];
-      auto                  s2range_end   = shell_tile_map[bi1];
-      decltype(s2range_end) s2range_start = 0l;
+      const auto  offset_i  = shell2bf[s1] - shell2bf[s1range_start];
+      const auto  n1        = obs[s1].size();
+      const auto& s2spl     = scf_vars.obs_shellpair_list.at(s1);
+      auto        sp12_iter = scf_vars.obs_shellpair_data.at(s1).begin();
 
-      if(bi1 > 0) s2range_start = shell_tile_map[bi1 - 1] + 1;
+      for(auto s2: s2spl) {
+        const auto* sp12 = (sp12_iter++)->get();
+        if(s2 < s2range_start || s2 > s2range_end) continue;
+
+        const auto offset_j = shell2bf[s2] - shell2bf[s2range_start];
+        const auto n2       = obs[s2].size();
+        const auto norm12   = SchwarzK(s1, s2);
+        ntriples += s0range_end - s0range_start + 1;
+        if(norm12 * dfnorm_max < screen_precision) continue;
 
-      tamm::Tile curshelloffset_j = 0U;
-      for(auto s2 = s2range_start; s2 <= s2range_end; ++s2) {
-        //// if (s2>s1) continue;
-        // auto n2 = shells[s2].size();
-        // auto n123 = n0*n1*n2;
-        // std::vector<TensorType> tbuf(n123);
-        auto                  dimj          = curshelloffset_j + AO_tiles[s2];
-        decltype(s0range_end) s0range_start = 0l;
-        if(bi2 > 0) s0range_start = df_shell_tile_map[bi2 - 1] + 1;
-
-        tamm::Tile curshelloffset_k = 0U;
         for(auto s0 = s0range_start; s0 <= s0range_end; ++s0) {
+          if(norm12 * dfNorm(s0) < screen_precision) continue;
+          ntriples_computed++;
+
           engine.compute2<Operator::coulomb, BraKet::xs_xx, 0>(dfbs[s0], unitshell, obs[s1],
-                                                               obs[s2]);
+                                                               obs[s2], nullptr, sp12);
           const auto* buf = results[0];
           if(buf == nullptr) continue;
-          // std::copy(buf, buf + n123, tbuf.begin());
+          is_zero = false;
 
-          size_t c    = 0;
-          auto   dimk = curshelloffset_k + dfAO_tiles[s0];
+          const auto offset_k = shell2bf_df[s0] - shell2bf_df[s0range_start];
+          const auto n0       = dfbs[s0].size();
 
-          for(auto k = curshelloffset_k; k < dimk; k++)
-            for(auto i = curshelloffset_i; i < dimi; i++)
-              for(auto j = curshelloffset_j; j < dimj; j++, c++)
+          size_t c = 0;
+          for(size_t k = offset_k; k < offset_k + n0; k++)
+            for(size_t i = offset_i; i < offset_i + n1; i++)
+              for(size_t j = offset_j; j < offset_j + n2; j++, c++) {
                 dbuf[(i * bd1 + j) * bd2 + k] = buf[c];
+                if(bi0 == bi1) dbuf[(j * bd1 + i) * bd2 + k] = buf[c];
+              }
+        } // s0
+      }   // s2
+    }     // s1
 
-          curshelloffset_k += dfAO_tiles[s0];
-        } // s2
-        curshelloffset_j += AO_tiles[s2];
-      } // s1
-      curshelloffset_i += AO_tiles[s1];
-    } // s0
+    if(is_zero) return;
     xyZ.put(blockid, dbuf);
+
+    if(bi0 != bi1) {
+      std::vector<TensorType> tbuf(size);
+      for(size_t i = 0; i < bd0; i++)
+        for(size_t j = 0; j < bd1; j++)
+          std::copy_n(&dbuf[(i * bd1 + j) * bd2], bd2, &tbuf[(j * bd0 + i) * bd2]);
+      xyZ.put(IndexVector{bi1, bi0, bi2}, tbuf);
+    }
   };
 
   auto do_t1 = std::chrono::high_resolution_clock::now();
   block_for(ec, xyZ(), compute_2body_fock_dfC_lambda);
+  ec.pg().barrier();
 
   auto   do_t2 = std::chrono::high_resolution_clock::now();
   double do_time =
     std::chrono::duration_cast<std::chrono::duration<double>>((do_t2 - do_t1)).count();
-  if(rank == 0 && debug) std::cout << "2BF-DFC: " << do_time << "s, ";
+
+  if(debug) {
+    size_t nt[2] = {ntriples, ntriples_computed}, nt_sum[2];
+    ec.pg().allreduce(nt, nt_sum, 2, ReduceOp::sum);
+    if(rank == 0)
+      std::cout << "2BF-DFC: " << do_time << "s (" << nt_sum[1] << "/" << nt_sum[0]
+                << " shell triples), ";
+  }
 }
 
 template<typename TensorType>
@@ -545,7 +581,8 @@ void exachem::scf::SCFIter::compute_2c_ints(ExecutionContext& ec, ChemEnv& chem_
 template<typename TensorType>
 void exachem::scf::SCFIter::init_ri(ExecutionContext& ec, ChemEnv& chem_env,
                                     ScalapackInfo& scalapack_info, const SCFVars& scf_vars,
-                                    EigenTensors& etensors, TAMMTensors& ttensors) {
+                                    const Matrix& SchwarzK, EigenTensors& etensors,
+                                    TAMMTensors& ttensors) {
   SystemData& sys_data    = chem_env.sys_data;
   SCFOptions& scf_options = chem_env.ioptions.scf_options;
 
@@ -697,7 +734,7 @@ void exachem::scf::SCFIter::init_ri(ExecutionContext& ec, ChemEnv& chem_env,
   if(!direct) {
     // Compute 3c ints
     Tensor<TensorType>::allocate(&ec, xyZ);
-    compute_3c_ints<TensorType>(ec, chem_env, scf_vars, xyZ);
+    compute_3c_ints<TensorType>(ec, chem_env, scf_vars, SchwarzK, etensors.dfNorm, xyZ);
 
     // Orthonormalize DF basis
     sch(xyK(mu, nu, d_nu) = xyZ(mu, nu, d_mu) * Vm1(d_mu, d_nu))
@@ -1037,11 +1074,17 @@ void exachem::scf::SCFIter::compute_2bf(ExecutionContext& ec, ChemEnv& chem_env,
   const bool do_snK       = sys_data.do_snK;
   const bool doK          = xHF != 0.0 && !do_snK;
   const bool is_spherical = (scf_options.gaussian_type == "spherical");
-
-  Matrix& G      = etensors.G_alpha;
-  Matrix& D      = etensors.D_alpha;
-  Matrix& G_beta = etensors.G_beta;
-  Matrix& D_beta = etensors.D_beta;
+  // the far-field quartets would still be needed for exact exchange, see init_cfmm
+  const bool do_cfmm = cfmm_ && !do_density_fitting && !doK;
+
+  Matrix&    G      = etensors.G_alpha;
+  const auto D      = density_view(etensors.D_alpha, etensors.D_alpha_shm);
+  Matrix&    G_beta = etensors.G_beta;
+  const auto D_beta = density_view(etensors.D_beta, etensors.D_beta_shm);
+  // with scf.node_shared the ranks of a node accumulate into one G per node
+  NodeSharedMatrix& G_shm      = etensors.G_alpha_shm;
+  NodeSharedMatrix& G_beta_shm = etensors.G_beta_shm;
+  const bool        shared_G   = G_shm.allocated();
 
   Tensor<TensorType>& F_dummy     = ttensors.F_dummy;
   Tensor<TensorType>& F_alpha_tmp = ttensors.F_alpha_tmp;
@@ -1071,9 +1114,16 @@ void exachem::scf::SCFIter::compute_2bf(ExecutionContext& ec, ChemEnv& chem_env,
   // To avoid skipping over the whole Fock matrix
   Matrix J12(shblk, shblk), J34(shblk, shblk);
   Matrix D12(shblk, shblk), D34(shblk, shblk);
+  Matrix G34(shblk, shblk);
   Matrix K1_alpha(shblk, N), K1_beta(shblk, N);
   Matrix K2_alpha(shblk, N), K2_beta(shblk, N);
 
+  auto add_to_G = [&](Matrix& Gm, NodeSharedMatrix& shm, size_t row, size_t col, size_t nrow,
+                      size_t ncol, const Matrix& blk) {
+    if(shared_G) shm.atomic_add_block(row, col, blk.block(0, 0, nrow, ncol));
+    else Gm.block(row, col, nrow, ncol) += blk.block(0, 0, nrow, ncol);
+  };
+
   auto comp_2bf_lambda = [&](IndexVector blockid) {
     auto s1        = blockid[0];
     auto bf1_first = shell2bf[s1];
@@ -1092,6 +1142,7 @@ void exachem::scf::SCFIter::compute_2bf(ExecutionContext& ec, ChemEnv& chem_env,
     const auto* sp12 = sp12_iter->get();
 
     const auto Dnorm12 = do_schwarz_screen ? 2 * D_shblk_norm(s1, s2) : 0.;
+    const int  leaf12  = do_cfmm ? cfmm_->leaf(s1, s2_pos) : -1;
 
     // To avoid skipping over the whole Fock matrix
     J12.setZero();
@@ -1109,179 +1160,187 @@ void exachem::scf::SCFIter::compute_2bf(ExecutionContext& ec, ChemEnv& chem_env,
     D12.block(0, 0, n1, n2) = D.block(bf1_first, bf2_first, n1, n2);
     if(is_uhf) D12.block(0, 0, n1, n2) += D_beta.block(bf1_first, bf2_first, n1, n2);
 
-    for(decltype(s1) s3 = 0; s3 <= s1; ++s3) {
-      auto bf3_first = shell2bf[s3];
-      auto n3        = obs[s3].size();
-
-      const auto Dnorm123 =
-        do_schwarz_screen ? std::max(D_shblk_norm(s1, s3), std::max(D_shblk_norm(s2, s3), Dnorm12))
-                          : 0.;
-
-      auto sp34_iter = scf_vars.obs_shellpair_data.at(s3).begin();
-
-      const auto s4_max = (s1 == s3) ? s2 : s3;
-      for(const auto& s4: scf_vars.obs_shellpair_list.at(s3)) {
-        if(s4 > s4_max)
-          break; // for each s3, s4 are stored in monotonically increasing
-                 // order
-
-        // must update the iter even if going to skip s4
-        const auto* sp34 = sp34_iter->get();
-        ++sp34_iter;
-
-        const auto Dnorm34 = do_schwarz_screen ? 2 * D_shblk_norm(s3, s4) : 0.0;
-
-        const auto Dnorm1234 =
-          do_schwarz_screen
-            ? std::max(D_shblk_norm(s1, s4),
-                       std::max(D_shblk_norm(s2, s4), std::max(D_shblk_norm(s3, s4), Dnorm123)))
-            : 0.;
-
-        if(do_schwarz_screen && Dnorm1234 * SchwarzK(s1, s2) * SchwarzK(s3, s4) < fock_precision)
-          continue;
+    // the canonical quartet (s1 s2|s3 s4), s4 = obs_shellpair_list.at(s3)[s34_pos]
+    auto compute_quartet = [&](size_t s3, size_t s34_pos) {
+      const auto  s4        = scf_vars.obs_shellpair_list.at(s3)[s34_pos];
+      const auto* sp34      = scf_vars.obs_shellpair_data.at(s3)[s34_pos].get();
+      auto        bf3_first = shell2bf[s3];
+      auto        n3        = obs[s3].size();
+      auto        bf4_first = shell2bf[s4];
+      auto        n4        = obs[s4].size();
+
+      const auto Dnorm34 = do_schwarz_screen ? 2 * D_shblk_norm(s3, s4) : 0.0;
+
+      const auto Dnorm1234 =
+        do_schwarz_screen
+          ? std::max(std::max(std::max(D_shblk_norm(s1, s3), D_shblk_norm(s2, s3)),
+                              std::max(D_shblk_norm(s1, s4), D_shblk_norm(s2, s4))),
+                     std::max(D_shblk_norm(s3, s4), Dnorm12))
+          : 0.;
+
+      if(do_schwarz_screen && Dnorm1234 * SchwarzK(s1, s2) * SchwarzK(s3, s4) < fock_precision)
+        return;
 
-        if(!doK) {
-          if(do_schwarz_screen && Dnorm12 * SchwarzK(s1, s2) * SchwarzK(s3, s4) < fock_precision &&
-             Dnorm34 * SchwarzK(s1, s2) * SchwarzK(s3, s4) < fock_precision)
-            continue;
-        }
+      if(!doK) {
+        if(do_schwarz_screen && Dnorm12 * SchwarzK(s1, s2) * SchwarzK(s3, s4) < fock_precision &&
+           Dnorm34 * SchwarzK(s1, s2) * SchwarzK(s3, s4) < fock_precision)
+          return;
+      }
 
-        auto bf4_first = shell2bf[s4];
-        auto n4        = obs[s4].size();
-
-        // For Coulomb part
-        D34.block(0, 0, n3, n4) = D.block(bf3_first, bf4_first, n3, n4);
-        if(is_uhf) D34.block(0, 0, n3, n4) += D_beta.block(bf3_first, bf4_first, n3, n4);
-
-        // compute the permutational degeneracy (i.e. # of equivalents) of
-        // the given shell set
-        auto s12_deg    = (s1 == s2) ? 1 : 2;
-        auto s34_deg    = (s3 == s4) ? 1 : 2;
-        auto s12_34_deg = (s1 == s3) ? (s2 == s4 ? 1 : 2) : 2;
-        auto s1234_deg  = s12_deg * s34_deg * s12_34_deg;
-
-        // prescale the integrals inside Libint
-        engine.prescale_by(0.5 * s1234_deg);
-
-        // compute integrals
-        engine.compute2<Operator::coulomb, libint2::BraKet::xx_xx, 0>(obs[s1], obs[s2], obs[s3],
-                                                                      obs[s4], sp12, sp34);
-
-        const auto* buf_1234 = buf[0];
-        if(buf_1234 == nullptr) continue; // if all integrals screened out, skip to next quartet
-
-        // 1) each shell set of integrals contributes up to 6 shell sets of
-        // the Fock matrix:
-        //    F(a,b) += 1/2 * (ab|cd) * D(c,d)
-        //    F(c,d) += 1/2 * (ab|cd) * D(a,b)
-        //    F(b,d) -= 1/8 * (ab|cd) * D(a,c)
-        //    F(b,c) -= 1/8 * (ab|cd) * D(a,d)
-        //    F(a,c) -= 1/8 * (ab|cd) * D(b,d)
-        //    F(a,d) -= 1/8 * (ab|cd) * D(b,c)
-        // 2) each permutationally-unique integral (shell set) must be
-        // scaled by its degeneracy,
-        //    i.e. the number of the integrals/sets equivalent to it
-        // 3) the end result must be symmetrized
-
-        // J and K for closed-shell calculations
-        if(doK && is_rhf) {
-          for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
-            const auto bf1 = f1 + bf1_first;
-            for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
-              const auto bf2 = f2 + bf2_first;
-              for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
-                const auto bf3 = f3 + bf3_first;
-                for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
-                  const auto bf4               = f4 + bf4_first;
-                  auto       value_scal_by_deg = buf_1234[f1234];
-                  J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
-                  G(bf3, bf4) += D12(f1, f2) * value_scal_by_deg;
-
-                  value_scal_by_deg *= Kfactor;
-                  K1_alpha(f1, bf3) += D(bf2, bf4) * value_scal_by_deg;
-                  K1_alpha(f1, bf4) += D(bf2, bf3) * value_scal_by_deg;
-                  K2_alpha(f2, bf3) += D(bf1, bf4) * value_scal_by_deg;
-                  K2_alpha(f2, bf4) += D(bf1, bf3) * value_scal_by_deg;
-                }
+      // For Coulomb part
+      D34.block(0, 0, n3, n4) = D.block(bf3_first, bf4_first, n3, n4);
+      if(is_uhf) D34.block(0, 0, n3, n4) += D_beta.block(bf3_first, bf4_first, n3, n4);
+      G34.block(0, 0, n3, n4).setZero();
+
+      // compute the permutational degeneracy (i.e. # of equivalents) of
+      // the given shell set
+      auto s12_deg    = (s1 == s2) ? 1 : 2;
+      auto s34_deg    = (s3 == s4) ? 1 : 2;
+      auto s12_34_deg = (s1 == s3) ? (s2 == s4 ? 1 : 2) : 2;
+      auto s1234_deg  = s12_deg * s34_deg * s12_34_deg;
+
+      // prescale the integrals inside Libint
+      engine.prescale_by(0.5 * s1234_deg);
+
+      // compute integrals
+      engine.compute2<Operator::coulomb, libint2::BraKet::xx_xx, 0>(obs[s1], obs[s2], obs[s3],
+                                                                    obs[s4], sp12, sp34);
+
+      const auto* buf_1234 = buf[0];
+      if(buf_1234 == nullptr) return; // if all integrals screened out, skip to next quartet
+
+      // 1) each shell set of integrals contributes up to 6 shell sets of
+      // the Fock matrix:
+      //    F(a,b) += 1/2 * (ab|cd) * D(c,d)
+      //    F(c,d) += 1/2 * (ab|cd) * D(a,b)
+      //    F(b,d) -= 1/8 * (ab|cd) * D(a,c)
+      //    F(b,c) -= 1/8 * (ab|cd) * D(a,d)
+      //    F(a,c) -= 1/8 * (ab|cd) * D(b,d)
+      //    F(a,d) -= 1/8 * (ab|cd) * D(b,c)
+      // 2) each permutationally-unique integral (shell set) must be
+      // scaled by its degeneracy,
+      //    i.e. the number of the integrals/sets equivalent to it
+      // 3) the end result must be symmetrized
+
+      // J and K for closed-shell calculations
+      if(doK && is_rhf) {
+        for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
+          const auto bf1 = f1 + bf1_first;
+          for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
+            const auto bf2 = f2 + bf2_first;
+            for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
+              const auto bf3 = f3 + bf3_first;
+              for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
+                const auto bf4               = f4 + bf4_first;
+                auto       value_scal_by_deg = buf_1234[f1234];
+                J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
+                G34(f3, f4) += D12(f1, f2) * value_scal_by_deg;
+
+                value_scal_by_deg *= Kfactor;
+                K1_alpha(f1, bf3) += D(bf2, bf4) * value_scal_by_deg;
+                K1_alpha(f1, bf4) += D(bf2, bf3) * value_scal_by_deg;
+                K2_alpha(f2, bf3) += D(bf1, bf4) * value_scal_by_deg;
+                K2_alpha(f2, bf4) += D(bf1, bf3) * value_scal_by_deg;
               }
             }
           }
         }
-        else if(doK && is_uhf) {
-          for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
-            const auto bf1 = f1 + bf1_first;
-            for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
-              const auto bf2 = f2 + bf2_first;
-              for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
-                const auto bf3 = f3 + bf3_first;
-                for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
-                  const auto bf4               = f4 + bf4_first;
-                  auto       value_scal_by_deg = buf_1234[f1234];
-                  auto       J34               = D12(f1, f2) * value_scal_by_deg;
-                  J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
-                  G(bf3, bf4) += J34;
-                  G_beta(bf3, bf4) += J34;
-
-                  value_scal_by_deg *= Kfactor;
-                  K1_alpha(f1, bf3) += D(bf2, bf4) * value_scal_by_deg;
-                  K1_alpha(f1, bf4) += D(bf2, bf3) * value_scal_by_deg;
-                  K2_alpha(f2, bf3) += D(bf1, bf4) * value_scal_by_deg;
-                  K2_alpha(f2, bf4) += D(bf1, bf3) * value_scal_by_deg;
-
-                  K1_beta(f1, bf3) += D_beta(bf2, bf4) * value_scal_by_deg;
-                  K1_beta(f1, bf4) += D_beta(bf2, bf3) * value_scal_by_deg;
-                  K2_beta(f2, bf3) += D_beta(bf1, bf4) * value_scal_by_deg;
-                  K2_beta(f2, bf4) += D_beta(bf1, bf3) * value_scal_by_deg;
-                }
+      }
+      else if(doK && is_uhf) {
+        for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
+          const auto bf1 = f1 + bf1_first;
+          for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
+            const auto bf2 = f2 + bf2_first;
+            for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
+              const auto bf3 = f3 + bf3_first;
+              for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
+                const auto bf4               = f4 + bf4_first;
+                auto       value_scal_by_deg = buf_1234[f1234];
+                auto       J34               = D12(f1, f2) * value_scal_by_deg;
+                J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
+                G34(f3, f4) += J34;
+
+                value_scal_by_deg *= Kfactor;
+                K1_alpha(f1, bf3) += D(bf2, bf4) * value_scal_by_deg;
+                K1_alpha(f1, bf4) += D(bf2, bf3) * value_scal_by_deg;
+                K2_alpha(f2, bf3) += D(bf1, bf4) * value_scal_by_deg;
+                K2_alpha(f2, bf4) += D(bf1, bf3) * value_scal_by_deg;
+
+                K1_beta(f1, bf3) += D_beta(bf2, bf4) * value_scal_by_deg;
+                K1_beta(f1, bf4) += D_beta(bf2, bf3) * value_scal_by_deg;
+                K2_beta(f2, bf3) += D_beta(bf1, bf4) * value_scal_by_deg;
+                K2_beta(f2, bf4) += D_beta(bf1, bf3) * value_scal_by_deg;
               }
             }
           }
         }
-        else if(is_rhf) {
-          for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
-            for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
-              for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
-                const auto bf3 = f3 + bf3_first;
-                for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
-                  const auto bf4               = f4 + bf4_first;
-                  auto       value_scal_by_deg = buf_1234[f1234];
-                  J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
-                  G(bf3, bf4) += D12(f1, f2) * value_scal_by_deg;
-                }
+      }
+      else if(is_rhf) {
+        for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
+          for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
+            for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
+              for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
+                auto value_scal_by_deg = buf_1234[f1234];
+                J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
+                G34(f3, f4) += D12(f1, f2) * value_scal_by_deg;
               }
             }
           }
         }
-        else if(is_uhf) {
-          for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
-            for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
-              for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
-                const auto bf3 = f3 + bf3_first;
-                for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
-                  const auto bf4               = f4 + bf4_first;
-                  auto       value_scal_by_deg = buf_1234[f1234];
-                  auto       J34               = D12(f1, f2) * value_scal_by_deg;
-                  J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
-                  G(bf3, bf4) += J34;
-                  G_beta(bf3, bf4) += J34;
-                }
+      }
+      else if(is_uhf) {
+        for(decltype(n1) f1 = 0, f1234 = 0; f1 != n1; ++f1) {
+          for(decltype(n2) f2 = 0; f2 != n2; ++f2) {
+            for(decltype(n3) f3 = 0; f3 != n3; ++f3) {
+              for(decltype(n4) f4 = 0; f4 != n4; ++f4, ++f1234) {
+                auto value_scal_by_deg = buf_1234[f1234];
+                auto J34               = D12(f1, f2) * value_scal_by_deg;
+                J12(f1, f2) += D34(f3, f4) * value_scal_by_deg;
+                G34(f3, f4) += J34;
               }
             }
           }
         }
       }
+
+      // Add Coulomb contributions to (s3,s4) block
+      add_to_G(G, G_shm, bf3_first, bf4_first, n3, n4, G34);
+      if(is_uhf) add_to_G(G_beta, G_beta_shm, bf3_first, bf4_first, n3, n4, G34);
+    };
+
+    if(do_cfmm) {
+      // only the ket pairs of the near leaves, J of the well-separated leaves is added from the
+      // multipole expansion
+      for(const int leaf34: cfmm_->near_leaves(leaf12)) {
+        for(const auto& [s3, s34_pos]: cfmm_->leaf_pairs(leaf34)) {
+          if(s3 > s1) break;
+          if(s3 == s1 && scf_vars.obs_shellpair_list.at(s3)[s34_pos] > s2) continue;
+          compute_quartet(s3, s34_pos);
+        }
+      }
+      cfmm_->add_far_field(s1, s2, leaf12, J12);
     }
+    else {
+      for(decltype(s1) s3 = 0; s3 <= s1; ++s3) {
+        // for each s3, s4 are stored in monotonically increasing order
+        const auto& s4list = scf_vars.obs_shellpair_list.at(s3);
+        const auto  s4_max = (s1 == s3) ? s2 : s3;
+        for(size_t s34_pos = 0; s34_pos < s4list.size() && s4list[s34_pos] <= s4_max; ++s34_pos)
+          compute_quartet(s3, s34_pos);
+      }
+    }
+
     // Add contributions to (s1,s2) block
-    G.block(bf1_first, bf2_first, n1, n2) += J12.block(0, 0, n1, n2);
-    if(is_uhf) G_beta.block(bf1_first, bf2_first, n1, n2) += J12.block(0, 0, n1, n2);
+    add_to_G(G, G_shm, bf1_first, bf2_first, n1, n2, J12);
+    if(is_uhf) add_to_G(G_beta, G_beta_shm, bf1_first, bf2_first, n1, n2, J12);
 
     // Add contributions to (s1,N) and (s2,N) blocks
     if(doK) {
-      G.block(bf1_first, 0, n1, N) += K1_alpha.block(0, 0, n1, N);
-      G.block(bf2_first, 0, n2, N) += K2_alpha.block(0, 0, n2, N);
+      add_to_G(G, G_shm, bf1_first, 0, n1, N, K1_alpha);
+      add_to_G(G, G_shm, bf2_first, 0, n2, N, K2_alpha);
       if(is_uhf) {
-        G_beta.block(bf1_first, 0, n1, N) += K1_beta.block(0, 0, n1, N);
-        G_beta.block(bf2_first, 0, n2, N) += K2_beta.block(0, 0, n2, N);
+        add_to_G(G_beta, G_beta_shm, bf1_first, 0, n1, N, K1_beta);
+        add_to_G(G_beta, G_beta_shm, bf2_first, 0, n2, N, K2_beta);
       }
     }
   };
@@ -1294,8 +1353,24 @@ void exachem::scf::SCFIter::compute_2bf(ExecutionContext& ec, ChemEnv& chem_env,
       chem_env.compute_shellblock_norm(obs, D); // matrix of infty-norms of shell blocks
     if(is_uhf) D_shblk_norm = D_shblk_norm.cwiseMax(chem_env.compute_shellblock_norm(obs, D_beta));
 
-    G.setZero(N, N);
-    if(is_uhf) G_beta.setZero(N, N);
+    if(do_cfmm) {
+      if(is_uhf) cfmm_->compute_moments(ec, D + D_beta, D_shblk_norm);
+      else cfmm_->compute_moments(ec, D, D_shblk_norm);
+    }
+
+    if(shared_G) {
+      // the rank-private G of the guess is not needed any more
+      G.resize(0, 0);
+      zero_node_shared(G_shm);
+      if(is_uhf) {
+        G_beta.resize(0, 0);
+        zero_node_shared(G_beta_shm);
+      }
+    }
+    else {
+      G.setZero(N, N);
+      if(is_uhf) G_beta.setZero(N, N);
+    }
     if(!scf_vars.do_load_bal) block_for(ec, F_dummy(), comp_2bf_lambda);
     else {
       for(Eigen::Index i1 = 0; i1 < etensors.taskmap.rows(); i1++)
@@ -1309,8 +1384,15 @@ void exachem::scf::SCFIter::compute_2bf(ExecutionContext& ec, ChemEnv& chem_env,
 
     // Matrix Gt = 0.5 * (G + G.transpose()); G=Gt
     // Gt     = 0.5 * (G_beta + G_beta.transpose());
-    eigen_to_tamm_tensor_acc(F_alpha_tmp, G);
-    if(is_uhf) eigen_to_tamm_tensor_acc(F_beta_tmp, G_beta);
+    if(shared_G) {
+      node_shared_to_tamm_acc(F_alpha_tmp, G_shm);
+      if(is_uhf) node_shared_to_tamm_acc(F_beta_tmp, G_beta_shm);
+      ec.pg().barrier();
+    }
+    else {
+      eigen_to_tamm_tensor_acc(F_alpha_tmp, G);
+      if(is_uhf) eigen_to_tamm_tensor_acc(F_beta_tmp, G_beta);
+    }
 
     do_t2   = std::chrono::high_resolution_clock::now();
     do_time = std::chrono::duration_cast<std::chrono::duration<double>>((do_t2 - do_t1)).count();
@@ -1318,6 +1400,16 @@ void exachem::scf::SCFIter::compute_2bf(ExecutionContext& ec, ChemEnv& chem_env,
     if(rank == 0 && debug)
       std::cout << std::fixed << std::setprecision(2) << "Fock build: " << do_time << "s, ";
 
+    if(do_cfmm && rank == 0) {
+      // ordered leaf pairs, near_leaf_pairs == leaves^2 means the far field was never used
+      auto& jcfmm              = chem_env.sys_data.results["output"]["SCF"]["cfmm"];
+      jcfmm["leaves"]          = cfmm_->nleaves();
+      jcfmm["near_leaf_pairs"] = cfmm_->nnear();
+      if(debug)
+        std::cout << "CFMM: " << cfmm_->nleaves() << " leaves, " << cfmm_->nnear()
+                  << " near leaf pairs, ";
+    }
+
     // ec.pg().barrier();
   }
   else {
@@ -1587,10 +1679,9 @@ template void exachem::scf::SCFIter::compute_2bf_ri<double>(
   const std::vector<size_t>& shell2bf, TAMMTensors& ttensors, EigenTensors& etensors,
   bool& is_3c_init, double xHF);
 
-template void exachem::scf::SCFIter::init_ri<double>(ExecutionContext& ec, ChemEnv& chem_env,
-                                                     ScalapackInfo& scalapack_info,
-                                                     const SCFVars& scf_vars,
-                                                     EigenTensors& etensors, TAMMTensors& ttensors);
+template void exachem::scf::SCFIter::init_ri<double>(
+  ExecutionContext& ec, ChemEnv& chem_env, ScalapackInfo& scalapack_info, const SCFVars& scf_vars,
+  const Matrix& SchwarzK, EigenTensors& etensors, TAMMTensors& ttensors);
 
 template void exachem::scf::SCFIter::compute_2c_ints<double>(ExecutionContext& ec,
                                                              ChemEnv&          chem_env,
@@ -1598,10 +1689,9 @@ template void exachem::scf::SCFIter::compute_2c_ints<double>(ExecutionContext& e
                                                              const SCFVars&    scf_vars,
                                                              TAMMTensors&      ttensors);
 
-template void exachem::scf::SCFIter::compute_3c_ints<double>(ExecutionContext&   ec,
-                                                             ChemEnv&            chem_env,
-                                                             const SCFVars&      scf_vars,
-                                                             Tensor<TensorType>& xyZ);
+template void exachem::scf::SCFIter::compute_3c_ints<double>(
+  ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars, const Matrix& SchwarzK,
+  const Eigen::VectorXd& dfNorm, Tensor<TensorType>& xyZ);
 
 template void exachem::scf::SCFIter::compute_2bf_ri_direct<double>(
   ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars,
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "scf/scf_cfmm.hpp"
 #include "scf/scf_compute.hpp"
 #include "scf/scf_gauxc.hpp"
 #include "scf/scf_guess.hpp"
@@ -15,6 +16,9 @@
 namespace exachem::scf {
 class SCFIter: public SCFCompute {
 private:
+  // octree of the shell pairs for the multipole Coulomb build, null unless init_cfmm was called
+  std::unique_ptr<CFMM> cfmm_;
+
   template<typename TensorType>
   void scf_diis(ExecutionContext& ec, ChemEnv& chem_env, const TiledIndexSpace& tAO,
                 Tensor<TensorType> F_alpha, Tensor<TensorType> F_beta,
@@ -32,6 +36,7 @@ private:
 
   template<typename TensorType>
   void compute_3c_ints(ExecutionContext& ec, ChemEnv& chem_env, const SCFVars& scf_vars,
+                       const Matrix& SchwarzK, const Eigen::VectorXd& dfNorm,
                        Tensor<TensorType>& xyZ);
 
   template<typename TensorType>
@@ -44,9 +49,17 @@ private:
                              EigenTensors& etensors, const Matrix& SchwarzK);
 
 public:
+  // builds the CFMM octree of the significant shell pairs once, the Fock builds of the 4-center
+  // SCF without exact exchange then only recompute its moments
+  void init_cfmm(const libint2::BasisSet& obs, const SCFVars& scf_vars, int order,
+                 double precision) {
+    cfmm_ = std::make_unique<CFMM>(obs, scf_vars, order, precision);
+  }
+
   template<typename TensorType>
   void init_ri(ExecutionContext& ec, ChemEnv& chem_env, ScalapackInfo& scalapack_info,
-               const SCFVars& scf_vars, EigenTensors& etensors, TAMMTensors& ttensors);
+               const SCFVars& scf_vars, const Matrix& SchwarzK, EigenTensors& etensors,
+               TAMMTensors& ttensors);
 
   template<typename TensorType>
   void compute_2bf(ExecutionContext& ec, ChemEnv& chem_env, ScalapackInfo& scalapack_info,
@@ -30,6 +30,7 @@ void scf(ExecutionContext& ec, ChemEnv& chem_env) {
     std::chrono::duration_cast<std::chrono::duration<double>>((hf_t2 - hf_t1)).count();
 
   ec.flush_and_sync();
+  chem_env.telemetry.record(ec.pg(), "SCF", "total", hf_time);
 
   if(rank == 0) {
     chem_env.sys_data.results["output"]["SCF"]["performance"] = {{"total_time", hf_time}};
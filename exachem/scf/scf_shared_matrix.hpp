@@ -0,0 +1,161 @@
+/*
+ * ExaChem: Open Source Exascale Computational Chemistry Software.
+ *
+ * Copyright 2023-2024 Pacific Northwest National Laboratory, Battelle Memorial Institute.
+ *
+ * See LICENSE.txt for details
+ */
+
+#pragma once
+
+#include "tamm/eigen_utils.hpp"
+#include <cstdint>
+#include <cstring>
+#include <mpi.h>
+
+namespace exachem::scf {
+
+/**
+ * Matrix stored once per node in an MPI-3 shared-memory window. The node root owns the storage
+ * and writes it, all ranks on the node read it through map() and may accumulate into it with
+ * atomic_add_block(). Like a TAMM tensor this is a handle: copies share the window and
+ * deallocate() has to be called explicitly.
+ */
+class NodeSharedMatrix {
+  MPI_Comm     node_comm_{MPI_COMM_NULL};
+  MPI_Win      win_{MPI_WIN_NULL};
+  double*      data_{nullptr};
+  int          node_rank_{-1};
+  Eigen::Index rows_{0}, cols_{0};
+
+public:
+  void allocate(MPI_Comm comm, Eigen::Index rows, Eigen::Index cols) {
+    rows_ = rows;
+    cols_ = cols;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm_);
+    MPI_Comm_rank(node_comm_, &node_rank_);
+
+    const MPI_Aint wsize = node_rank_ == 0 ? rows * cols * sizeof(double) : 0;
+    double*        base  = nullptr;
+    MPI_Win_allocate_shared(wsize, sizeof(double), MPI_INFO_NULL, node_comm_, &base, &win_);
+
+    MPI_Aint qsize;
+    int      qdisp;
+    MPI_Win_shared_query(win_, 0, &qsize, &qdisp, &data_);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+    if(node_rank_ == 0) map().setZero();
+    sync();
+  }
+
+  void deallocate() {
+    if(win_ == MPI_WIN_NULL) return;
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+    MPI_Comm_free(&node_comm_);
+    data_ = nullptr;
+    rows_ = cols_ = 0;
+  }
+
+  // makes the writes of the node root visible to the other ranks on the node
+  void sync() const {
+    MPI_Win_sync(win_);
+    MPI_Barrier(node_comm_);
+    MPI_Win_sync(win_);
+  }
+
+  bool     allocated() const { return win_ != MPI_WIN_NULL; }
+  bool     node_root() const { return node_rank_ == 0; }
+  MPI_Comm node_comm() const { return node_comm_; }
+
+  Eigen::Map<Matrix>       map() { return Eigen::Map<Matrix>(data_, rows_, cols_); }
+  Eigen::Map<const Matrix> cmap() const { return Eigen::Map<const Matrix>(data_, rows_, cols_); }
+
+  // Adds blk at (row, col). All ranks of the node may add overlapping blocks concurrently, every
+  // element is updated with a compare-and-swap. The sums are visible to the node after sync().
+  template<typename Derived>
+  void atomic_add_block(Eigen::Index row, Eigen::Index col, const Eigen::MatrixBase<Derived>& blk) {
+    auto dense = map();
+    for(Eigen::Index i = 0; i < blk.rows(); i++)
+      for(Eigen::Index j = 0; j < blk.cols(); j++) {
+        const double v = blk(i, j);
+        if(v != 0.0) atomic_add(&dense(row + i, col + j), v);
+      }
+  }
+
+private:
+  static void atomic_add(double* addr, double v) {
+    static_assert(sizeof(double) == sizeof(uint64_t));
+    auto*    bits     = reinterpret_cast<uint64_t*>(addr);
+    uint64_t expected = __atomic_load_n(bits, __ATOMIC_RELAXED);
+    uint64_t desired;
+    do {
+      double sum;
+      std::memcpy(&sum, &expected, sizeof(double));
+      sum += v;
+      std::memcpy(&desired, &sum, sizeof(double));
+    } while(!__atomic_compare_exchange_n(bits, &expected, desired, true, __ATOMIC_RELAXED,
+                                         __ATOMIC_RELAXED));
+  }
+};
+
+// The node root reads every block of a dense 2D tensor into the window.
+template<typename T>
+void tamm_to_node_shared(tamm::Tensor<T>& tensor, NodeSharedMatrix& shm) {
+  if(shm.node_root()) {
+    auto dense = shm.map();
+    for(const auto& blockid: tensor.loop_nest()) {
+      if(!tensor.is_non_zero(blockid)) continue;
+      std::vector<T> buf(tensor.block_size(blockid));
+      tensor.get(blockid, buf);
+      const auto off  = tensor.block_offsets(blockid);
+      const auto dims = tensor.block_dims(blockid);
+      for(size_t i = 0, c = 0; i < dims[0]; i++)
+        for(size_t j = 0; j < dims[1]; j++, c++) dense(off[0] + i, off[1] + j) = buf[c];
+    }
+  }
+  shm.sync();
+}
+
+// Zeroes a window that the ranks of the node are about to accumulate into.
+inline void zero_node_shared(NodeSharedMatrix& shm) {
+  if(shm.node_root()) shm.map().setZero();
+  shm.sync();
+}
+
+// Waits for every rank of the node to finish its atomic_add_block calls, then the node root
+// alone accumulates the node total into the distributed tensor.
+template<typename T>
+void node_shared_to_tamm_acc(tamm::Tensor<T>& tensor, NodeSharedMatrix& shm) {
+  shm.sync();
+  if(!shm.node_root()) return;
+  const auto dense = shm.cmap();
+  for(const auto& blockid: tensor.loop_nest()) {
+    if(!tensor.is_non_zero(blockid)) continue;
+    std::vector<T> buf(tensor.block_size(blockid));
+    const auto     off  = tensor.block_offsets(blockid);
+    const auto     dims = tensor.block_dims(blockid);
+    for(size_t i = 0, c = 0; i < dims[0]; i++)
+      for(size_t j = 0; j < dims[1]; j++, c++) buf[c] = dense(off[0] + i, off[1] + j);
+    tensor.add(blockid, buf);
+  }
+}
+
+// Refreshes the Eigen replica of a density: the node-shared window when one is allocated,
+// the rank-private matrix otherwise.
+template<typename T>
+void tamm_to_eigen_density(tamm::Tensor<T>& tensor, Matrix& dense, NodeSharedMatrix& shm) {
+  if(!shm.allocated()) {
+    tamm_to_eigen_tensor(tensor, dense);
+    return;
+  }
+  tamm_to_node_shared(tensor, shm);
+  dense.resize(0, 0);
+}
+
+// Read-only view of whichever density replica is in use.
+inline Eigen::Map<const Matrix> density_view(const Matrix& dense, const NodeSharedMatrix& shm) {
+  if(shm.allocated()) return shm.cmap();
+  return Eigen::Map<const Matrix>(dense.data(), dense.rows(), dense.cols());
+}
+
+} // namespace exachem::scf
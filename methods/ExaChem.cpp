@@ -21,9 +21,11 @@
 #endif
 
 #include "exachem/common/chemenv.hpp"
+#include "exachem/common/memory_plan.hpp"
 #include "exachem/common/options/parse_options.hpp"
 #include "scf/scf_main.hpp"
 #include "mp2/cd_mp2.hpp"
+#include "gw/cd_gw.hpp"
 // clang-format on
 using namespace exachem;
 
@@ -44,8 +46,324 @@ void cd_cc2_driver(ExecutionContext& ec, ChemEnv& chem_env);
 namespace exachem::cc::ducc {
 void ducc_driver(ExecutionContext& ec, ChemEnv& chem_env);
 }
+namespace exachem::cc::dlpno {
+void dlpno_ccsd_driver(ExecutionContext& ec, ChemEnv& chem_env);
+}
 #endif
 
+// Runs the task of one input file on the process group of ec.
+void run_input(ExecutionContext& ec, const std::string& ifile, const std::string& cur_date) {
+  const auto rank = ec.pg().rank();
+
+  std::string   input_file = fs::canonical(ifile);
+  std::ifstream testinput(input_file);
+  if(!testinput) tamm_terminate("Input file provided [" + input_file + "] does not exist!");
+
+  // read geometry from a json file
+  ChemEnv chem_env;
+  chem_env.input_file = input_file;
+
+  if(rank == 0) {
+    cout << endl << std::string(60, '-') << endl;
+    cout << endl << "Input file provided: " << input_file << endl << endl;
+  }
+
+  // This call should update all input options and SystemData object
+  std::unique_ptr<ECOptionParser> iparse = std::make_unique<ECOptionParser>(chem_env);
+
+  ECOptions& ioptions              = chem_env.ioptions;
+  chem_env.sys_data.input_molecule = ParserUtils::getfilename(input_file);
+
+  if(chem_env.ioptions.common_options.file_prefix.empty()) {
+    chem_env.ioptions.common_options.file_prefix = chem_env.sys_data.input_molecule;
+  }
+
+  chem_env.sys_data.output_file_prefix =
+    chem_env.ioptions.common_options.file_prefix + "." + chem_env.ioptions.common_options.basis;
+  chem_env.workspace_dir = chem_env.sys_data.output_file_prefix + "_files/";
+  chem_env.open_telemetry(rank == 0);
+
+  if(rank == 0) {
+    std::cout << chem_env.jinput.dump(2) << std::endl;
+    cout << endl
+         << "Output folder & files prefix: " << chem_env.sys_data.output_file_prefix << endl
+         << endl;
+    chem_env.sys_data.results["output"]["machine_info"]["date"]           = cur_date;
+    chem_env.sys_data.results["output"]["machine_info"]["nnodes"]         = ec.nnodes();
+    chem_env.sys_data.results["output"]["machine_info"]["nproc_per_node"] = ec.ppn();
+    chem_env.sys_data.results["output"]["machine_info"]["nproc_total"] = ec.nnodes() * ec.ppn();
+    auto meminfo                                                       = ec.mem_info();
+    chem_env.sys_data.results["output"]["machine_info"]["cpu"]["name"] = meminfo.cpu_name;
+    chem_env.sys_data.results["output"]["machine_info"]["cpu"]["cpu_memory_per_node_gib"] =
+      meminfo.cpu_mem_per_node;
+    chem_env.sys_data.results["output"]["machine_info"]["cpu"]["total_cpu_memory_gib"] =
+      meminfo.total_cpu_mem;
+    if(ec.has_gpu()) {
+      chem_env.sys_data.results["output"]["machine_info"]["ngpus_per_node"] = ec.gpn();
+      chem_env.sys_data.results["output"]["machine_info"]["ngpus_total"] = ec.nnodes() * ec.gpn();
+      chem_env.sys_data.results["output"]["machine_info"]["gpu"]["name"] = meminfo.gpu_name;
+      chem_env.sys_data.results["output"]["machine_info"]["gpu"]["memory_per_gpu_gib"] =
+        meminfo.gpu_mem_per_device;
+      chem_env.sys_data.results["output"]["machine_info"]["gpu"]["gpu_memory_per_node_gib"] =
+        meminfo.gpu_mem_per_node;
+      chem_env.sys_data.results["output"]["machine_info"]["gpu"]["total_gpu_memory_gib"] =
+        meminfo.total_gpu_mem;
+    }
+  }
+
+  const auto              task = ioptions.task_options;
+  const std::vector<bool> tvec = {task.sinfo,
+                                  task.scf,
+                                  task.mp2,
+                                  task.gw,
+                                  task.fci,
+                                  task.cd_2e,
+                                  task.ducc,
+                                  task.ccsd,
+                                  task.ccsd_t,
+                                  task.ccsd_lambda,
+                                  task.eom_ccsd,
+                                  task.fcidump,
+                                  task.rteom_cc2,
+                                  task.rteom_ccsd,
+                                  task.gfccsd,
+                                  task.dlpno_ccsd.first,
+                                  task.dlpno_ccsd_t.first};
+  if(std::count(tvec.begin(), tvec.end(), true) > 1)
+    tamm_terminate("[INPUT FILE ERROR] only a single task can be enabled at once!");
+
+
+#if !defined(USE_MACIS)
+  if(task.fci) tamm_terminate("Full CI integration not enabled!");
+#endif
+
+  SCFOptions& scf_options   = chem_env.ioptions.scf_options;
+  chem_env.ec_basis         = ECBasis(ec, scf_options.basis, scf_options.basisfile,
+                                      scf_options.gaussian_type, chem_env.atoms, chem_env.ec_atoms);
+  chem_env.shells           = chem_env.ec_basis.shells;
+  chem_env.sys_data.has_ecp = chem_env.ec_basis.has_ecp;
+
+  // Predict the memory of every phase before SCF, scaled by the overhead factors measured by
+  // earlier runs of this input. The drivers check their exact plans again before allocating.
+  MemoryPlan::load_calibration(ec, chem_env.workspace_dir + chem_env.sys_data.output_file_prefix +
+                                     ".memory_calibration.json");
+  const bool fits = print_memory_prediction(ec, chem_env);
+  if(chem_env.ioptions.common_options.memory_dry_run) {
+    if(rank == 0) cout << endl << "memory_dry_run: exiting before the calculation" << endl;
+    return;
+  }
+  if(!fits && rank == 0)
+    cout << endl
+         << "WARNING: the predicted memory of at least one phase exceeds the available memory"
+         << endl;
+
+  if(task.sinfo) chem_env.sinfo(ec);
+  else if(task.scf) scf::scf_driver(ec, chem_env);
+#if defined(EC_CC)
+  else if(task.mp2) mp2::cd_mp2(ec, chem_env);
+  else if(task.gw) gw::cd_gw(ec, chem_env);
+  else if(task.cd_2e) cholesky_2e::cholesky_decomp_2e(ec, chem_env);
+  else if(task.ccsd) cc::ccsd::cd_ccsd(ec, chem_env);
+  else if(task.ccsd_t) cc::ccsd_t::ccsd_t_driver(ec, chem_env);
+  else if(task.cc2) cc2::cd_cc2_driver(ec, chem_env);
+  else if(task.ccsd_lambda) cc::ccsd_lambda::ccsd_lambda_driver(ec, chem_env);
+  else if(task.eom_ccsd) cc::eom::eom_ccsd_driver(ec, chem_env);
+  else if(task.ducc) cc::ducc::ducc_driver(ec, chem_env);
+  else if(task.dlpno_ccsd.first || task.dlpno_ccsd_t.first)
+    cc::dlpno::dlpno_ccsd_driver(ec, chem_env);
+#if !defined(USE_UPCXX) and defined(EC_COMPLEX)
+  else if(task.fci || task.fcidump) fci::fci_driver(ec, chem_env);
+  else if(task.gfccsd) cc::gfcc::gfccsd_driver(ec, chem_env);
+  else if(task.rteom_ccsd) rteom_cc::ccsd::rt_eom_cd_ccsd_driver(ec, chem_env);
+#endif
+
+#endif
+
+  else
+    tamm_terminate(
+      "[ERROR] Unsupported task specified (or) code for the specified task is not built");
+}
+
+// Relative cost of an input used to order the inputs of the task farm and size their process
+// groups: the number of basis functions raised to the formal scaling of the requested task.
+double estimate_cost(ExecutionContext& ec, const std::string& ifile) {
+  ChemEnv chem_env;
+  chem_env.input_file = fs::canonical(ifile);
+  ECOptionParser iparse(chem_env);
+
+  SCFOptions& scf_options = chem_env.ioptions.scf_options;
+  ECBasis     ec_basis(ec, scf_options.basis, scf_options.basisfile, scf_options.gaussian_type,
+                       chem_env.atoms, chem_env.ec_atoms);
+  const double nbf = ec_basis.shells.nbf();
+
+  const auto task  = chem_env.ioptions.task_options;
+  double     power = 4; // scf, mp2, cd_2e, gw, fcidump
+  if(task.sinfo) power = 0;
+  else if(task.cc2) power = 5;
+  else if(task.ccsd || task.ccsd_lambda || task.eom_ccsd || task.ducc || task.fci ||
+          task.rteom_ccsd || task.gfccsd || task.dlpno_ccsd.first)
+    power = 6;
+  else if(task.ccsd_t || task.dlpno_ccsd_t.first) power = 7;
+  return std::pow(nbf, power);
+}
+
+// Runs the inputs concurrently on subgroups of the world process group (EXACHEM_TASK_FARM).
+//
+// The world is divided into units of group_nodes nodes (single ranks on a single node), and the
+// units into groups once, before any input runs. Every input whose estimated cost is larger than
+// the average work per unit gets a group of several units sized by its cost, and starts on it
+// right away. The remaining units are single-unit groups. All groups, the merged ones as soon as
+// their own input is done, take the remaining inputs in decreasing order of cost from a shared
+// queue, so no group waits for another until the queue is empty.
+void run_task_farm(ExecutionContext& ec, std::vector<std::string> inputfiles, int group_nodes,
+                   const std::string& cur_date) {
+  const int world_rank   = ec.pg().rank().value();
+  const int world_nranks = ec.pg().size().value();
+  const int nnodes       = ec.nnodes();
+  const int ppn          = ec.ppn();
+
+  // the inputs are parsed and their basis sets built on rank 0 only. Every rank then has the
+  // same costs, so the schedule below needs no further communication.
+  std::vector<double> costs(inputfiles.size(), 0.0);
+  if(world_rank == 0) {
+    ProcGroup        pg_l = ProcGroup::create_coll(MPI_COMM_SELF);
+    ExecutionContext ec_l{pg_l, DistributionKind::nw, MemoryManagerKind::local};
+    for(size_t i = 0; i < inputfiles.size(); i++) costs[i] = estimate_cost(ec_l, inputfiles[i]);
+    ec_l.flush_and_sync();
+    pg_l.destroy_coll();
+  }
+  ec.pg().broadcast(costs.data(), costs.size(), 0);
+
+  std::vector<std::pair<double, std::string>> queue;
+  for(size_t i = 0; i < inputfiles.size(); i++) queue.push_back({costs[i], inputfiles[i]});
+  std::stable_sort(queue.begin(), queue.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  const int unit_nranks = nnodes > 1 ? std::min(group_nodes, nnodes) * ppn : 1;
+  const int nunits      = world_nranks / unit_nranks;
+  // ranks left over by the division into units join the last unit
+  const int my_unit = std::min(world_rank / unit_nranks, nunits - 1);
+
+  const int64_t nqueued    = static_cast<int64_t>(queue.size());
+  double        total_cost = 0;
+  for(const auto& q: queue) total_cost += q.first;
+
+  // Units of the merged groups of the first nbig inputs, followed by the single-unit groups. With
+  // no more inputs than units every input gets a group, sized by a largest-remainder split.
+  std::vector<int> group_units;
+  int64_t          nbig = 0;
+  if(nqueued <= nunits) {
+    nbig = nqueued;
+    group_units.assign(nqueued, 1);
+    std::vector<double> remainder(nqueued, 0);
+    int                 assigned = nqueued;
+    for(int64_t i = 0; i < nqueued; i++) {
+      const double share = total_cost > 0 ? (nunits - nqueued) * queue[i].first / total_cost : 0;
+      group_units[i] += static_cast<int>(share);
+      remainder[i] = share - static_cast<int>(share);
+      assigned += static_cast<int>(share);
+    }
+    std::vector<int64_t> order(nqueued);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int64_t a, int64_t b) { return remainder[a] > remainder[b]; });
+    for(int64_t i = 0; assigned < nunits; i = (i + 1) % nqueued, assigned++)
+      group_units[order[i]]++;
+  }
+  else {
+    // at least one single-unit group is kept for the queue
+    const double unit_work = total_cost / nunits;
+    int          big_units = 0;
+    for(; nbig < nqueued && queue[nbig].first > unit_work; nbig++) {
+      const int units = static_cast<int>(queue[nbig].first / unit_work);
+      if(big_units + units > nunits - 1) break;
+      group_units.push_back(units);
+      big_units += units;
+    }
+    group_units.resize(nbig + nunits - big_units, 1);
+  }
+
+  int color = 0;
+  for(int end = group_units[0]; my_unit >= end; end += group_units[color]) color++;
+
+  if(world_rank == 0) {
+    std::cout << std::endl
+              << "Task farm: " << nqueued << " inputs, " << group_units.size() << " groups ("
+              << nbig << " of them sized by cost) of units of " << unit_nranks << " ranks"
+              << std::endl;
+    for(int64_t i = 0; i < nqueued; i++) {
+      std::cout << "  " << std::scientific << std::setprecision(2) << queue[i].first << "  "
+                << queue[i].second;
+      if(i < nbig) std::cout << "  (group " << i << ", " << group_units[i] << " units)";
+      std::cout << std::endl;
+    }
+    std::cout << std::defaultfloat;
+  }
+
+  // runs inputs on the group with the given color, printing to <input>.out
+  auto run_on_group = [&](auto&& next_input) {
+    MPI_Comm farm_comm;
+    MPI_Comm_split(ec.pg().comm(), color, world_rank, &farm_comm);
+    ProcGroup pg = ProcGroup::create_coll(farm_comm);
+    {
+      ExecutionContext fec{pg, DistributionKind::nw, MemoryManagerKind::ga};
+      for(int64_t next = next_input(fec); next >= 0; next = next_input(fec)) {
+        const std::string& ifile   = queue[next].second;
+        const auto         farm_t1 = std::chrono::high_resolution_clock::now();
+
+        std::ofstream   out;
+        std::streambuf* cout_buf = nullptr;
+        if(fec.pg().rank() == 0) {
+          out.open(fs::path(ifile).stem().string() + ".out");
+          cout_buf = std::cout.rdbuf(out.rdbuf());
+        }
+        run_input(fec, ifile, cur_date);
+        if(cout_buf) std::cout.rdbuf(cout_buf);
+
+        const auto   farm_t2 = std::chrono::high_resolution_clock::now();
+        const double farm_time =
+          std::chrono::duration_cast<std::chrono::duration<double>>((farm_t2 - farm_t1)).count();
+        if(fec.pg().rank() == 0)
+          std::cout << "Task farm: " << ifile << " finished on group " << color << " ("
+                    << fec.pg().size().value() << " ranks) in " << std::fixed
+                    << std::setprecision(2) << farm_time << " secs" << std::endl;
+      }
+      fec.flush_and_sync();
+    }
+    pg.destroy_coll();
+    MPI_Comm_free(&farm_comm);
+  };
+
+  // the inputs after the first nbig are claimed through a GA atomic counter, as the GFCC
+  // process groups do
+  const bool     has_queue = nbig < nqueued;
+  AtomicCounter* ac        = nullptr;
+  if(has_queue) {
+    ac = new AtomicCounterGA(ec.pg(), 1);
+    ac->allocate(0);
+  }
+
+  bool own_input = color < nbig;
+  run_on_group([&](ExecutionContext& fec) {
+    if(own_input) {
+      own_input = false;
+      return static_cast<int64_t>(color);
+    }
+    if(!has_queue) return int64_t{-1};
+    int64_t next = -1;
+    if(fec.pg().rank() == 0) next = nbig + ac->fetch_add(0, 1);
+    fec.pg().broadcast(&next, 0);
+    return next < nqueued ? next : int64_t{-1};
+  });
+
+  // collective over the world, after every group is done
+  if(has_queue) {
+    ac->deallocate();
+    delete ac;
+  }
+  ec.pg().barrier();
+}
+
 int main(int argc, char* argv[]) {
   tamm::initialize(argc, argv);
 
@@ -61,11 +379,13 @@ int main(int argc, char* argv[]) {
   }
 
   std::ostringstream cur_date;
-  if(rank == 0) {
+  {
     auto current_time   = std::chrono::system_clock::now();
     auto current_time_t = std::chrono::system_clock::to_time_t(current_time);
     auto cur_local_time = localtime(&current_time_t);
     cur_date << std::put_time(cur_local_time, "%c");
+  }
+  if(rank == 0) {
     cout << endl << "date: " << cur_date.str() << endl;
     cout << "program: " << fs::canonical(argv[0]) << endl;
     std::cout << "nnodes: " << ec.nnodes() << ", ";
@@ -83,6 +403,7 @@ int main(int argc, char* argv[]) {
     for(auto const& dir_entry: std::filesystem::directory_iterator{input_fpath}) {
       if(fs::path(dir_entry.path()).extension() == ".json") inputfiles.push_back(dir_entry.path());
     }
+    std::sort(inputfiles.begin(), inputfiles.end());
   }
   else {
     if(!fs::exists(input_fpath))
@@ -93,122 +414,25 @@ int main(int argc, char* argv[]) {
   if(inputfiles.empty()) tamm_terminate("No input files provided");
 
   for(auto ifile: inputfiles) {
-    std::string   input_file = fs::canonical(ifile);
-    std::ifstream testinput(input_file);
-    if(!testinput) tamm_terminate("Input file provided [" + input_file + "] does not exist!");
-
-    // read geometry from a json file
-    ChemEnv chem_env;
-    chem_env.input_file = input_file;
-
-    if(rank == 0) {
-      cout << endl << std::string(60, '-') << endl;
-      cout << endl << "Input file provided: " << input_file << endl << endl;
-    }
-
-    // This call should update all input options and SystemData object
-    std::unique_ptr<ECOptionParser> iparse = std::make_unique<ECOptionParser>(chem_env);
-
-    ECOptions& ioptions              = chem_env.ioptions;
-    chem_env.sys_data.input_molecule = ParserUtils::getfilename(input_file);
-
-    if(chem_env.ioptions.common_options.file_prefix.empty()) {
-      chem_env.ioptions.common_options.file_prefix = chem_env.sys_data.input_molecule;
-    }
-
-    chem_env.sys_data.output_file_prefix =
-      chem_env.ioptions.common_options.file_prefix + "." + chem_env.ioptions.common_options.basis;
-    chem_env.workspace_dir = chem_env.sys_data.output_file_prefix + "_files/";
-
-    if(rank == 0) {
-      std::cout << chem_env.jinput.dump(2) << std::endl;
-      cout << endl
-           << "Output folder & files prefix: " << chem_env.sys_data.output_file_prefix << endl
-           << endl;
-      chem_env.sys_data.results["output"]["machine_info"]["date"]           = cur_date.str();
-      chem_env.sys_data.results["output"]["machine_info"]["nnodes"]         = ec.nnodes();
-      chem_env.sys_data.results["output"]["machine_info"]["nproc_per_node"] = ec.ppn();
-      chem_env.sys_data.results["output"]["machine_info"]["nproc_total"] = ec.nnodes() * ec.ppn();
-      auto meminfo                                                       = ec.mem_info();
-      chem_env.sys_data.results["output"]["machine_info"]["cpu"]["name"] = meminfo.cpu_name;
-      chem_env.sys_data.results["output"]["machine_info"]["cpu"]["cpu_memory_per_node_gib"] =
-        meminfo.cpu_mem_per_node;
-      chem_env.sys_data.results["output"]["machine_info"]["cpu"]["total_cpu_memory_gib"] =
-        meminfo.total_cpu_mem;
-      if(ec.has_gpu()) {
-        chem_env.sys_data.results["output"]["machine_info"]["ngpus_per_node"] = ec.gpn();
-        chem_env.sys_data.results["output"]["machine_info"]["ngpus_total"] = ec.nnodes() * ec.gpn();
-        chem_env.sys_data.results["output"]["machine_info"]["gpu"]["name"] = meminfo.gpu_name;
-        chem_env.sys_data.results["output"]["machine_info"]["gpu"]["memory_per_gpu_gib"] =
-          meminfo.gpu_mem_per_device;
-        chem_env.sys_data.results["output"]["machine_info"]["gpu"]["gpu_memory_per_node_gib"] =
-          meminfo.gpu_mem_per_node;
-        chem_env.sys_data.results["output"]["machine_info"]["gpu"]["total_gpu_memory_gib"] =
-          meminfo.total_gpu_mem;
-      }
-    }
-
-    const auto              task = ioptions.task_options;
-    const std::vector<bool> tvec = {task.sinfo,
-                                    task.scf,
-                                    task.mp2,
-                                    task.gw,
-                                    task.fci,
-                                    task.cd_2e,
-                                    task.ducc,
-                                    task.ccsd,
-                                    task.ccsd_t,
-                                    task.ccsd_lambda,
-                                    task.eom_ccsd,
-                                    task.fcidump,
-                                    task.rteom_cc2,
-                                    task.rteom_ccsd,
-                                    task.gfccsd,
-                                    task.dlpno_ccsd.first,
-                                    task.dlpno_ccsd_t.first};
-    if(std::count(tvec.begin(), tvec.end(), true) > 1)
-      tamm_terminate("[INPUT FILE ERROR] only a single task can be enabled at once!");
-
-    std::string ec_arg2{};
-    if(argc == 3) {
-      ec_arg2 = std::string(argv[2]);
-      if(!fs::exists(ec_arg2))
-        tamm_terminate("Input file provided [" + ec_arg2 + "] does not exist!");
-    }
-
-#if !defined(USE_MACIS)
-    if(task.fci) tamm_terminate("Full CI integration not enabled!");
-#endif
-
-    SCFOptions& scf_options   = chem_env.ioptions.scf_options;
-    chem_env.ec_basis         = ECBasis(ec, scf_options.basis, scf_options.basisfile,
-                                        scf_options.gaussian_type, chem_env.atoms, chem_env.ec_atoms);
-    chem_env.shells           = chem_env.ec_basis.shells;
-    chem_env.sys_data.has_ecp = chem_env.ec_basis.has_ecp;
+    std::ifstream testinput(ifile);
+    if(!testinput) tamm_terminate("Input file provided [" + ifile + "] does not exist!");
+  }
 
-    if(task.sinfo) chem_env.sinfo();
-    else if(task.scf) scf::scf_driver(ec, chem_env);
-#if defined(EC_CC)
-    else if(task.mp2) mp2::cd_mp2(ec, chem_env);
-    else if(task.cd_2e) cholesky_2e::cholesky_decomp_2e(ec, chem_env);
-    else if(task.ccsd) cc::ccsd::cd_ccsd(ec, chem_env);
-    else if(task.ccsd_t) cc::ccsd_t::ccsd_t_driver(ec, chem_env);
-    else if(task.cc2) cc2::cd_cc2_driver(ec, chem_env);
-    else if(task.ccsd_lambda) cc::ccsd_lambda::ccsd_lambda_driver(ec, chem_env);
-    else if(task.eom_ccsd) cc::eom::eom_ccsd_driver(ec, chem_env);
-    else if(task.ducc) cc::ducc::ducc_driver(ec, chem_env);
-#if !defined(USE_UPCXX) and defined(EC_COMPLEX)
-    else if(task.fci || task.fcidump) fci::fci_driver(ec, chem_env);
-    else if(task.gfccsd) cc::gfcc::gfccsd_driver(ec, chem_env);
-    else if(task.rteom_ccsd) rteom_cc::ccsd::rt_eom_cd_ccsd_driver(ec, chem_env);
-#endif
+  std::string ec_arg2{};
+  if(argc == 3) {
+    ec_arg2 = std::string(argv[2]);
+    if(!fs::exists(ec_arg2))
+      tamm_terminate("Input file provided [" + ec_arg2 + "] does not exist!");
+  }
 
-#endif
+  // EXACHEM_TASK_FARM=<nodes per group> runs the inputs of a folder concurrently
+  int farm_group_nodes = 0;
+  if(const char* farm_env = std::getenv("EXACHEM_TASK_FARM")) farm_group_nodes = std::atoi(farm_env);
 
-    else
-      tamm_terminate(
-        "[ERROR] Unsupported task specified (or) code for the specified task is not built");
-  }
+  if(farm_group_nodes > 0 && inputfiles.size() > 1)
+    run_task_farm(ec, inputfiles, farm_group_nodes, cur_date.str());
+  else
+    for(auto ifile: inputfiles) run_input(ec, ifile, cur_date.str());
 
   tamm::finalize();
 